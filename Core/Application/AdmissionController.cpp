@@ -0,0 +1,97 @@
+#include "AdmissionController.h"
+
+#include <stdexcept>
+
+namespace Core::Application {
+AdmissionController::Ticket::~Ticket() {
+    if (controller_ != nullptr) {
+        controller_->release();
+    }
+}
+
+AdmissionController::Ticket::Ticket(Ticket&& other) noexcept : controller_(other.controller_) {
+    other.controller_ = nullptr;
+}
+
+AdmissionController::Ticket& AdmissionController::Ticket::operator=(Ticket&& other) noexcept {
+    if (this != &other) {
+        if (controller_ != nullptr) {
+            controller_->release();
+        }
+        controller_ = other.controller_;
+        other.controller_ = nullptr;
+    }
+    return *this;
+}
+
+AdmissionController::AdmissionController(const AdmissionSettings& settings)
+    : settings_(settings), lastEmpty_(Clock::now()) {
+    if (settings_.maxConcurrent == 0) {
+        throw std::invalid_argument("Количество одновременных операций должно быть положительным");
+    }
+}
+
+AdmissionController::Ticket AdmissionController::acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto now = Clock::now();
+
+    // Ожидающие идут первыми: свободное место достаётся новому запросу, только если очереди нет
+    if (waiting_ == 0) {
+        lastEmpty_ = now;
+        if (active_ < settings_.maxConcurrent) {
+            ++active_;
+            ++admitted_;
+            return Ticket(this);
+        }
+    }
+
+    if (waiting_ >= settings_.maxQueued) {
+        ++rejectedQueueFull_;
+        return Ticket();
+    }
+
+    // Очередь стоит дольше interval - это не всплеск, а перегрузка: ждать долго бесполезно
+    const bool standingQueue = now - lastEmpty_ > settings_.interval;
+    const auto deadline = now + (standingQueue ? settings_.target : settings_.interval);
+
+    ++waiting_;
+    const bool admitted =
+        released_.wait_until(lock, deadline, [this] { return active_ < settings_.maxConcurrent; });
+    --waiting_;
+
+    if (waiting_ == 0) {
+        lastEmpty_ = Clock::now();
+    }
+
+    if (!admitted) {
+        ++rejectedTimeout_;
+        return Ticket();
+    }
+
+    ++active_;
+    ++admitted_;
+    ++queued_;
+    return Ticket(this);
+}
+
+AdmissionStatistics AdmissionController::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    AdmissionStatistics statistics;
+    statistics.admitted = admitted_;
+    statistics.queued = queued_;
+    statistics.rejectedQueueFull = rejectedQueueFull_;
+    statistics.rejectedTimeout = rejectedTimeout_;
+    statistics.active = active_;
+    statistics.waiting = waiting_;
+    return statistics;
+}
+
+void AdmissionController::release() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --active_;
+    }
+    released_.notify_one();
+}
+} // namespace Core::Application
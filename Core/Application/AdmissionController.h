@@ -0,0 +1,113 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+namespace Core::Application {
+/**
+ * @brief Настройки контроля допуска
+ */
+struct AdmissionSettings {
+    size_t maxConcurrent = 2;                       // Одновременно выполняемых операций
+    size_t maxQueued = 2;                           // Ожидающих допуска; остальным отказ сразу
+    std::chrono::milliseconds target{5};            // Ожидание при стоящей очереди (CoDel target)
+    std::chrono::milliseconds interval{100};        // Ожидание при пустевшей очереди (CoDel interval)
+};
+
+/**
+ * @brief Счётчики контроля допуска
+ */
+struct AdmissionStatistics {
+    uint64_t admitted = 0;
+    uint64_t queued = 0;             // Допущенные после ожидания
+    uint64_t rejectedQueueFull = 0;  // Отказ без ожидания: очередь заполнена
+    uint64_t rejectedTimeout = 0;    // Отказ после ожидания (сброс нагрузки)
+    uint64_t active = 0;
+    uint64_t waiting = 0;
+};
+
+/**
+ * @brief Контроль допуска: ограничение одновременных операций с очередью
+ *
+ * Не больше maxConcurrent операций выполняются одновременно, не больше maxQueued
+ * ждут освобождения места; остальным сразу отказывается. Ожидание ограничено
+ * по правилу CoDel для очередей запросов: если очередь пустела за последний
+ * interval, новый запрос ждёт до interval (пережидает всплеск), а если очередь
+ * стоит дольше interval - только target. Так при перегрузке запросы отклоняются
+ * быстро, а не копят задержку, и время ответа допущенных остаётся ограниченным.
+ *
+ * Ожидание блокирует вызывающий поток.
+ */
+class AdmissionController {
+  public:
+    /**
+     * @brief Разрешение на выполнение операции; освобождает место при уничтожении
+     */
+    class Ticket {
+      public:
+        Ticket() = default;
+        ~Ticket();
+
+        Ticket(Ticket&& other) noexcept;
+        Ticket& operator=(Ticket&& other) noexcept;
+
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+        /**
+         * @brief Допущена ли операция
+         */
+        explicit operator bool() const {
+            return controller_ != nullptr;
+        }
+
+      private:
+        friend class AdmissionController;
+
+        explicit Ticket(AdmissionController* controller) : controller_(controller) {}
+
+        AdmissionController* controller_ = nullptr;
+    };
+
+    /**
+     * @brief Конструктор
+     * @throws std::invalid_argument если maxConcurrent равно нулю
+     */
+    explicit AdmissionController(const AdmissionSettings& settings);
+
+    AdmissionController(const AdmissionController&) = delete;
+    AdmissionController& operator=(const AdmissionController&) = delete;
+
+    /**
+     * @brief Ждёт места для операции
+     * @return Разрешение; пустое, если в допуске отказано
+     */
+    Ticket acquire();
+
+    /**
+     * @brief Возвращает счётчики
+     */
+    AdmissionStatistics getStatistics() const;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    AdmissionSettings settings_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable released_;
+    size_t active_ = 0;
+    size_t waiting_ = 0;
+    Clock::time_point lastEmpty_;  // Когда очередь в последний раз была пуста
+
+    uint64_t admitted_ = 0;
+    uint64_t queued_ = 0;
+    uint64_t rejectedQueueFull_ = 0;
+    uint64_t rejectedTimeout_ = 0;
+
+    void release();
+};
+} // namespace Core::Application
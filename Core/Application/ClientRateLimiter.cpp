@@ -0,0 +1,73 @@
+#include "ClientRateLimiter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace Core::Application {
+ClientRateLimiter::ClientRateLimiter(double ratePerSecond, double burst, size_t maxClients)
+    : ratePerSecond_(ratePerSecond),
+      burst_(burst),
+      maxClientsPerShard_(std::max<size_t>(maxClients / SHARD_COUNT, 1)) {
+    if (ratePerSecond <= 0.0 || burst <= 0.0) {
+        throw std::invalid_argument("Частота и размер всплеска запросов должны быть положительными");
+    }
+
+    shards_.reserve(SHARD_COUNT);
+    for (size_t i = 0; i < SHARD_COUNT; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+bool ClientRateLimiter::tryAcquire(std::string_view client, Clock::time_point now) {
+    Shard& shard = *shards_[std::hash<std::string_view>{}(client) % SHARD_COUNT];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    std::string key(client);
+    auto it = shard.buckets.find(key);
+    if (it == shard.buckets.end()) {
+        if (shard.buckets.size() >= maxClientsPerShard_) {
+            evictLeastRecent(shard);
+        }
+        it = shard.buckets.emplace(std::move(key), Bucket{burst_, now, {}}).first;
+        shard.recency.push_front(&it->first);
+        it->second.recency = shard.recency.begin();
+    } else {
+        refill(it->second, now);
+        shard.recency.splice(shard.recency.begin(), shard.recency, it->second.recency);
+    }
+
+    if (it->second.tokens < 1.0) {
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    it->second.tokens -= 1.0;
+    return true;
+}
+
+std::chrono::seconds ClientRateLimiter::getRetryAfter() const {
+    // Токен появляется не позже, чем через 1 / ratePerSecond
+    return std::chrono::seconds(std::max<int64_t>(1, static_cast<int64_t>(std::ceil(1.0 / ratePerSecond_))));
+}
+
+void ClientRateLimiter::refill(Bucket& bucket, Clock::time_point now) const {
+    const double elapsed = std::chrono::duration<double>(now - bucket.updatedAt).count();
+    if (elapsed > 0.0) {
+        bucket.tokens = std::min(burst_, bucket.tokens + elapsed * ratePerSecond_);
+        bucket.updatedAt = now;
+    }
+}
+
+void ClientRateLimiter::evictLeastRecent(Shard& shard) {
+    if (shard.recency.empty()) {
+        return;
+    }
+
+    // Указатель на ключ убирается из списка до удаления самого ключа
+    const auto victim = shard.buckets.find(*shard.recency.back());
+    shard.recency.pop_back();
+    shard.buckets.erase(victim);
+}
+} // namespace Core::Application
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Core::Application {
+/**
+ * @brief Ограничение частоты запросов каждого клиента (token bucket)
+ *
+ * У каждого клиента (например, IP-адреса) своё ведро на burst запросов,
+ * пополняемое со скоростью ratePerSecond. Клиенты распределены по шардам
+ * со своими мьютексами. Число клиентов в шарде ограничено: новый клиент
+ * вытесняет тот, что обращался давнее всех (LRU), за O(1) - поток запросов
+ * с множества адресов не раздувает таблицу и не замедляет каждый запрос.
+ * Вытесненный клиент при возвращении получает полное ведро; давно не
+ * обращавшийся клиент обычно и так успевает его наполнить.
+ */
+class ClientRateLimiter {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Конструктор
+     * @param ratePerSecond Средняя допустимая частота запросов клиента
+     * @param burst Запросов подряд, допустимых после простоя
+     * @param maxClients Максимум отслеживаемых клиентов
+     * @throws std::invalid_argument если ratePerSecond или burst не положительны
+     */
+    ClientRateLimiter(double ratePerSecond, double burst, size_t maxClients = 100000);
+
+    ClientRateLimiter(const ClientRateLimiter&) = delete;
+    ClientRateLimiter& operator=(const ClientRateLimiter&) = delete;
+
+    /**
+     * @brief Расходует токен клиента
+     * @param client Идентификатор клиента
+     * @param now Текущее время
+     * @return true, если запрос допустим
+     */
+    bool tryAcquire(std::string_view client, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Через сколько секунд у клиента, получившего отказ, появится токен
+     */
+    std::chrono::seconds getRetryAfter() const;
+
+    /**
+     * @brief Количество отклонённых запросов
+     */
+    uint64_t getRejectedCount() const {
+        return rejected_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    static constexpr size_t SHARD_COUNT = 16;
+
+    // Ключи buckets от недавних клиентов к давним (элементы unordered_map не перемещаются)
+    using RecencyList = std::list<const std::string*>;
+
+    struct Bucket {
+        double tokens = 0.0;
+        Clock::time_point updatedAt;
+        RecencyList::iterator recency;
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, Bucket> buckets;
+        RecencyList recency;
+    };
+
+    double ratePerSecond_;
+    double burst_;
+    size_t maxClientsPerShard_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::atomic<uint64_t> rejected_{0};
+
+    /**
+     * @brief Пополняет ведро на время, прошедшее с последнего обращения
+     */
+    void refill(Bucket& bucket, Clock::time_point now) const;
+
+    /**
+     * @brief Удаляет из шарда давнее всех обращавшегося клиента (мьютекс шарда должен быть захвачен)
+     */
+    static void evictLeastRecent(Shard& shard);
+};
+} // namespace Core::Application
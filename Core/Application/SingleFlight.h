@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../Ports/RequestDeadline.h"
+
+namespace Core::Application {
+/**
+ * @brief Счётчики объединения одинаковых запросов
+ */
+struct SingleFlightStatistics {
+    uint64_t executions = 0;  // Вызовы, выполненные самостоятельно
+    uint64_t shared = 0;      // Вызовы, получившие результат чужого выполнения
+    uint64_t timeouts = 0;    // Вызовы, не дождавшиеся чужого выполнения (maxWait, срок, отключение)
+};
+
+/**
+ * @brief Объединение одновременных вызовов с одинаковым ключом
+ *
+ * Первый вызов с ключом выполняет функцию, а вызовы с тем же ключом, пришедшие
+ * до её завершения, ждут и получают тот же результат или то же исключение.
+ * После завершения ключ освобождается: следующий вызов выполнит функцию заново,
+ * поэтому результаты не кешируются, а только разделяются.
+ *
+ * Функция получает срок первого вызова с общей проверкой отключения: она
+ * срабатывает, только когда отключились клиенты всех вызовов, ждущих результат.
+ * Вызов, пришедший после этого, не присоединяется к прерываемому выполнению,
+ * а выполняет функцию заново.
+ *
+ * Ожидание ограничено maxWait и сроком самого вызова, а отключение его клиента
+ * проверяется во время ожидания. Не дождавшийся вызов получает
+ * Ports::RequestCancelledError, а не выполняет функцию сам, чтобы не умножать
+ * нагрузку на медленный бэкенд.
+ *
+ * @tparam Value Тип результата (копируется каждому ожидавшему вызову)
+ */
+template <typename Value>
+class SingleFlight {
+  public:
+    /**
+     * @brief Конструктор
+     * @param maxWait Максимальное время ожидания чужого выполнения
+     */
+    explicit SingleFlight(std::chrono::milliseconds maxWait) : maxWait_(maxWait) {}
+
+    SingleFlight(const SingleFlight&) = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    /**
+     * @brief Выполняет функцию или присоединяется к её выполнению с тем же ключом
+     * @param key Ключ вызова
+     * @param deadline Срок вызова: ограничивает ожидание чужого выполнения
+     * @param function Функция, вычисляющая результат по сроку (const Ports::RequestDeadline&)
+     * @return Результат функции
+     * @throws Исключение функции; Ports::RequestCancelledError, если ожидание превысило
+     *         maxWait или срок вызова либо клиент вызова отключился
+     */
+    template <typename Function>
+    Value run(const std::string& key, const Ports::RequestDeadline& deadline, Function&& function) {
+        std::shared_future<Value> inFlight;
+        std::shared_ptr<Attendance> attendance;
+        size_t caller = 0;
+        std::promise<Value> promise;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            const auto it = calls_.find(key);
+            if (it != calls_.end() && it->second.attendance->join(deadline.getDisconnectProbe(), caller)) {
+                inFlight = it->second.result;
+                attendance = it->second.attendance;
+            } else {
+                // Выполнение, все клиенты которого отключились, прерывается: его заменяет новое
+                attendance = std::make_shared<Attendance>(deadline.getDisconnectProbe());
+                calls_[key] = Call{promise.get_future().share(), attendance};
+            }
+        }
+
+        if (inFlight.valid()) {
+            try {
+                return await(inFlight, deadline);
+            } catch (...) {
+                // Не дождавшийся вызов больше не удерживает общее выполнение
+                attendance->leave(caller);
+                throw;
+            }
+        }
+
+        executions_.fetch_add(1, std::memory_order_relaxed);
+
+        // Без проверки у первого вызова его клиент считается подключённым всегда,
+        // и общая проверка никогда бы не сработала
+        Ports::RequestDeadline::DisconnectProbe sharedProbe;
+        if (deadline.hasDisconnectProbe()) {
+            sharedProbe = [attendance] { return attendance->allDisconnected(); };
+        }
+        const Ports::RequestDeadline sharedDeadline = deadline.withDisconnectProbe(std::move(sharedProbe));
+
+        try {
+            Value value = function(sharedDeadline);
+            // Ключ освобождается до публикации результата: вызов, пришедший после
+            // завершения, не должен получить уже готовый (возможно, устаревший) результат
+            release(key, attendance);
+            promise.set_value(value);
+            return value;
+        } catch (...) {
+            release(key, attendance);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+    }
+
+    /**
+     * @brief Возвращает счётчики вызовов
+     */
+    SingleFlightStatistics getStatistics() const {
+        SingleFlightStatistics statistics;
+        statistics.executions = executions_.load(std::memory_order_relaxed);
+        statistics.shared = shared_.load(std::memory_order_relaxed);
+        statistics.timeouts = timeouts_.load(std::memory_order_relaxed);
+        return statistics;
+    }
+
+  private:
+    /**
+     * @brief Вызовы, ждущие одного выполнения, и проверки отключения их клиентов
+     *
+     * Проверки вызываются из потока, следящего за сроками запросов.
+     */
+    class Attendance {
+      public:
+        explicit Attendance(Ports::RequestDeadline::DisconnectProbe leaderProbe) {
+            callers_.push_back({std::move(leaderProbe), false});
+        }
+
+        /**
+         * @brief Присоединяет вызов
+         * @param caller Номер вызова для leave()
+         * @return false, если все клиенты уже отключились и выполнение прерывается
+         */
+        bool join(Ports::RequestDeadline::DisconnectProbe probe, size_t& caller) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (abandoned_) {
+                return false;
+            }
+            caller = callers_.size();
+            callers_.push_back({std::move(probe), false});
+            return true;
+        }
+
+        void leave(size_t caller) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            callers_[caller].left = true;
+        }
+
+        /**
+         * @brief Отключились ли клиенты всех вызовов (вызов без проверки не отключается)
+         */
+        bool allDisconnected() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!abandoned_) {
+                abandoned_ = std::all_of(callers_.begin(), callers_.end(), [](const Caller& caller) {
+                    return caller.left || (caller.probe && caller.probe());
+                });
+            }
+            return abandoned_;
+        }
+
+      private:
+        struct Caller {
+            Ports::RequestDeadline::DisconnectProbe probe;
+            bool left;  // Перестал ждать результат (срок, maxWait или отключение)
+        };
+
+        std::mutex mutex_;
+        std::vector<Caller> callers_;
+        bool abandoned_ = false;  // Отключение замечено - выполнение прерывается
+    };
+
+    /**
+     * @brief Выполнение с ключом
+     */
+    struct Call {
+        std::shared_future<Value> result;
+        std::shared_ptr<Attendance> attendance;
+    };
+
+    // Как часто ожидающий вызов проверяет отключение своего клиента
+    static constexpr std::chrono::milliseconds DISCONNECT_POLL_INTERVAL{50};
+
+    std::chrono::milliseconds maxWait_;
+
+    std::mutex mutex_;
+    std::unordered_map<std::string, Call> calls_;
+
+    std::atomic<uint64_t> executions_{0};
+    std::atomic<uint64_t> shared_{0};
+    std::atomic<uint64_t> timeouts_{0};
+
+    /**
+     * @brief Ждёт чужое выполнение до maxWait или срока вызова, смотря что раньше
+     */
+    Value await(const std::shared_future<Value>& inFlight, const Ports::RequestDeadline& deadline) {
+        using Clock = Ports::RequestDeadline::Clock;
+
+        auto waitUntil = Clock::now() + maxWait_;
+        if (deadline.hasExpiry()) {
+            waitUntil = std::min(waitUntil, deadline.getExpiresAt());
+        }
+
+        while (true) {
+            const auto now = Clock::now();
+            const auto nextCheck =
+                deadline.hasDisconnectProbe() ? std::min(waitUntil, now + DISCONNECT_POLL_INTERVAL) : waitUntil;
+            if (inFlight.wait_until(nextCheck) == std::future_status::ready) {
+                break;
+            }
+
+            if (Clock::now() >= waitUntil || deadline.isClientDisconnected()) {
+                timeouts_.fetch_add(1, std::memory_order_relaxed);
+                deadline.throwIfCancelled();
+                throw Ports::RequestCancelledError("Превышено время ожидания одинакового запроса");
+            }
+        }
+
+        shared_.fetch_add(1, std::memory_order_relaxed);
+        return inFlight.get();
+    }
+
+    void release(const std::string& key, const std::shared_ptr<Attendance>& attendance) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Ключ мог уже перейти к новому выполнению, заменившему прерываемое
+        const auto it = calls_.find(key);
+        if (it != calls_.end() && it->second.attendance == attendance) {
+            calls_.erase(it);
+        }
+    }
+};
+} // namespace Core::Application
@@ -1,21 +1,90 @@
 #include "IndexPageUseCase.h"
 
+#include <chrono>
 #include <stdexcept>
 
+#include "../../Domain/Service/ContentHashService.h"
+
 namespace Core::Application::UseCases {
 IndexPageUseCase::IndexPageUseCase(std::shared_ptr<Ports::IDocumentRepository> documentRepository,
                                    std::shared_ptr<Ports::IWordRepository> wordRepository,
                                    std::shared_ptr<Ports::IHtmlParser> htmlParser,
-                                   std::shared_ptr<Ports::ITextProcessor> textProcessor)
+                                   std::shared_ptr<Ports::ITextProcessor> textProcessor,
+                                   std::shared_ptr<Ports::IMetricsRegistry> metrics)
     : documentRepository_(std::move(documentRepository)),
       wordRepository_(std::move(wordRepository)),
       htmlParser_(std::move(htmlParser)),
-      textProcessor_(std::move(textProcessor)) {}
+      textProcessor_(std::move(textProcessor)),
+      metrics_(std::move(metrics)) {
+    parseLatency_ = getStageLatency(metrics_.get(), "parse");
+    indexLatency_ = getStageLatency(metrics_.get(), "index");
+    databaseLatency_ = getStageLatency(metrics_.get(), "db");
+}
+
+void IndexPageUseCase::recordLatency(Ports::ILatencyHistogram* histogram, std::chrono::nanoseconds duration) {
+    if (histogram != nullptr) {
+        histogram->record(duration);
+    }
+}
+
+Ports::ILatencyHistogram* IndexPageUseCase::getStageLatency(Ports::IMetricsRegistry* metrics,
+                                                            const std::string& stage) {
+    if (metrics == nullptr) {
+        return nullptr;
+    }
+    return &metrics->histogram("spider_stage_duration_seconds", "Crawl time by stage", "stage=\"" + stage + "\"");
+}
+
+DTO::IndexPageResultDTO IndexPageUseCase::execute(const std::string& url,
+                                                  const std::string& htmlContent,
+                                                  const DTO::CacheValidatorsDTO& validators) {
+    using Clock = std::chrono::steady_clock;
+
+    DTO::IndexPageResultDTO result;
+
+    // Хешируем исходный HTML и сравниваем с хешем прошлого краулинга.
+    // Совпадение означает, что разбор, анализ и запись в БД можно пропустить
+    auto startedAt = Clock::now();
+    const auto contentHash = Domain::Service::ContentHashService::hash(htmlContent);
+    std::chrono::nanoseconds indexTime = Clock::now() - startedAt;
+
+    // Время БД складывается из чтения состояния и записи, между которыми идёт разбор
+    startedAt = Clock::now();
+    std::optional<DTO::DocumentStateDTO> previousState;
+    try {
+        previousState = documentRepository_->findStateByUrl(url);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при индексации страницы " + url + ": " + e.what());
+    }
+    std::chrono::nanoseconds databaseTime = Clock::now() - startedAt;
+
+    if (previousState.has_value() && previousState->contentHash == contentHash) {
+        result.documentId = previousState->documentId;
+        result.status = DTO::IndexPageResultDTO::Status::Unchanged;
+
+        // Сервер мог выдать новые валидаторы для того же содержимого
+        if (previousState->validators != validators) {
+            startedAt = Clock::now();
+            try {
+                documentRepository_->updateCacheValidators(result.documentId, validators);
+            } catch (const std::exception& e) {
+                throw std::runtime_error("Ошибка при индексации страницы " + url + ": " + e.what());
+            }
+            databaseTime += Clock::now() - startedAt;
+        }
+
+        recordLatency(databaseLatency_, databaseTime);
+        return result;
+    }
 
-Domain::Model::Document::IdType IndexPageUseCase::execute(const std::string& url,
-                                                          const std::string& htmlContent) {
     // Извлекаем текст из HTML
-    std::string text = htmlParser_->extractText(htmlContent);
+    std::string text;
+    {
+        Ports::ScopedLatency latency(parseLatency_);
+        text = htmlParser_->extractText(htmlContent);
+    }
+
+    startedAt = Clock::now();
 
     // Нормализуем текст
     text = textProcessor_->normalize(text);
@@ -26,22 +95,38 @@ Domain::Model::Document::IdType IndexPageUseCase::execute(const std::string& url
     // Анализируем частотность слов
     auto wordFrequencies = Core::Domain::Service::IndexingService::analyzeWordFrequency(text);
 
-    // Выполняем все операции с БД в одной транзакции
-    // Это критично для многопоточной работы
+    indexTime += Clock::now() - startedAt;
+    recordLatency(indexLatency_, indexTime);
+
+    // Документ сохраняется без хеша: хеш фиксируется только после постингов.
+    // Если запись постингов не удалась, следующий краулинг проиндексирует страницу заново
     Domain::Model::Document document(url, text);
-    Domain::Model::Document::IdType documentId = 0;
 
+    startedAt = Clock::now();
     try {
         // Сохраняем документ (создаём новый или обновляем существующий)
-        documentId = documentRepository_->save(document);
+        result.documentId = documentRepository_->save(document);
 
         // Сохраняем частотность слов (обновляем существующие или создаём новые)
-        wordRepository_->saveWordFrequencies(documentId, wordFrequencies);
+        wordRepository_->saveWordFrequencies(result.documentId, wordFrequencies);
+
+        // Постинги записаны: сохраняем хеш и валидаторы для следующего условного запроса
+        documentRepository_->updateContentState(result.documentId, contentHash, validators);
     } catch (const std::exception& e) {
         // Перебрасываем исключение с дополнительной информацией
         throw std::runtime_error("Ошибка при индексации страницы " + url + ": " + e.what());
     }
+    databaseTime += Clock::now() - startedAt;
+    recordLatency(databaseLatency_, databaseTime);
 
-    return documentId;
+    return result;
+}
+
+DTO::CacheValidatorsDTO IndexPageUseCase::getCacheValidators(const std::string& url) {
+    auto state = documentRepository_->findStateByUrl(url);
+    if (!state.has_value()) {
+        return {};
+    }
+    return state->validators;
 }
 } // namespace Core::Application::UseCases
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
 #include <string>
 
+#include "../../DTO/CacheValidatorsDTO.h"
+#include "../../DTO/IndexPageResultDTO.h"
 #include "../../Domain/Service/IndexingService.h"
 #include "../../Ports/IDocumentRepository.h"
 #include "../../Ports/IHtmlParser.h"
+#include "../../Ports/IMetricsRegistry.h"
 #include "../../Ports/ITextProcessor.h"
 #include "../../Ports/IWordRepository.h"
 
@@ -15,24 +19,56 @@ namespace Core::Application::UseCases {
  *
  * Выполняет полную индексацию страницы: парсинг HTML, извлечение текста,
  * анализ частотности слов и сохранение в БД.
+ *
+ * Если хеш HTML совпадает с сохранённым при прошлом краулинге,
+ * индексация пропускается.
+ *
+ * Поколение индекса (сброс кеша результатов поиска HTTPServer) не меняется:
+ * его увеличивает Spider один раз после прохода краулинга, изменившего страницы.
+ *
+ * С реестром метрик время этапов записывается в spider_stage_duration_seconds:
+ * parse - извлечение текста из HTML, index - хеш, нормализация и частотность слов,
+ * db - все обращения к БД при индексации страницы (одна запись на страницу).
  */
 class IndexPageUseCase {
   public:
     /**
      * @brief Конструктор с инъекцией зависимостей
+     * @param metrics Реестр метрик этапов индексации (nullptr - без метрик)
      */
     IndexPageUseCase(std::shared_ptr<Ports::IDocumentRepository> documentRepository,
                      std::shared_ptr<Ports::IWordRepository> wordRepository,
                      std::shared_ptr<Ports::IHtmlParser> htmlParser,
-                     std::shared_ptr<Ports::ITextProcessor> textProcessor);
+                     std::shared_ptr<Ports::ITextProcessor> textProcessor,
+                     std::shared_ptr<Ports::IMetricsRegistry> metrics = nullptr);
 
     /**
      * @brief Индексирует веб-страницу
      * @param url URL страницы
      * @param htmlContent HTML-содержимое страницы
-     * @return ID созданного документа, или 0 если индексация не удалась
+     * @param validators ETag / Last-Modified ответа, сохраняются для условных запросов
+     * @return Результат индексации: ID документа и признак того, что страница не изменилась
+     */
+    DTO::IndexPageResultDTO execute(const std::string& url,
+                                    const std::string& htmlContent,
+                                    const DTO::CacheValidatorsDTO& validators = {});
+
+    /**
+     * @brief Возвращает HTTP-валидаторы, сохранённые при прошлом краулинге
+     * @param url URL страницы
+     * @return ETag / Last-Modified (пусто, если документ новый или сервер их не отдавал)
+     */
+    DTO::CacheValidatorsDTO getCacheValidators(const std::string& url);
+
+    /**
+     * @brief Гистограмма этапа краулинга в spider_stage_duration_seconds
+     *
+     * Этапы вне Use Case (скачивание, извлечение ссылок) пишутся в ту же метрику.
+     * @param metrics Реестр метрик (может быть nullptr)
+     * @param stage Название этапа
+     * @return Гистограмма или nullptr без реестра
      */
-    Domain::Model::Document::IdType execute(const std::string& url, const std::string& htmlContent);
+    static Ports::ILatencyHistogram* getStageLatency(Ports::IMetricsRegistry* metrics, const std::string& stage);
 
   private:
     std::shared_ptr<Ports::IDocumentRepository> documentRepository_;
@@ -40,5 +76,13 @@ class IndexPageUseCase {
     std::shared_ptr<Ports::IHtmlParser> htmlParser_;
     std::shared_ptr<Ports::ITextProcessor> textProcessor_;
     Domain::Service::IndexingService indexingService_;
+
+    // Гистограммы этапов индексации (nullptr без реестра метрик)
+    std::shared_ptr<Ports::IMetricsRegistry> metrics_;
+    Ports::ILatencyHistogram* parseLatency_ = nullptr;
+    Ports::ILatencyHistogram* indexLatency_ = nullptr;
+    Ports::ILatencyHistogram* databaseLatency_ = nullptr;
+
+    static void recordLatency(Ports::ILatencyHistogram* histogram, std::chrono::nanoseconds duration);
 };
 } // namespace Core::Application::UseCases
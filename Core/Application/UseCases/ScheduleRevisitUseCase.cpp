@@ -0,0 +1,55 @@
+#include "ScheduleRevisitUseCase.h"
+
+#include <chrono>
+
+namespace Core::Application::UseCases {
+ScheduleRevisitUseCase::ScheduleRevisitUseCase(
+    std::shared_ptr<Ports::IRevisitScheduleRepository> scheduleRepository)
+    : scheduleRepository_(std::move(scheduleRepository)) {}
+
+void ScheduleRevisitUseCase::recordVisit(const std::string& url, bool changed) {
+    auto schedule = scheduleRepository_->findByUrl(url);
+    if (!schedule.has_value()) {
+        schedule.emplace(url);
+    }
+
+    Domain::Service::RevisitSchedulingService::recordVisit(schedule.value(), now(), changed);
+
+    scheduleRepository_->save(schedule.value());
+}
+
+std::vector<std::string> ScheduleRevisitUseCase::takeDueUrls(size_t limit) {
+    const auto currentTime = now();
+
+    // Извлечённые страницы откладываются на минимальный интервал: если посещение
+    // не удастся, страница вернётся в очередь, а не будет выдаваться бесконечно
+    const auto leaseUntil =
+        currentTime + Domain::Service::RevisitSchedulingService::MIN_REVISIT_INTERVAL_SEC;
+
+    auto schedules = scheduleRepository_->takeDue(currentTime, limit, leaseUntil);
+
+    std::vector<std::string> urls;
+    urls.reserve(schedules.size());
+    for (const auto& schedule : schedules) {
+        urls.push_back(schedule.getUrl());
+    }
+
+    return urls;
+}
+
+std::optional<int64_t> ScheduleRevisitUseCase::secondsUntilNextVisit() {
+    const auto nextVisit = scheduleRepository_->findNextVisitTime();
+    if (!nextVisit.has_value()) {
+        return std::nullopt;
+    }
+
+    const auto currentTime = now();
+    return nextVisit.value() > currentTime ? nextVisit.value() - currentTime : 0;
+}
+
+Domain::Model::RevisitSchedule::TimestampType ScheduleRevisitUseCase::now() {
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+} // namespace Core::Application::UseCases
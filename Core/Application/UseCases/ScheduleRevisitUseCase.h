@@ -0,0 +1,54 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../../Domain/Service/RevisitSchedulingService.h"
+#include "../../Ports/IRevisitScheduleRepository.h"
+
+namespace Core::Application::UseCases {
+/**
+ * @brief Use Case для адаптивного повторного краулинга
+ *
+ * Учитывает результат каждого посещения страницы (изменилась или нет)
+ * и выдаёт страницы, время повторного посещения которых наступило.
+ */
+class ScheduleRevisitUseCase {
+  public:
+    /**
+     * @brief Конструктор с инъекцией зависимостей
+     */
+    explicit ScheduleRevisitUseCase(
+        std::shared_ptr<Ports::IRevisitScheduleRepository> scheduleRepository);
+
+    /**
+     * @brief Регистрирует посещение страницы и планирует следующее
+     * @param url URL страницы
+     * @param changed Изменилась ли страница с прошлого посещения
+     */
+    void recordVisit(const std::string& url, bool changed);
+
+    /**
+     * @brief Извлекает URL страниц, которые пора посетить повторно
+     * @param limit Максимальное количество страниц
+     * @return Список URL в порядке наступления времени посещения
+     */
+    std::vector<std::string> takeDueUrls(size_t limit);
+
+    /**
+     * @brief Возвращает число секунд до ближайшего запланированного посещения
+     * @return Секунды (0, если посещение уже наступило); nullopt, если расписаний нет
+     */
+    std::optional<int64_t> secondsUntilNextVisit();
+
+  private:
+    std::shared_ptr<Ports::IRevisitScheduleRepository> scheduleRepository_;
+
+    /**
+     * @brief Текущее время в секундах с начала эпохи
+     */
+    static Domain::Model::RevisitSchedule::TimestampType now();
+};
+} // namespace Core::Application::UseCases
@@ -1,28 +1,186 @@
 #include "SearchDocumentsUseCase.h"
 
+#include <algorithm>
+#include <chrono>
+
 namespace Core::Application::UseCases {
 SearchDocumentsUseCase::SearchDocumentsUseCase(
     std::shared_ptr<Ports::IWordRepository> wordRepository,
-    std::shared_ptr<Ports::ITextProcessor> textProcessor)
-    : wordRepository_(std::move(wordRepository)), textProcessor_(std::move(textProcessor)) {}
+    std::shared_ptr<Ports::ITextProcessor> textProcessor,
+    std::shared_ptr<Ports::ISearchResultCache> resultCache,
+    std::shared_ptr<Ports::IIndexGenerationRepository> indexGeneration,
+    std::chrono::milliseconds coalescingTimeout,
+    std::shared_ptr<Ports::IMetricsRegistry> metrics)
+    : wordRepository_(std::move(wordRepository)),
+      textProcessor_(std::move(textProcessor)),
+      resultCache_(std::move(resultCache)),
+      indexGeneration_(std::move(indexGeneration)),
+      metrics_(std::move(metrics)) {
+    if (coalescingTimeout.count() > 0) {
+        inFlightSearches_ = std::make_unique<SingleFlight<DTO::SearchHitsDTO>>(coalescingTimeout);
+    }
+
+    normalizeLatency_ = getStageLatency(metrics_.get(), "normalize");
+    repositoryLatency_ = getStageLatency(metrics_.get(), "db");
+    rankingLatency_ = getStageLatency(metrics_.get(), "rank");
+}
 
 std::vector<Domain::Model::SearchResult> SearchDocumentsUseCase::execute(
     const Domain::ValueObject::SearchQuery& query,
-    size_t maxResults) {
+    size_t maxResults,
+    const Ports::RequestDeadline& deadline) {
+    return executeWithTotal(query, maxResults, deadline).results;
+}
+
+DTO::SearchHitsDTO SearchDocumentsUseCase::executeWithTotal(const Domain::ValueObject::SearchQuery& query,
+                                                            size_t maxResults,
+                                                            const Ports::RequestDeadline& deadline) {
     // Нормализуем и приводим термы запроса к нижнему регистру
     // (так же, как при индексации документов)
     std::vector<std::string> terms;
-    for (const auto& term : query.getTerms()) {
-        std::string normalized = textProcessor_->normalize(term);
-        terms.push_back(textProcessor_->toLowercase(normalized));
+    {
+        Ports::ScopedLatency latency(normalizeLatency_);
+        for (const auto& term : query.getTerms()) {
+            std::string normalized = textProcessor_->normalize(term);
+            terms.push_back(textProcessor_->toLowercase(normalized));
+        }
+
+        // Повторы слова не меняют результат поиска "все слова", но ломали бы
+        // сравнение количества найденных слов с количеством термов
+        std::sort(terms.begin(), terms.end());
+        terms.erase(std::unique(terms.begin(), terms.end()), terms.end());
+    }
+
+    if (terms.empty()) {
+        return {};
     }
 
-    // Ищем документы
-    auto results = wordRepository_->search(terms);
+    const std::string key = makeSearchKey(terms, maxResults);
 
-    // Ранжируем и ограничиваем результаты
-    results = Core::Domain::Service::RankingService::rankResults(std::move(results), maxResults);
+    if (!resultCache_) {
+        return searchCoalesced(key, terms, maxResults, deadline);
+    }
+
+    // Поколение читается до поиска: если Spider изменит индекс во время поиска,
+    // запись получит старое поколение и при следующем обращении будет отброшена
+    const int64_t generation = indexGeneration_ ? indexGeneration_->getGeneration() : 0;
 
-    return results;
+    if (auto cached = resultCache_->find(key, generation)) {
+        return std::move(*cached);
+    }
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    auto hits = searchCoalesced(key, terms, maxResults, deadline);
+    resultCache_->store(key, generation, hits, std::chrono::steady_clock::now() - startedAt);
+
+    return hits;
+}
+
+Ports::ILatencyHistogram* SearchDocumentsUseCase::getStageLatency(Ports::IMetricsRegistry* metrics,
+                                                                  const std::string& stage) {
+    if (metrics == nullptr) {
+        return nullptr;
+    }
+    return &metrics->histogram("search_stage_duration_seconds", "Search time by stage", "stage=\"" + stage + "\"");
+}
+
+std::optional<Ports::SearchCacheStatistics> SearchDocumentsUseCase::getCacheStatistics() const {
+    if (!resultCache_) {
+        return std::nullopt;
+    }
+    return resultCache_->getStatistics();
+}
+
+std::optional<SingleFlightStatistics> SearchDocumentsUseCase::getCoalescingStatistics() const {
+    if (!inFlightSearches_) {
+        return std::nullopt;
+    }
+    return inFlightSearches_->getStatistics();
+}
+
+DTO::SearchHitsDTO SearchDocumentsUseCase::searchCoalesced(const std::string& key,
+                                                           const std::vector<std::string>& terms,
+                                                           size_t maxResults,
+                                                           const Ports::RequestDeadline& deadline) {
+    if (!inFlightSearches_) {
+        return search(terms, maxResults, deadline);
+    }
+
+    // Результат разделяют все ожидающие: поиск прерывается по отключению, только когда отключились все их клиенты
+    return inFlightSearches_->run(key, deadline, [&](const Ports::RequestDeadline& sharedDeadline) {
+        return search(terms, maxResults, sharedDeadline);
+    });
+}
+
+DTO::SearchHitsDTO SearchDocumentsUseCase::search(const std::vector<std::string>& terms,
+                                                  size_t maxResults,
+                                                  const Ports::RequestDeadline& deadline) {
+    // Лучшие документы со всеми словами: постинги пересекаются в памяти, а документы,
+    // заведомо не попадающие в выдачу, не досчитываются
+    // Время репозитория складывается из двух запросов, между которыми идёт ранжирование
+    auto startedAt = std::chrono::steady_clock::now();
+    const auto postings = wordRepository_->findPostings(terms, deadline);
+    std::chrono::nanoseconds repositoryTime = std::chrono::steady_clock::now() - startedAt;
+
+    std::vector<Domain::Service::PostingIntersectionService::Match> matches;
+    {
+        Ports::ScopedLatency latency(rankingLatency_);
+        matches = Domain::Service::PostingIntersectionService::intersectTop(postings, maxResults);
+    }
+    if (matches.empty()) {
+        if (repositoryLatency_ != nullptr) {
+            repositoryLatency_->record(repositoryTime);
+        }
+        return {};
+    }
+
+    DTO::SearchHitsDTO hits;
+
+    // Неполная выдача означает, что пересечение просмотрено целиком и отсечений не было
+    if (matches.size() < maxResults) {
+        hits.totalHits = matches.size();
+    } else {
+        hits.totalHits = postings.front().size();
+        for (const auto& postingList : postings) {
+            hits.totalHits = std::min(hits.totalHits, postingList.size());
+        }
+        // У запроса из одного слова пересечение - весь его список
+        hits.totalIsExact = postings.size() == 1;
+    }
+
+    // URL загружаем только для документов выдачи
+    std::vector<Domain::Model::Document::IdType> documentIds;
+    documentIds.reserve(matches.size());
+    for (const auto& match : matches) {
+        documentIds.push_back(match.documentId);
+    }
+
+    startedAt = std::chrono::steady_clock::now();
+    const auto urls = wordRepository_->findDocumentUrls(documentIds, deadline);
+    repositoryTime += std::chrono::steady_clock::now() - startedAt;
+    if (repositoryLatency_ != nullptr) {
+        repositoryLatency_->record(repositoryTime);
+    }
+
+    // Документы уже в порядке RankingService
+    hits.results.reserve(matches.size());
+    for (const auto& match : matches) {
+        const auto it = urls.find(match.documentId);
+        if (it != urls.end()) {
+            hits.results.emplace_back(match.documentId, it->second, match.relevance);
+        }
+    }
+
+    return hits;
+}
+
+std::string SearchDocumentsUseCase::makeSearchKey(const std::vector<std::string>& terms, size_t maxResults) {
+    // Нулевой байт не встречается в тексте термов, поэтому разные наборы термов не совпадают
+    std::string key = std::to_string(maxResults);
+    for (const auto& term : terms) {
+        key += '\0';
+        key += term;
+    }
+    return key;
 }
 } // namespace Core::Application::UseCases
@@ -1,41 +1,145 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <optional>
+#include <string>
 #include <vector>
 
+#include "../../DTO/SearchHitsDTO.h"
 #include "../../Domain/Model/SearchResult.h"
+#include "../../Domain/Service/PostingIntersectionService.h"
 #include "../../Domain/Service/RankingService.h"
 #include "../../Domain/ValueObject/SearchQuery.h"
+#include "../../Ports/IIndexGenerationRepository.h"
+#include "../../Ports/ISearchResultCache.h"
+#include "../../Ports/IMetricsRegistry.h"
 #include "../../Ports/ITextProcessor.h"
 #include "../../Ports/IWordRepository.h"
+#include "../../Ports/RequestDeadline.h"
+#include "../SingleFlight.h"
 
 namespace Core::Application::UseCases {
 /**
  * @brief Use Case для поиска документов
  *
  * Выполняет поиск документов по запросу, ранжирует и ограничивает результаты.
+ * Списки постингов слов запрашиваются у репозитория, а пересекаются здесь,
+ * через PostingIntersectionService.
+ *
+ * Если передан кеш результатов, выдача сначала ищется в нём по нормализованным
+ * термам и количеству результатов. Записи кеша помечаются поколением индекса,
+ * прочитанным до поиска; без счётчика поколений (индекс неизменен) оно равно нулю.
+ *
+ * Одновременные поиски с одинаковым ключом (при промахе кеша) объединяются:
+ * репозиторий опрашивает только первый, остальные ждут его результат.
+ *
+ * Количество найденных документов точное, если их меньше maxResults или в запросе
+ * одно слово; иначе пересечение досчитывается не до конца (MaxScore) и количество
+ * оценивается сверху длиной самого короткого списка постингов.
+ *
+ * Срок запроса передаётся репозиторию: поиск, результат которого уже не нужен,
+ * прерывается исключением Ports::RequestCancelledError и не попадает в кеш.
+ *
+ * С реестром метрик время этапов поиска (нормализация термов, запросы к репозиторию,
+ * пересечение и ранжирование) записывается в search_stage_duration_seconds.
  */
 class SearchDocumentsUseCase {
   public:
     /**
      * @brief Конструктор с инъекцией зависимостей
+     * @param coalescingTimeout Максимальное ожидание одинакового поиска (0 - не объединять)
+     * @param metrics Реестр метрик этапов поиска (nullptr - без метрик)
      */
     SearchDocumentsUseCase(std::shared_ptr<Ports::IWordRepository> wordRepository,
-                           std::shared_ptr<Ports::ITextProcessor> textProcessor);
+                           std::shared_ptr<Ports::ITextProcessor> textProcessor,
+                           std::shared_ptr<Ports::ISearchResultCache> resultCache = nullptr,
+                           std::shared_ptr<Ports::IIndexGenerationRepository> indexGeneration = nullptr,
+                           std::chrono::milliseconds coalescingTimeout = std::chrono::milliseconds::zero(),
+                           std::shared_ptr<Ports::IMetricsRegistry> metrics = nullptr);
 
     /**
      * @brief Выполняет поиск по запросу
      * @param query Поисковый запрос
      * @param maxResults Максимальное количество результатов (по умолчанию 10)
+     * @param deadline Срок запроса (по умолчанию без срока)
      * @return Список отранжированных результатов
+     * @throws Ports::RequestCancelledError если срок истёк или клиент отключился
      */
     std::vector<Domain::Model::SearchResult> execute(
         const Domain::ValueObject::SearchQuery& query,
-        size_t maxResults = Domain::Service::RankingService::DEFAULT_MAX_RESULTS);
+        size_t maxResults = Domain::Service::RankingService::DEFAULT_MAX_RESULTS,
+        const Ports::RequestDeadline& deadline = Ports::RequestDeadline());
+
+    /**
+     * @brief Выполняет поиск по запросу и считает найденные документы
+     * @param query Поисковый запрос
+     * @param maxResults Максимальное количество результатов
+     * @param deadline Срок запроса (по умолчанию без срока)
+     * @return Отранжированные результаты и количество документов со всеми словами запроса
+     * @throws Ports::RequestCancelledError если срок истёк или клиент отключился
+     */
+    DTO::SearchHitsDTO executeWithTotal(const Domain::ValueObject::SearchQuery& query,
+                                        size_t maxResults,
+                                        const Ports::RequestDeadline& deadline = Ports::RequestDeadline());
+
+    /**
+     * @brief Возвращает счётчики кеша результатов
+     * @return Счётчики или nullopt, если кеш не используется
+     */
+    std::optional<Ports::SearchCacheStatistics> getCacheStatistics() const;
+
+    /**
+     * @brief Возвращает счётчики объединения одинаковых поисков
+     * @return Счётчики или nullopt, если поиски не объединяются
+     */
+    std::optional<SingleFlightStatistics> getCoalescingStatistics() const;
+
+    /**
+     * @brief Гистограмма этапа поиска в search_stage_duration_seconds
+     *
+     * Этапы вне Use Case (разбор запроса, отрисовка ответа) пишутся в ту же метрику.
+     * @param metrics Реестр метрик (может быть nullptr)
+     * @param stage Название этапа
+     * @return Гистограмма или nullptr без реестра
+     */
+    static Ports::ILatencyHistogram* getStageLatency(Ports::IMetricsRegistry* metrics, const std::string& stage);
 
   private:
     std::shared_ptr<Ports::IWordRepository> wordRepository_;
     std::shared_ptr<Ports::ITextProcessor> textProcessor_;
+    std::shared_ptr<Ports::ISearchResultCache> resultCache_;
+    std::shared_ptr<Ports::IIndexGenerationRepository> indexGeneration_;
+    std::unique_ptr<SingleFlight<DTO::SearchHitsDTO>> inFlightSearches_;
     Domain::Service::RankingService rankingService_;
+
+    // Гистограммы этапов поиска (nullptr без реестра метрик)
+    std::shared_ptr<Ports::IMetricsRegistry> metrics_;
+    Ports::ILatencyHistogram* normalizeLatency_ = nullptr;
+    Ports::ILatencyHistogram* repositoryLatency_ = nullptr;
+    Ports::ILatencyHistogram* rankingLatency_ = nullptr;
+
+    /**
+     * @brief Ищет документы по нормализованным термам без кеша
+     * @param terms Термы: нормализованные, в нижнем регистре, отсортированные, без повторов
+     * @param maxResults Максимальное количество результатов
+     * @param deadline Срок запроса
+     */
+    DTO::SearchHitsDTO search(const std::vector<std::string>& terms,
+                              size_t maxResults,
+                              const Ports::RequestDeadline& deadline);
+
+    /**
+     * @brief Ищет документы, объединяя одновременные поиски с одинаковым ключом
+     */
+    DTO::SearchHitsDTO searchCoalesced(const std::string& key,
+                                       const std::vector<std::string>& terms,
+                                       size_t maxResults,
+                                       const Ports::RequestDeadline& deadline);
+
+    /**
+     * @brief Строит ключ поиска (для кеша и объединения) из термов и количества результатов
+     */
+    static std::string makeSearchKey(const std::vector<std::string>& terms, size_t maxResults);
 };
 } // namespace Core::Application::UseCases
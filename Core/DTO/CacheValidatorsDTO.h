@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+namespace Core::DTO {
+/**
+ * @brief DTO с HTTP-валидаторами кеша для условных запросов
+ *
+ * Значения заголовков ETag и Last-Modified из ответа сервера.
+ * При повторном краулинге отправляются как If-None-Match и If-Modified-Since.
+ */
+struct CacheValidatorsDTO {
+    std::string etag;          // Значение заголовка ETag (пусто, если нет)
+    std::string lastModified;  // Значение заголовка Last-Modified (пусто, если нет)
+
+    bool empty() const { return etag.empty() && lastModified.empty(); }
+
+    bool operator==(const CacheValidatorsDTO& other) const {
+        return etag == other.etag && lastModified == other.lastModified;
+    }
+
+    bool operator!=(const CacheValidatorsDTO& other) const { return !(*this == other); }
+};
+} // namespace Core::DTO
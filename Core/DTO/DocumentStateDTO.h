@@ -0,0 +1,20 @@
+#pragma once
+
+#include <optional>
+
+#include "../Domain/Model/Document.h"
+#include "CacheValidatorsDTO.h"
+
+namespace Core::DTO {
+/**
+ * @brief DTO с состоянием ранее проиндексированного документа
+ *
+ * Лёгкая проекция документа без текстового содержимого, используемая
+ * для обнаружения изменений при повторном краулинге.
+ */
+struct DocumentStateDTO {
+    Domain::Model::Document::IdType documentId{0};                        // ID документа
+    std::optional<Domain::Model::Document::ContentHashType> contentHash;  // Хеш HTML (если известен)
+    CacheValidatorsDTO validators;                                        // ETag / Last-Modified последнего ответа
+};
+} // namespace Core::DTO
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "../Domain/Model/Document.h"
+
+namespace Core::DTO {
+/**
+ * @brief DTO для результата индексации страницы
+ */
+struct IndexPageResultDTO {
+    /**
+     * @brief Итог обработки страницы
+     */
+    enum class Status {
+        Indexed,    // Страница проиндексирована (новая или изменившаяся)
+        Unchanged,  // Содержимое не изменилось, индексация пропущена
+    };
+
+    Domain::Model::Document::IdType documentId{0};  // ID документа (0 если индексация не удалась)
+    Status status{Status::Indexed};                 // Итог обработки
+};
+} // namespace Core::DTO
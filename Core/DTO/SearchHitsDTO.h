@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../Domain/Model/SearchResult.h"
+
+namespace Core::DTO {
+/**
+ * @brief DTO для выдачи поиска с количеством найденных документов
+ */
+struct SearchHitsDTO {
+    std::vector<Domain::Model::SearchResult> results;  // Лучшие документы в порядке ранжирования
+    size_t totalHits{0};                               // Документов со всеми словами запроса
+    bool totalIsExact{true};                           // false - totalHits оценка сверху
+};
+} // namespace Core::DTO
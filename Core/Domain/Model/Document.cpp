@@ -19,6 +19,10 @@ const std::string& Document::getContent() const {
     return content_;
 }
 
+const std::optional<Document::ContentHashType>& Document::getContentHash() const {
+    return contentHash_;
+}
+
 bool Document::isPersisted() const {
     return id_ != 0;
 }
@@ -26,4 +30,8 @@ bool Document::isPersisted() const {
 void Document::setId(IdType id) {
     id_ = id;
 }
+
+void Document::setContentHash(ContentHashType contentHash) {
+    contentHash_ = contentHash;
+}
 } // namespace Core::Domain::Model
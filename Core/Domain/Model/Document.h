@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
 #include <string>
 
 namespace Core::Domain::Model {
@@ -13,6 +14,7 @@ namespace Core::Domain::Model {
 class Document {
   public:
     using IdType = int64_t;
+    using ContentHashType = uint64_t;
 
     /**
      * @brief Конструктор для нового документа (без ID)
@@ -28,6 +30,7 @@ class Document {
     IdType getId() const;
     const std::string& getUrl() const;
     const std::string& getContent() const;
+    const std::optional<ContentHashType>& getContentHash() const;
 
     // Проверка, сохранен ли документ в БД
     bool isPersisted() const;
@@ -35,9 +38,13 @@ class Document {
     // Установка ID (используется репозиторием после сохранения)
     void setId(IdType id);
 
+    // Установка хеша исходного HTML (используется для обнаружения изменений)
+    void setContentHash(ContentHashType contentHash);
+
   private:
     IdType id_;  // 0 означает, что документ ещё не сохранен в БД
     std::string url_;
     std::string content_;
+    std::optional<ContentHashType> contentHash_;  // Хеш исходного HTML страницы
 };
 } // namespace Core::Domain::Model
@@ -0,0 +1,62 @@
+#include "PostingList.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Core::Domain::Model {
+namespace {
+struct PostingStorage {
+    std::vector<PostingList::DocumentIdType> documentIds;
+    std::vector<PostingList::FrequencyType> frequencies;
+};
+} // namespace
+
+PostingList::PostingList(std::vector<DocumentIdType> documentIds, std::vector<FrequencyType> frequencies) {
+    if (documentIds.size() != frequencies.size()) {
+        throw std::invalid_argument("Количество документов и частот в списке постингов должно совпадать");
+    }
+
+    // Данные живут в общем хранилище, чтобы копии списка ссылались на одну память
+    auto storage = std::make_shared<PostingStorage>();
+    storage->documentIds = std::move(documentIds);
+    storage->frequencies = std::move(frequencies);
+
+    documentIds_ = storage->documentIds.data();
+    frequencies_ = storage->frequencies.data();
+    size_ = storage->documentIds.size();
+    owner_ = std::move(storage);
+
+    for (size_t i = 0; i < size_; ++i) {
+        maxFrequency_ = std::max(maxFrequency_, frequencies_[i]);
+    }
+}
+
+PostingList::PostingList(std::shared_ptr<const void> owner, const DocumentIdType* documentIds,
+                         const FrequencyType* frequencies, size_t size, FrequencyType maxFrequency)
+    : owner_(std::move(owner)),
+      documentIds_(documentIds),
+      frequencies_(frequencies),
+      size_(size),
+      maxFrequency_(maxFrequency) {}
+
+const PostingList::DocumentIdType* PostingList::getDocumentIds() const {
+    return documentIds_;
+}
+
+const PostingList::FrequencyType* PostingList::getFrequencies() const {
+    return frequencies_;
+}
+
+size_t PostingList::size() const {
+    return size_;
+}
+
+bool PostingList::empty() const {
+    return size_ == 0;
+}
+
+PostingList::FrequencyType PostingList::getMaxFrequency() const {
+    return maxFrequency_;
+}
+} // namespace Core::Domain::Model
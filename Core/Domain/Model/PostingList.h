@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Core::Domain::Model {
+/**
+ * @brief Постинги одного слова: отсортированные по возрастанию ID документов и частоты
+ *
+ * Список либо владеет своими данными, либо ссылается на память неизменяемого
+ * индекса; во втором случае owner продлевает жизнь индекса, пока список используется.
+ * Копирование дешёвое: данные не копируются.
+ *
+ * Максимальная частота списка - верхняя оценка вклада слова в релевантность,
+ * по которой поиск отбрасывает документы, заведомо не попадающие в выдачу.
+ */
+class PostingList {
+  public:
+    using DocumentIdType = int64_t;
+    using FrequencyType = int32_t;
+
+    /**
+     * @brief Пустой список
+     */
+    PostingList() = default;
+
+    /**
+     * @brief Конструктор списка, владеющего данными
+     * @param documentIds ID документов по возрастанию
+     * @param frequencies Частоты (по одной на документ)
+     * @throws std::invalid_argument если размеры массивов различаются
+     */
+    PostingList(std::vector<DocumentIdType> documentIds, std::vector<FrequencyType> frequencies);
+
+    /**
+     * @brief Конструктор списка, ссылающегося на чужую память
+     * @param owner Владелец памяти
+     * @param documentIds ID документов по возрастанию
+     * @param frequencies Частоты
+     * @param size Количество постингов
+     * @param maxFrequency Максимальная частота в списке (хранится вместе со списком)
+     */
+    PostingList(std::shared_ptr<const void> owner, const DocumentIdType* documentIds,
+                const FrequencyType* frequencies, size_t size, FrequencyType maxFrequency);
+
+    // Геттеры
+    const DocumentIdType* getDocumentIds() const;
+    const FrequencyType* getFrequencies() const;
+    size_t size() const;
+    bool empty() const;
+    FrequencyType getMaxFrequency() const;
+
+  private:
+    std::shared_ptr<const void> owner_;
+    const DocumentIdType* documentIds_ = nullptr;
+    const FrequencyType* frequencies_ = nullptr;
+    size_t size_ = 0;
+    FrequencyType maxFrequency_ = 0;
+};
+} // namespace Core::Domain::Model
@@ -0,0 +1,70 @@
+#include "RevisitSchedule.h"
+
+namespace Core::Domain::Model {
+RevisitSchedule::RevisitSchedule(std::string url)
+    : url_(std::move(url)),
+      visitCount_(0),
+      changeCount_(0),
+      observedSeconds_(0.0),
+      lastVisitAt_(0),
+      nextVisitAt_(0) {}
+
+RevisitSchedule::RevisitSchedule(std::string url,
+                                 CounterType visitCount,
+                                 CounterType changeCount,
+                                 double observedSeconds,
+                                 TimestampType lastVisitAt,
+                                 TimestampType nextVisitAt)
+    : url_(std::move(url)),
+      visitCount_(visitCount),
+      changeCount_(changeCount),
+      observedSeconds_(observedSeconds),
+      lastVisitAt_(lastVisitAt),
+      nextVisitAt_(nextVisitAt) {}
+
+const std::string& RevisitSchedule::getUrl() const {
+    return url_;
+}
+
+RevisitSchedule::CounterType RevisitSchedule::getVisitCount() const {
+    return visitCount_;
+}
+
+RevisitSchedule::CounterType RevisitSchedule::getChangeCount() const {
+    return changeCount_;
+}
+
+double RevisitSchedule::getObservedSeconds() const {
+    return observedSeconds_;
+}
+
+RevisitSchedule::TimestampType RevisitSchedule::getLastVisitAt() const {
+    return lastVisitAt_;
+}
+
+RevisitSchedule::TimestampType RevisitSchedule::getNextVisitAt() const {
+    return nextVisitAt_;
+}
+
+void RevisitSchedule::recordVisit(TimestampType visitedAt, bool changed) {
+    // Первое посещение не даёт наблюдения: изменение определяется
+    // только относительно предыдущего посещения
+    if (visitCount_ > 0) {
+        if (visitedAt <= lastVisitAt_) {
+            return;  // Повторное посещение в ту же секунду не несёт информации
+        }
+
+        observedSeconds_ += static_cast<double>(visitedAt - lastVisitAt_);
+        if (changed) {
+            changeCount_++;
+        }
+    }
+
+    visitCount_++;
+    lastVisitAt_ = visitedAt;
+}
+
+void RevisitSchedule::setNextVisitAt(TimestampType nextVisitAt) {
+    nextVisitAt_ = nextVisitAt;
+}
+} // namespace Core::Domain::Model
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace Core::Domain::Model {
+/**
+ * @brief Расписание повторного посещения страницы
+ *
+ * Хранит историю посещений страницы (сколько раз посещали и сколько раз
+ * обнаружили изменение) и время следующего посещения. По истории
+ * оценивается частота изменения страницы.
+ */
+class RevisitSchedule {
+  public:
+    using TimestampType = int64_t;  // Секунды с начала эпохи Unix
+    using CounterType = int32_t;
+
+    /**
+     * @brief Конструктор для страницы, которую ещё не посещали
+     */
+    explicit RevisitSchedule(std::string url);
+
+    /**
+     * @brief Конструктор для существующего расписания (из БД)
+     */
+    RevisitSchedule(std::string url,
+                    CounterType visitCount,
+                    CounterType changeCount,
+                    double observedSeconds,
+                    TimestampType lastVisitAt,
+                    TimestampType nextVisitAt);
+
+    // Геттеры
+    const std::string& getUrl() const;
+    CounterType getVisitCount() const;
+    CounterType getChangeCount() const;
+    double getObservedSeconds() const;
+    TimestampType getLastVisitAt() const;
+    TimestampType getNextVisitAt() const;
+
+    /**
+     * @brief Регистрирует посещение страницы
+     * @param visitedAt Время посещения
+     * @param changed Изменилась ли страница с прошлого посещения
+     */
+    void recordVisit(TimestampType visitedAt, bool changed);
+
+    /**
+     * @brief Устанавливает время следующего посещения
+     */
+    void setNextVisitAt(TimestampType nextVisitAt);
+
+  private:
+    std::string url_;
+    CounterType visitCount_;   // Количество посещений
+    CounterType changeCount_;  // Сколько раз при посещении обнаружено изменение
+    double observedSeconds_;   // Суммарная длительность интервалов между посещениями
+    TimestampType lastVisitAt_;
+    TimestampType nextVisitAt_;
+};
+} // namespace Core::Domain::Model
@@ -0,0 +1,105 @@
+#include "ContentHashService.h"
+
+#include <cstring>
+
+namespace Core::Domain::Service {
+ContentHashService::HashType ContentHashService::hash(const std::string& content) {
+    return hash(content.data(), content.size());
+}
+
+ContentHashService::HashType ContentHashService::hash(const void* data, size_t size, HashType seed) {
+    static constexpr size_t STRIPE_SIZE = 32;
+    static constexpr size_t LANE_SIZE = 8;
+    static constexpr size_t HALF_LANE_SIZE = 4;
+
+    const auto* ptr = static_cast<const unsigned char*>(data);
+    const unsigned char* const end = ptr + size;
+    HashType result = 0;
+
+    if (size >= STRIPE_SIZE) {
+        // Четыре независимых аккумулятора обрабатывают блоки по 32 байта
+        const unsigned char* const limit = end - STRIPE_SIZE;
+        HashType acc1 = seed + PRIME_1 + PRIME_2;
+        HashType acc2 = seed + PRIME_2;
+        HashType acc3 = seed;
+        HashType acc4 = seed - PRIME_1;
+
+        do {
+            acc1 = round(acc1, readUint64(ptr));
+            acc2 = round(acc2, readUint64(ptr + LANE_SIZE));
+            acc3 = round(acc3, readUint64(ptr + 2 * LANE_SIZE));
+            acc4 = round(acc4, readUint64(ptr + 3 * LANE_SIZE));
+            ptr += STRIPE_SIZE;
+        } while (ptr <= limit);
+
+        result = rotateLeft(acc1, 1) + rotateLeft(acc2, 7) + rotateLeft(acc3, 12) +
+                 rotateLeft(acc4, 18);
+        result = mergeRound(result, acc1);
+        result = mergeRound(result, acc2);
+        result = mergeRound(result, acc3);
+        result = mergeRound(result, acc4);
+    } else {
+        result = seed + PRIME_5;
+    }
+
+    result += static_cast<HashType>(size);
+
+    // Обрабатываем оставшиеся байты
+    while (ptr + LANE_SIZE <= end) {
+        result ^= round(0, readUint64(ptr));
+        result = rotateLeft(result, 27) * PRIME_1 + PRIME_4;
+        ptr += LANE_SIZE;
+    }
+
+    if (ptr + HALF_LANE_SIZE <= end) {
+        result ^= static_cast<HashType>(readUint32(ptr)) * PRIME_1;
+        result = rotateLeft(result, 23) * PRIME_2 + PRIME_3;
+        ptr += HALF_LANE_SIZE;
+    }
+
+    while (ptr < end) {
+        result ^= static_cast<HashType>(*ptr) * PRIME_5;
+        result = rotateLeft(result, 11) * PRIME_1;
+        ++ptr;
+    }
+
+    // Финальное перемешивание битов (avalanche)
+    result ^= result >> 33;
+    result *= PRIME_2;
+    result ^= result >> 29;
+    result *= PRIME_3;
+    result ^= result >> 32;
+
+    return result;
+}
+
+ContentHashService::HashType ContentHashService::rotateLeft(HashType value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+ContentHashService::HashType ContentHashService::round(HashType accumulator, HashType input) {
+    accumulator += input * PRIME_2;
+    accumulator = rotateLeft(accumulator, 31);
+    accumulator *= PRIME_1;
+    return accumulator;
+}
+
+ContentHashService::HashType ContentHashService::mergeRound(HashType accumulator, HashType value) {
+    accumulator ^= round(0, value);
+    accumulator = accumulator * PRIME_1 + PRIME_4;
+    return accumulator;
+}
+
+ContentHashService::HashType ContentHashService::readUint64(const unsigned char* ptr) {
+    // memcpy безопасен для невыровненных адресов и компилируется в одну инструкцию
+    HashType value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+
+uint32_t ContentHashService::readUint32(const unsigned char* ptr) {
+    uint32_t value = 0;
+    std::memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+} // namespace Core::Domain::Service
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Core::Domain::Service {
+/**
+ * @brief Доменный сервис для вычисления хеша содержимого страниц
+ *
+ * Реализует 64-битный некриптографический хеш XXH64. Используется для
+ * быстрого обнаружения неизменившихся страниц при повторном краулинге.
+ */
+class ContentHashService {
+  public:
+    using HashType = uint64_t;
+
+    /**
+     * @brief Вычисляет хеш содержимого
+     * @param content Содержимое (например, HTML страницы)
+     * @return 64-битный хеш
+     */
+    static HashType hash(const std::string& content);
+
+    /**
+     * @brief Вычисляет хеш произвольного блока данных
+     * @param data Указатель на данные
+     * @param size Размер данных в байтах
+     * @param seed Начальное значение хеша
+     * @return 64-битный хеш
+     */
+    static HashType hash(const void* data, size_t size, HashType seed = 0);
+
+  private:
+    static constexpr HashType PRIME_1 = 0x9E3779B185EBCA87ULL;
+    static constexpr HashType PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+    static constexpr HashType PRIME_3 = 0x165667B19E3779F9ULL;
+    static constexpr HashType PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+    static constexpr HashType PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+    static HashType rotateLeft(HashType value, int bits);
+    static HashType round(HashType accumulator, HashType input);
+    static HashType mergeRound(HashType accumulator, HashType value);
+    static HashType readUint64(const unsigned char* ptr);
+    static uint32_t readUint32(const unsigned char* ptr);
+};
+} // namespace Core::Domain::Service
@@ -4,8 +4,12 @@
 #include <cctype>
 #include <sstream>
 
+#include "../../Ports/ITracer.h"
+
 namespace Core::Domain::Service {
 std::map<std::string, int> IndexingService::analyzeWordFrequency(const std::string& text) {
+    Ports::TraceSpan span("index.word_frequency", "index");
+
     std::map<std::string, int> frequency;
 
     // Извлекаем слова
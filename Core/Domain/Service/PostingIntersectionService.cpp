@@ -0,0 +1,545 @@
+#include "PostingIntersectionService.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define POSTING_INTERSECTION_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// GCC и Clang собирают SIMD-функции для своего набора инструкций без флагов
+// компилятора для всего проекта; MSVC разрешает интринсики и так
+#if defined(__GNUC__) || defined(__clang__)
+#define POSTING_INTERSECTION_TARGET(isa) __attribute__((target(isa)))
+#else
+#define POSTING_INTERSECTION_TARGET(isa)
+#endif
+
+namespace Core::Domain::Service {
+namespace {
+using DocumentIdType = PostingIntersectionService::DocumentIdType;
+using FrequencyType = Model::PostingList::FrequencyType;
+using RelevanceType = PostingIntersectionService::RelevanceType;
+using Match = PostingIntersectionService::Match;
+using OrderedLists = std::vector<const Model::PostingList*>;
+
+// Участок, который дешевле просмотреть целиком, чем продолжать бинарный поиск
+constexpr size_t LINEAR_SEARCH_SIZE = 16;
+
+// Постингов самого редкого списка в блоке, по максимумам которых прекращается просмотр
+constexpr size_t SCORE_BLOCK_SIZE = 64;
+
+/**
+ * @brief Ядра блочного сравнения
+ *
+ * countLess считает элементы меньше target в отсортированном блоке, то есть
+ * возвращает позицию первого элемента >= target. Раннего выхода нет: сумма
+ * по всему блоку уже равна ответу, а непредсказуемый переход стоил бы дороже
+ * лишних сравнений.
+ */
+struct ScalarCompare {
+    static size_t countLess(const DocumentIdType* documentIds, size_t size, DocumentIdType target) {
+        size_t count = 0;
+        for (size_t i = 0; i < size; ++i) {
+            count += documentIds[i] < target ? 1 : 0;
+        }
+        return count;
+    }
+};
+
+#ifdef POSTING_INTERSECTION_X86
+// Количество единиц в маске сравнения из movemask (не больше 4 бит);
+// таблица вместо POPCNT, которого формально может не быть при SSE4.2
+constexpr uint8_t MASK_BIT_COUNT[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+struct Sse42Compare {
+    POSTING_INTERSECTION_TARGET("sse4.2")
+    static size_t countLess(const DocumentIdType* documentIds, size_t size, DocumentIdType target) {
+        constexpr size_t LANES = 2;
+        const __m128i pivot = _mm_set1_epi64x(target);
+
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + LANES <= size; i += LANES) {
+            const __m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i*>(documentIds + i));
+            count += MASK_BIT_COUNT[_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpgt_epi64(pivot, values)))];
+        }
+
+        return count + ScalarCompare::countLess(documentIds + i, size - i, target);
+    }
+};
+
+struct Avx2Compare {
+    POSTING_INTERSECTION_TARGET("avx2")
+    static size_t countLess(const DocumentIdType* documentIds, size_t size, DocumentIdType target) {
+        constexpr size_t LANES = 4;
+        const __m256i pivot = _mm256_set1_epi64x(target);
+
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + LANES <= size; i += LANES) {
+            const __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(documentIds + i));
+            count += MASK_BIT_COUNT[_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(pivot, values)))];
+        }
+
+        return count + ScalarCompare::countLess(documentIds + i, size - i, target);
+    }
+};
+
+struct CpuFeatures {
+    bool sse42 = false;
+    bool avx2 = false;
+};
+
+CpuFeatures queryCpuFeatures() {
+    CpuFeatures features;
+#ifdef _MSC_VER
+    constexpr int SSE42_BIT = 1 << 20;
+    constexpr int OSXSAVE_BIT = 1 << 27;
+    constexpr int AVX_BIT = 1 << 28;
+    constexpr int AVX2_BIT = 1 << 5;
+    constexpr unsigned long long YMM_STATE = 0x6;
+
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    features.sse42 = (info[2] & SSE42_BIT) != 0;
+    // AVX2 пригоден, только если ОС сохраняет YMM-регистры при переключении контекста
+    const bool osSavesYmm = (info[2] & OSXSAVE_BIT) != 0 && (info[2] & AVX_BIT) != 0 &&
+                            (_xgetbv(0) & YMM_STATE) == YMM_STATE;
+
+    if (maxLeaf >= 7 && osSavesYmm) {
+        __cpuidex(info, 7, 0);
+        features.avx2 = (info[1] & AVX2_BIT) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    features.sse42 = __builtin_cpu_supports("sse4.2") != 0;
+    features.avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+    return features;
+}
+
+const CpuFeatures& getCpuFeatures() {
+    static const CpuFeatures features = queryCpuFeatures();
+    return features;
+}
+#endif
+
+template <typename Compare>
+inline size_t advanceWith(const DocumentIdType* documentIds, size_t size, size_t from, DocumentIdType target) {
+    if (from >= size) {
+        return size;
+    }
+
+    // Сначала блок сразу за текущей позицией: в списках близкой длины следующий
+    // кандидат почти всегда рядом, и галоп не нужен
+    const size_t block = std::min(LINEAR_SEARCH_SIZE, size - from);
+    const size_t less = Compare::countLess(documentIds + from, block, target);
+    if (less < block) {
+        return from + less;
+    }
+
+    // Галоп: удваиваем шаг, пока не перешагнём target; documentIds[low] < target
+    size_t low = from + block - 1;
+    size_t step = block;
+    while (low + step < size && documentIds[low + step] < target) {
+        low += step;
+        step *= 2;
+    }
+
+    // Ответ в [first, last]: бинарный поиск до короткого участка, затем блочное сравнение
+    size_t first = low + 1;
+    size_t last = std::min(low + step, size);
+    while (last - first > LINEAR_SEARCH_SIZE) {
+        const size_t middle = first + (last - first) / 2;
+        if (documentIds[middle] < target) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    return first + Compare::countLess(documentIds + first, last - first, target);
+}
+
+/**
+ * @brief Оставляет в matches документы, которые есть в list, и добавляет их частоты
+ * @return Количество оставшихся документов (они в начале matches)
+ */
+template <typename Compare>
+inline size_t filterWith(Match* matches, size_t count, const Model::PostingList& list) {
+    const DocumentIdType* documentIds = list.getDocumentIds();
+    const size_t size = list.size();
+    size_t position = 0;
+    size_t kept = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+        const Match match = matches[i];
+        position = advanceWith<Compare>(documentIds, size, position, match.documentId);
+        if (position == size) {
+            break;
+        }
+
+        if (documentIds[position] == match.documentId) {
+            matches[kept++] = {match.documentId, match.relevance + list.getFrequencies()[position]};
+        }
+    }
+
+    return kept;
+}
+
+// Суммы частот считаются в int64 и в выдаче ограничиваются диапазоном RelevanceType
+RelevanceType clampRelevance(int64_t relevance) {
+    return static_cast<RelevanceType>(std::min<int64_t>(relevance, std::numeric_limits<RelevanceType>::max()));
+}
+
+enum class CandidateResult { MATCHED, REJECTED, EXHAUSTED };
+
+/**
+ * @brief Досчитывает релевантность кандидата из самого редкого списка по остальным
+ * @param positions Позиции в списках, сдвигаются только вперёд
+ * @param remainingBounds remainingBounds[i] - сумма максимальных частот списков начиная с i
+ * @param relevance Релевантность, накопленная по уже просмотренным спискам
+ * @return EXHAUSTED, если какой-то список кончился и следующих совпадений уже не будет
+ */
+template <typename Compare>
+inline CandidateResult scoreCandidate(const OrderedLists& ordered, size_t* positions,
+                                      const int64_t* remainingBounds, const RankingService::TopDocuments& top,
+                                      DocumentIdType documentId, int64_t& relevance) {
+    for (size_t listIndex = 1; listIndex < ordered.size(); ++listIndex) {
+        const Model::PostingList& list = *ordered[listIndex];
+        size_t& position = positions[listIndex];
+
+        position = advanceWith<Compare>(list.getDocumentIds(), list.size(), position, documentId);
+        if (position == list.size()) {
+            return CandidateResult::EXHAUSTED;
+        }
+        if (list.getDocumentIds()[position] != documentId) {
+            return CandidateResult::REJECTED;
+        }
+
+        relevance += list.getFrequencies()[position];
+
+        // MaxScore: даже максимальные частоты оставшихся слов не поднимут документ в выдачу
+        if (!top.canEnter(documentId, clampRelevance(relevance + remainingBounds[listIndex + 1]))) {
+            return CandidateResult::REJECTED;
+        }
+    }
+
+    return CandidateResult::MATCHED;
+}
+
+/**
+ * @brief Собирает в top лучшие документы пересечения
+ */
+template <typename Compare>
+inline void collectTopWith(const OrderedLists& ordered, RankingService::TopDocuments& top, size_t maxResults) {
+    const Model::PostingList& rarest = *ordered.front();
+    const DocumentIdType* rarestIds = rarest.getDocumentIds();
+    const FrequencyType* rarestFrequencies = rarest.getFrequencies();
+    const size_t listCount = ordered.size();
+
+    std::vector<int64_t> remainingBounds(listCount + 1, 0);
+    for (size_t listIndex = listCount; listIndex-- > 1;) {
+        remainingBounds[listIndex] = remainingBounds[listIndex + 1] + ordered[listIndex]->getMaxFrequency();
+    }
+
+    // Один проход по частотам самого редкого списка: максимумы блоков и кандидаты
+    // с наибольшей частотой. Кандидаты считаются первыми и сразу поднимают порог
+    // выдачи, после чего большинство остальных отсекается без досчёта
+    const size_t blockCount = (rarest.size() + SCORE_BLOCK_SIZE - 1) / SCORE_BLOCK_SIZE;
+    std::vector<FrequencyType> blockBounds(blockCount);
+    RankingService::TopDocuments seedSelector(maxResults);
+
+    // ID возрастают, поэтому документ с частотой, равной порогу, в кандидаты уже не попадёт
+    FrequencyType seedThreshold = 0;
+    for (size_t block = 0; block < blockCount; ++block) {
+        const size_t begin = block * SCORE_BLOCK_SIZE;
+        const size_t end = std::min(begin + SCORE_BLOCK_SIZE, rarest.size());
+        FrequencyType bound = 0;
+
+        for (size_t i = begin; i < end; ++i) {
+            const FrequencyType frequency = rarestFrequencies[i];
+            bound = std::max(bound, frequency);
+
+            if (frequency > seedThreshold) {
+                seedSelector.offer(rarestIds[i], frequency);
+                seedThreshold = seedSelector.isFull() ? seedSelector.getThreshold() : 0;
+            }
+        }
+
+        blockBounds[block] = bound;
+    }
+
+    // Максимум по всем блокам от текущего до конца
+    for (size_t block = blockCount; block-- > 1;) {
+        blockBounds[block - 1] = std::max(blockBounds[block - 1], blockBounds[block]);
+    }
+
+    std::vector<Match> seeds = seedSelector.takeRanked();
+    std::vector<size_t> positions(listCount, 0);
+
+    for (const Match& seed : seeds) {
+        // Кандидаты идут не по порядку ID, поэтому каждый ищется с начала списков
+        std::fill(positions.begin(), positions.end(), 0);
+        int64_t relevance = seed.relevance;
+        if (scoreCandidate<Compare>(ordered, positions.data(), remainingBounds.data(), top, seed.documentId,
+                                    relevance) == CandidateResult::MATCHED) {
+            top.offer(seed.documentId, clampRelevance(relevance));
+        }
+    }
+
+    std::sort(seeds.begin(), seeds.end(),
+              [](const Match& lhs, const Match& rhs) { return lhs.documentId < rhs.documentId; });
+    std::fill(positions.begin(), positions.end(), 0);
+    size_t seedIndex = 0;
+
+    for (size_t block = 0; block < blockCount; ++block) {
+        const size_t begin = block * SCORE_BLOCK_SIZE;
+        const size_t end = std::min(begin + SCORE_BLOCK_SIZE, rarest.size());
+
+        // Оставшиеся постинги самого редкого списка уже не дадут документа выше худшего в выдаче
+        if (!top.canEnter(rarestIds[begin], clampRelevance(blockBounds[block] + remainingBounds[1]))) {
+            return;
+        }
+
+        for (size_t i = begin; i < end; ++i) {
+            const DocumentIdType documentId = rarestIds[i];
+            if (seedIndex < seeds.size() && seeds[seedIndex].documentId == documentId) {
+                ++seedIndex;
+                continue;
+            }
+
+            int64_t relevance = rarestFrequencies[i];
+            if (!top.canEnter(documentId, clampRelevance(relevance + remainingBounds[1]))) {
+                continue;
+            }
+
+            const CandidateResult result = scoreCandidate<Compare>(
+                ordered, positions.data(), remainingBounds.data(), top, documentId, relevance);
+            if (result == CandidateResult::EXHAUSTED) {
+                return;
+            }
+            if (result == CandidateResult::MATCHED) {
+                top.offer(documentId, clampRelevance(relevance));
+            }
+        }
+    }
+}
+
+// Точки входа ядер: весь цикл компилируется под набор инструкций ядра,
+// чтобы блочное сравнение встраивалось в него без вызова
+using FilterFunction = size_t (*)(Match* matches, size_t count, const Model::PostingList& list);
+using CollectTopFunction = void (*)(const OrderedLists& ordered, RankingService::TopDocuments& top,
+                                    size_t maxResults);
+using AdvanceFunction = size_t (*)(const DocumentIdType* documentIds, size_t size, size_t from,
+                                   DocumentIdType target);
+
+size_t filterScalar(Match* matches, size_t count, const Model::PostingList& list) {
+    return filterWith<ScalarCompare>(matches, count, list);
+}
+
+size_t advanceScalar(const DocumentIdType* documentIds, size_t size, size_t from, DocumentIdType target) {
+    return advanceWith<ScalarCompare>(documentIds, size, from, target);
+}
+
+void collectTopScalar(const OrderedLists& ordered, RankingService::TopDocuments& top, size_t maxResults) {
+    collectTopWith<ScalarCompare>(ordered, top, maxResults);
+}
+
+#ifdef POSTING_INTERSECTION_X86
+POSTING_INTERSECTION_TARGET("sse4.2")
+size_t filterSse42(Match* matches, size_t count, const Model::PostingList& list) {
+    return filterWith<Sse42Compare>(matches, count, list);
+}
+
+POSTING_INTERSECTION_TARGET("sse4.2")
+size_t advanceSse42(const DocumentIdType* documentIds, size_t size, size_t from, DocumentIdType target) {
+    return advanceWith<Sse42Compare>(documentIds, size, from, target);
+}
+
+POSTING_INTERSECTION_TARGET("sse4.2")
+void collectTopSse42(const OrderedLists& ordered, RankingService::TopDocuments& top, size_t maxResults) {
+    collectTopWith<Sse42Compare>(ordered, top, maxResults);
+}
+
+POSTING_INTERSECTION_TARGET("avx2")
+size_t filterAvx2(Match* matches, size_t count, const Model::PostingList& list) {
+    return filterWith<Avx2Compare>(matches, count, list);
+}
+
+POSTING_INTERSECTION_TARGET("avx2")
+size_t advanceAvx2(const DocumentIdType* documentIds, size_t size, size_t from, DocumentIdType target) {
+    return advanceWith<Avx2Compare>(documentIds, size, from, target);
+}
+
+POSTING_INTERSECTION_TARGET("avx2")
+void collectTopAvx2(const OrderedLists& ordered, RankingService::TopDocuments& top, size_t maxResults) {
+    collectTopWith<Avx2Compare>(ordered, top, maxResults);
+}
+#endif
+
+FilterFunction selectFilter(PostingIntersectionService::Kernel kernel) {
+    switch (kernel) {
+#ifdef POSTING_INTERSECTION_X86
+    case PostingIntersectionService::Kernel::AVX2:
+        return filterAvx2;
+    case PostingIntersectionService::Kernel::SSE42:
+        return filterSse42;
+#endif
+    default:
+        return filterScalar;
+    }
+}
+
+CollectTopFunction selectCollectTop(PostingIntersectionService::Kernel kernel) {
+    switch (kernel) {
+#ifdef POSTING_INTERSECTION_X86
+    case PostingIntersectionService::Kernel::AVX2:
+        return collectTopAvx2;
+    case PostingIntersectionService::Kernel::SSE42:
+        return collectTopSse42;
+#endif
+    default:
+        return collectTopScalar;
+    }
+}
+
+AdvanceFunction selectAdvance(PostingIntersectionService::Kernel kernel) {
+    switch (kernel) {
+#ifdef POSTING_INTERSECTION_X86
+    case PostingIntersectionService::Kernel::AVX2:
+        return advanceAvx2;
+    case PostingIntersectionService::Kernel::SSE42:
+        return advanceSse42;
+#endif
+    default:
+        return advanceScalar;
+    }
+}
+
+void requireSupported(PostingIntersectionService::Kernel kernel) {
+    if (!PostingIntersectionService::isSupported(kernel)) {
+        throw std::invalid_argument(std::string("Процессор не поддерживает ядро пересечения ") +
+                                    PostingIntersectionService::getKernelName(kernel));
+    }
+}
+
+/**
+ * @brief Упорядочивает списки по возрастанию длины
+ * @return Пустой результат, если списков нет или какой-то из них пуст (пересечение пусто)
+ */
+OrderedLists orderByLength(const std::vector<Model::PostingList>& lists) {
+    OrderedLists ordered;
+    ordered.reserve(lists.size());
+    for (const auto& list : lists) {
+        if (list.empty()) {
+            return {};
+        }
+        ordered.push_back(&list);
+    }
+
+    // Начинаем с самого редкого слова: кандидатов не больше его постингов
+    std::sort(ordered.begin(), ordered.end(), [](const Model::PostingList* lhs, const Model::PostingList* rhs) {
+        return lhs->size() < rhs->size();
+    });
+    return ordered;
+}
+} // namespace
+
+std::vector<PostingIntersectionService::Match> PostingIntersectionService::intersect(
+    const std::vector<Model::PostingList>& lists) {
+    return intersect(lists, detectKernel());
+}
+
+std::vector<PostingIntersectionService::Match> PostingIntersectionService::intersect(
+    const std::vector<Model::PostingList>& lists, Kernel kernel) {
+    requireSupported(kernel);
+
+    const OrderedLists ordered = orderByLength(lists);
+    if (ordered.empty()) {
+        return {};
+    }
+
+    const Model::PostingList& rarest = *ordered.front();
+    std::vector<Match> matches;
+    matches.reserve(rarest.size());
+    for (size_t i = 0; i < rarest.size(); ++i) {
+        matches.push_back({rarest.getDocumentIds()[i], rarest.getFrequencies()[i]});
+    }
+
+    const FilterFunction filter = selectFilter(kernel);
+    for (size_t listIndex = 1; listIndex < ordered.size() && !matches.empty(); ++listIndex) {
+        matches.resize(filter(matches.data(), matches.size(), *ordered[listIndex]));
+    }
+
+    return matches;
+}
+
+std::vector<PostingIntersectionService::Match> PostingIntersectionService::intersectTop(
+    const std::vector<Model::PostingList>& lists, size_t maxResults) {
+    return intersectTop(lists, maxResults, detectKernel());
+}
+
+std::vector<PostingIntersectionService::Match> PostingIntersectionService::intersectTop(
+    const std::vector<Model::PostingList>& lists, size_t maxResults, Kernel kernel) {
+    requireSupported(kernel);
+
+    const OrderedLists ordered = orderByLength(lists);
+    if (ordered.empty() || maxResults == 0) {
+        return {};
+    }
+
+    RankingService::TopDocuments top(maxResults);
+    selectCollectTop(kernel)(ordered, top, maxResults);
+    return top.takeRanked();
+}
+
+size_t PostingIntersectionService::advance(const DocumentIdType* documentIds, size_t size, size_t from,
+                                           DocumentIdType target, Kernel kernel) {
+    return selectAdvance(kernel)(documentIds, size, from, target);
+}
+
+PostingIntersectionService::Kernel PostingIntersectionService::detectKernel() {
+    static const Kernel kernel = isSupported(Kernel::AVX2)    ? Kernel::AVX2
+                                 : isSupported(Kernel::SSE42) ? Kernel::SSE42
+                                                              : Kernel::SCALAR;
+    return kernel;
+}
+
+bool PostingIntersectionService::isSupported(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::SCALAR:
+        return true;
+#ifdef POSTING_INTERSECTION_X86
+    case Kernel::SSE42:
+        return getCpuFeatures().sse42;
+    case Kernel::AVX2:
+        return getCpuFeatures().avx2;
+#endif
+    default:
+        return false;
+    }
+}
+
+const char* PostingIntersectionService::getKernelName(Kernel kernel) {
+    switch (kernel) {
+    case Kernel::SSE42:
+        return "sse4.2";
+    case Kernel::AVX2:
+        return "avx2";
+    default:
+        return "scalar";
+    }
+}
+} // namespace Core::Domain::Service
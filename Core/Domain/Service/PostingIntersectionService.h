@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../Model/PostingList.h"
+#include "../Model/SearchResult.h"
+#include "RankingService.h"
+
+namespace Core::Domain::Service {
+/**
+ * @brief Доменный сервис для пересечения списков постингов
+ *
+ * Находит документы, входящие во все списки, и суммирует их частоты.
+ * Списки пересекаются начиная с самого короткого: кандидатов не больше его
+ * длины, а в длинных списках позиция следующего кандидата ищется галопом
+ * (экспоненциальным поиском) от текущей, поэтому пара "редкое слово + "и""
+ * стоит O(m log(n/m)), а не O(n).
+ *
+ * Короткие участки списка сравниваются с искомым ID блоками через SSE4.2
+ * или AVX2; ядро выбирается по возможностям процессора при первом вызове,
+ * без них используется скалярное.
+ *
+ * Для выдачи из N лучших документов (intersectTop) кандидаты, которые даже
+ * с максимальными частотами остальных слов не попадают в выдачу, не
+ * досчитываются (MaxScore), а просмотр прекращается, как только оставшиеся
+ * блоки самого редкого списка не могут дать такой релевантности.
+ */
+class PostingIntersectionService {
+  public:
+    using DocumentIdType = Model::PostingList::DocumentIdType;
+    using RelevanceType = Model::SearchResult::RelevanceType;
+
+    /**
+     * @brief Реализация поиска позиции в списке
+     */
+    enum class Kernel { SCALAR, SSE42, AVX2 };
+
+    /**
+     * @brief Документ из пересечения и сумма его частот во всех списках
+     */
+    using Match = RankingService::ScoredDocument;
+
+    /**
+     * @brief Пересекает списки лучшим доступным ядром
+     * @param lists Списки постингов (по одному на слово запроса)
+     * @return Документы из всех списков по возрастанию ID
+     */
+    static std::vector<Match> intersect(const std::vector<Model::PostingList>& lists);
+
+    /**
+     * @brief Пересекает списки указанным ядром
+     * @throws std::invalid_argument если процессор не поддерживает ядро
+     */
+    static std::vector<Match> intersect(const std::vector<Model::PostingList>& lists, Kernel kernel);
+
+    /**
+     * @brief Находит лучшие документы пересечения лучшим доступным ядром
+     * @param lists Списки постингов (по одному на слово запроса)
+     * @param maxResults Размер выдачи
+     * @return Не больше maxResults документов в порядке RankingService
+     */
+    static std::vector<Match> intersectTop(const std::vector<Model::PostingList>& lists, size_t maxResults);
+
+    /**
+     * @brief Находит лучшие документы пересечения указанным ядром
+     * @throws std::invalid_argument если процессор не поддерживает ядро
+     */
+    static std::vector<Match> intersectTop(const std::vector<Model::PostingList>& lists, size_t maxResults,
+                                           Kernel kernel);
+
+    /**
+     * @brief Находит первую позицию в [from, size) с ID документа >= target
+     * @param documentIds ID документов по возрастанию
+     * @param size Длина списка
+     * @param from Позиция, с которой начинается поиск
+     * @param target Искомый ID
+     * @param kernel Ядро поиска (должно поддерживаться процессором)
+     * @return Найденная позиция или size
+     */
+    static size_t advance(const DocumentIdType* documentIds, size_t size, size_t from, DocumentIdType target,
+                          Kernel kernel);
+
+    /**
+     * @brief Лучшее ядро, поддерживаемое процессором (определяется один раз)
+     */
+    static Kernel detectKernel();
+
+    /**
+     * @brief Проверяет, поддерживает ли процессор ядро
+     */
+    static bool isSupported(Kernel kernel);
+
+    /**
+     * @brief Название ядра для логов ("scalar", "sse4.2", "avx2")
+     */
+    static const char* getKernelName(Kernel kernel);
+};
+} // namespace Core::Domain::Service
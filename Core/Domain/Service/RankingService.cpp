@@ -1,12 +1,68 @@
 #include "RankingService.h"
 
 #include <algorithm>
+#include <cstddef>
 
 namespace Core::Domain::Service {
+namespace {
+bool resultRanksHigher(const Model::SearchResult& lhs, const Model::SearchResult& rhs) {
+    return RankingService::ranksHigher({lhs.getDocumentId(), lhs.getRelevance()},
+                                       {rhs.getDocumentId(), rhs.getRelevance()});
+}
+} // namespace
+
+RankingService::TopDocuments::TopDocuments(size_t capacity) : capacity_(capacity) {
+    heap_.reserve(capacity);
+}
+
+bool RankingService::TopDocuments::canEnter(DocumentIdType documentId, RelevanceType relevance) const {
+    if (capacity_ == 0) {
+        return false;
+    }
+
+    // Вершина кучи - худший документ выдачи
+    return !isFull() || ranksHigher({documentId, relevance}, heap_.front());
+}
+
+void RankingService::TopDocuments::offer(DocumentIdType documentId, RelevanceType relevance) {
+    if (!canEnter(documentId, relevance)) {
+        return;
+    }
+
+    // С компаратором "выше в выдаче" std::*_heap держат в вершине худший документ
+    if (isFull()) {
+        std::pop_heap(heap_.begin(), heap_.end(), ranksHigher);
+        heap_.back() = {documentId, relevance};
+    } else {
+        heap_.push_back({documentId, relevance});
+    }
+    std::push_heap(heap_.begin(), heap_.end(), ranksHigher);
+}
+
+bool RankingService::TopDocuments::isFull() const {
+    return heap_.size() >= capacity_;
+}
+
+RankingService::RelevanceType RankingService::TopDocuments::getThreshold() const {
+    return heap_.front().relevance;
+}
+
+std::vector<RankingService::ScoredDocument> RankingService::TopDocuments::takeRanked() {
+    std::sort_heap(heap_.begin(), heap_.end(), ranksHigher);
+    return std::move(heap_);
+}
+
+bool RankingService::ranksHigher(const ScoredDocument& lhs, const ScoredDocument& rhs) {
+    if (lhs.relevance != rhs.relevance) {
+        return lhs.relevance > rhs.relevance;
+    }
+    return lhs.documentId < rhs.documentId;
+}
+
 std::vector<Model::SearchResult> RankingService::sortByRelevance(
     std::vector<Model::SearchResult> results) {
     // Сортируем по убыванию релевантности
-    std::sort(results.begin(), results.end());
+    std::sort(results.begin(), results.end(), resultRanksHigher);
     return results;
 }
 
@@ -22,8 +78,12 @@ std::vector<Model::SearchResult> RankingService::limitResults(
 std::vector<Model::SearchResult> RankingService::rankResults(
     std::vector<Model::SearchResult> results,
     size_t maxResults) {
-    results = sortByRelevance(std::move(results));
-    results = limitResults(std::move(results), maxResults);
-    return results;
+    if (results.size() > maxResults) {
+        std::partial_sort(results.begin(), results.begin() + static_cast<ptrdiff_t>(maxResults), results.end(),
+                          resultRanksHigher);
+        return limitResults(std::move(results), maxResults);
+    }
+
+    return sortByRelevance(std::move(results));
 }
 } // namespace Core::Domain::Service
@@ -1,18 +1,82 @@
 #pragma once
 
-#include "../Model/SearchResult.h"
+#include <cstddef>
 #include <vector>
 
+#include "../Model/SearchResult.h"
+
 namespace Core::Domain::Service {
 /**
  * @brief Доменный сервис для ранжирования результатов поиска
  *
  * Отвечает за сортировку и ограничение результатов поиска.
+ * Документы упорядочиваются по убыванию релевантности, при равной
+ * релевантности - по возрастанию ID, чтобы выдача была детерминированной.
  */
 class RankingService {
   public:
     static constexpr size_t DEFAULT_MAX_RESULTS = 10;
 
+    using DocumentIdType = Model::SearchResult::DocumentIdType;
+    using RelevanceType = Model::SearchResult::RelevanceType;
+
+    /**
+     * @brief Документ и его релевантность (без URL)
+     */
+    struct ScoredDocument {
+        DocumentIdType documentId;
+        RelevanceType relevance;
+    };
+
+    /**
+     * @brief Ограниченная куча лучших документов
+     *
+     * Хранит не больше capacity документов; худший из них - в вершине кучи,
+     * поэтому проверка и вставка стоят O(1) и O(log capacity), а не сортировку
+     * всех найденных документов.
+     */
+    class TopDocuments {
+      public:
+        explicit TopDocuments(size_t capacity);
+
+        /**
+         * @brief Проверяет, попал бы документ с такой релевантностью в выдачу
+         *
+         * Используется и для верхних оценок релевантности: если даже оценка
+         * не проходит, документ можно не досчитывать.
+         */
+        bool canEnter(DocumentIdType documentId, RelevanceType relevance) const;
+
+        /**
+         * @brief Добавляет документ, вытесняя худший при переполнении
+         */
+        void offer(DocumentIdType documentId, RelevanceType relevance);
+
+        /**
+         * @brief Набрано ли capacity документов
+         */
+        bool isFull() const;
+
+        /**
+         * @brief Релевантность худшего документа в выдаче (только если isFull())
+         */
+        RelevanceType getThreshold() const;
+
+        /**
+         * @brief Забирает документы в порядке выдачи
+         */
+        std::vector<ScoredDocument> takeRanked();
+
+      private:
+        size_t capacity_;
+        std::vector<ScoredDocument> heap_;
+    };
+
+    /**
+     * @brief Сравнение в порядке выдачи: true, если lhs выше rhs
+     */
+    static bool ranksHigher(const ScoredDocument& lhs, const ScoredDocument& rhs);
+
     /**
      * @brief Сортирует результаты по убыванию релевантности
      * @param results Результаты поиска
@@ -31,7 +95,9 @@ class RankingService {
                                                          size_t maxResults = DEFAULT_MAX_RESULTS);
 
     /**
-     * @brief Сортирует и ограничивает результаты
+     * @brief Выбирает maxResults лучших результатов
+     *
+     * Частичная сортировка: упорядочиваются только попавшие в выдачу результаты.
      * @param results Результаты поиска
      * @param maxResults Максимальное количество результатов
      * @return Отсортированный и ограниченный список результатов
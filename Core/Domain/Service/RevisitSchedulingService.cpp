@@ -0,0 +1,86 @@
+#include "RevisitSchedulingService.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Core::Domain::Service {
+double RevisitSchedulingService::estimateChangeRate(int64_t observations,
+                                                    int64_t changes,
+                                                    double observedSeconds) {
+    static constexpr double CORRECTION = 0.5;
+
+    if (observations <= 0 || observedSeconds <= 0.0) {
+        return 0.0;
+    }
+
+    const auto n = static_cast<double>(observations);
+    const auto x = static_cast<double>(std::clamp<int64_t>(changes, 0, observations));
+    const double meanInterval = observedSeconds / n;
+
+    return -std::log((n - x + CORRECTION) / (n + CORRECTION)) / meanInterval;
+}
+
+int64_t RevisitSchedulingService::computeRevisitInterval(double changeRate, double visitPriceSec) {
+    // Изменений не наблюдалось, или страница меняется быстрее, чем её можно догнать
+    const double marginalGain = changeRate * visitPriceSec;
+    if (changeRate <= 0.0 || marginalGain >= 1.0) {
+        return MAX_REVISIT_INTERVAL_SEC;
+    }
+
+    // r = λI из уравнения 1 - (1 + r)·e^(-r) = μλ; левая часть возрастает по r,
+    // поэтому корень ищется делением отрезка
+    static constexpr int BISECTION_STEPS = 64;
+    double low = 0.0;
+    double high = 1.0;
+    const auto gain = [](double r) { return 1.0 - (1.0 + r) * std::exp(-r); };
+    while (gain(high) < marginalGain) {
+        high *= 2.0;
+    }
+    for (int step = 0; step < BISECTION_STEPS; ++step) {
+        const double middle = 0.5 * (low + high);
+        (gain(middle) < marginalGain ? low : high) = middle;
+    }
+
+    const double interval = high / changeRate;
+    if (interval >= static_cast<double>(MAX_REVISIT_INTERVAL_SEC)) {
+        return MAX_REVISIT_INTERVAL_SEC;
+    }
+
+    return std::max(MIN_REVISIT_INTERVAL_SEC, static_cast<int64_t>(interval));
+}
+
+void RevisitSchedulingService::recordVisit(Model::RevisitSchedule& schedule,
+                                           Model::RevisitSchedule::TimestampType visitedAt,
+                                           bool changed,
+                                           double visitPriceSec) {
+    // Страница уже отложена как недогоняемая (её посетили спустя максимальный интервал)
+    const bool givenUp =
+        schedule.getVisitCount() > 0 && visitedAt - schedule.getLastVisitAt() >= MAX_REVISIT_INTERVAL_SEC;
+    schedule.recordVisit(visitedAt, changed);
+
+    // Пока нет ни одного интервала наблюдения, используем интервал по умолчанию
+    const int64_t observations = schedule.getVisitCount() - 1;
+    int64_t interval = DEFAULT_REVISIT_INTERVAL_SEC;
+
+    if (givenUp && changed && schedule.getChangeCount() == observations) {
+        // Изменения видны в каждом интервале, поэтому оценка λ - лишь нижняя граница,
+        // и она падает с ростом интервала. Без этой ветки отложенная страница вернулась
+        // бы к частым посещениям, и бюджет снова уходил бы на неё
+        interval = MAX_REVISIT_INTERVAL_SEC;
+    } else if (observations > 0 && schedule.getChangeCount() == 0) {
+        // Изменений ещё не видели - оценка λ равна нулю. Вместо мгновенного
+        // перехода к максимальному интервалу удваиваем наблюдённый период
+        static constexpr double BACKOFF_FACTOR = 2.0;
+        const double backoff = BACKOFF_FACTOR * schedule.getObservedSeconds();
+        interval = backoff >= static_cast<double>(MAX_REVISIT_INTERVAL_SEC)
+                       ? MAX_REVISIT_INTERVAL_SEC
+                       : std::max(MIN_REVISIT_INTERVAL_SEC, static_cast<int64_t>(backoff));
+    } else if (observations > 0) {
+        const double changeRate =
+            estimateChangeRate(observations, schedule.getChangeCount(), schedule.getObservedSeconds());
+        interval = computeRevisitInterval(changeRate, visitPriceSec);
+    }
+
+    schedule.setNextVisitAt(visitedAt + interval);
+}
+} // namespace Core::Domain::Service
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../Model/RevisitSchedule.h"
+
+namespace Core::Domain::Service {
+/**
+ * @brief Доменный сервис для планирования повторных посещений страниц
+ *
+ * Изменения страницы моделируются пуассоновским процессом с интенсивностью λ.
+ * Интенсивность оценивается по истории посещений: сколько интервалов между
+ * посещениями наблюдалось и в скольких из них страница изменилась.
+ *
+ * Интервалы выбираются так, чтобы при ограниченном числе скачиваний средняя
+ * свежесть индекса была наибольшей (Cho, Garcia-Molina). Частота посещений растёт
+ * с λ только до некоторого предела, а затем падает: страницу, которая меняется
+ * быстрее, чем её можно догнать, скачивать часто бесполезно - копия устаревает
+ * почти сразу. Такие страницы посещаются раз в MAX_REVISIT_INTERVAL_SEC.
+ */
+class RevisitSchedulingService {
+  public:
+    static constexpr int64_t MIN_REVISIT_INTERVAL_SEC = 60 * 60;            // 1 час
+    static constexpr int64_t MAX_REVISIT_INTERVAL_SEC = 30 * 24 * 60 * 60;  // 30 дней
+    static constexpr int64_t DEFAULT_REVISIT_INTERVAL_SEC = 24 * 60 * 60;   // 1 сутки
+    static constexpr int64_t DEFAULT_VISIT_PRICE_SEC = 6 * 60 * 60;         // 6 часов
+
+    /**
+     * @brief Оценивает интенсивность изменений страницы (изменений в секунду)
+     * @param observations Количество наблюдённых интервалов между посещениями
+     * @param changes Количество интервалов, в которых обнаружено изменение
+     * @param observedSeconds Суммарная длительность наблюдённых интервалов
+     * @return Оценка λ; 0, если наблюдений нет
+     *
+     * Используется оценка λ = -ln((n - X + 0.5) / (n + 0.5)) / Δ, где n - число
+     * интервалов, X - число интервалов с изменениями, Δ - средний интервал.
+     * В отличие от наивной X / (n·Δ) она учитывает, что за один интервал
+     * страница могла измениться несколько раз, и не расходится при X = n.
+     */
+    static double estimateChangeRate(int64_t observations, int64_t changes, double observedSeconds);
+
+    /**
+     * @brief Вычисляет интервал до следующего посещения
+     * @param changeRate Оценка интенсивности изменений (изменений в секунду)
+     * @param visitPriceSec Цена посещения μ (секунды): чем больше, тем реже посещения
+     * @return Интервал в секундах в пределах [MIN_REVISIT_INTERVAL_SEC, MAX_REVISIT_INTERVAL_SEC]
+     *
+     * Свежесть страницы, посещаемой раз в I, равна F = (1 - e^(-λI)) / (λI). Сумма F
+     * по страницам при заданном числе посещений максимальна, когда прирост свежести
+     * от ещё одного посещения у всех страниц одинаков: 1 - (1 + r)·e^(-r) = μλ, r = λI.
+     * Левая часть меньше 1, поэтому страницы с λ >= 1 / μ не догоняются. Для редко
+     * меняющихся страниц I ≈ sqrt(2μ / λ).
+     */
+    static int64_t computeRevisitInterval(double changeRate, double visitPriceSec = DEFAULT_VISIT_PRICE_SEC);
+
+    /**
+     * @brief Регистрирует посещение и планирует следующее
+     *
+     * Пока изменений не наблюдалось, интервал удваивается относительно
+     * наблюдённого периода (до MAX_REVISIT_INTERVAL_SEC). Страница, отложенная
+     * на максимальный интервал и снова изменившаяся в каждом интервале, остаётся
+     * отложенной: по таким наблюдениям λ оценивается только снизу.
+     * @param schedule Расписание страницы
+     * @param visitedAt Время посещения (секунды с начала эпохи)
+     * @param changed Изменилась ли страница с прошлого посещения
+     * @param visitPriceSec Цена посещения (см. computeRevisitInterval)
+     */
+    static void recordVisit(Model::RevisitSchedule& schedule,
+                            Model::RevisitSchedule::TimestampType visitedAt,
+                            bool changed,
+                            double visitPriceSec = DEFAULT_VISIT_PRICE_SEC);
+};
+} // namespace Core::Domain::Service
@@ -19,14 +19,60 @@ class IConfiguration {
     virtual std::string getDatabaseName() const = 0;
     virtual std::string getDatabaseUser() const = 0;
     virtual std::string getDatabasePassword() const = 0;
+    virtual std::string getDatabasePostingStorage() const = 0;
 
     // Настройки Spider
     virtual std::string getSpiderStartUrl() const = 0;
     virtual int getSpiderCrawlDepth() const = 0;
     virtual int getSpiderThreadPoolSize() const = 0;
+    virtual bool getSpiderRecrawlEnabled() const = 0;
+    virtual int getSpiderRecrawlBatchSize() const = 0;
+    virtual int getSpiderRecrawlMaxSleepSec() const = 0;
+    virtual std::string getSpiderFrontierDir() const = 0;
+    virtual int getSpiderFrontierGroupCommitMs() const = 0;
+    virtual int getSpiderFrontierSnapshotRecords() const = 0;
+    virtual std::string getSpiderFrontierSpillDir() const = 0;
+    virtual int getSpiderFrontierMemoryHighWatermark() const = 0;
+    virtual int getSpiderFrontierMemoryLowWatermark() const = 0;
+    virtual int getSpiderStatusPort() const = 0;
+    virtual int getSpiderStatusIntervalSec() const = 0;
 
     // Настройки HTTP Server
     virtual int getHttpServerPort() const = 0;
     virtual int getHttpServerMaxResults() const = 0;
+    virtual std::string getHttpServerSearchBackend() const = 0;
+    virtual std::string getHttpServerIndexFile() const = 0;
+    virtual int getHttpServerCacheMaxBytes() const = 0;
+    virtual int getHttpServerCacheTtlSec() const = 0;
+    virtual int getHttpServerCacheShards() const = 0;
+    virtual int getHttpServerCacheGenerationPollMs() const = 0;
+    virtual int getHttpServerCoalescingTimeoutMs() const = 0;
+    virtual int getHttpServerReadTimeoutSec() const = 0;
+    virtual int getHttpServerKeepAliveTimeoutSec() const = 0;
+    virtual int getHttpServerMaxKeepAliveRequests() const = 0;
+    virtual int getHttpServerThreads() const = 0;
+    virtual bool getHttpServerReusePort() const = 0;
+    virtual bool getHttpServerPinThreads() const = 0;
+    virtual int getHttpServerApiMaxResults() const = 0;
+    virtual int getHttpServerCompressionMinBytes() const = 0;
+    virtual int getHttpServerCompressionLevel() const = 0;
+    virtual int getHttpServerMaxConcurrentSearches() const = 0;
+    virtual int getHttpServerSearchQueueSize() const = 0;
+    virtual int getHttpServerSearchQueueTargetMs() const = 0;
+    virtual int getHttpServerSearchQueueIntervalMs() const = 0;
+    virtual int getHttpServerRateLimitPerIp() const = 0;
+    virtual int getHttpServerRateLimitBurst() const = 0;
+    virtual int getHttpServerRequestTimeoutMs() const = 0;
+    virtual bool getHttpServerMetricsEnabled() const = 0;
+
+    // Настройки журнала
+    virtual std::string getLoggingLevel() const = 0;
+    virtual std::string getLoggingFormat() const = 0;
+    virtual int getLoggingBufferRecords() const = 0;
+    virtual int getLoggingRateLimitPerSec() const = 0;
+
+    // Настройки трассировки
+    virtual std::string getTracingFile() const = 0;
+    virtual int getTracingMaxEvents() const = 0;
 };
 } // namespace Core::Ports
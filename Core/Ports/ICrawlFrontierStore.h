@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Core::Ports {
+/**
+ * @brief URL в очереди краулинга с глубиной
+ */
+struct FrontierEntry {
+    std::string url;
+    int depth = 0;
+};
+
+/**
+ * @brief Состояние очереди краулинга, восстановленное после перезапуска
+ */
+struct RecoveredFrontier {
+    std::vector<FrontierEntry> pending;  // URL, ещё не обработанные до конца (в порядке очереди)
+    std::vector<uint64_t> visited;       // Отпечатки всех URL, когда-либо попавших в очередь
+};
+
+/**
+ * @brief Источник данных для снимка очереди краулинга
+ *
+ * Создаётся очередью краулинга под её блокировкой и перебирается хранилищем
+ * позже, в фоновом потоке: состояние зафиксировано на момент создания.
+ */
+class IFrontierSnapshotSource {
+  public:
+    virtual ~IFrontierSnapshotSource() = default;
+
+    /**
+     * @brief Перебирает необработанные URL (включая находящиеся в обработке)
+     */
+    virtual void forEachPending(const std::function<void(const FrontierEntry&)>& visitor) const = 0;
+
+    /**
+     * @brief Перебирает отпечатки посещённых URL
+     */
+    virtual void forEachVisited(const std::function<void(uint64_t)>& visitor) const = 0;
+};
+
+/**
+ * @brief Интерфейс персистентного хранилища очереди краулинга
+ *
+ * Позволяет продолжить краулинг после аварийного завершения процесса,
+ * а не начинать заново со стартового URL.
+ * Реализация будет в Infrastructure слое.
+ */
+class ICrawlFrontierStore {
+  public:
+    virtual ~ICrawlFrontierStore() = default;
+
+    /**
+     * @brief Восстанавливает состояние очереди (снимок + журнал)
+     * @return Необработанные URL и отпечатки посещённых
+     */
+    virtual RecoveredFrontier recover() = 0;
+
+    /**
+     * @brief Записывает постановку URL в очередь
+     */
+    virtual void appendEnqueued(const FrontierEntry& entry) = 0;
+
+    /**
+     * @brief Записывает завершение обработки URL
+     * @param fingerprint Отпечаток URL
+     */
+    virtual void appendCompleted(uint64_t fingerprint) = 0;
+
+    /**
+     * @brief Проверяет, пора ли сжать журнал в снимок
+     */
+    virtual bool isCompactionDue() const = 0;
+
+    /**
+     * @brief Начинает сжатие журнала в снимок
+     *
+     * Вызывается под блокировкой очереди, чтобы снимок совпадал с позицией
+     * в журнале; сам снимок записывается в фоне, после возврата.
+     * @param source Состояние очереди на момент вызова
+     */
+    virtual void compact(std::shared_ptr<const IFrontierSnapshotSource> source) = 0;
+
+    /**
+     * @brief Сбрасывает накопленные записи на диск
+     */
+    virtual void flush() = 0;
+
+    /**
+     * @brief Удаляет журнал и снимок завершённого краулинга
+     *
+     * После этого recover() вернёт пустое состояние, и следующий запуск
+     * начнёт краулинг заново со стартового URL.
+     */
+    virtual void reset() = 0;
+};
+} // namespace Core::Ports
@@ -3,6 +3,7 @@
 #include <optional>
 #include <vector>
 
+#include "../DTO/DocumentStateDTO.h"
 #include "../Domain/Model/Document.h"
 
 namespace Core::Ports {
@@ -44,6 +45,36 @@ class IDocumentRepository {
      */
     virtual bool existsByUrl(const std::string& url) = 0;
 
+    /**
+     * @brief Находит состояние документа по URL (ID, хеш содержимого, валидаторы)
+     * @param url URL документа
+     * @return Состояние документа, если документ существует
+     *
+     * В отличие от findByUrl не загружает текст документа.
+     */
+    virtual std::optional<DTO::DocumentStateDTO> findStateByUrl(const std::string& url) = 0;
+
+    /**
+     * @brief Сохраняет HTTP-валидаторы кеша документа
+     * @param id ID документа
+     * @param validators ETag / Last-Modified последнего ответа
+     */
+    virtual void updateCacheValidators(Domain::Model::Document::IdType id,
+                                       const DTO::CacheValidatorsDTO& validators) = 0;
+
+    /**
+     * @brief Сохраняет хеш содержимого и HTTP-валидаторы документа
+     * @param id ID документа
+     * @param contentHash Хеш исходного HTML
+     * @param validators ETag / Last-Modified последнего ответа
+     *
+     * Вызывается после записи постингов: пока хеш не сохранён, следующий
+     * краулинг считает страницу изменённой и индексирует её заново.
+     */
+    virtual void updateContentState(Domain::Model::Document::IdType id,
+                                    Domain::Model::Document::ContentHashType contentHash,
+                                    const DTO::CacheValidatorsDTO& validators) = 0;
+
     /**
      * @brief Находит все документы
      * @return Список всех документов
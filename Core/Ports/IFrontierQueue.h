@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <optional>
+
+#include "ICrawlFrontierStore.h"
+
+namespace Core::Ports {
+using FrontierSnapshot = std::function<void(const std::function<void(const FrontierEntry&)>&)>;
+
+/**
+ * @brief Интерфейс FIFO-очереди URL, ожидающих краулинга
+ *
+ * Хранилище элементов очереди краулинга. Реализация может держать в памяти
+ * только часть очереди, а остальное хранить на диске.
+ * Не потокобезопасна: синхронизацию обеспечивает вызывающая сторона.
+ * Реализация будет в Infrastructure слое.
+ */
+class IFrontierQueue {
+  public:
+    virtual ~IFrontierQueue() = default;
+
+    /**
+     * @brief Добавляет URL в конец очереди
+     */
+    virtual void push(FrontierEntry entry) = 0;
+
+    /**
+     * @brief Извлекает URL из начала очереди
+     * @return URL или nullopt, если очередь пуста
+     */
+    virtual std::optional<FrontierEntry> pop() = 0;
+
+    /**
+     * @brief Ожидание данных с диска, на котором заблокировался бы pop()
+     * @return Функция ожидания или пустая функция, если pop() не будет ждать диск
+     *
+     * Функция вызывается без синхронизации с очередью: вызывающая сторона отпускает
+     * свою блокировку на время ожидания и после него вызывает pop().
+     */
+    virtual std::function<void()> pendingRead() = 0;
+
+    /**
+     * @brief Ожидание отстающей фоновой записи на диск после push()
+     * @return Функция ожидания или пустая функция, если запись не отстаёт
+     *
+     * Как и ожидание чтения, вызывается без синхронизации с очередью: так добавляющий
+     * поток притормаживается, пока диск не догонит, не задерживая остальные потоки.
+     */
+    virtual std::function<void()> pendingWrite() = 0;
+
+    /**
+     * @brief Проверяет, пуста ли очередь
+     */
+    virtual bool empty() const = 0;
+
+    /**
+     * @brief Количество URL в очереди
+     */
+    virtual size_t size() const = 0;
+
+    /**
+     * @brief Перебирает URL в порядке очереди, не извлекая их
+     */
+    virtual void forEach(const std::function<void(const FrontierEntry&)>& visitor) const = 0;
+
+    /**
+     * @brief Перебор URL очереди, зафиксированных на момент вызова
+     *
+     * Возвращённая функция вызывается позже, без синхронизации с очередью
+     * (например, из потока записи снимка), и перебирает URL в порядке очереди.
+     */
+    virtual FrontierSnapshot snapshot() const = 0;
+};
+} // namespace Core::Ports
@@ -1,9 +1,49 @@
 #pragma once
 
+#include <map>
 #include <optional>
 #include <string>
 
+#include "../DTO/CacheValidatorsDTO.h"
+
 namespace Core::Ports {
+/**
+ * @brief Результат HTTP-запроса: статус, заголовки, тело и валидаторы кеша
+ */
+struct HttpFetchResult {
+    static constexpr int STATUS_NETWORK_ERROR = 0;
+    static constexpr int STATUS_OK = 200;
+    static constexpr int STATUS_MULTIPLE_CHOICES = 300;
+    static constexpr int STATUS_NOT_MODIFIED = 304;
+    static constexpr int STATUS_BAD_REQUEST = 400;
+
+    int statusCode = STATUS_NETWORK_ERROR;       // HTTP-статус (0 - ошибка сети)
+    std::string body;                            // Тело ответа
+    std::map<std::string, std::string> headers;  // Заголовки ответа
+    DTO::CacheValidatorsDTO validators;          // ETag / Last-Modified из ответа
+
+    /**
+     * @brief Успешный ответ с телом (2xx)
+     */
+    bool isSuccess() const { return statusCode >= STATUS_OK && statusCode < STATUS_MULTIPLE_CHOICES; }
+
+    /**
+     * @brief Страница не изменилась с момента прошлого запроса (304)
+     */
+    bool isNotModified() const { return statusCode == STATUS_NOT_MODIFIED; }
+
+    /**
+     * @brief Ответ, тело которого считается содержимым страницы
+     *
+     * Кроме 2xx - редирект без заголовка Location: идти некуда, и тело
+     * отдаётся как есть.
+     */
+    bool hasContent() const {
+        return isSuccess() ||
+               (statusCode >= STATUS_MULTIPLE_CHOICES && statusCode < STATUS_BAD_REQUEST && !isNotModified());
+    }
+};
+
 /**
  * @brief Интерфейс HTTP-клиента для скачивания веб-страниц
  *
@@ -21,17 +61,21 @@ class IHttpClient {
      */
     virtual std::optional<std::string> get(const std::string& url) = 0;
 
+    /**
+     * @brief Выполняет условный GET-запрос по указанному URL
+     * @param url URL для запроса
+     * @param validators Валидаторы прошлого ответа (If-None-Match / If-Modified-Since)
+     * @return Статус, заголовки, тело и новые валидаторы
+     *
+     * Если страница не изменилась, сервер отвечает 304 без тела.
+     */
+    virtual HttpFetchResult fetch(const std::string& url, const DTO::CacheValidatorsDTO& validators = {}) = 0;
+
     /**
      * @brief Проверяет, доступен ли URL
      * @param url URL для проверки
      * @return true если URL доступен
      */
     virtual bool isAccessible(const std::string& url) = 0;
-
-    /**
-     * @brief Устанавливает ID рабочего потока для логирования
-     * @param workerId Номер потока (1, 2, 3...)
-     */
-    virtual void setWorkerId(int workerId) = 0;
 };
 } // namespace Core::Ports
@@ -1,48 +1,113 @@
 #pragma once
 
 #include <functional>
-#include <map>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "RequestDeadline.h"
 
 namespace Core::Ports {
+/**
+ * @brief HTTP-запрос без копирования
+ *
+ * Поля указывают в буферы соединения и действительны только во время
+ * вызова обработчика: всё, что нужно сохранить, обработчик копирует сам.
+ */
+struct HttpRequestView {
+    std::string_view method;
+    std::string_view target;
+    std::string_view body;
+    std::string_view remoteAddress;  // IP-адрес клиента
+    RequestDeadline deadline;        // Срок обработки и проверка отключения клиента
+
+    // Поиск заголовка в запросе сервера (без копирования и без выделения памяти)
+    using HeaderLookup = std::string_view (*)(const void* headers, std::string_view name);
+    const void* headers = nullptr;
+    HeaderLookup headerLookup = nullptr;
+
+    /**
+     * @brief Возвращает значение заголовка (без учёта регистра имени)
+     * @return Значение или пустая строка, если заголовка нет
+     */
+    std::string_view getHeader(std::string_view name) const {
+        return headerLookup != nullptr ? headerLookup(headers, name) : std::string_view();
+    }
+};
+
+/**
+ * @brief Заголовок HTTP-ответа
+ */
+struct HttpHeader {
+    std::string name;
+    std::string value;
+};
+
 /**
  * @brief HTTP-ответ с телом и заголовками
+ *
+ * Тело передаётся серверу перемещением и становится буфером ответа без копирования;
+ * заголовки хранятся плоским списком (их обычно два-три).
  */
 struct HttpResponse {
     std::string body;
-    std::map<std::string, std::string> headers;
+    std::vector<HttpHeader> headers;
     int statusCode = 200;
 
+    /**
+     * @brief Устанавливает заголовок (заменяет заголовок с тем же именем)
+     */
+    void setHeader(std::string name, std::string value) {
+        for (auto& header : headers) {
+            if (header.name == name) {
+                header.value = std::move(value);
+                return;
+            }
+        }
+        headers.push_back({std::move(name), std::move(value)});
+    }
+
+    /**
+     * @brief Возвращает значение заголовка
+     * @return Указатель на значение или nullptr, если заголовка нет
+     */
+    const std::string* findHeader(std::string_view name) const {
+        for (const auto& header : headers) {
+            if (header.name == name) {
+                return &header.value;
+            }
+        }
+        return nullptr;
+    }
+
     /**
      * @brief Создаёт HTML-ответ
      */
-    static HttpResponse html(const std::string& htmlBody, int status = 200) {
-        HttpResponse response;
-        response.body = htmlBody;
-        response.statusCode = status;
-        response.headers["Content-Type"] = "text/html; charset=utf-8";
-        return response;
+    static HttpResponse html(std::string htmlBody, int status = 200) {
+        return withBody(std::move(htmlBody), "text/html; charset=utf-8", status);
     }
 
     /**
      * @brief Создаёт JSON-ответ
      */
-    static HttpResponse json(const std::string& jsonBody, int status = 200) {
-        HttpResponse response;
-        response.body = jsonBody;
-        response.statusCode = status;
-        response.headers["Content-Type"] = "application/json";
-        return response;
+    static HttpResponse json(std::string jsonBody, int status = 200) {
+        return withBody(std::move(jsonBody), "application/json", status);
     }
 
     /**
      * @brief Создаёт текстовый ответ
      */
-    static HttpResponse text(const std::string& textBody, int status = 200) {
+    static HttpResponse text(std::string textBody, int status = 200) {
+        return withBody(std::move(textBody), "text/plain; charset=utf-8", status);
+    }
+
+  private:
+    static HttpResponse withBody(std::string body, const char* contentType, int status) {
         HttpResponse response;
-        response.body = textBody;
+        response.body = std::move(body);
         response.statusCode = status;
-        response.headers["Content-Type"] = "text/plain; charset=utf-8";
+        response.headers.push_back({"Content-Type", contentType});
         return response;
     }
 };
@@ -55,9 +120,7 @@ struct HttpResponse {
  */
 class IHttpServer {
   public:
-    using RequestHandler = std::function<HttpResponse(const std::string& method,
-                                                      const std::string& target,
-                                                      const std::string& body)>;
+    using RequestHandler = std::function<HttpResponse(const HttpRequestView& request)>;
 
     virtual ~IHttpServer() = default;
 
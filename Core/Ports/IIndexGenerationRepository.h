@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Core::Ports {
+/**
+ * @brief Интерфейс счётчика поколений индекса
+ *
+ * Spider увеличивает счётчик после прохода краулинга, изменившего индекс,
+ * HTTPServer сравнивает его с поколением записей кеша результатов поиска.
+ * Реализация будет в Infrastructure слое.
+ */
+class IIndexGenerationRepository {
+  public:
+    using GenerationType = int64_t;
+
+    virtual ~IIndexGenerationRepository() = default;
+
+    /**
+     * @brief Возвращает текущее поколение индекса
+     */
+    virtual GenerationType getGeneration() = 0;
+
+    /**
+     * @brief Начинает новое поколение индекса
+     *
+     * Вызывается после фиксации изменений индекса (один раз на проход краулинга).
+     */
+    virtual void bumpGeneration() = 0;
+};
+} // namespace Core::Ports
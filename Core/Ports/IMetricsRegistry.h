@@ -0,0 +1,132 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace Core::Ports {
+/**
+ * @brief Монотонно растущий счётчик
+ */
+class ICounter {
+  public:
+    virtual ~ICounter() = default;
+
+    virtual void add(uint64_t value = 1) = 0;
+
+    virtual uint64_t get() const = 0;
+};
+
+/**
+ * @brief Текущее значение (соединения, запросы в обработке, ...)
+ */
+class IGauge {
+  public:
+    virtual ~IGauge() = default;
+
+    virtual void add(int64_t delta) = 0;
+    virtual void set(int64_t value) = 0;
+
+    virtual int64_t get() const = 0;
+};
+
+/**
+ * @brief Сводка распределения длительностей
+ */
+struct LatencySummary {
+    uint64_t count = 0;
+    std::chrono::nanoseconds sum{0};
+    std::chrono::nanoseconds p50{0};
+    std::chrono::nanoseconds p90{0};
+    std::chrono::nanoseconds p99{0};
+
+    std::chrono::nanoseconds getMean() const {
+        return count == 0 ? std::chrono::nanoseconds(0) : sum / static_cast<int64_t>(count);
+    }
+};
+
+/**
+ * @brief Распределение длительностей
+ */
+class ILatencyHistogram {
+  public:
+    virtual ~ILatencyHistogram() = default;
+
+    virtual void record(std::chrono::nanoseconds duration) = 0;
+
+    /**
+     * @brief Сводка по всем записям (для страниц состояния; дороже записи)
+     */
+    virtual LatencySummary getSummary() const = 0;
+};
+
+/**
+ * @brief Реестр метрик
+ *
+ * Метрики создаются один раз (обычно при старте) и живут, пока жив реестр;
+ * обновлять их можно из любых потоков. Повторная регистрация того же имени
+ * с теми же метками возвращает ту же метрику.
+ *
+ * Метки передаются готовой строкой в формате Prometheus: stage="db".
+ */
+class IMetricsRegistry {
+  public:
+    virtual ~IMetricsRegistry() = default;
+
+    virtual ICounter& counter(const std::string& name,
+                              const std::string& help,
+                              const std::string& labels = "") = 0;
+
+    virtual IGauge& gauge(const std::string& name, const std::string& help, const std::string& labels = "") = 0;
+
+    virtual ILatencyHistogram& histogram(const std::string& name,
+                                         const std::string& help,
+                                         const std::string& labels = "") = 0;
+
+    /**
+     * @brief Регистрирует значение, вычисляемое при каждом чтении метрик
+     *
+     * Для счётчиков, которые уже ведёт другой компонент (кеш, сжатие ответов).
+     * @param isCounter Значение монотонно растёт (counter), иначе gauge
+     */
+    virtual void callback(const std::string& name,
+                          const std::string& help,
+                          bool isCounter,
+                          std::function<double()> read,
+                          const std::string& labels = "") = 0;
+
+    /**
+     * @brief Возвращает все метрики в текстовом формате Prometheus
+     */
+    virtual std::string render() const = 0;
+};
+
+/**
+ * @brief Замеряет время от создания до уничтожения и записывает его в гистограмму
+ *
+ * Без гистограммы (nullptr) ничего не замеряет.
+ */
+class ScopedLatency {
+  public:
+    explicit ScopedLatency(ILatencyHistogram* histogram)
+        : histogram_(histogram) {
+        if (histogram_ != nullptr) {
+            startedAt_ = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ScopedLatency() {
+        if (histogram_ != nullptr) {
+            histogram_->record(std::chrono::steady_clock::now() - startedAt_);
+        }
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+  private:
+    ILatencyHistogram* histogram_;
+    std::chrono::steady_clock::time_point startedAt_;
+};
+} // namespace Core::Ports
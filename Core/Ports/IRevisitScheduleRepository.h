@@ -0,0 +1,55 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../Domain/Model/RevisitSchedule.h"
+
+namespace Core::Ports {
+/**
+ * @brief Интерфейс репозитория расписаний повторного посещения
+ *
+ * Персистентная очередь с приоритетом по времени следующего посещения.
+ * Реализация будет в Infrastructure слое.
+ */
+class IRevisitScheduleRepository {
+  public:
+    virtual ~IRevisitScheduleRepository() = default;
+
+    /**
+     * @brief Находит расписание страницы по URL
+     * @param url URL страницы
+     * @return Расписание, если страница уже посещалась
+     */
+    virtual std::optional<Domain::Model::RevisitSchedule> findByUrl(const std::string& url) = 0;
+
+    /**
+     * @brief Сохраняет расписание (создаёт или обновляет)
+     * @param schedule Расписание для сохранения
+     */
+    virtual void save(const Domain::Model::RevisitSchedule& schedule) = 0;
+
+    /**
+     * @brief Извлекает страницы, время посещения которых наступило
+     * @param now Текущее время (секунды с начала эпохи)
+     * @param limit Максимальное количество страниц
+     * @param leaseUntil Новое время посещения извлечённых страниц
+     * @return Расписания в порядке возрастания времени посещения
+     *
+     * Извлечённым страницам атомарно назначается время leaseUntil, чтобы
+     * страница, посещение которой не удалось, не выдавалась повторно сразу же.
+     * Успешное посещение перепланирует страницу через save().
+     */
+    virtual std::vector<Domain::Model::RevisitSchedule> takeDue(
+        Domain::Model::RevisitSchedule::TimestampType now,
+        size_t limit,
+        Domain::Model::RevisitSchedule::TimestampType leaseUntil) = 0;
+
+    /**
+     * @brief Возвращает ближайшее запланированное время посещения
+     * @return Время посещения, если расписания есть
+     */
+    virtual std::optional<Domain::Model::RevisitSchedule::TimestampType> findNextVisitTime() = 0;
+};
+} // namespace Core::Ports
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "../DTO/SearchHitsDTO.h"
+
+namespace Core::Ports {
+/**
+ * @brief Счётчики кеша результатов поиска
+ */
+struct SearchCacheStatistics {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t invalidations = 0;  // Промахи из-за смены поколения индекса или истёкшего TTL
+    uint64_t evictions = 0;      // Записи, вытесненные из-за ограничения по памяти
+    uint64_t entries = 0;
+    uint64_t bytes = 0;
+    std::chrono::nanoseconds savedLatency{0};  // Суммарное время поиска, сэкономленное попаданиями
+
+    /**
+     * @brief Доля попаданий среди всех обращений
+     */
+    double getHitRatio() const {
+        const uint64_t lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+};
+
+/**
+ * @brief Интерфейс кеша результатов поиска
+ *
+ * Хранит готовую выдачу по ключу запроса. Каждая запись помечена поколением
+ * индекса, в котором она посчитана: запись другого поколения считается
+ * устаревшей и не возвращается.
+ * Реализация будет в Infrastructure слое; должна быть потокобезопасной.
+ */
+class ISearchResultCache {
+  public:
+    virtual ~ISearchResultCache() = default;
+
+    /**
+     * @brief Находит выдачу в кеше
+     * @param key Ключ запроса
+     * @param generation Текущее поколение индекса
+     * @return Выдача, если она есть, посчитана в этом поколении и не устарела
+     */
+    virtual std::optional<DTO::SearchHitsDTO> find(const std::string& key, int64_t generation) = 0;
+
+    /**
+     * @brief Сохраняет выдачу в кеш
+     * @param key Ключ запроса
+     * @param generation Поколение индекса, прочитанное до начала поиска
+     * @param hits Выдача
+     * @param computeTime Время поиска (учитывается в сэкономленном времени при попаданиях)
+     */
+    virtual void store(const std::string& key,
+                       int64_t generation,
+                       const DTO::SearchHitsDTO& hits,
+                       std::chrono::nanoseconds computeTime) = 0;
+
+    /**
+     * @brief Возвращает счётчики кеша
+     */
+    virtual SearchCacheStatistics getStatistics() const = 0;
+};
+} // namespace Core::Ports
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+
+namespace Core::Ports {
+/**
+ * @brief Приёмник отрезков трассировки
+ *
+ * Отрезок - именованный интервал времени в одном потоке ("http.tls",
+ * "db.words.upsert"). Вложенность отрезков определяется по времени, поэтому
+ * по записанным отрезкам строится flame chart обработки каждой страницы.
+ */
+class ITracer {
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    virtual ~ITracer() = default;
+
+    /**
+     * @brief Записывает завершённый отрезок (вызывается из любых потоков)
+     * @param name Имя этапа (строковый литерал)
+     * @param category Подсистема (строковый литерал)
+     * @param detail Пояснение, например URL страницы; может быть пустым
+     */
+    virtual void recordSpan(const char* name,
+                            const char* category,
+                            std::string_view detail,
+                            Clock::time_point start,
+                            Clock::time_point end) = 0;
+};
+
+namespace Tracing {
+// Трассировщик процесса; nullptr - трассировка выключена
+inline std::atomic<ITracer*> activeTracer{nullptr};
+
+/**
+ * @brief Включает трассировку (tracer != nullptr) или выключает её
+ *
+ * Трассировщик должен жить, пока в потоках могут быть открытые отрезки.
+ */
+inline void setTracer(ITracer* tracer) {
+    activeTracer.store(tracer, std::memory_order_release);
+}
+
+inline ITracer* getTracer() {
+    return activeTracer.load(std::memory_order_acquire);
+}
+} // namespace Tracing
+
+/**
+ * @brief Отрезок трассировки от создания до end() или уничтожения
+ *
+ * При выключенной трассировке - одно чтение атомарного указателя: время не
+ * замеряется, пояснение не копируется.
+ */
+class TraceSpan {
+  public:
+    TraceSpan(const char* name, const char* category, std::string_view detail = {})
+        : tracer_(Tracing::getTracer()) {
+        if (tracer_ != nullptr) {
+            name_ = name;
+            category_ = category;
+            detail_.assign(detail);
+            start_ = ITracer::Clock::now();
+        }
+    }
+
+    ~TraceSpan() {
+        end();
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    /**
+     * @brief Завершает отрезок раньше конца области видимости
+     */
+    void end() {
+        if (tracer_ != nullptr) {
+            tracer_->recordSpan(name_, category_, detail_, start_, ITracer::Clock::now());
+            tracer_ = nullptr;
+        }
+    }
+
+  private:
+    ITracer* tracer_;
+    const char* name_ = nullptr;
+    const char* category_ = nullptr;
+    std::string detail_;
+    ITracer::Clock::time_point start_;
+};
+} // namespace Core::Ports
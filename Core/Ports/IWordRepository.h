@@ -2,12 +2,15 @@
 
 #include <map>
 #include <optional>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "../Domain/Model/Document.h"
-#include "../Domain/Model/SearchResult.h"
+#include "../Domain/Model/PostingList.h"
 #include "../Domain/Model/Word.h"
 #include "../Domain/Model/WordFrequency.h"
+#include "RequestDeadline.h"
 
 namespace Core::Ports {
 /**
@@ -49,11 +52,24 @@ class IWordRepository {
                                      const std::map<std::string, int>& wordFrequencies) = 0;
 
     /**
-     * @brief Ищет документы, содержащие все указанные слова
-     * @param words Список слов для поиска
-     * @return Список результатов поиска с релевантностью
+     * @brief Находит постинги слов
+     * @param words Слова (нормализованные, в нижнем регистре)
+     * @param deadline Срок запроса, которым ограничивается чтение из хранилища
+     * @return Списки постингов в порядке слов; для неизвестного слова - пустой список
+     * @throws RequestCancelledError если чтение прервано по сроку или отключению клиента
      */
-    virtual std::vector<Domain::Model::SearchResult> search(
-        const std::vector<std::string>& words) = 0;
+    virtual std::vector<Domain::Model::PostingList> findPostings(const std::vector<std::string>& words,
+                                                                 const RequestDeadline& deadline) = 0;
+
+    /**
+     * @brief Находит URL документов
+     * @param documentIds ID документов
+     * @param deadline Срок запроса, которым ограничивается чтение из хранилища
+     * @return Карта: ID документа -> URL (документов, которых уже нет, в ней нет)
+     * @throws RequestCancelledError если чтение прервано по сроку или отключению клиента
+     */
+    virtual std::unordered_map<Domain::Model::Document::IdType, std::string> findDocumentUrls(
+        const std::vector<Domain::Model::Document::IdType>& documentIds,
+        const RequestDeadline& deadline) = 0;
 };
 } // namespace Core::Ports
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace Core::Ports {
+/**
+ * @brief Запрос прерван: истёк его срок или клиент отключился
+ */
+class RequestCancelledError : public std::runtime_error {
+  public:
+    explicit RequestCancelledError(const std::string& message) : std::runtime_error(message) {}
+};
+
+/**
+ * @brief Срок выполнения запроса и проверка отключения клиента
+ *
+ * Создаётся сервером на каждый запрос и передаётся по ссылке до репозиториев:
+ * они ограничивают сроком время запросов к хранилищу и прерывают запросы,
+ * результат которых уже никому не нужен. По умолчанию срока нет.
+ */
+class RequestDeadline {
+  public:
+    using Clock = std::chrono::steady_clock;
+    // Возвращает true, если клиент отключился; вызывается из других потоков
+    using DisconnectProbe = std::function<bool()>;
+
+    /**
+     * @brief Без срока и без проверки клиента
+     */
+    RequestDeadline() = default;
+
+    /**
+     * @brief Конструктор
+     * @param expiresAt Момент, после которого результат запроса не нужен
+     * @param disconnectProbe Проверка отключения клиента (может быть пустой)
+     */
+    explicit RequestDeadline(Clock::time_point expiresAt, DisconnectProbe disconnectProbe = nullptr)
+        : expiresAt_(expiresAt), hasExpiry_(true), disconnectProbe_(std::move(disconnectProbe)) {}
+
+    /**
+     * @brief Без срока, но с проверкой отключения клиента
+     */
+    explicit RequestDeadline(DisconnectProbe disconnectProbe) : disconnectProbe_(std::move(disconnectProbe)) {}
+
+    /**
+     * @brief Есть ли у запроса срок
+     */
+    bool hasExpiry() const {
+        return hasExpiry_;
+    }
+
+    Clock::time_point getExpiresAt() const {
+        return expiresAt_;
+    }
+
+    /**
+     * @brief Оставшееся время (не меньше нуля); без срока - максимальное
+     */
+    std::chrono::milliseconds getRemaining(Clock::time_point now = Clock::now()) const {
+        if (!hasExpiry_) {
+            return std::chrono::milliseconds::max();
+        }
+        if (now >= expiresAt_) {
+            return std::chrono::milliseconds::zero();
+        }
+        return std::chrono::duration_cast<std::chrono::milliseconds>(expiresAt_ - now);
+    }
+
+    /**
+     * @brief Может ли запрос быть прерван (есть срок или проверка клиента)
+     */
+    bool isCancellable() const {
+        return hasExpiry_ || static_cast<bool>(disconnectProbe_);
+    }
+
+    bool hasDisconnectProbe() const {
+        return static_cast<bool>(disconnectProbe_);
+    }
+
+    bool isExpired(Clock::time_point now = Clock::now()) const {
+        return hasExpiry_ && now >= expiresAt_;
+    }
+
+    bool isClientDisconnected() const {
+        return disconnectProbe_ && disconnectProbe_();
+    }
+
+    /**
+     * @brief Нужно ли прервать запрос
+     */
+    bool shouldCancel(Clock::time_point now = Clock::now()) const {
+        return isExpired(now) || isClientDisconnected();
+    }
+
+    /**
+     * @brief Бросает RequestCancelledError, если запрос нужно прервать
+     */
+    void throwIfCancelled() const {
+        if (isExpired()) {
+            throw RequestCancelledError("Истёк срок выполнения запроса");
+        }
+        if (isClientDisconnected()) {
+            throw RequestCancelledError("Клиент отключился");
+        }
+    }
+
+    const DisconnectProbe& getDisconnectProbe() const {
+        return disconnectProbe_;
+    }
+
+    /**
+     * @brief Тот же срок с другой проверкой клиента (пустая - без проверки)
+     *
+     * Для работы, результат которой разделяют несколько запросов: её нужно
+     * прерывать, только когда отключились все их клиенты.
+     */
+    RequestDeadline withDisconnectProbe(DisconnectProbe disconnectProbe) const {
+        RequestDeadline deadline;
+        deadline.expiresAt_ = expiresAt_;
+        deadline.hasExpiry_ = hasExpiry_;
+        deadline.disconnectProbe_ = std::move(disconnectProbe);
+        return deadline;
+    }
+
+  private:
+    Clock::time_point expiresAt_;
+    bool hasExpiry_ = false;
+    DisconnectProbe disconnectProbe_;
+};
+} // namespace Core::Ports
@@ -0,0 +1,163 @@
+#include "SearchApi.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "../Infrastructure/Http/JsonWriter.h"
+#include "../Infrastructure/Http/QueryString.h"
+
+namespace {
+// Байт JSON на результат сверх длины URL и на поля ответа сверх длины запроса
+constexpr size_t RESULT_JSON_OVERHEAD = 64;
+constexpr size_t RESPONSE_JSON_OVERHEAD = 160;
+
+/**
+ * @brief Разбирает неотрицательное целое значение параметра
+ * @return Значение, defaultValue, если параметра нет, или nullopt, если он некорректен
+ */
+std::optional<size_t> parseSize(const std::optional<std::string>& parameter, size_t defaultValue) {
+    if (!parameter.has_value()) {
+        return defaultValue;
+    }
+
+    size_t value = 0;
+    const char* end = parameter->data() + parameter->size();
+    const auto [ptr, errc] = std::from_chars(parameter->data(), end, value);
+    if (errc != std::errc() || ptr != end || parameter->empty()) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/**
+ * @brief Пишет поля ответа, общие для JSON и NDJSON
+ */
+void writeSummary(Infrastructure::Http::JsonWriter& json,
+                  std::string_view query,
+                  size_t offset,
+                  size_t limit,
+                  const Core::DTO::SearchHitsDTO& hits,
+                  double tookMs) {
+    json.key("query").value(query);
+    json.key("offset").value(offset);
+    json.key("limit").value(limit);
+    json.key("total").value(hits.totalHits);
+    json.key("total_exact").value(hits.totalIsExact);
+    json.key("took_ms").value(tookMs, 4);
+}
+
+void writeResult(Infrastructure::Http::JsonWriter& json, const Core::Domain::Model::SearchResult& result) {
+    json.beginObject();
+    json.key("id").value(result.getDocumentId());
+    json.key("url").value(result.getUrl());
+    json.key("relevance").value(result.getRelevance());
+    json.endObject();
+}
+} // namespace
+
+SearchApi::SearchApi(std::shared_ptr<Core::Application::UseCases::SearchDocumentsUseCase> searchDocumentsUseCase,
+                     size_t defaultLimit,
+                     size_t maxResults,
+                     const std::shared_ptr<Core::Ports::IMetricsRegistry>& metrics)
+    : searchDocumentsUseCase_(std::move(searchDocumentsUseCase)),
+      defaultLimit_(defaultLimit),
+      maxResults_(maxResults),
+      // Те же этапы, что у HTML-страниц: отрисовка здесь - запись JSON
+      queryParseLatency_(
+          Core::Application::UseCases::SearchDocumentsUseCase::getStageLatency(metrics.get(), "query_parse")),
+      renderLatency_(
+          Core::Application::UseCases::SearchDocumentsUseCase::getStageLatency(metrics.get(), "render")) {}
+
+Core::Ports::HttpResponse SearchApi::handle(const Core::Ports::HttpRequestView& request) const {
+    const auto startedAt = std::chrono::steady_clock::now();
+    const std::string_view parameters = Infrastructure::Http::getQueryString(request.target);
+
+    const auto queryString = Infrastructure::Http::findQueryParameter(parameters, "q");
+    if (!queryString.has_value() || queryString->empty()) {
+        return error("Missing query parameter q", 400);
+    }
+
+    const auto limit = parseSize(Infrastructure::Http::findQueryParameter(parameters, "limit"), defaultLimit_);
+    const auto offset = parseSize(Infrastructure::Http::findQueryParameter(parameters, "offset"), 0);
+    if (!limit.has_value() || *limit == 0 || !offset.has_value()) {
+        return error("limit must be a positive integer and offset a non-negative integer", 400);
+    }
+    if (*limit > maxResults_ || *offset > maxResults_ - *limit) {
+        return error("offset + limit must not exceed " + std::to_string(maxResults_), 400);
+    }
+
+    const auto format = Infrastructure::Http::findQueryParameter(parameters, "format");
+    if (format.has_value() && *format != "json" && *format != "ndjson") {
+        return error("format must be json or ndjson", 400);
+    }
+    const bool ndjson = format.has_value()
+                            ? *format == "ndjson"
+                            : request.getHeader("Accept").find("application/x-ndjson") != std::string_view::npos;
+
+    std::optional<Core::Domain::ValueObject::SearchQuery> searchQuery;
+    {
+        Core::Ports::ScopedLatency latency(queryParseLatency_);
+        searchQuery = Core::Domain::ValueObject::SearchQuery::create(*queryString);
+    }
+    if (!searchQuery.has_value()) {
+        return error("Invalid query: at most 4 words separated by spaces", 400);
+    }
+
+    // Окно [offset, offset + limit) берётся из выдачи размера offset + limit
+    const auto hits =
+        searchDocumentsUseCase_->executeWithTotal(searchQuery.value(), *offset + *limit, request.deadline);
+    const double tookMs =
+        std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startedAt).count();
+
+    const auto first = hits.results.begin() + static_cast<ptrdiff_t>(std::min(*offset, hits.results.size()));
+    const auto last = hits.results.end();
+
+    Core::Ports::ScopedLatency renderTime(renderLatency_);
+
+    // Тело пишется один раз в заранее выделенную строку нужного размера
+    size_t estimatedSize = RESPONSE_JSON_OVERHEAD + queryString->size();
+    for (auto it = first; it != last; ++it) {
+        estimatedSize += RESULT_JSON_OVERHEAD + it->getUrl().size();
+    }
+
+    std::string body;
+    body.reserve(estimatedSize);
+    Infrastructure::Http::JsonWriter json(body);
+
+    if (ndjson) {
+        json.beginObject();
+        writeSummary(json, *queryString, *offset, *limit, hits, tookMs);
+        json.endObject().newline();
+
+        for (auto it = first; it != last; ++it) {
+            writeResult(json, *it);
+            json.newline();
+        }
+
+        auto response = Core::Ports::HttpResponse::json(std::move(body));
+        response.setHeader("Content-Type", "application/x-ndjson");
+        return response;
+    }
+
+    json.beginObject();
+    writeSummary(json, *queryString, *offset, *limit, hits, tookMs);
+    json.key("results").beginArray();
+    for (auto it = first; it != last; ++it) {
+        writeResult(json, *it);
+    }
+    json.endArray();
+    json.endObject();
+
+    return Core::Ports::HttpResponse::json(std::move(body));
+}
+
+Core::Ports::HttpResponse SearchApi::error(std::string_view message, int status) {
+    std::string body;
+    Infrastructure::Http::JsonWriter json(body);
+    json.beginObject().key("error").value(message).endObject();
+    return Core::Ports::HttpResponse::json(std::move(body), status);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+
+#include "../Core/Application/UseCases/SearchDocumentsUseCase.h"
+#include "../Core/Ports/IHttpServer.h"
+#include "../Core/Ports/IMetricsRegistry.h"
+
+/**
+ * @brief JSON API поиска: GET /api/search?q=...&limit=...&offset=...
+ *
+ * Ответ - объект с запросом, окном выдачи, количеством найденных документов
+ * (total и признак total_exact), временем поиска и массивом results.
+ * С format=ndjson (или Accept: application/x-ndjson) ответ - NDJSON: первая
+ * строка - те же поля без results, далее по строке на результат.
+ *
+ * JSON пишется потоково прямо в тело ответа, ёмкость которого оценивается
+ * заранее по URL выдачи; тело затем перемещается в буфер сервера без копирования.
+ */
+class SearchApi {
+  public:
+    /**
+     * @brief Конструктор
+     * @param searchDocumentsUseCase Use Case поиска
+     * @param defaultLimit Размер выдачи, если limit не указан
+     * @param maxResults Наибольшее offset + limit
+     * @param metrics Реестр метрик этапов поиска (nullptr - без метрик)
+     */
+    SearchApi(std::shared_ptr<Core::Application::UseCases::SearchDocumentsUseCase> searchDocumentsUseCase,
+              size_t defaultLimit,
+              size_t maxResults,
+              const std::shared_ptr<Core::Ports::IMetricsRegistry>& metrics = nullptr);
+
+    /**
+     * @brief Обрабатывает запрос к /api/search
+     */
+    Core::Ports::HttpResponse handle(const Core::Ports::HttpRequestView& request) const;
+
+    /**
+     * @brief Ответ API с ошибкой: {"error": message}
+     */
+    static Core::Ports::HttpResponse error(std::string_view message, int status);
+
+  private:
+    std::shared_ptr<Core::Application::UseCases::SearchDocumentsUseCase> searchDocumentsUseCase_;
+    size_t defaultLimit_;
+    size_t maxResults_;
+    Core::Ports::ILatencyHistogram* queryParseLatency_ = nullptr;
+    Core::Ports::ILatencyHistogram* renderLatency_ = nullptr;
+};
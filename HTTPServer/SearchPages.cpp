@@ -0,0 +1,264 @@
+#include "SearchPages.h"
+
+#include <charconv>
+
+namespace {
+// Форма поиска
+constexpr std::string_view SEARCH_FORM_HTML = R"(<!DOCTYPE html>
+<html lang="ru">
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+    <title>Поисковая система</title>
+    <style>
+        body {
+            font-family: Arial, sans-serif;
+            max-width: 800px;
+            margin: 50px auto;
+            padding: 20px;
+        }
+        h1 {
+            color: #333;
+            text-align: center;
+        }
+        .search-box {
+            text-align: center;
+            margin-top: 50px;
+        }
+        input[type="text"] {
+            width: 60%;
+            padding: 12px;
+            font-size: 16px;
+            border: 1px solid #ddd;
+            border-radius: 4px;
+        }
+        button {
+            padding: 12px 30px;
+            font-size: 16px;
+            background-color: #4CAF50;
+            color: white;
+            border: none;
+            border-radius: 4px;
+            cursor: pointer;
+            margin-left: 10px;
+        }
+        button:hover {
+            background-color: #45a049;
+        }
+        .info {
+            text-align: center;
+            margin-top: 20px;
+            color: #666;
+            font-size: 14px;
+        }
+    </style>
+</head>
+<body>
+    <h1>Поисковая система</h1>
+    <div class="search-box">
+        <form method="GET" action="/search">
+            <input type="text" name="query" placeholder="Введите поисковый запрос..." autofocus>
+            <button type="submit">Найти</button>
+        </form>
+    </div>
+    <div class="info">
+        <p>Максимум 4 слова в запросе</p>
+    </div>
+</body>
+</html>)";
+
+// Начало страницы результатов: стили и форма повторного поиска
+constexpr std::string_view RESULTS_HEADER_HTML = R"(<!DOCTYPE html>
+<html lang="ru">
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+    <title>Результаты поиска: {{query}}</title>
+    <style>
+        body {
+            font-family: Arial, sans-serif;
+            max-width: 800px;
+            margin: 50px auto;
+            padding: 20px;
+        }
+        h1 {
+            color: #333;
+        }
+        .search-again {
+            margin-bottom: 30px;
+        }
+        input[type="text"] {
+            width: 60%;
+            padding: 12px;
+            font-size: 16px;
+            border: 1px solid #ddd;
+            border-radius: 4px;
+        }
+        button {
+            padding: 12px 30px;
+            font-size: 16px;
+            background-color: #4CAF50;
+            color: white;
+            border: none;
+            border-radius: 4px;
+            cursor: pointer;
+            margin-left: 10px;
+        }
+        button:hover {
+            background-color: #45a049;
+        }
+        .result {
+            margin-bottom: 25px;
+            padding: 15px;
+            background-color: #f9f9f9;
+            border-radius: 4px;
+        }
+        .result-title {
+            font-size: 18px;
+            margin-bottom: 5px;
+        }
+        .result-title a {
+            color: #1a0dab;
+            text-decoration: none;
+        }
+        .result-title a:hover {
+            text-decoration: underline;
+        }
+        .result-relevance {
+            color: #666;
+            font-size: 14px;
+        }
+        .no-results {
+            text-align: center;
+            color: #666;
+            margin-top: 50px;
+            font-size: 18px;
+        }
+        .results-info {
+            color: #666;
+            margin-bottom: 20px;
+        }
+    </style>
+</head>
+<body>
+    <h1>Результаты поиска</h1>
+    <div class="search-again">
+        <form method="GET" action="/search">
+            <input type="text" name="query" value="{{query}}" autofocus>
+            <button type="submit">Найти</button>
+        </form>
+    </div>
+)";
+
+// Количество найденных документов
+constexpr std::string_view RESULTS_INFO_HTML = R"(    <div class="results-info">Найдено результатов: {{count}}</div>
+)";
+
+// Один результат поиска
+constexpr std::string_view RESULT_ITEM_HTML = R"(    <div class="result">
+        <div class="result-title"><a href="{{url}}" target="_blank">{{url}}</a></div>
+        <div class="result-relevance">Релевантность: {{relevance}}</div>
+    </div>
+)";
+
+// Сообщение о пустой выдаче
+constexpr std::string_view NO_RESULTS_HTML = R"(
+    <div class="no-results">
+        <p>По вашему запросу ничего не найдено.</p>
+        <p>Попробуйте изменить запрос.</p>
+    </div>
+)";
+
+// Конец страницы результатов
+constexpr std::string_view RESULTS_FOOTER_HTML = R"(
+</body>
+</html>)";
+
+// Страница ошибки
+constexpr std::string_view ERROR_HTML = R"(<!DOCTYPE html>
+<html lang="ru">
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+    <title>Ошибка</title>
+    <style>
+        body {
+            font-family: Arial, sans-serif;
+            max-width: 800px;
+            margin: 50px auto;
+            padding: 20px;
+            text-align: center;
+        }
+        h1 {
+            color: #d32f2f;
+        }
+        .error-message {
+            background-color: #ffebee;
+            padding: 20px;
+            border-radius: 4px;
+            margin: 30px 0;
+            color: #c62828;
+        }
+        a {
+            color: #1a0dab;
+            text-decoration: none;
+        }
+        a:hover {
+            text-decoration: underline;
+        }
+    </style>
+</head>
+<body>
+    <h1>Ошибка</h1>
+    <div class="error-message">
+        <p>{{message}}</p>
+    </div>
+    <p><a href="/">Вернуться к поиску</a></p>
+</body>
+</html>)";
+} // namespace
+
+SearchPages::SearchPages()
+    : searchForm_(Core::Ports::HttpResponse::html(std::string(SEARCH_FORM_HTML))),
+      resultsHeader_(RESULTS_HEADER_HTML, {"query"}),
+      resultsInfo_(RESULTS_INFO_HTML, {"count"}),
+      resultItem_(RESULT_ITEM_HTML, {"url", "relevance"}),
+      noResults_(NO_RESULTS_HTML),
+      resultsFooter_(RESULTS_FOOTER_HTML),
+      errorPage_(ERROR_HTML, {"message"}) {}
+
+Core::Ports::HttpResponse SearchPages::searchForm(const Core::Ports::HttpRequestView& request) const {
+    return searchForm_.respond(request);
+}
+
+std::string SearchPages::renderSearchResults(const std::vector<Core::Domain::Model::SearchResult>& results,
+                                             std::string_view query) const {
+    Infrastructure::Http::RenderBuffer buffer;
+    std::string& html = buffer.get();
+
+    resultsHeader_.render(html, {query});
+
+    if (results.empty()) {
+        noResults_.render(html);
+    } else {
+        char count[24];
+        const auto countEnd = std::to_chars(count, count + sizeof(count), results.size()).ptr;
+        resultsInfo_.render(html, {std::string_view(count, countEnd - count)});
+
+        for (const auto& result : results) {
+            char relevance[16];
+            const auto relevanceEnd =
+                std::to_chars(relevance, relevance + sizeof(relevance), result.getRelevance()).ptr;
+            resultItem_.render(html, {result.getUrl(), std::string_view(relevance, relevanceEnd - relevance)});
+        }
+    }
+
+    resultsFooter_.render(html);
+    return buffer.take();
+}
+
+std::string SearchPages::renderError(std::string_view errorMessage) const {
+    Infrastructure::Http::RenderBuffer buffer;
+    errorPage_.render(buffer.get(), {errorMessage});
+    return buffer.take();
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../Core/Domain/Model/SearchResult.h"
+#include "../Core/Ports/IHttpServer.h"
+#include "../Infrastructure/Http/HtmlTemplate.h"
+#include "../Infrastructure/Http/StaticResponse.h"
+
+/**
+ * @brief HTML-страницы поискового сервера
+ *
+ * Шаблоны страниц разбираются один раз при создании объекта; отрисовка
+ * дописывает фрагменты и экранированные значения в буфер из пула потока.
+ * Форма поиска не меняется и отдаётся готовым ответом с ETag.
+ *
+ * Объект неизменяем после создания, его можно использовать из всех потоков сервера.
+ */
+class SearchPages {
+  public:
+    SearchPages();
+
+    /**
+     * @brief Ответ с формой поиска (304, если у клиента та же версия)
+     */
+    Core::Ports::HttpResponse searchForm(const Core::Ports::HttpRequestView& request) const;
+
+    /**
+     * @brief Отрисовывает страницу с результатами поиска
+     */
+    std::string renderSearchResults(const std::vector<Core::Domain::Model::SearchResult>& results,
+                                    std::string_view query) const;
+
+    /**
+     * @brief Отрисовывает страницу с сообщением об ошибке
+     */
+    std::string renderError(std::string_view errorMessage) const;
+
+  private:
+    Infrastructure::Http::StaticResponse searchForm_;
+    Infrastructure::Http::HtmlTemplate resultsHeader_;
+    Infrastructure::Http::HtmlTemplate resultsInfo_;
+    Infrastructure::Http::HtmlTemplate resultItem_;
+    Infrastructure::Http::HtmlTemplate noResults_;
+    Infrastructure::Http::HtmlTemplate resultsFooter_;
+    Infrastructure::Http::HtmlTemplate errorPage_;
+};
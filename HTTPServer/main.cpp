@@ -1,347 +1,151 @@
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 
 #include <windows.h>
 
 #include "../HTTPServerData/DIContainer.h"
 #include "../Core/Ports/IHttpServer.h"
+#include "../Infrastructure/Http/QueryString.h"
+#include "../Infrastructure/Http/ResponseCompressor.h"
+#include "../Infrastructure/Logging/Logger.h"
+#include "SearchApi.h"
+#include "SearchPages.h"
 
 /**
- * @brief Генерирует HTML-страницу с формой поиска
+ * @brief Парсит URL query string для извлечения параметра query
+ * @param target URL path with query string (e.g., "/search?query=test")
+ * @return Extracted and decoded query parameter
  */
-std::string generateSearchFormHtml() {
-    return R"(<!DOCTYPE html>
-<html lang="ru">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Поисковая система</title>
-    <style>
-        body {
-            font-family: Arial, sans-serif;
-            max-width: 800px;
-            margin: 50px auto;
-            padding: 20px;
-        }
-        h1 {
-            color: #333;
-            text-align: center;
-        }
-        .search-box {
-            text-align: center;
-            margin-top: 50px;
-        }
-        input[type="text"] {
-            width: 60%;
-            padding: 12px;
-            font-size: 16px;
-            border: 1px solid #ddd;
-            border-radius: 4px;
-        }
-        button {
-            padding: 12px 30px;
-            font-size: 16px;
-            background-color: #4CAF50;
-            color: white;
-            border: none;
-            border-radius: 4px;
-            cursor: pointer;
-            margin-left: 10px;
-        }
-        button:hover {
-            background-color: #45a049;
-        }
-        .info {
-            text-align: center;
-            margin-top: 20px;
-            color: #666;
-            font-size: 14px;
-        }
-    </style>
-</head>
-<body>
-    <h1>Поисковая система</h1>
-    <div class="search-box">
-        <form method="GET" action="/search">
-            <input type="text" name="query" placeholder="Введите поисковый запрос..." autofocus>
-            <button type="submit">Найти</button>
-        </form>
-    </div>
-    <div class="info">
-        <p>Максимум 4 слова в запросе</p>
-    </div>
-</body>
-</html>)";
+std::string parseQueryFromUrl(std::string_view target) {
+    return Infrastructure::Http::findQueryParameter(Infrastructure::Http::getQueryString(target), "query")
+        .value_or("");
 }
 
 /**
- * @brief Генерирует HTML-страницу с результатами поиска
+ * @brief Формирует текстовый отчёт о кеше результатов поиска
  */
-std::string generateSearchResultsHtml(const std::vector<Core::Domain::Model::SearchResult>& results,
-                                      const std::string& query) {
-    std::ostringstream html;
-
-    html << R"(<!DOCTYPE html>
-<html lang="ru">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Результаты поиска: )" << query
-         << R"(</title>
-    <style>
-        body {
-            font-family: Arial, sans-serif;
-            max-width: 800px;
-            margin: 50px auto;
-            padding: 20px;
-        }
-        h1 {
-            color: #333;
-        }
-        .search-again {
-            margin-bottom: 30px;
-        }
-        input[type="text"] {
-            width: 60%;
-            padding: 12px;
-            font-size: 16px;
-            border: 1px solid #ddd;
-            border-radius: 4px;
-        }
-        button {
-            padding: 12px 30px;
-            font-size: 16px;
-            background-color: #4CAF50;
-            color: white;
-            border: none;
-            border-radius: 4px;
-            cursor: pointer;
-            margin-left: 10px;
-        }
-        button:hover {
-            background-color: #45a049;
-        }
-        .result {
-            margin-bottom: 25px;
-            padding: 15px;
-            background-color: #f9f9f9;
-            border-radius: 4px;
-        }
-        .result-title {
-            font-size: 18px;
-            margin-bottom: 5px;
-        }
-        .result-title a {
-            color: #1a0dab;
-            text-decoration: none;
-        }
-        .result-title a:hover {
-            text-decoration: underline;
-        }
-        .result-relevance {
-            color: #666;
-            font-size: 14px;
-        }
-        .no-results {
-            text-align: center;
-            color: #666;
-            margin-top: 50px;
-            font-size: 18px;
-        }
-        .results-info {
-            color: #666;
-            margin-bottom: 20px;
-        }
-    </style>
-</head>
-<body>
-    <h1>Результаты поиска</h1>
-    <div class="search-again">
-        <form method="GET" action="/search">
-            <input type="text" name="query" value=")" << query
-         << R"(" autofocus>
-            <button type="submit">Найти</button>
-        </form>
-    </div>
-)";
-
-    if (results.empty()) {
-        html << R"(
-    <div class="no-results">
-        <p>По вашему запросу ничего не найдено.</p>
-        <p>Попробуйте изменить запрос.</p>
-    </div>
-)";
-    } else {
-        html << "    <div class=\"results-info\">Найдено результатов: " << results.size() << "</div>\n";
-
-        for (const auto& result : results) {
-            html << "    <div class=\"result\">\n"
-                 << "        <div class=\"result-title\"><a href=\"" << result.getUrl() << "\" target=\"_blank\">"
-                 << result.getUrl() << "</a></div>\n"
-                 << "        <div class=\"result-relevance\">Релевантность: " << result.getRelevance()
-                 << "</div>\n"
-                 << "    </div>\n";
-        }
+std::string generateCacheStatisticsText(const std::optional<Core::Ports::SearchCacheStatistics>& statistics) {
+    if (!statistics.has_value()) {
+        return "Кеш результатов выключен\n";
     }
 
-    html << R"(
-</body>
-</html>)";
+    const double savedMs = std::chrono::duration<double, std::milli>(statistics->savedLatency).count();
+
+    std::ostringstream text;
+    text << "Попадания: " << statistics->hits << "\n"
+         << "Промахи: " << statistics->misses << "\n"
+         << "Доля попаданий: " << std::fixed << std::setprecision(4) << statistics->getHitRatio() << "\n"
+         << "Сброшено (поколение индекса или TTL): " << statistics->invalidations << "\n"
+         << "Вытеснено: " << statistics->evictions << "\n"
+         << "Записей: " << statistics->entries << "\n"
+         << "Объём, байт: " << statistics->bytes << "\n"
+         << "Сэкономлено времени поиска, мс: " << std::setprecision(3) << savedMs << "\n";
+    return text.str();
+}
+
+/**
+ * @brief Формирует текстовый отчёт об объединении одинаковых поисков
+ */
+std::string generateCoalescingStatisticsText(
+    const std::optional<Core::Application::SingleFlightStatistics>& statistics) {
+    if (!statistics.has_value()) {
+        return "Объединение одинаковых поисков выключено\n";
+    }
 
-    return html.str();
+    std::ostringstream text;
+    text << "Поисков выполнено: " << statistics->executions << "\n"
+         << "Поисков объединено: " << statistics->shared << "\n"
+         << "Не дождались одинакового поиска: " << statistics->timeouts << "\n";
+    return text.str();
 }
 
 /**
- * @brief Генерирует HTML-страницу с сообщением об ошибке
+ * @brief Формирует текстовый отчёт об отрисовке HTML-страниц
  */
-std::string generateErrorHtml(const std::string& errorMessage) {
-    std::ostringstream html;
-
-    html << R"(<!DOCTYPE html>
-<html lang="ru">
-<head>
-    <meta charset="UTF-8">
-    <meta name="viewport" content="width=device-width, initial-scale=1.0">
-    <title>Ошибка</title>
-    <style>
-        body {
-            font-family: Arial, sans-serif;
-            max-width: 800px;
-            margin: 50px auto;
-            padding: 20px;
-            text-align: center;
-        }
-        h1 {
-            color: #d32f2f;
-        }
-        .error-message {
-            background-color: #ffebee;
-            padding: 20px;
-            border-radius: 4px;
-            margin: 30px 0;
-            color: #c62828;
-        }
-        a {
-            color: #1a0dab;
-            text-decoration: none;
-        }
-        a:hover {
-            text-decoration: underline;
-        }
-    </style>
-</head>
-<body>
-    <h1>Ошибка</h1>
-    <div class="error-message">
-        <p>)" << errorMessage
-         << R"(</p>
-    </div>
-    <p><a href="/">Вернуться к поиску</a></p>
-</body>
-</html>)";
-
-    return html.str();
+std::string generateRenderStatisticsText(const Infrastructure::Http::RenderStatistics& statistics) {
+    const double averageUs = std::chrono::duration<double, std::micro>(statistics.getAverageRenderTime()).count();
+
+    std::ostringstream text;
+    text << "Страниц отрисовано: " << statistics.renders << "\n"
+         << "Среднее время отрисовки, мкс: " << std::fixed << std::setprecision(2) << averageUs << "\n"
+         << "Выделений памяти на страницу: " << statistics.getAllocationsPerRender() << "\n"
+         << "Отрисовок с ростом буфера: " << statistics.bufferGrowths << "\n";
+    return text.str();
 }
 
 /**
- * @brief URL-декодирование строки
- * @param encoded Закодированная строка
- * @return Раскодированная строка
+ * @brief Формирует текстовый отчёт об отправленных телах ответов и их сжатии
  */
-std::string urlDecode(const std::string& encoded) {
-    std::string decoded;
-    for (size_t i = 0; i < encoded.length(); ++i) {
-        if (encoded[i] == '+') {
-            decoded += ' ';
-        } else if (encoded[i] == '%' && i + 2 < encoded.length()) {
-            // Декодирование процентно-кодированных символов
-            // Простая реализация для основных случаев (%20, %D0, %D1 для UTF-8)
-            std::string hex = encoded.substr(i + 1, 2);
-            try {
-                int value = std::stoi(hex, nullptr, 16);
-                decoded += static_cast<char>(value);
-                i += 2;
-            } catch (...) {
-                // Если не удалось декодировать - оставляем как есть
-                decoded += encoded[i];
-            }
-        } else {
-            decoded += encoded[i];
-        }
-    }
-    return decoded;
+std::string generateCompressionStatisticsText(const Infrastructure::Http::CompressionStatistics& statistics) {
+    const double compressionMs = std::chrono::duration<double, std::milli>(statistics.compressionTime).count();
+
+    std::ostringstream text;
+    text << "Ответов отправлено: " << statistics.responses << "\n"
+         << "Отправлено байт тела: " << statistics.bytesOut << "\n"
+         << "Сжато при отправке: " << statistics.compressedResponses << "\n"
+         << "Байт до сжатия: " << statistics.compressedBytesIn << "\n"
+         << "Байт после сжатия: " << statistics.compressedBytesOut << "\n"
+         << "Степень сжатия: " << std::fixed << std::setprecision(3) << statistics.getCompressionRatio() << "\n"
+         << "Время сжатия, мс: " << compressionMs << "\n";
+    return text.str();
 }
 
 /**
- * @brief Парсит URL query string для извлечения параметра query
- * @param target URL path with query string (e.g., "/search?query=test")
- * @return Extracted and decoded query parameter
+ * @brief Формирует текстовый отчёт о контроле допуска и ограничении частоты поисков
  */
-std::string parseQueryFromUrl(const std::string& target) {
-    // Ищем начало query string
-    size_t queryStart = target.find('?');
-    if (queryStart == std::string::npos) {
-        return "";
+std::string generateAdmissionStatisticsText(const Core::Application::AdmissionController* admission,
+                                            const Core::Application::ClientRateLimiter* rateLimiter) {
+    std::ostringstream text;
+    if (admission != nullptr) {
+        const auto statistics = admission->getStatistics();
+        text << "Поисков допущено: " << statistics.admitted << "\n"
+             << "Допущено после ожидания: " << statistics.queued << "\n"
+             << "Отказано (очередь заполнена): " << statistics.rejectedQueueFull << "\n"
+             << "Отказано (истекло ожидание): " << statistics.rejectedTimeout << "\n"
+             << "Выполняется: " << statistics.active << "\n"
+             << "Ожидает: " << statistics.waiting << "\n";
+    } else {
+        text << "Ограничение одновременных поисков выключено\n";
     }
 
-    // Ищем параметр query=
-    const std::string prefix = "query=";
-    size_t queryPos = target.find(prefix, queryStart);
-    if (queryPos == std::string::npos) {
-        return "";
+    if (rateLimiter != nullptr) {
+        text << "Отказано по частоте запросов с IP: " << rateLimiter->getRejectedCount() << "\n";
+    } else {
+        text << "Ограничение частоты запросов с IP выключено\n";
     }
+    return text.str();
+}
 
-    // Извлекаем значение до следующего & или до конца строки
-    size_t valueStart = queryPos + prefix.length();
-    size_t valueEnd = target.find('&', valueStart);
-    std::string query = (valueEnd == std::string::npos)
-        ? target.substr(valueStart)
-        : target.substr(valueStart, valueEnd - valueStart);
-
-    return urlDecode(query);
+/**
+ * @brief Ответ на поиск, в котором отказано из-за нагрузки
+ * @param status 429 (превышена частота запросов клиента) или 503 (сервер перегружен)
+ */
+Core::Ports::HttpResponse makeRejectionResponse(const SearchPages& pages, bool api, int status,
+                                                std::chrono::seconds retryAfter) {
+    const bool tooManyRequests = status == 429;
+
+    Core::Ports::HttpResponse response =
+        api ? SearchApi::error(tooManyRequests ? "Too many requests" : "Server is overloaded", status)
+            : Core::Ports::HttpResponse::html(
+                  pages.renderError(tooManyRequests ? "Слишком много запросов. Повторите позже."
+                                                    : "Сервер перегружен. Повторите позже."),
+                  status);
+    response.setHeader("Retry-After", std::to_string(retryAfter.count()));
+    return response;
 }
 
 /**
  * @brief Парсит тело POST-запроса для извлечения параметра query
  */
-std::string parseQueryFromBody(const std::string& body) {
+std::string parseQueryFromBody(std::string_view body) {
     // Формат: query=search+terms или query=search%20terms
-    const std::string prefix = "query=";
-    size_t pos = body.find(prefix);
-
-    if (pos == std::string::npos) {
-        return "";
-    }
-
-    std::string query = body.substr(pos + prefix.length());
-
-    // Находим конец значения (до & или конца строки)
-    size_t endPos = query.find('&');
-    if (endPos != std::string::npos) {
-        query = query.substr(0, endPos);
-    }
-
-    // URL-декодирование: заменяем + на пробелы
-    std::string decoded;
-    for (size_t i = 0; i < query.length(); ++i) {
-        if (query[i] == '+') {
-            decoded += ' ';
-        } else if (query[i] == '%' && i + 2 < query.length()) {
-            // Простое декодирование %20 -> пробел
-            if (query.substr(i, 3) == "%20") {
-                decoded += ' ';
-                i += 2;
-            } else {
-                decoded += query[i];
-            }
-        } else {
-            decoded += query[i];
-        }
-    }
-
-    return decoded;
+    return Infrastructure::Http::findQueryParameter(body, "query").value_or("");
 }
 
 int main(int argc, char* argv[]) {
@@ -371,20 +175,103 @@ int main(int argc, char* argv[]) {
 
         std::cout << "Порт HTTP-сервера: " << port << std::endl;
         std::cout << "Максимум результатов: " << maxResults << std::endl;
+        std::cout << "Поисковый движок: " << config->getHttpServerSearchBackend() << std::endl;
+        if (config->getHttpServerSearchBackend() == "mmap") {
+            std::cout << "Файл индекса: " << config->getHttpServerIndexFile() << std::endl;
+        }
+        if (config->getHttpServerCacheMaxBytes() > 0) {
+            std::cout << "Кеш результатов, байт: " << config->getHttpServerCacheMaxBytes() << std::endl;
+        } else {
+            std::cout << "Кеш результатов выключен" << std::endl;
+        }
         std::cout << std::endl;
 
         // Получаем зависимости
         auto searchDocumentsUseCase = container.getSearchDocumentsUseCase();
         auto httpServer = container.getHttpServer();
+        auto searchAdmission = container.getSearchAdmission();
+        auto rateLimiter = container.getClientRateLimiter();
+        auto metrics = container.getMetricsRegistry();
+
+        if (searchAdmission != nullptr) {
+            const int maxConcurrentSearches = config->getHttpServerMaxConcurrentSearches();
+            const int searchQueueSize = std::max(config->getHttpServerSearchQueueSize(), 0);
+            std::cout << "Одновременных поисков: " << maxConcurrentSearches << ", в очереди: " << searchQueueSize
+                      << std::endl;
+            // Ожидание в очереди блокирует поток сервера до search_queue_interval_ms
+            if (static_cast<unsigned int>(maxConcurrentSearches + searchQueueSize) >=
+                container.getHttpServerThreadCount()) {
+                std::cout << "ВНИМАНИЕ: max_concurrent_searches + search_queue_size не меньше числа потоков "
+                             "сервера - при перегрузке выполняемые и ожидающие поиски займут все потоки"
+                          << std::endl;
+            }
+        }
+        if (rateLimiter != nullptr) {
+            std::cout << "Поисков в секунду с одного IP: " << config->getHttpServerRateLimitPerIp() << std::endl;
+        }
+
+        // Шаблоны страниц разбираются один раз, до запуска сервера
+        const auto pages = std::make_shared<const SearchPages>();
+        const auto searchApi = std::make_shared<const SearchApi>(
+            searchDocumentsUseCase, maxResults, static_cast<size_t>(config->getHttpServerApiMaxResults()),
+            metrics);
+
+        // Этапы поиска вне Use Case (nullptr, если метрики выключены; реестр держит DI контейнер)
+        using Core::Application::UseCases::SearchDocumentsUseCase;
+        Core::Ports::ILatencyHistogram* queryParseLatency =
+            SearchDocumentsUseCase::getStageLatency(metrics.get(), "query_parse");
+        Core::Ports::ILatencyHistogram* renderLatency =
+            SearchDocumentsUseCase::getStageLatency(metrics.get(), "render");
 
         // Обработчик HTTP-запросов
-        auto requestHandler = [searchDocumentsUseCase, maxResults](const std::string& method,
-                                                                    const std::string& target,
-                                                                    const std::string& body) -> Core::Ports::HttpResponse {
+        auto requestHandler = [searchDocumentsUseCase, maxResults, pages, searchApi, searchAdmission, rateLimiter,
+                               queryParseLatency, renderLatency](
+                                  const Core::Ports::HttpRequestView& request) -> Core::Ports::HttpResponse {
+            const std::string_view method = request.method;
+            const std::string_view target = request.target;
+            const std::string_view path = target.substr(0, target.find('?'));
+            const bool apiSearch = method == "GET" && path == "/api/search";
+
             try {
+                // Поиск - единственная дорогая операция: при перегрузке лучше быстро отказать
+                // части запросов, чем отвечать всем с растущей задержкой
+                const bool search = apiSearch || (method == "GET" && target.find("/search") == 0) ||
+                                    (method == "POST" && target == "/search");
+                Core::Application::AdmissionController::Ticket searchTicket;
+
+                if (search) {
+                    if (rateLimiter != nullptr && !rateLimiter->tryAcquire(request.remoteAddress)) {
+                        return makeRejectionResponse(*pages, apiSearch, 429, rateLimiter->getRetryAfter());
+                    }
+                    if (searchAdmission != nullptr) {
+                        // Разрешение удерживается до конца обработки запроса
+                        searchTicket = searchAdmission->acquire();
+                        if (!searchTicket) {
+                            return makeRejectionResponse(*pages, apiSearch, 503, std::chrono::seconds(1));
+                        }
+                    }
+                }
+
                 // GET / - форма поиска
                 if (method == "GET" && target == "/") {
-                    return Core::Ports::HttpResponse::html(generateSearchFormHtml());
+                    return pages->searchForm(request);
+                }
+
+                // GET /stats - счётчики кеша результатов поиска
+                if (method == "GET" && target == "/stats") {
+                    using Infrastructure::Http::RenderBuffer;
+                    using Infrastructure::Http::ResponseCompressor;
+                    return Core::Ports::HttpResponse::text(
+                        generateCacheStatisticsText(searchDocumentsUseCase->getCacheStatistics()) + "\n" +
+                        generateCoalescingStatisticsText(searchDocumentsUseCase->getCoalescingStatistics()) +
+                        "\n" + generateRenderStatisticsText(RenderBuffer::getStatistics()) + "\n" +
+                        generateCompressionStatisticsText(ResponseCompressor::getStatistics()) + "\n" +
+                        generateAdmissionStatisticsText(searchAdmission.get(), rateLimiter.get()));
+                }
+
+                // GET /api/search?q=...&limit=...&offset=... - поиск в JSON или NDJSON
+                if (apiSearch) {
+                    return searchApi->handle(request);
                 }
 
                 // GET /search?query=... - выполнение поиска через GET
@@ -394,55 +281,80 @@ int main(int argc, char* argv[]) {
 
                     if (queryString.empty()) {
                         // Если нет параметра query - показываем форму
-                        return Core::Ports::HttpResponse::html(generateSearchFormHtml());
+                        return pages->searchForm(request);
                     }
 
                     // Создаём SearchQuery
-                    auto searchQuery = Core::Domain::ValueObject::SearchQuery::create(queryString);
+                    std::optional<Core::Domain::ValueObject::SearchQuery> searchQuery;
+                    {
+                        Core::Ports::ScopedLatency latency(queryParseLatency);
+                        searchQuery = Core::Domain::ValueObject::SearchQuery::create(queryString);
+                    }
 
                     if (!searchQuery.has_value()) {
                         return Core::Ports::HttpResponse::html(
-                            generateErrorHtml("Некорректный запрос. Максимум 4 слова, разделённых пробелами."), 400);
+                            pages->renderError("Некорректный запрос. Максимум 4 слова, разделённых пробелами."),
+                            400);
                     }
 
                     // Выполняем поиск
-                    auto results = searchDocumentsUseCase->execute(searchQuery.value(), maxResults);
+                    auto results =
+                        searchDocumentsUseCase->execute(searchQuery.value(), maxResults, request.deadline);
 
                     // Возвращаем HTML с результатами
-                    return Core::Ports::HttpResponse::html(generateSearchResultsHtml(results, queryString));
+                    Core::Ports::ScopedLatency renderTime(renderLatency);
+                    return Core::Ports::HttpResponse::html(pages->renderSearchResults(results, queryString));
                 }
 
                 // POST /search - выполнение поиска через POST
                 if (method == "POST" && target == "/search") {
                     // Извлекаем запрос из тела
-                    std::string queryString = parseQueryFromBody(body);
+                    std::string queryString = parseQueryFromBody(request.body);
 
                     if (queryString.empty()) {
-                        return Core::Ports::HttpResponse::html(generateErrorHtml("Пустой поисковый запрос"), 400);
+                        return Core::Ports::HttpResponse::html(pages->renderError("Пустой поисковый запрос"), 400);
                     }
 
                     // Создаём SearchQuery
-                    auto searchQuery = Core::Domain::ValueObject::SearchQuery::create(queryString);
+                    std::optional<Core::Domain::ValueObject::SearchQuery> searchQuery;
+                    {
+                        Core::Ports::ScopedLatency latency(queryParseLatency);
+                        searchQuery = Core::Domain::ValueObject::SearchQuery::create(queryString);
+                    }
 
                     if (!searchQuery.has_value()) {
                         return Core::Ports::HttpResponse::html(
-                            generateErrorHtml("Некорректный запрос. Максимум 4 слова, разделённых пробелами."), 400);
+                            pages->renderError("Некорректный запрос. Максимум 4 слова, разделённых пробелами."),
+                            400);
                     }
 
                     // Выполняем поиск
-                    auto results = searchDocumentsUseCase->execute(searchQuery.value(), maxResults);
+                    auto results =
+                        searchDocumentsUseCase->execute(searchQuery.value(), maxResults, request.deadline);
 
                     // Возвращаем HTML с результатами
-                    return Core::Ports::HttpResponse::html(generateSearchResultsHtml(results, queryString));
+                    Core::Ports::ScopedLatency renderTime(renderLatency);
+                    return Core::Ports::HttpResponse::html(pages->renderSearchResults(results, queryString));
                 }
 
                 // Неизвестный запрос
-                return Core::Ports::HttpResponse::html(generateErrorHtml("Страница не найдена"), 404);
+                return Core::Ports::HttpResponse::html(pages->renderError("Страница не найдена"), 404);
 
+            } catch (const Core::Ports::RequestCancelledError& e) {
+                // Срок истёк или клиент отключился (тогда ответ никто не прочитает)
+                LOG_WARNING("search", "Поиск прерван: ", e.what());
+                if (apiSearch) {
+                    return SearchApi::error("Search timed out", 504);
+                }
+                return Core::Ports::HttpResponse::html(
+                    pages->renderError("Поиск не уложился в отведённое время. Повторите позже."), 504);
             } catch (const std::exception& e) {
-                std::cerr << "Ошибка обработки запроса: " << e.what() << std::endl;
+                LOG_ERROR("search", "Ошибка обработки запроса: ", e.what());
+                if (apiSearch) {
+                    return SearchApi::error("Internal server error", 500);
+                }
                 return Core::Ports::HttpResponse::html(
-                    generateErrorHtml("Внутренняя ошибка сервера: " + std::string(e.what())), 500);
+                    pages->renderError("Внутренняя ошибка сервера: " + std::string(e.what())), 500);
             }
         };
 
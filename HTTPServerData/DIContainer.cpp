@@ -1,14 +1,81 @@
 #include "DIContainer.h"
 
+#include <algorithm>
+#include <chrono>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
 
+#include "../Infrastructure/Cache/PollingIndexGenerationRepository.h"
+#include "../Infrastructure/Cache/ShardedSearchResultCache.h"
 #include "../Infrastructure/Configuration/IniConfiguration.h"
 #include "../Infrastructure/Database/DatabaseConnection.h"
+#include "../Infrastructure/Database/PostgresIndexGenerationRepository.h"
+#include "../Infrastructure/Database/PostgresPackedWordRepository.h"
 #include "../Infrastructure/Database/PostgresWordRepository.h"
+#include "../Infrastructure/Database/QueryCancellationWatchdog.h"
 #include "../Infrastructure/Http/BoostBeastHttpServer.h"
+#include "../Infrastructure/Http/ResponseCompressor.h"
+#include "../Infrastructure/Index/InMemoryWordRepository.h"
+#include "../Infrastructure/Index/MappedIndex.h"
+#include "../Infrastructure/Index/PostgresIndexLoader.h"
+#include "../Infrastructure/Logging/Logger.h"
+#include "../Infrastructure/Metrics/MetricsRegistry.h"
 #include "../Infrastructure/Text/BoostLocaleTextProcessor.h"
+#include "../Infrastructure/Tracing/ChromeTraceWriter.h"
 
 namespace HTTPServerData {
+namespace {
+/**
+ * @brief Создаёт репозиторий слов для выбранного в конфигурации хранения постингов
+ */
+std::shared_ptr<Core::Ports::IWordRepository> createWordRepository(
+    const Core::Ports::IConfiguration& configuration,
+    std::shared_ptr<Infrastructure::Database::DatabaseConnection> dbConnection,
+    std::shared_ptr<Infrastructure::Database::QueryCancellationWatchdog> cancellationWatchdog) {
+    const std::string postingStorage = configuration.getDatabasePostingStorage();
+
+    if (postingStorage == "rows") {
+        return std::make_shared<Infrastructure::Database::PostgresWordRepository>(std::move(dbConnection),
+                                                                                  std::move(cancellationWatchdog));
+    }
+    if (postingStorage == "packed") {
+        return std::make_shared<Infrastructure::Database::PostgresPackedWordRepository>(
+            std::move(dbConnection), std::move(cancellationWatchdog));
+    }
+
+    throw std::runtime_error("Неизвестный posting_storage: " + postingStorage);
+}
+
+/**
+ * @brief Настройки журнала из конфигурации
+ */
+Infrastructure::Logging::LoggerSettings createLoggerSettings(const Core::Ports::IConfiguration& configuration) {
+    Infrastructure::Logging::LoggerSettings settings;
+    settings.level = Infrastructure::Logging::parseLogLevel(configuration.getLoggingLevel());
+    settings.format = Infrastructure::Logging::parseLogFormat(configuration.getLoggingFormat());
+    settings.threadBufferRecords = static_cast<size_t>(std::max(configuration.getLoggingBufferRecords(), 2));
+    settings.rateLimitPerSecond = static_cast<uint32_t>(std::max(configuration.getLoggingRateLimitPerSec(), 0));
+    return settings;
+}
+
+/**
+ * @brief Трассировщик из конфигурации; nullptr, если файл трассировки не задан
+ */
+std::shared_ptr<Infrastructure::Tracing::ChromeTraceWriter> createTracer(
+    const Core::Ports::IConfiguration& configuration) {
+    const std::string traceFile = configuration.getTracingFile();
+    if (traceFile.empty()) {
+        return nullptr;
+    }
+
+    const auto maxEvents = static_cast<uint64_t>(std::max(configuration.getTracingMaxEvents(), 0));
+    auto tracer = std::make_shared<Infrastructure::Tracing::ChromeTraceWriter>(traceFile, maxEvents);
+    LOG_INFO("tracing", "Трассировка пишется в ", traceFile);
+    return tracer;
+}
+} // namespace
+
 DIContainer::DIContainer(const std::string& configPath) {
     configuration_ = std::make_shared<Infrastructure::Configuration::IniConfiguration>(configPath);
 
@@ -16,24 +83,187 @@ DIContainer::DIContainer(const std::string& configPath) {
 }
 
 void DIContainer::initialize() {
+    // Журнал создаётся первым: через него пишут компоненты, создаваемые ниже
+    logger_ = std::make_shared<Infrastructure::Logging::AsyncLogger>(createLoggerSettings(*configuration_));
+
+    // Трассировка включается до создания компонентов, чтобы в неё попали все их отрезки
+    tracer_ = createTracer(*configuration_);
+    Core::Ports::Tracing::setTracer(tracer_.get());
+
     textProcessor_ =
         std::make_shared<Infrastructure::Text::BoostLocaleTextProcessor>("ru_RU.UTF-8");
 
-    httpServer_ = std::make_shared<Infrastructure::Http::BoostBeastHttpServer>(4);
+    Infrastructure::Http::HttpServerSettings serverSettings;
+    const int threads = configuration_->getHttpServerThreads();
+    serverSettings.threadCount =
+        threads > 0 ? static_cast<unsigned int>(threads) : std::max(std::thread::hardware_concurrency(), 1U);
+    serverSettings.reusePort = configuration_->getHttpServerReusePort();
+    serverSettings.pinThreads = configuration_->getHttpServerPinThreads();
+    serverSettings.session.readTimeout = std::chrono::seconds(configuration_->getHttpServerReadTimeoutSec());
+    serverSettings.session.keepAliveTimeout =
+        std::chrono::seconds(configuration_->getHttpServerKeepAliveTimeoutSec());
+    serverSettings.session.maxRequestsPerConnection =
+        static_cast<unsigned int>(std::max(configuration_->getHttpServerMaxKeepAliveRequests(), 1));
+    serverSettings.session.compressionMinSize =
+        static_cast<size_t>(std::max(configuration_->getHttpServerCompressionMinBytes(), 0));
+    serverSettings.session.compressionLevel = std::clamp(configuration_->getHttpServerCompressionLevel(), 1, 9);
+    serverSettings.session.requestTimeout =
+        std::chrono::milliseconds(std::max(configuration_->getHttpServerRequestTimeoutMs(), 0));
+
+    if (configuration_->getHttpServerMetricsEnabled()) {
+        metricsRegistry_ = std::make_shared<Infrastructure::Metrics::MetricsRegistry>();
+    }
+
+    httpServer_ = std::make_shared<Infrastructure::Http::BoostBeastHttpServer>(serverSettings, metricsRegistry_);
+    httpServerThreadCount_ = serverSettings.threadCount;
+
+    // Поиск блокирует поток сервера, поэтому одновременных поисков должно быть меньше потоков:
+    // иначе при перегрузке занятыми окажутся все потоки и не ответят даже на отказ
+    const int maxConcurrentSearches = configuration_->getHttpServerMaxConcurrentSearches();
+    if (maxConcurrentSearches > 0) {
+        Core::Application::AdmissionSettings admissionSettings;
+        admissionSettings.maxConcurrent = static_cast<size_t>(maxConcurrentSearches);
+        admissionSettings.maxQueued =
+            static_cast<size_t>(std::max(configuration_->getHttpServerSearchQueueSize(), 0));
+        admissionSettings.target =
+            std::chrono::milliseconds(std::max(configuration_->getHttpServerSearchQueueTargetMs(), 0));
+        admissionSettings.interval =
+            std::chrono::milliseconds(std::max(configuration_->getHttpServerSearchQueueIntervalMs(), 0));
+        searchAdmission_ = std::make_shared<Core::Application::AdmissionController>(admissionSettings);
+    }
+
+    const int rateLimitPerIp = configuration_->getHttpServerRateLimitPerIp();
+    if (rateLimitPerIp > 0) {
+        clientRateLimiter_ = std::make_shared<Core::Application::ClientRateLimiter>(
+            rateLimitPerIp, std::max(configuration_->getHttpServerRateLimitBurst(), 1));
+    }
+
+    // Поисковый движок: SQL-запросы к БД, индекс, загруженный в память,
+    // или готовый файл индекса, отображённый в память (к БД не подключается)
+    const std::string searchBackend = configuration_->getHttpServerSearchBackend();
+
+    if (searchBackend == "mmap") {
+        auto index = Infrastructure::Index::MappedIndex::open(configuration_->getHttpServerIndexFile());
+        wordRepository_ = std::make_shared<Infrastructure::Index::InMemoryWordRepository>(index);
+    } else {
+        const std::string connectionString = createDatabaseConnectionString();
+        auto dbConnection =
+            std::make_shared<Infrastructure::Database::DatabaseConnection>(connectionString);
+
+        dbConnection->createSchema();
 
-    const std::string connectionString = createDatabaseConnectionString();
-    auto dbConnection =
-        std::make_shared<Infrastructure::Database::DatabaseConnection>(connectionString);
+        databaseConnection_ = dbConnection;
 
-    dbConnection->createSchema();
+        if (searchBackend == "postgres") {
+            // Сторож прерывает поиски, клиент которых отключился или срок которых истёк
+            cancellationWatchdog_ = std::make_shared<Infrastructure::Database::QueryCancellationWatchdog>();
+            wordRepository_ = createWordRepository(*configuration_, dbConnection, cancellationWatchdog_);
 
-    databaseConnection_ = dbConnection;
+            // Индекс меняется, пока работает Spider. Поколение читается через отдельное
+            // соединение: основное используют потоки поиска
+            auto generationConnection =
+                std::make_shared<Infrastructure::Database::DatabaseConnection>(connectionString);
+            auto generationRepository = std::make_shared<
+                Infrastructure::Database::PostgresIndexGenerationRepository>(generationConnection);
+            indexGeneration_ = std::make_shared<Infrastructure::Cache::PollingIndexGenerationRepository>(
+                generationRepository,
+                std::chrono::milliseconds(configuration_->getHttpServerCacheGenerationPollMs()));
+        } else if (searchBackend == "memory") {
+            const bool packedPostings = configuration_->getDatabasePostingStorage() == "packed";
+            auto index = Infrastructure::Index::PostgresIndexLoader::load(*dbConnection, packedPostings);
+            wordRepository_ = std::make_shared<Infrastructure::Index::InMemoryWordRepository>(index);
+        } else {
+            throw std::runtime_error("Неизвестный search_backend: " + searchBackend);
+        }
+    }
 
-    wordRepository_ =
-        std::make_shared<Infrastructure::Database::PostgresWordRepository>(dbConnection);
+    // Индекс в памяти и файл индекса неизменны, поэтому без счётчика поколений
+    // записи кеша устаревают только по TTL
+    const int cacheMaxBytes = configuration_->getHttpServerCacheMaxBytes();
+    if (cacheMaxBytes > 0) {
+        searchResultCache_ = std::make_shared<Infrastructure::Cache::ShardedSearchResultCache>(
+            static_cast<size_t>(cacheMaxBytes),
+            std::chrono::seconds(configuration_->getHttpServerCacheTtlSec()),
+            static_cast<size_t>(std::max(configuration_->getHttpServerCacheShards(), 1)));
+    }
 
     searchDocumentsUseCase_ = std::make_shared<Core::Application::UseCases::SearchDocumentsUseCase>(
-        wordRepository_, textProcessor_);
+        wordRepository_, textProcessor_, searchResultCache_, indexGeneration_,
+        std::chrono::milliseconds(configuration_->getHttpServerCoalescingTimeoutMs()), metricsRegistry_);
+
+    if (metricsRegistry_) {
+        registerComponentMetrics();
+    }
+}
+
+void DIContainer::registerComponentMetrics() {
+    auto& registry = *metricsRegistry_;
+    const auto useCase = searchDocumentsUseCase_;
+
+    // Компоненты ведут свои счётчики сами, метрики читают их при каждом запросе /metrics
+    if (searchResultCache_) {
+        const auto cache = searchResultCache_;
+        registry.callback("search_cache_hits_total", "Search result cache hits", true,
+                          [cache] { return static_cast<double>(cache->getStatistics().hits); });
+        registry.callback("search_cache_misses_total", "Search result cache misses", true,
+                          [cache] { return static_cast<double>(cache->getStatistics().misses); });
+        registry.callback("search_cache_evictions_total", "Search result cache evictions", true,
+                          [cache] { return static_cast<double>(cache->getStatistics().evictions); });
+        registry.callback("search_cache_hit_ratio", "Search result cache hit ratio since start", false,
+                          [cache] { return cache->getStatistics().getHitRatio(); });
+        registry.callback("search_cache_entries", "Search result cache entries", false,
+                          [cache] { return static_cast<double>(cache->getStatistics().entries); });
+        registry.callback("search_cache_bytes", "Search result cache size in bytes", false,
+                          [cache] { return static_cast<double>(cache->getStatistics().bytes); });
+    }
+
+    if (useCase->getCoalescingStatistics().has_value()) {
+        registry.callback("search_coalesced_total", "Searches that received a concurrent identical search result",
+                          true,
+                          [useCase] { return static_cast<double>(useCase->getCoalescingStatistics()->shared); });
+    }
+
+    if (searchAdmission_) {
+        const auto admission = searchAdmission_;
+        registry.callback("search_admission_active", "Searches being executed", false,
+                          [admission] { return static_cast<double>(admission->getStatistics().active); });
+        registry.callback("search_admission_waiting", "Searches waiting for admission", false,
+                          [admission] { return static_cast<double>(admission->getStatistics().waiting); });
+        registry.callback(
+            "search_rejected_total", "Searches rejected by load shedding", true,
+            [admission] { return static_cast<double>(admission->getStatistics().rejectedQueueFull); },
+            "reason=\"queue_full\"");
+        registry.callback(
+            "search_rejected_total", "Searches rejected by load shedding", true,
+            [admission] { return static_cast<double>(admission->getStatistics().rejectedTimeout); },
+            "reason=\"queue_timeout\"");
+    }
+    if (clientRateLimiter_) {
+        const auto rateLimiter = clientRateLimiter_;
+        registry.callback(
+            "search_rejected_total", "Searches rejected by load shedding", true,
+            [rateLimiter] { return static_cast<double>(rateLimiter->getRejectedCount()); },
+            "reason=\"rate_limit\"");
+    }
+
+    if (cancellationWatchdog_) {
+        const auto watchdog = cancellationWatchdog_;
+        registry.callback("search_cancelled_queries_total", "Database queries cancelled by request deadline", true,
+                          [watchdog] { return static_cast<double>(watchdog->getCancelledCount()); });
+    }
+
+    using Infrastructure::Http::ResponseCompressor;
+    registry.callback("http_response_bytes_total", "Response body bytes as sent", true,
+                      [] { return static_cast<double>(ResponseCompressor::getStatistics().bytesOut); });
+    registry.callback("http_compressed_responses_total", "Responses compressed on the fly", true,
+                      [] { return static_cast<double>(ResponseCompressor::getStatistics().compressedResponses); });
+
+    const auto logger = logger_;
+    registry.callback("log_records_dropped_total", "Log records dropped because a thread buffer was full", true,
+                      [logger] { return static_cast<double>(logger->getDroppedCount()); });
+    registry.callback(
+        "log_records_suppressed_total", "Log records suppressed by the per-call-site rate limit", true,
+        [] { return static_cast<double>(Infrastructure::Logging::AsyncLogger::getSuppressedCount()); });
 }
 
 std::string DIContainer::createDatabaseConnectionString() const {
@@ -55,10 +285,26 @@ DIContainer::getSearchDocumentsUseCase() {
     return searchDocumentsUseCase_;
 }
 
+std::shared_ptr<Core::Application::AdmissionController> DIContainer::getSearchAdmission() {
+    return searchAdmission_;
+}
+
+std::shared_ptr<Core::Application::ClientRateLimiter> DIContainer::getClientRateLimiter() {
+    return clientRateLimiter_;
+}
+
+unsigned int DIContainer::getHttpServerThreadCount() const {
+    return httpServerThreadCount_;
+}
+
 std::shared_ptr<Core::Ports::IHttpServer> DIContainer::getHttpServer() {
     return httpServer_;
 }
 
+std::shared_ptr<Core::Ports::IMetricsRegistry> DIContainer::getMetricsRegistry() {
+    return metricsRegistry_;
+}
+
 std::shared_ptr<Core::Ports::IConfiguration> DIContainer::getConfiguration() {
     return configuration_;
 }
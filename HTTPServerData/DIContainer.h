@@ -3,13 +3,30 @@
 #include <memory>
 #include <string>
 
+#include "../Core/Application/AdmissionController.h"
+#include "../Core/Application/ClientRateLimiter.h"
 #include "../Core/Application/UseCases/SearchDocumentsUseCase.h"
 #include "../Core/Ports/IConfiguration.h"
 #include "../Core/Ports/IDatabaseConnection.h"
 #include "../Core/Ports/IHttpServer.h"
+#include "../Core/Ports/IIndexGenerationRepository.h"
+#include "../Core/Ports/IMetricsRegistry.h"
+#include "../Core/Ports/ISearchResultCache.h"
 #include "../Core/Ports/ITextProcessor.h"
 #include "../Core/Ports/IWordRepository.h"
 
+namespace Infrastructure::Database {
+class QueryCancellationWatchdog;
+}
+
+namespace Infrastructure::Logging {
+class AsyncLogger;
+}
+
+namespace Infrastructure::Tracing {
+class ChromeTraceWriter;
+}
+
 namespace HTTPServerData {
 /**
  * @brief Контейнер зависимостей для приложения HTTPServer
@@ -40,12 +57,35 @@ class DIContainer {
     std::shared_ptr<Core::Application::UseCases::SearchDocumentsUseCase>
     getSearchDocumentsUseCase();
 
+    /**
+     * @brief Получить контроль допуска поисков
+     * @return Shared pointer на AdmissionController или nullptr, если ограничение выключено
+     */
+    std::shared_ptr<Core::Application::AdmissionController> getSearchAdmission();
+
+    /**
+     * @brief Получить ограничение частоты поисков с одного IP
+     * @return Shared pointer на ClientRateLimiter или nullptr, если ограничение выключено
+     */
+    std::shared_ptr<Core::Application::ClientRateLimiter> getClientRateLimiter();
+
+    /**
+     * @brief Количество потоков HTTP-сервера
+     */
+    unsigned int getHttpServerThreadCount() const;
+
     /**
      * @brief Получить HTTP-сервер
      * @return Shared pointer на IHttpServer
      */
     std::shared_ptr<Core::Ports::IHttpServer> getHttpServer();
 
+    /**
+     * @brief Получить реестр метрик
+     * @return Shared pointer на IMetricsRegistry или nullptr, если метрики выключены
+     */
+    std::shared_ptr<Core::Ports::IMetricsRegistry> getMetricsRegistry();
+
     /**
      * @brief Получить конфигурацию
      * @return Shared pointer на IConfiguration
@@ -53,16 +93,32 @@ class DIContainer {
     std::shared_ptr<Core::Ports::IConfiguration> getConfiguration();
 
   private:
+    // Журнал объявлен первым, чтобы уничтожаться последним: после потоков остальных компонентов
+    std::shared_ptr<Infrastructure::Logging::AsyncLogger> logger_;
+    // Трассировщик (nullptr - выключена); уничтожается после потоков, пишущих отрезки
+    std::shared_ptr<Infrastructure::Tracing::ChromeTraceWriter> tracer_;
+
     // Configuration
     std::shared_ptr<Core::Ports::IConfiguration> configuration_;
 
     // Infrastructure components
+    std::shared_ptr<Core::Ports::IMetricsRegistry> metricsRegistry_;
     std::shared_ptr<Core::Ports::ITextProcessor> textProcessor_;
     std::shared_ptr<Core::Ports::IHttpServer> httpServer_;
+    unsigned int httpServerThreadCount_ = 0;
+
+    // Load shedding
+    std::shared_ptr<Core::Application::AdmissionController> searchAdmission_;
+    std::shared_ptr<Core::Application::ClientRateLimiter> clientRateLimiter_;
 
     // Database
     std::shared_ptr<Core::Ports::IDatabaseConnection> databaseConnection_;
     std::shared_ptr<Core::Ports::IWordRepository> wordRepository_;
+    std::shared_ptr<Core::Ports::IIndexGenerationRepository> indexGeneration_;
+    std::shared_ptr<Infrastructure::Database::QueryCancellationWatchdog> cancellationWatchdog_;
+
+    // Cache
+    std::shared_ptr<Core::Ports::ISearchResultCache> searchResultCache_;
 
     // Use Cases
     std::shared_ptr<Core::Application::UseCases::SearchDocumentsUseCase> searchDocumentsUseCase_;
@@ -72,6 +128,11 @@ class DIContainer {
      */
     void initialize();
 
+    /**
+     * @brief Регистрирует метрики, вычисляемые из счётчиков компонентов (кеш, допуск, сжатие)
+     */
+    void registerComponentMetrics();
+
     /**
      * @brief Создаёт строку подключения к базе данных из конфигурации
      * @return Строка подключения PostgreSQL
@@ -0,0 +1,148 @@
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include <windows.h>
+
+#include "../Infrastructure/Configuration/IniConfiguration.h"
+#include "../Infrastructure/Database/DatabaseConnection.h"
+#include "../Infrastructure/Database/PostgresPackedWordRepository.h"
+#include "../Infrastructure/Index/IndexSegmentWriter.h"
+#include "../Infrastructure/Index/MappedIndex.h"
+#include "../Infrastructure/Index/PostgresIndexLoader.h"
+
+/**
+ * @brief Выводит справку по командам
+ */
+void printUsage() {
+    std::cout << "Использование:" << std::endl;
+    std::cout << "  IndexBuilder build [config.ini] [файл]  - построить индекс из базы данных" << std::endl;
+    std::cout << "  IndexBuilder verify <файл>              - проверить файл индекса" << std::endl;
+    std::cout << "  IndexBuilder pack [config.ini]          - перестроить word_postings из word_frequencies"
+              << std::endl;
+}
+
+/**
+ * @brief Создаёт строку подключения к базе данных из конфигурации
+ */
+std::string createDatabaseConnectionString(const Core::Ports::IConfiguration& config) {
+    std::ostringstream oss;
+    oss << "host=" << config.getDatabaseHost() << " port=" << config.getDatabasePort()
+        << " dbname=" << config.getDatabaseName() << " user=" << config.getDatabaseUser()
+        << " password=" << config.getDatabasePassword();
+
+    return oss.str();
+}
+
+/**
+ * @brief Время, прошедшее с момента start, в миллисекундах
+ */
+long long elapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Строит файл индекса из таблиц PostgreSQL
+ */
+int buildIndex(const std::string& configPath, std::string outputPath) {
+    std::cout << "Загрузка конфигурации из: " << configPath << std::endl;
+    Infrastructure::Configuration::IniConfiguration config(configPath);
+
+    if (outputPath.empty()) {
+        outputPath = config.getHttpServerIndexFile();
+    }
+
+    Infrastructure::Database::DatabaseConnection dbConnection(createDatabaseConnectionString(config));
+
+    auto start = std::chrono::steady_clock::now();
+    const bool packedPostings = config.getDatabasePostingStorage() == "packed";
+    auto index = Infrastructure::Index::PostgresIndexLoader::load(dbConnection, packedPostings);
+
+    std::cout << "Загружено из базы данных за " << elapsedMs(start) << " мс: " << index->getDocumentCount()
+              << " документов, " << index->getTermCount() << " слов, " << index->getPostingCount()
+              << " постингов" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    Infrastructure::Index::IndexSegmentWriter::write(*index, outputPath);
+
+    std::cout << "Индекс записан в " << outputPath << " за " << elapsedMs(start) << " мс" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Перестраивает упакованные постинги word_postings из word_frequencies
+ */
+int packPostings(const std::string& configPath) {
+    std::cout << "Загрузка конфигурации из: " << configPath << std::endl;
+    Infrastructure::Configuration::IniConfiguration config(configPath);
+
+    auto dbConnection = std::make_shared<Infrastructure::Database::DatabaseConnection>(
+        createDatabaseConnectionString(config));
+    dbConnection->createSchema();
+
+    Infrastructure::Database::PostgresPackedWordRepository repository(dbConnection);
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto statistics = repository.rebuildFromRows();
+
+    std::cout << "word_postings перестроена за " << elapsedMs(start) << " мс: " << statistics.wordCount
+              << " слов, " << statistics.postingCount << " постингов" << std::endl;
+    std::cout << "  word_frequencies: " << statistics.rowStorageBytes << " байт" << std::endl;
+    std::cout << "  word_postings: " << statistics.packedStorageBytes << " байт" << std::endl;
+    std::cout << "Для записи и поиска по упакованным постингам укажите posting_storage=packed" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Проверяет контрольные суммы и структуру файла индекса
+ */
+int verifyIndex(const std::string& indexPath) {
+    const auto start = std::chrono::steady_clock::now();
+    auto index = Infrastructure::Index::MappedIndex::open(indexPath);
+    index->verify();
+
+    std::cout << "Индекс " << indexPath << " корректен (" << elapsedMs(start) << " мс)" << std::endl;
+    std::cout << "  Размер файла: " << index->getFileSize() << " байт" << std::endl;
+    std::cout << "  Документов: " << index->getDocumentCount() << std::endl;
+    std::cout << "  Слов: " << index->getTermCount() << std::endl;
+    std::cout << "  Постингов: " << index->getPostingCount() << std::endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    // Устанавливаем UTF-8 для консоли
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    const std::string command = argv[1];
+
+    try {
+        if (command == "build") {
+            const std::string configPath = argc > 2 ? argv[2] : "config.ini";
+            const std::string outputPath = argc > 3 ? argv[3] : "";
+            return buildIndex(configPath, outputPath);
+        }
+
+        if (command == "pack") {
+            return packPostings(argc > 2 ? argv[2] : "config.ini");
+        }
+
+        if (command == "verify" && argc > 2) {
+            return verifyIndex(argv[2]);
+        }
+
+        printUsage();
+        return 1;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ОШИБКА: " << e.what() << std::endl;
+        return 1;
+    }
+}
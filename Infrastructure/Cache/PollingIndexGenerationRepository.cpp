@@ -0,0 +1,44 @@
+#include "PollingIndexGenerationRepository.h"
+
+#include <stdexcept>
+
+namespace Infrastructure::Cache {
+PollingIndexGenerationRepository::PollingIndexGenerationRepository(
+    std::shared_ptr<Core::Ports::IIndexGenerationRepository> source,
+    std::chrono::milliseconds refreshInterval)
+    : source_(std::move(source)), refreshInterval_(refreshInterval) {
+    if (!source_) {
+        throw std::invalid_argument("Счётчик поколений индекса не может быть nullptr");
+    }
+
+    std::lock_guard<std::mutex> lock(sourceMutex_);
+    refresh();
+}
+
+PollingIndexGenerationRepository::GenerationType PollingIndexGenerationRepository::getGeneration() {
+    const Clock::rep now = Clock::now().time_since_epoch().count();
+
+    if (now >= nextRefreshAt_.load(std::memory_order_acquire)) {
+        // Если значение уже перечитывает другой поток, не ждём его
+        std::unique_lock<std::mutex> lock(sourceMutex_, std::try_to_lock);
+        if (lock.owns_lock() && now >= nextRefreshAt_.load(std::memory_order_acquire)) {
+            refresh();
+        }
+    }
+
+    return generation_.load(std::memory_order_acquire);
+}
+
+void PollingIndexGenerationRepository::bumpGeneration() {
+    std::lock_guard<std::mutex> lock(sourceMutex_);
+    source_->bumpGeneration();
+    refresh();
+}
+
+void PollingIndexGenerationRepository::refresh() {
+    generation_.store(source_->getGeneration(), std::memory_order_release);
+
+    const auto nextRefreshAt = Clock::now() + std::chrono::duration_cast<Clock::duration>(refreshInterval_);
+    nextRefreshAt_.store(nextRefreshAt.time_since_epoch().count(), std::memory_order_release);
+}
+} // namespace Infrastructure::Cache
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include "../../Core/Ports/IIndexGenerationRepository.h"
+
+namespace Infrastructure::Cache {
+/**
+ * @brief Счётчик поколений индекса, перечитываемый не чаще заданного интервала
+ *
+ * Оборачивает другой счётчик (обычно в БД), чтобы проверка поколения
+ * не стоила запроса к БД на каждый поиск. Перечитывает значение один поток,
+ * остальные в это время получают прежнее, поэтому результат поиска может
+ * отставать от Spider не больше чем на интервал опроса (плюс время запроса).
+ */
+class PollingIndexGenerationRepository : public Core::Ports::IIndexGenerationRepository {
+  public:
+    /**
+     * @brief Конструктор (сразу читает текущее поколение)
+     * @param source Исходный счётчик; должен допускать вызовы из разных потоков поочерёдно
+     * @param refreshInterval Интервал опроса исходного счётчика
+     */
+    PollingIndexGenerationRepository(std::shared_ptr<Core::Ports::IIndexGenerationRepository> source,
+                                     std::chrono::milliseconds refreshInterval);
+
+    ~PollingIndexGenerationRepository() override = default;
+
+    GenerationType getGeneration() override;
+
+    void bumpGeneration() override;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    std::shared_ptr<Core::Ports::IIndexGenerationRepository> source_;
+    std::chrono::nanoseconds refreshInterval_;
+
+    std::mutex sourceMutex_;  // Исходный счётчик вызывается из одного потока за раз
+    std::atomic<GenerationType> generation_{0};
+    std::atomic<Clock::rep> nextRefreshAt_{0};
+
+    /**
+     * @brief Перечитывает поколение (sourceMutex_ должен быть захвачен)
+     */
+    void refresh();
+};
+} // namespace Infrastructure::Cache
@@ -0,0 +1,125 @@
+#include "ShardedSearchResultCache.h"
+
+#include <functional>
+#include <stdexcept>
+
+namespace Infrastructure::Cache {
+ShardedSearchResultCache::ShardedSearchResultCache(size_t maxBytes,
+                                                   std::chrono::milliseconds ttl,
+                                                   size_t shardCount)
+    : shardCapacity_(shardCount == 0 ? 0 : maxBytes / shardCount), ttl_(ttl) {
+    if (maxBytes == 0 || shardCount == 0) {
+        throw std::invalid_argument("Размер и количество шардов кеша должны быть положительными");
+    }
+
+    shards_.reserve(shardCount);
+    for (size_t i = 0; i < shardCount; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+    }
+}
+
+std::optional<Core::DTO::SearchHitsDTO> ShardedSearchResultCache::find(const std::string& key,
+                                                                      int64_t generation) {
+    Shard& shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto found = shard.index.find(key);
+    if (found == shard.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    const auto it = found->second;
+    const bool expired = ttl_.count() > 0 && Clock::now() >= it->expiresAt;
+    if (it->generation != generation || expired) {
+        erase(shard, it);
+        invalidations_.fetch_add(1, std::memory_order_relaxed);
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    shard.entries.splice(shard.entries.begin(), shard.entries, it);
+
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    savedNanoseconds_.fetch_add(it->computeTime.count(), std::memory_order_relaxed);
+
+    return it->hits;
+}
+
+void ShardedSearchResultCache::store(const std::string& key,
+                                     int64_t generation,
+                                     const Core::DTO::SearchHitsDTO& hits,
+                                     std::chrono::nanoseconds computeTime) {
+    const size_t bytes = estimateBytes(key, hits);
+
+    // Запись больше шарда вытеснила бы весь шард и всё равно не поместилась бы
+    if (bytes > shardCapacity_) {
+        return;
+    }
+
+    Entry entry;
+    entry.key = key;
+    entry.generation = generation;
+    entry.hits = hits;
+    entry.computeTime = computeTime;
+    entry.expiresAt = Clock::now() + ttl_;
+    entry.bytes = bytes;
+
+    Shard& shard = getShard(key);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const auto found = shard.index.find(key);
+    if (found != shard.index.end()) {
+        // Запись более нового поколения не заменяем результатом, посчитанным по старым данным
+        if (found->second->generation > generation) {
+            return;
+        }
+        erase(shard, found->second);
+    }
+
+    while (!shard.entries.empty() && shard.bytes + bytes > shardCapacity_) {
+        erase(shard, std::prev(shard.entries.end()));
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    shard.entries.push_front(std::move(entry));
+    shard.index.emplace(key, shard.entries.begin());
+    shard.bytes += bytes;
+}
+
+Core::Ports::SearchCacheStatistics ShardedSearchResultCache::getStatistics() const {
+    Core::Ports::SearchCacheStatistics statistics;
+    statistics.hits = hits_.load(std::memory_order_relaxed);
+    statistics.misses = misses_.load(std::memory_order_relaxed);
+    statistics.invalidations = invalidations_.load(std::memory_order_relaxed);
+    statistics.evictions = evictions_.load(std::memory_order_relaxed);
+    statistics.savedLatency = std::chrono::nanoseconds(savedNanoseconds_.load(std::memory_order_relaxed));
+
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        statistics.entries += shard->entries.size();
+        statistics.bytes += shard->bytes;
+    }
+
+    return statistics;
+}
+
+ShardedSearchResultCache::Shard& ShardedSearchResultCache::getShard(const std::string& key) {
+    return *shards_[std::hash<std::string>{}(key) % shards_.size()];
+}
+
+void ShardedSearchResultCache::erase(Shard& shard, std::list<Entry>::iterator it) {
+    shard.bytes -= it->bytes;
+    shard.index.erase(it->key);
+    shard.entries.erase(it);
+}
+
+size_t ShardedSearchResultCache::estimateBytes(const std::string& key, const Core::DTO::SearchHitsDTO& hits) {
+    // Ключ хранится дважды: в записи и в индексе шарда
+    size_t bytes = ENTRY_OVERHEAD_BYTES + 2 * key.size();
+    for (const auto& result : hits.results) {
+        bytes += sizeof(result) + result.getUrl().size();
+    }
+    return bytes;
+}
+} // namespace Infrastructure::Cache
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../Core/Ports/ISearchResultCache.h"
+
+namespace Infrastructure::Cache {
+/**
+ * @brief Кеш результатов поиска в памяти, разбитый на шарды
+ *
+ * Ключ попадает в шард по хешу; у каждого шарда свой мьютекс, своя LRU-очередь
+ * и своя доля ограничения по памяти, поэтому потоки сервера, ищущие разные
+ * запросы, почти не конкурируют за блокировку.
+ *
+ * Запись удаляется при обращении, если её поколение индекса не совпадает
+ * с текущим или истёк её TTL. Размер записи оценивается по длине ключа и URL.
+ */
+class ShardedSearchResultCache : public Core::Ports::ISearchResultCache {
+  public:
+    /**
+     * @brief Конструктор
+     * @param maxBytes Ограничение оценочного размера всех записей
+     * @param ttl Время жизни записи (0 - без ограничения)
+     * @param shardCount Количество шардов
+     * @throws std::invalid_argument если maxBytes или shardCount равны нулю
+     */
+    ShardedSearchResultCache(size_t maxBytes, std::chrono::milliseconds ttl, size_t shardCount);
+
+    ~ShardedSearchResultCache() override = default;
+
+    ShardedSearchResultCache(const ShardedSearchResultCache&) = delete;
+    ShardedSearchResultCache& operator=(const ShardedSearchResultCache&) = delete;
+
+    std::optional<Core::DTO::SearchHitsDTO> find(const std::string& key, int64_t generation) override;
+
+    void store(const std::string& key,
+               int64_t generation,
+               const Core::DTO::SearchHitsDTO& hits,
+               std::chrono::nanoseconds computeTime) override;
+
+    Core::Ports::SearchCacheStatistics getStatistics() const override;
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    // Накладные расходы записи сверх ключа и выдачи: узлы списка и хеш-таблицы
+    static constexpr size_t ENTRY_OVERHEAD_BYTES = 128;
+
+    struct Entry {
+        std::string key;
+        int64_t generation = 0;
+        Core::DTO::SearchHitsDTO hits;
+        std::chrono::nanoseconds computeTime{0};
+        Clock::time_point expiresAt;
+        size_t bytes = 0;
+    };
+
+    /**
+     * @brief Шард: LRU-очередь (начало - самые свежие) и индекс по ключу
+     */
+    struct Shard {
+        mutable std::mutex mutex;
+        std::list<Entry> entries;
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        size_t bytes = 0;
+    };
+
+    size_t shardCapacity_;
+    std::chrono::milliseconds ttl_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
+    std::atomic<uint64_t> invalidations_{0};
+    std::atomic<uint64_t> evictions_{0};
+    std::atomic<int64_t> savedNanoseconds_{0};
+
+    Shard& getShard(const std::string& key);
+
+    /**
+     * @brief Удаляет запись из шарда (мьютекс шарда должен быть захвачен)
+     */
+    static void erase(Shard& shard, std::list<Entry>::iterator it);
+
+    /**
+     * @brief Оценивает размер записи в байтах
+     */
+    static size_t estimateBytes(const std::string& key, const Core::DTO::SearchHitsDTO& hits);
+};
+} // namespace Infrastructure::Cache
@@ -114,6 +114,10 @@ std::string IniConfiguration::getDatabasePassword() const {
     return getValue("database", "password", "");
 }
 
+std::string IniConfiguration::getDatabasePostingStorage() const {
+    return getValue("database", "posting_storage", DEFAULT_DATABASE_POSTING_STORAGE);
+}
+
 // Настройки Spider
 std::string IniConfiguration::getSpiderStartUrl() const {
     return getValue("spider", "start_url", "https://example.com");
@@ -127,6 +131,50 @@ int IniConfiguration::getSpiderThreadPoolSize() const {
     return getIntValue("spider", "thread_pool_size", DEFAULT_SPIDER_THREAD_POOL_SIZE);
 }
 
+bool IniConfiguration::getSpiderRecrawlEnabled() const {
+    return getIntValue("spider", "recrawl_enabled", 0) != 0;
+}
+
+int IniConfiguration::getSpiderRecrawlBatchSize() const {
+    return getIntValue("spider", "recrawl_batch_size", DEFAULT_SPIDER_RECRAWL_BATCH_SIZE);
+}
+
+int IniConfiguration::getSpiderRecrawlMaxSleepSec() const {
+    return getIntValue("spider", "recrawl_max_sleep_sec", DEFAULT_SPIDER_RECRAWL_MAX_SLEEP_SEC);
+}
+
+std::string IniConfiguration::getSpiderFrontierDir() const {
+    return getValue("spider", "frontier_dir", "");
+}
+
+int IniConfiguration::getSpiderFrontierGroupCommitMs() const {
+    return getIntValue("spider", "frontier_group_commit_ms", DEFAULT_SPIDER_FRONTIER_GROUP_COMMIT_MS);
+}
+
+int IniConfiguration::getSpiderFrontierSnapshotRecords() const {
+    return getIntValue("spider", "frontier_snapshot_records", DEFAULT_SPIDER_FRONTIER_SNAPSHOT_RECORDS);
+}
+
+std::string IniConfiguration::getSpiderFrontierSpillDir() const {
+    return getValue("spider", "frontier_spill_dir", "");
+}
+
+int IniConfiguration::getSpiderFrontierMemoryHighWatermark() const {
+    return getIntValue("spider", "frontier_memory_high_watermark", DEFAULT_SPIDER_FRONTIER_MEMORY_HIGH_WATERMARK);
+}
+
+int IniConfiguration::getSpiderFrontierMemoryLowWatermark() const {
+    return getIntValue("spider", "frontier_memory_low_watermark", DEFAULT_SPIDER_FRONTIER_MEMORY_LOW_WATERMARK);
+}
+
+int IniConfiguration::getSpiderStatusPort() const {
+    return getIntValue("spider", "status_port", 0);
+}
+
+int IniConfiguration::getSpiderStatusIntervalSec() const {
+    return getIntValue("spider", "status_interval_sec", DEFAULT_SPIDER_STATUS_INTERVAL_SEC);
+}
+
 // Настройки HTTP Server
 int IniConfiguration::getHttpServerPort() const {
     return getIntValue("http_server", "port", DEFAULT_HTTP_SERVER_PORT);
@@ -135,4 +183,126 @@ int IniConfiguration::getHttpServerPort() const {
 int IniConfiguration::getHttpServerMaxResults() const {
     return getIntValue("http_server", "max_results", DEFAULT_HTTP_SERVER_MAX_RESULTS);
 }
+
+std::string IniConfiguration::getHttpServerSearchBackend() const {
+    return getValue("http_server", "search_backend", DEFAULT_HTTP_SERVER_SEARCH_BACKEND);
+}
+
+std::string IniConfiguration::getHttpServerIndexFile() const {
+    return getValue("http_server", "index_file", DEFAULT_HTTP_SERVER_INDEX_FILE);
+}
+
+int IniConfiguration::getHttpServerCacheMaxBytes() const {
+    return getIntValue("http_server", "cache_max_bytes", DEFAULT_HTTP_SERVER_CACHE_MAX_BYTES);
+}
+
+int IniConfiguration::getHttpServerCacheTtlSec() const {
+    return getIntValue("http_server", "cache_ttl_sec", DEFAULT_HTTP_SERVER_CACHE_TTL_SEC);
+}
+
+int IniConfiguration::getHttpServerCacheShards() const {
+    return getIntValue("http_server", "cache_shards", DEFAULT_HTTP_SERVER_CACHE_SHARDS);
+}
+
+int IniConfiguration::getHttpServerCacheGenerationPollMs() const {
+    return getIntValue("http_server", "cache_generation_poll_ms", DEFAULT_HTTP_SERVER_CACHE_GENERATION_POLL_MS);
+}
+
+int IniConfiguration::getHttpServerCoalescingTimeoutMs() const {
+    return getIntValue("http_server", "coalescing_timeout_ms", DEFAULT_HTTP_SERVER_COALESCING_TIMEOUT_MS);
+}
+
+int IniConfiguration::getHttpServerReadTimeoutSec() const {
+    return getIntValue("http_server", "read_timeout_sec", DEFAULT_HTTP_SERVER_READ_TIMEOUT_SEC);
+}
+
+int IniConfiguration::getHttpServerKeepAliveTimeoutSec() const {
+    return getIntValue("http_server", "keep_alive_timeout_sec", DEFAULT_HTTP_SERVER_KEEP_ALIVE_TIMEOUT_SEC);
+}
+
+int IniConfiguration::getHttpServerMaxKeepAliveRequests() const {
+    return getIntValue("http_server", "max_keep_alive_requests", DEFAULT_HTTP_SERVER_MAX_KEEP_ALIVE_REQUESTS);
+}
+
+int IniConfiguration::getHttpServerThreads() const {
+    return getIntValue("http_server", "threads", DEFAULT_HTTP_SERVER_THREADS);
+}
+
+bool IniConfiguration::getHttpServerReusePort() const {
+    return getIntValue("http_server", "reuse_port", 0) != 0;
+}
+
+bool IniConfiguration::getHttpServerPinThreads() const {
+    return getIntValue("http_server", "pin_threads", 0) != 0;
+}
+
+int IniConfiguration::getHttpServerApiMaxResults() const {
+    return getIntValue("http_server", "api_max_results", DEFAULT_HTTP_SERVER_API_MAX_RESULTS);
+}
+
+int IniConfiguration::getHttpServerCompressionMinBytes() const {
+    return getIntValue("http_server", "compression_min_bytes", DEFAULT_HTTP_SERVER_COMPRESSION_MIN_BYTES);
+}
+
+int IniConfiguration::getHttpServerCompressionLevel() const {
+    return getIntValue("http_server", "compression_level", DEFAULT_HTTP_SERVER_COMPRESSION_LEVEL);
+}
+
+int IniConfiguration::getHttpServerMaxConcurrentSearches() const {
+    return getIntValue("http_server", "max_concurrent_searches", DEFAULT_HTTP_SERVER_MAX_CONCURRENT_SEARCHES);
+}
+
+int IniConfiguration::getHttpServerSearchQueueSize() const {
+    return getIntValue("http_server", "search_queue_size", DEFAULT_HTTP_SERVER_SEARCH_QUEUE_SIZE);
+}
+
+int IniConfiguration::getHttpServerSearchQueueTargetMs() const {
+    return getIntValue("http_server", "search_queue_target_ms", DEFAULT_HTTP_SERVER_SEARCH_QUEUE_TARGET_MS);
+}
+
+int IniConfiguration::getHttpServerSearchQueueIntervalMs() const {
+    return getIntValue("http_server", "search_queue_interval_ms", DEFAULT_HTTP_SERVER_SEARCH_QUEUE_INTERVAL_MS);
+}
+
+int IniConfiguration::getHttpServerRateLimitPerIp() const {
+    return getIntValue("http_server", "rate_limit_per_ip", DEFAULT_HTTP_SERVER_RATE_LIMIT_PER_IP);
+}
+
+int IniConfiguration::getHttpServerRateLimitBurst() const {
+    return getIntValue("http_server", "rate_limit_burst", DEFAULT_HTTP_SERVER_RATE_LIMIT_BURST);
+}
+
+int IniConfiguration::getHttpServerRequestTimeoutMs() const {
+    return getIntValue("http_server", "request_timeout_ms", DEFAULT_HTTP_SERVER_REQUEST_TIMEOUT_MS);
+}
+
+bool IniConfiguration::getHttpServerMetricsEnabled() const {
+    return getIntValue("http_server", "metrics_enabled", 1) != 0;
+}
+
+// Настройки журнала
+std::string IniConfiguration::getLoggingLevel() const {
+    return getValue("logging", "level", DEFAULT_LOGGING_LEVEL);
+}
+
+std::string IniConfiguration::getLoggingFormat() const {
+    return getValue("logging", "format", DEFAULT_LOGGING_FORMAT);
+}
+
+int IniConfiguration::getLoggingBufferRecords() const {
+    return getIntValue("logging", "buffer_records", DEFAULT_LOGGING_BUFFER_RECORDS);
+}
+
+int IniConfiguration::getLoggingRateLimitPerSec() const {
+    return getIntValue("logging", "rate_limit_per_sec", DEFAULT_LOGGING_RATE_LIMIT_PER_SEC);
+}
+
+// Настройки трассировки
+std::string IniConfiguration::getTracingFile() const {
+    return getValue("tracing", "file", "");
+}
+
+int IniConfiguration::getTracingMaxEvents() const {
+    return getIntValue("tracing", "max_events", DEFAULT_TRACING_MAX_EVENTS);
+}
 } // namespace Infrastructure::Configuration
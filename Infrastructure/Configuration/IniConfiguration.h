@@ -27,23 +27,103 @@ class IniConfiguration : public Core::Ports::IConfiguration {
     std::string getDatabaseName() const override;
     std::string getDatabaseUser() const override;
     std::string getDatabasePassword() const override;
+    std::string getDatabasePostingStorage() const override;
 
     // Настройки Spider
     std::string getSpiderStartUrl() const override;
     int getSpiderCrawlDepth() const override;
     int getSpiderThreadPoolSize() const override;
+    bool getSpiderRecrawlEnabled() const override;
+    int getSpiderRecrawlBatchSize() const override;
+    int getSpiderRecrawlMaxSleepSec() const override;
+    std::string getSpiderFrontierDir() const override;
+    int getSpiderFrontierGroupCommitMs() const override;
+    int getSpiderFrontierSnapshotRecords() const override;
+    std::string getSpiderFrontierSpillDir() const override;
+    int getSpiderFrontierMemoryHighWatermark() const override;
+    int getSpiderFrontierMemoryLowWatermark() const override;
+    int getSpiderStatusPort() const override;
+    int getSpiderStatusIntervalSec() const override;
 
     // Настройки HTTP Server
     int getHttpServerPort() const override;
     int getHttpServerMaxResults() const override;
+    std::string getHttpServerSearchBackend() const override;
+    std::string getHttpServerIndexFile() const override;
+    int getHttpServerCacheMaxBytes() const override;
+    int getHttpServerCacheTtlSec() const override;
+    int getHttpServerCacheShards() const override;
+    int getHttpServerCacheGenerationPollMs() const override;
+    int getHttpServerCoalescingTimeoutMs() const override;
+    int getHttpServerReadTimeoutSec() const override;
+    int getHttpServerKeepAliveTimeoutSec() const override;
+    int getHttpServerMaxKeepAliveRequests() const override;
+    int getHttpServerThreads() const override;
+    bool getHttpServerReusePort() const override;
+    bool getHttpServerPinThreads() const override;
+    int getHttpServerApiMaxResults() const override;
+    int getHttpServerCompressionMinBytes() const override;
+    int getHttpServerCompressionLevel() const override;
+    int getHttpServerMaxConcurrentSearches() const override;
+    int getHttpServerSearchQueueSize() const override;
+    int getHttpServerSearchQueueTargetMs() const override;
+    int getHttpServerSearchQueueIntervalMs() const override;
+    int getHttpServerRateLimitPerIp() const override;
+    int getHttpServerRateLimitBurst() const override;
+    int getHttpServerRequestTimeoutMs() const override;
+    bool getHttpServerMetricsEnabled() const override;
+
+    // Настройки журнала
+    std::string getLoggingLevel() const override;
+    std::string getLoggingFormat() const override;
+    int getLoggingBufferRecords() const override;
+    int getLoggingRateLimitPerSec() const override;
+
+    // Настройки трассировки
+    std::string getTracingFile() const override;
+    int getTracingMaxEvents() const override;
 
   private:
     // Константы значений по умолчанию
     static constexpr int DEFAULT_DATABASE_PORT = 5432;
+    static constexpr const char* DEFAULT_DATABASE_POSTING_STORAGE = "rows";
     static constexpr int DEFAULT_SPIDER_CRAWL_DEPTH = 3;
     static constexpr int DEFAULT_SPIDER_THREAD_POOL_SIZE = 10;
+    static constexpr int DEFAULT_SPIDER_RECRAWL_BATCH_SIZE = 1000;
+    static constexpr int DEFAULT_SPIDER_RECRAWL_MAX_SLEEP_SEC = 300;
+    static constexpr int DEFAULT_SPIDER_FRONTIER_GROUP_COMMIT_MS = 50;
+    static constexpr int DEFAULT_SPIDER_FRONTIER_SNAPSHOT_RECORDS = 1000000;
+    static constexpr int DEFAULT_SPIDER_FRONTIER_MEMORY_HIGH_WATERMARK = 200000;
+    static constexpr int DEFAULT_SPIDER_FRONTIER_MEMORY_LOW_WATERMARK = 50000;
+    static constexpr int DEFAULT_SPIDER_STATUS_INTERVAL_SEC = 10;
     static constexpr int DEFAULT_HTTP_SERVER_PORT = 8080;
     static constexpr int DEFAULT_HTTP_SERVER_MAX_RESULTS = 10;
+    static constexpr const char* DEFAULT_HTTP_SERVER_SEARCH_BACKEND = "postgres";
+    static constexpr const char* DEFAULT_HTTP_SERVER_INDEX_FILE = "search.idx";
+    static constexpr int DEFAULT_HTTP_SERVER_CACHE_MAX_BYTES = 64 * 1024 * 1024;
+    static constexpr int DEFAULT_HTTP_SERVER_CACHE_TTL_SEC = 300;
+    static constexpr int DEFAULT_HTTP_SERVER_CACHE_SHARDS = 16;
+    static constexpr int DEFAULT_HTTP_SERVER_CACHE_GENERATION_POLL_MS = 1000;
+    static constexpr int DEFAULT_HTTP_SERVER_COALESCING_TIMEOUT_MS = 5000;
+    static constexpr int DEFAULT_HTTP_SERVER_READ_TIMEOUT_SEC = 10;
+    static constexpr int DEFAULT_HTTP_SERVER_KEEP_ALIVE_TIMEOUT_SEC = 30;
+    static constexpr int DEFAULT_HTTP_SERVER_MAX_KEEP_ALIVE_REQUESTS = 1000;
+    static constexpr int DEFAULT_HTTP_SERVER_THREADS = 4;
+    static constexpr int DEFAULT_HTTP_SERVER_API_MAX_RESULTS = 1000;
+    static constexpr int DEFAULT_HTTP_SERVER_COMPRESSION_MIN_BYTES = 1024;
+    static constexpr int DEFAULT_HTTP_SERVER_COMPRESSION_LEVEL = 6;
+    static constexpr int DEFAULT_HTTP_SERVER_MAX_CONCURRENT_SEARCHES = 0;
+    static constexpr int DEFAULT_HTTP_SERVER_SEARCH_QUEUE_SIZE = 0;
+    static constexpr int DEFAULT_HTTP_SERVER_SEARCH_QUEUE_TARGET_MS = 5;
+    static constexpr int DEFAULT_HTTP_SERVER_SEARCH_QUEUE_INTERVAL_MS = 100;
+    static constexpr int DEFAULT_HTTP_SERVER_RATE_LIMIT_PER_IP = 0;
+    static constexpr int DEFAULT_HTTP_SERVER_RATE_LIMIT_BURST = 20;
+    static constexpr int DEFAULT_HTTP_SERVER_REQUEST_TIMEOUT_MS = 5000;
+    static constexpr const char* DEFAULT_LOGGING_LEVEL = "info";
+    static constexpr const char* DEFAULT_LOGGING_FORMAT = "text";
+    static constexpr int DEFAULT_LOGGING_BUFFER_RECORDS = 1024;
+    static constexpr int DEFAULT_LOGGING_RATE_LIMIT_PER_SEC = 20;
+    static constexpr int DEFAULT_TRACING_MAX_EVENTS = 1000000;
 
     /**
      * @brief Загружает и парсит INI файл
@@ -37,6 +37,9 @@ void DatabaseConnection::createSchema() {
         createDocumentsTable(txn);
         createWordsTable(txn);
         createWordFrequenciesTable(txn);
+        createWordPostingsTable(txn);
+        createRevisitScheduleTable(txn);
+        createIndexGenerationSequence(txn);
 
         // Создаём индексы
         createIndexes(txn);
@@ -56,11 +59,19 @@ void DatabaseConnection::createDocumentsTable(pqxx::work& txn) {
             id BIGSERIAL PRIMARY KEY,
             url VARCHAR()" + std::to_string(MAX_URL_LENGTH) +
                             R"() UNIQUE NOT NULL,
-            content TEXT NOT NULL
+            content TEXT NOT NULL,
+            content_hash BIGINT,
+            etag TEXT,
+            last_modified TEXT
         )
     )";
 
     txn.exec(sql);
+
+    // Миграция для баз, созданных до появления хеша содержимого и валидаторов
+    txn.exec("ALTER TABLE documents ADD COLUMN IF NOT EXISTS content_hash BIGINT");
+    txn.exec("ALTER TABLE documents ADD COLUMN IF NOT EXISTS etag TEXT");
+    txn.exec("ALTER TABLE documents ADD COLUMN IF NOT EXISTS last_modified TEXT");
 }
 
 void DatabaseConnection::createWordsTable(pqxx::work& txn) {
@@ -90,6 +101,48 @@ void DatabaseConnection::createWordFrequenciesTable(pqxx::work& txn) {
     txn.exec(sql);
 }
 
+void DatabaseConnection::createWordPostingsTable(pqxx::work& txn) {
+    // Альтернатива word_frequencies: все постинги слова одним закодированным blob
+    // (см. PostingListCodec); last_document_id позволяет дописывать без декодирования
+    const std::string sql = R"(
+        CREATE TABLE IF NOT EXISTS word_postings (
+            word_id BIGINT PRIMARY KEY REFERENCES words(id) ON DELETE CASCADE,
+            document_count INTEGER NOT NULL,
+            last_document_id BIGINT NOT NULL,
+            postings BYTEA NOT NULL
+        )
+    )";
+
+    txn.exec(sql);
+
+    // varint почти не сжимается: отключаем сжатие TOAST, чтобы не тратить на него CPU
+    txn.exec("ALTER TABLE word_postings ALTER COLUMN postings SET STORAGE EXTERNAL");
+}
+
+void DatabaseConnection::createRevisitScheduleTable(pqxx::work& txn) {
+    static constexpr int MAX_URL_LENGTH = 2048;
+
+    const std::string sql = R"(
+        CREATE TABLE IF NOT EXISTS revisit_schedule (
+            url VARCHAR()" + std::to_string(MAX_URL_LENGTH) +
+                            R"() PRIMARY KEY,
+            visit_count INTEGER NOT NULL,
+            change_count INTEGER NOT NULL,
+            observed_seconds DOUBLE PRECISION NOT NULL,
+            last_visit_at BIGINT NOT NULL,
+            next_visit_at BIGINT NOT NULL
+        )
+    )";
+
+    txn.exec(sql);
+}
+
+void DatabaseConnection::createIndexGenerationSequence(pqxx::work& txn) {
+    // Поколение индекса - последовательность, а не строка таблицы: nextval не берёт
+    // блокировку строки и не откатывается, поэтому потоки Spider не ждут друг друга
+    txn.exec("CREATE SEQUENCE IF NOT EXISTS index_generation");
+}
+
 void DatabaseConnection::createIndexes(pqxx::work& txn) {
     // Индекс на url для быстрого поиска документов по URL
     txn.exec(R"(
@@ -103,16 +156,24 @@ void DatabaseConnection::createIndexes(pqxx::work& txn) {
         ON words(text)
     )");
 
-    // Индекс на word_id для быстрого поиска по словам
+    // Постинги слова по возрастанию document_id вместе с частотой: поиск читает
+    // их index-only scan без сортировки. Заменяет прежний индекс только по word_id
     txn.exec(R"(
-        CREATE INDEX IF NOT EXISTS idx_word_frequencies_word_id
-        ON word_frequencies(word_id)
+        CREATE INDEX IF NOT EXISTS idx_word_frequencies_word_document
+        ON word_frequencies(word_id, document_id) INCLUDE (frequency)
     )");
+    txn.exec("DROP INDEX IF EXISTS idx_word_frequencies_word_id");
 
     // Индекс на document_id для быстрого поиска по документам
     txn.exec(R"(
         CREATE INDEX IF NOT EXISTS idx_word_frequencies_document_id
         ON word_frequencies(document_id)
     )");
+
+    // Индекс на next_visit_at - очередь повторных посещений по времени
+    txn.exec(R"(
+        CREATE INDEX IF NOT EXISTS idx_revisit_schedule_next_visit_at
+        ON revisit_schedule(next_visit_at)
+    )");
 }
 } // namespace Infrastructure::Database
@@ -45,7 +45,8 @@ class DatabaseConnection : public Core::Ports::IDatabaseConnection {
     /**
      * @brief Создаёт схему базы данных (таблицы и индексы)
      *
-     * Создаёт таблицы documents, words, word_frequencies если их нет.
+     * Создаёт таблицы documents, words, word_frequencies, word_postings,
+     * revisit_schedule и последовательность index_generation, если их нет.
      * Идемпотентная операция - можно вызывать многократно.
      */
     void createSchema() override;
@@ -72,6 +73,21 @@ class DatabaseConnection : public Core::Ports::IDatabaseConnection {
      */
     static void createWordFrequenciesTable(pqxx::work& txn);
 
+    /**
+     * @brief Выполняет SQL-запрос для создания таблицы word_postings
+     */
+    static void createWordPostingsTable(pqxx::work& txn);
+
+    /**
+     * @brief Выполняет SQL-запрос для создания таблицы revisit_schedule
+     */
+    static void createRevisitScheduleTable(pqxx::work& txn);
+
+    /**
+     * @brief Создаёт последовательность index_generation (поколение индекса)
+     */
+    static void createIndexGenerationSequence(pqxx::work& txn);
+
     /**
      * @brief Создаёт индексы для ускорения поиска
      */
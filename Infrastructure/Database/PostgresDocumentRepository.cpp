@@ -1,7 +1,10 @@
 #include "PostgresDocumentRepository.h"
 
+#include <cstring>
 #include <stdexcept>
 
+#include "../../Core/Ports/ITracer.h"
+
 namespace Infrastructure::Database {
 PostgresDocumentRepository::PostgresDocumentRepository(
     std::shared_ptr<DatabaseConnection> dbConnection)
@@ -13,6 +16,8 @@ PostgresDocumentRepository::PostgresDocumentRepository(
 
 Core::Domain::Model::Document::IdType PostgresDocumentRepository::save(
     Core::Domain::Model::Document& document) {
+    Core::Ports::TraceSpan span("db.document.save", "db", document.getUrl());
+
     if (!dbConnection_->isConnected()) {
         throw std::runtime_error("Нет соединения с базой данных");
     }
@@ -26,18 +31,25 @@ Core::Domain::Model::Document::IdType PostgresDocumentRepository::save(
 
         Core::Domain::Model::Document::IdType documentId = 0;
 
+        // Хеш исходного HTML (NULL, если не вычислен)
+        std::optional<int64_t> contentHash;
+        if (document.getContentHash().has_value()) {
+            contentHash = toDatabaseHash(document.getContentHash().value());
+        }
+
         if (!checkResult.empty()) {
             // Документ существует - обновляем его содержимое
             documentId = checkResult[0][0].as<Core::Domain::Model::Document::IdType>();
 
-            const std::string updateSql = "UPDATE documents SET content = $1 WHERE id = $2";
-            txn.exec(updateSql, pqxx::params(document.getContent(), documentId));
+            const std::string updateSql =
+                "UPDATE documents SET content = $1, content_hash = $2 WHERE id = $3";
+            txn.exec(updateSql, pqxx::params(document.getContent(), contentHash, documentId));
         } else {
             // Документ не существует - вставляем новый
             const std::string insertSql =
-                "INSERT INTO documents (url, content) VALUES ($1, $2) RETURNING id";
-            pqxx::result insertResult =
-                txn.exec(insertSql, pqxx::params(document.getUrl(), document.getContent()));
+                "INSERT INTO documents (url, content, content_hash) VALUES ($1, $2, $3) RETURNING id";
+            pqxx::result insertResult = txn.exec(
+                insertSql, pqxx::params(document.getUrl(), document.getContent(), contentHash));
 
             documentId = insertResult[0][0].as<Core::Domain::Model::Document::IdType>();
         }
@@ -62,16 +74,14 @@ std::optional<Core::Domain::Model::Document> PostgresDocumentRepository::findByI
     try {
         pqxx::work txn(dbConnection_->getConnection());
 
-        const std::string sql = "SELECT id, url, content FROM documents WHERE id = $1";
+        const std::string sql = "SELECT id, url, content, content_hash FROM documents WHERE id = $1";
         pqxx::result result = txn.exec(sql, pqxx::params(id));
 
         if (result.empty()) {
             return std::nullopt;
         }
 
-        const auto& row = result[0];
-        return Core::Domain::Model::Document(row[0].as<Core::Domain::Model::Document::IdType>(),
-                                             row[1].as<std::string>(), row[2].as<std::string>());
+        return documentFromRow(result[0]);
     } catch (const std::exception& e) {
         throw std::runtime_error("Ошибка при поиске документа по ID: " + std::string(e.what()));
     }
@@ -79,6 +89,8 @@ std::optional<Core::Domain::Model::Document> PostgresDocumentRepository::findByI
 
 std::optional<Core::Domain::Model::Document> PostgresDocumentRepository::findByUrl(
     const std::string& url) {
+    Core::Ports::TraceSpan span("db.document.find", "db", url);
+
     if (!dbConnection_->isConnected()) {
         throw std::runtime_error("Нет соединения с базой данных");
     }
@@ -86,16 +98,14 @@ std::optional<Core::Domain::Model::Document> PostgresDocumentRepository::findByU
     try {
         pqxx::work txn(dbConnection_->getConnection());
 
-        const std::string sql = "SELECT id, url, content FROM documents WHERE url = $1";
+        const std::string sql = "SELECT id, url, content, content_hash FROM documents WHERE url = $1";
         pqxx::result result = txn.exec(sql, pqxx::params(url));
 
         if (result.empty()) {
             return std::nullopt;
         }
 
-        const auto& row = result[0];
-        return Core::Domain::Model::Document(row[0].as<Core::Domain::Model::Document::IdType>(),
-                                             row[1].as<std::string>(), row[2].as<std::string>());
+        return documentFromRow(result[0]);
     } catch (const std::exception& e) {
         throw std::runtime_error("Ошибка при поиске документа по URL: " + std::string(e.what()));
     }
@@ -119,6 +129,111 @@ bool PostgresDocumentRepository::existsByUrl(const std::string& url) {
     }
 }
 
+std::optional<Core::DTO::DocumentStateDTO> PostgresDocumentRepository::findStateByUrl(
+    const std::string& url) {
+    Core::Ports::TraceSpan span("db.document.state", "db", url);
+
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        // Загружаем только ID, хеш и валидаторы - текст документа не нужен
+        const std::string sql =
+            "SELECT id, content_hash, etag, last_modified FROM documents WHERE url = $1";
+        pqxx::result result = txn.exec(sql, pqxx::params(url));
+
+        if (result.empty()) {
+            return std::nullopt;
+        }
+
+        const auto& row = result[0];
+
+        Core::DTO::DocumentStateDTO state;
+        state.documentId = row[0].as<Core::Domain::Model::Document::IdType>();
+        if (!row[1].is_null()) {
+            state.contentHash = fromDatabaseHash(row[1].as<int64_t>());
+        }
+        if (!row[2].is_null()) {
+            state.validators.etag = row[2].as<std::string>();
+        }
+        if (!row[3].is_null()) {
+            state.validators.lastModified = row[3].as<std::string>();
+        }
+
+        return state;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при получении состояния документа: " +
+                                 std::string(e.what()));
+    }
+}
+
+void PostgresDocumentRepository::updateCacheValidators(
+    Core::Domain::Model::Document::IdType id,
+    const Core::DTO::CacheValidatorsDTO& validators) {
+    Core::Ports::TraceSpan span("db.document.validators", "db");
+
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        std::optional<std::string> etag;
+        if (!validators.etag.empty()) {
+            etag = validators.etag;
+        }
+
+        std::optional<std::string> lastModified;
+        if (!validators.lastModified.empty()) {
+            lastModified = validators.lastModified;
+        }
+
+        const std::string sql = "UPDATE documents SET etag = $1, last_modified = $2 WHERE id = $3";
+        txn.exec(sql, pqxx::params(etag, lastModified, id));
+
+        txn.commit();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при сохранении валидаторов кеша: " + std::string(e.what()));
+    }
+}
+
+void PostgresDocumentRepository::updateContentState(
+    Core::Domain::Model::Document::IdType id,
+    Core::Domain::Model::Document::ContentHashType contentHash,
+    const Core::DTO::CacheValidatorsDTO& validators) {
+    Core::Ports::TraceSpan span("db.document.state.update", "db");
+
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        std::optional<std::string> etag;
+        if (!validators.etag.empty()) {
+            etag = validators.etag;
+        }
+
+        std::optional<std::string> lastModified;
+        if (!validators.lastModified.empty()) {
+            lastModified = validators.lastModified;
+        }
+
+        const std::string sql =
+            "UPDATE documents SET content_hash = $1, etag = $2, last_modified = $3 WHERE id = $4";
+        txn.exec(sql, pqxx::params(toDatabaseHash(contentHash), etag, lastModified, id));
+
+        txn.commit();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при сохранении состояния документа: " + std::string(e.what()));
+    }
+}
+
 std::vector<Core::Domain::Model::Document> PostgresDocumentRepository::findAll() {
     if (!dbConnection_->isConnected()) {
         throw std::runtime_error("Нет соединения с базой данных");
@@ -127,15 +242,14 @@ std::vector<Core::Domain::Model::Document> PostgresDocumentRepository::findAll()
     try {
         pqxx::work txn(dbConnection_->getConnection());
 
-        const std::string sql = "SELECT id, url, content FROM documents ORDER BY id";
+        const std::string sql = "SELECT id, url, content, content_hash FROM documents ORDER BY id";
         pqxx::result result = txn.exec(sql);
 
         std::vector<Core::Domain::Model::Document> documents;
         documents.reserve(result.size());
 
         for (const auto& row : result) {
-            documents.emplace_back(row[0].as<Core::Domain::Model::Document::IdType>(),
-                                   row[1].as<std::string>(), row[2].as<std::string>());
+            documents.push_back(documentFromRow(row));
         }
 
         return documents;
@@ -143,4 +257,29 @@ std::vector<Core::Domain::Model::Document> PostgresDocumentRepository::findAll()
         throw std::runtime_error("Ошибка при получении всех документов: " + std::string(e.what()));
     }
 }
+
+Core::Domain::Model::Document PostgresDocumentRepository::documentFromRow(const pqxx::row& row) {
+    Core::Domain::Model::Document document(row[0].as<Core::Domain::Model::Document::IdType>(),
+                                           row[1].as<std::string>(), row[2].as<std::string>());
+
+    if (!row[3].is_null()) {
+        document.setContentHash(fromDatabaseHash(row[3].as<int64_t>()));
+    }
+
+    return document;
+}
+
+int64_t PostgresDocumentRepository::toDatabaseHash(
+    Core::Domain::Model::Document::ContentHashType contentHash) {
+    int64_t value = 0;
+    std::memcpy(&value, &contentHash, sizeof(value));
+    return value;
+}
+
+Core::Domain::Model::Document::ContentHashType PostgresDocumentRepository::fromDatabaseHash(
+    int64_t value) {
+    Core::Domain::Model::Document::ContentHashType contentHash = 0;
+    std::memcpy(&contentHash, &value, sizeof(contentHash));
+    return contentHash;
+}
 } // namespace Infrastructure::Database
@@ -27,8 +27,9 @@ class PostgresDocumentRepository : public Core::Ports::IDocumentRepository {
      * @param document Документ для сохранения
      * @return ID сохраненного документа
      *
-     * Если документ с таким URL уже существует, обновляет его содержимое.
-     * Если документ новый, вставляет новую запись.
+     * Если документ с таким URL уже существует, обновляет его содержимое
+     * и хеш. Если документ новый, вставляет новую запись. Документ без хеша
+     * сохраняется с content_hash = NULL.
      */
     Core::Domain::Model::Document::IdType save(Core::Domain::Model::Document& document) override;
 
@@ -54,6 +55,33 @@ class PostgresDocumentRepository : public Core::Ports::IDocumentRepository {
      */
     bool existsByUrl(const std::string& url) override;
 
+    /**
+     * @brief Находит состояние документа по URL (ID, хеш содержимого, валидаторы)
+     * @param url URL документа
+     * @return Состояние документа, если документ существует
+     */
+    std::optional<Core::DTO::DocumentStateDTO> findStateByUrl(const std::string& url) override;
+
+    /**
+     * @brief Сохраняет HTTP-валидаторы кеша документа
+     * @param id ID документа
+     * @param validators ETag / Last-Modified последнего ответа
+     *
+     * Пустые значения сохраняются как NULL.
+     */
+    void updateCacheValidators(Core::Domain::Model::Document::IdType id,
+                               const Core::DTO::CacheValidatorsDTO& validators) override;
+
+    /**
+     * @brief Сохраняет хеш содержимого и HTTP-валидаторы документа одним UPDATE
+     * @param id ID документа
+     * @param contentHash Хеш исходного HTML
+     * @param validators ETag / Last-Modified последнего ответа
+     */
+    void updateContentState(Core::Domain::Model::Document::IdType id,
+                            Core::Domain::Model::Document::ContentHashType contentHash,
+                            const Core::DTO::CacheValidatorsDTO& validators) override;
+
     /**
      * @brief Находит все документы
      * @return Список всех документов
@@ -62,5 +90,23 @@ class PostgresDocumentRepository : public Core::Ports::IDocumentRepository {
 
   private:
     std::shared_ptr<DatabaseConnection> dbConnection_;
+
+    /**
+     * @brief Создаёт документ из строки результата (id, url, content, content_hash)
+     */
+    static Core::Domain::Model::Document documentFromRow(const pqxx::row& row);
+
+    /**
+     * @brief Преобразует хеш в значение BIGINT для хранения в БД
+     *
+     * PostgreSQL не имеет беззнакового 64-битного типа, поэтому хеш
+     * хранится с сохранением битового представления.
+     */
+    static int64_t toDatabaseHash(Core::Domain::Model::Document::ContentHashType contentHash);
+
+    /**
+     * @brief Преобразует значение BIGINT из БД обратно в хеш
+     */
+    static Core::Domain::Model::Document::ContentHashType fromDatabaseHash(int64_t value);
 };
 } // namespace Infrastructure::Database
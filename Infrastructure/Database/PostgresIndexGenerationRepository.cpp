@@ -0,0 +1,44 @@
+#include "PostgresIndexGenerationRepository.h"
+
+#include <stdexcept>
+
+namespace Infrastructure::Database {
+PostgresIndexGenerationRepository::PostgresIndexGenerationRepository(
+    std::shared_ptr<DatabaseConnection> dbConnection)
+    : dbConnection_(std::move(dbConnection)) {
+    if (!dbConnection_) {
+        throw std::invalid_argument("DatabaseConnection не может быть nullptr");
+    }
+}
+
+PostgresIndexGenerationRepository::GenerationType PostgresIndexGenerationRepository::getGeneration() {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::nontransaction txn(dbConnection_->getConnection());
+
+        // До первого nextval last_value уже равен начальному значению, но is_called = false
+        const pqxx::result result =
+            txn.exec("SELECT CASE WHEN is_called THEN last_value ELSE 0 END FROM index_generation");
+
+        return result[0][0].as<GenerationType>();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при чтении поколения индекса: " + std::string(e.what()));
+    }
+}
+
+void PostgresIndexGenerationRepository::bumpGeneration() {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::nontransaction txn(dbConnection_->getConnection());
+        txn.exec("SELECT nextval('index_generation')");
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при обновлении поколения индекса: " + std::string(e.what()));
+    }
+}
+} // namespace Infrastructure::Database
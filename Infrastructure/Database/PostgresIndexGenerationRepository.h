@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+
+#include "../../Core/Ports/IIndexGenerationRepository.h"
+#include "DatabaseConnection.h"
+
+namespace Infrastructure::Database {
+/**
+ * @brief PostgreSQL реализация счётчика поколений индекса
+ *
+ * Поколение хранится в последовательности index_generation. Увеличение
+ * выполняется вне транзакции, сразу после фиксации изменений индекса.
+ */
+class PostgresIndexGenerationRepository : public Core::Ports::IIndexGenerationRepository {
+  public:
+    /**
+     * @brief Конструктор
+     * @param dbConnection Соединение с базой данных
+     */
+    explicit PostgresIndexGenerationRepository(std::shared_ptr<DatabaseConnection> dbConnection);
+
+    ~PostgresIndexGenerationRepository() override = default;
+
+    /**
+     * @brief Читает текущее значение последовательности (0, пока она не увеличивалась)
+     */
+    GenerationType getGeneration() override;
+
+    /**
+     * @brief Увеличивает последовательность (nextval)
+     */
+    void bumpGeneration() override;
+
+  private:
+    std::shared_ptr<DatabaseConnection> dbConnection_;
+};
+} // namespace Infrastructure::Database
@@ -0,0 +1,371 @@
+#include "PostgresPackedWordRepository.h"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../../Core/Ports/ITracer.h"
+
+namespace Infrastructure::Database {
+namespace {
+/**
+ * @brief Дописывает в SQL плейсхолдеры строк VALUES: ($n::t1, $n+1::t2), ...
+ * @param sql Поток SQL-запроса
+ * @param rows Количество строк
+ * @param columnCasts Приведение типа для каждого столбца (например, "::bigint")
+ * @param firstParamIndex Номер первого параметра
+ */
+void appendRowPlaceholders(std::ostringstream& sql, size_t rows, const std::vector<std::string>& columnCasts,
+                           size_t firstParamIndex = 1) {
+    size_t paramIndex = firstParamIndex;
+
+    for (size_t row = 0; row < rows; ++row) {
+        sql << (row > 0 ? ", (" : "(");
+        for (size_t column = 0; column < columnCasts.size(); ++column) {
+            sql << (column > 0 ? ", $" : "$") << paramIndex++ << columnCasts[column];
+        }
+        sql << ")";
+    }
+}
+
+/**
+ * @brief Представление blob для передачи в запрос как bytea
+ */
+pqxx::bytes_view asBytesView(const PostingListCodec::Bytes& blob) {
+    return pqxx::bytes_view(blob.data(), blob.size());
+}
+} // namespace
+
+PostgresPackedWordRepository::PostgresPackedWordRepository(
+    std::shared_ptr<DatabaseConnection> dbConnection,
+    std::shared_ptr<QueryCancellationWatchdog> cancellationWatchdog)
+    : PostgresWordRepository(std::move(dbConnection), std::move(cancellationWatchdog)) {}
+
+void PostgresPackedWordRepository::saveFrequency(const Core::Domain::Model::WordFrequency& frequency) {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+        savePostings(txn, frequency.getDocumentId(), {{frequency.getWordId(), frequency.getFrequency()}});
+        txn.commit();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при сохранении частотности: " + std::string(e.what()));
+    }
+}
+
+void PostgresPackedWordRepository::saveWordFrequencies(Core::Domain::Model::Document::IdType documentId,
+                                                       const std::map<std::string, int>& wordFrequencies) {
+    Core::Ports::TraceSpan span("db.words.save", "db");
+
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    if (wordFrequencies.empty()) {
+        return;
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        const auto wordIds = upsertWords(txn, wordFrequencies);
+
+        std::vector<std::pair<WordIdType, FrequencyType>> postings;
+        postings.reserve(wordFrequencies.size());
+        for (const auto& [wordText, frequency] : wordFrequencies) {
+            postings.emplace_back(wordIds.at(wordText), frequency);
+        }
+
+        savePostings(txn, documentId, std::move(postings));
+        txn.commit();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при сохранении частотностей слов: " + std::string(e.what()));
+    }
+}
+
+std::vector<Core::Domain::Model::PostingList> PostgresPackedWordRepository::findPostings(
+    const std::vector<std::string>& words,
+    const Core::Ports::RequestDeadline& deadline) {
+    Core::Ports::TraceSpan span("db.postings.find", "db");
+
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    if (words.empty()) {
+        return {};
+    }
+
+    try {
+        // Запрос выполняется под сроком, а blob декодируется уже после освобождения соединения
+        auto blobs = runSearchQuery(deadline, [&words](pqxx::read_transaction& txn) {
+            std::ostringstream sql;
+            sql << R"(
+                SELECT w.text, wp.postings
+                FROM words w
+                INNER JOIN word_postings wp ON wp.word_id = w.id
+                WHERE w.text IN ()";
+            pqxx::params params;
+            for (size_t i = 0; i < words.size(); ++i) {
+                sql << (i > 0 ? ", $" : "$") << (i + 1);
+                params.append(words[i]);
+            }
+            sql << ")";
+
+            std::unordered_map<std::string, pqxx::bytes> rows;
+            for (const auto& row : txn.exec(sql.str(), params)) {
+                rows.emplace(row[0].as<std::string>(), row[1].as<pqxx::bytes>());
+            }
+            return rows;
+        });
+
+        std::vector<Core::Domain::Model::PostingList> postings;
+        postings.reserve(words.size());
+
+        for (const auto& word : words) {
+            const auto it = blobs.find(word);
+            if (it == blobs.end()) {
+                postings.emplace_back();
+                continue;
+            }
+
+            std::vector<DocumentIdType> documentIds;
+            std::vector<FrequencyType> frequencies;
+            PostingListCodec::Cursor cursor(it->second.data(), it->second.size());
+            PostingListCodec::Posting posting;
+            while (cursor.next(posting)) {
+                documentIds.push_back(posting.documentId);
+                frequencies.push_back(posting.frequency);
+            }
+
+            postings.emplace_back(std::move(documentIds), std::move(frequencies));
+        }
+
+        return postings;
+    } catch (const Core::Ports::RequestCancelledError&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при поиске постингов слов: " + std::string(e.what()));
+    }
+}
+
+PostgresPackedWordRepository::RebuildStatistics PostgresPackedWordRepository::rebuildFromRows() {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    struct PackedWord {
+        WordIdType wordId = 0;
+        int64_t documentCount = 0;
+        DocumentIdType lastDocumentId = 0;
+        PostingListCodec::Bytes blob;
+    };
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+        RebuildStatistics statistics;
+
+        txn.exec("TRUNCATE word_postings");
+
+        // Упакованные списки в разы меньше исходных строк, поэтому собираются в памяти:
+        // пока идёт потоковое чтение, другие запросы в этом соединении невозможны
+        std::vector<PackedWord> packedWords;
+
+        for (auto [wordId, documentId, frequency] : txn.stream<WordIdType, DocumentIdType, FrequencyType>(
+                 "SELECT word_id, document_id, frequency FROM word_frequencies ORDER BY word_id, document_id")) {
+            if (packedWords.empty() || packedWords.back().wordId != wordId) {
+                packedWords.emplace_back();
+                packedWords.back().wordId = wordId;
+            }
+
+            auto& packed = packedWords.back();
+            PostingListCodec::append(packed.blob, packed.lastDocumentId, {documentId, frequency});
+            packed.lastDocumentId = documentId;
+            packed.documentCount++;
+            statistics.postingCount++;
+        }
+
+        statistics.wordCount = static_cast<int64_t>(packedWords.size());
+
+        for (size_t begin = 0; begin < packedWords.size(); begin += BATCH_ROWS) {
+            const size_t end = std::min(packedWords.size(), begin + BATCH_ROWS);
+
+            std::ostringstream sql;
+            sql << "INSERT INTO word_postings (word_id, document_count, last_document_id, postings) VALUES ";
+            appendRowPlaceholders(sql, end - begin, {"::bigint", "::integer", "::bigint", "::bytea"});
+
+            pqxx::params params;
+            for (size_t i = begin; i < end; ++i) {
+                params.append(packedWords[i].wordId);
+                params.append(packedWords[i].documentCount);
+                params.append(packedWords[i].lastDocumentId);
+                params.append(asBytesView(packedWords[i].blob));
+            }
+
+            txn.exec(sql.str(), params);
+        }
+
+        const auto sizes = txn.exec(
+            "SELECT pg_total_relation_size('word_frequencies'), pg_total_relation_size('word_postings')");
+        statistics.rowStorageBytes = sizes[0][0].as<int64_t>();
+        statistics.packedStorageBytes = sizes[0][1].as<int64_t>();
+
+        txn.commit();
+        return statistics;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при перестроении упакованных постингов: " + std::string(e.what()));
+    }
+}
+
+void PostgresPackedWordRepository::savePostings(pqxx::work& txn, DocumentIdType documentId,
+                                                std::vector<std::pair<WordIdType, FrequencyType>> postings) {
+    Core::Ports::TraceSpan span("db.postings.save", "db");
+
+    // Строки слов блокируются в порядке word_id во всех потоках, что исключает взаимоблокировки
+    std::sort(postings.begin(), postings.end());
+
+    std::unordered_map<WordIdType, DocumentIdType> lastDocumentIds;
+
+    for (size_t begin = 0; begin < postings.size(); begin += BATCH_ROWS) {
+        const size_t end = std::min(postings.size(), begin + BATCH_ROWS);
+
+        std::ostringstream sql;
+        sql << "SELECT word_id, last_document_id FROM word_postings WHERE word_id IN (";
+        pqxx::params params;
+        for (size_t i = begin; i < end; ++i) {
+            sql << (i > begin ? ", $" : "$") << (i - begin + 1);
+            params.append(postings[i].first);
+        }
+        sql << ") ORDER BY word_id FOR UPDATE";
+
+        for (const auto& row : txn.exec(sql.str(), params)) {
+            lastDocumentIds.emplace(row[0].as<WordIdType>(), row[1].as<DocumentIdType>());
+        }
+    }
+
+    // Три случая: новое слово, дописывание в конец списка или перекодирование списка
+    struct EncodedPosting {
+        WordIdType wordId;
+        PostingListCodec::Posting posting;
+        PostingListCodec::Bytes blob;
+    };
+
+    std::vector<EncodedPosting> inserts;
+    std::vector<EncodedPosting> appends;
+    std::vector<std::pair<WordIdType, PostingListCodec::Posting>> merges;
+
+    for (const auto& [wordId, frequency] : postings) {
+        const PostingListCodec::Posting posting{documentId, frequency};
+        const auto it = lastDocumentIds.find(wordId);
+
+        if (it == lastDocumentIds.end()) {
+            inserts.push_back({wordId, posting, {}});
+            PostingListCodec::append(inserts.back().blob, 0, posting);
+        } else if (documentId > it->second) {
+            appends.push_back({wordId, posting, {}});
+            PostingListCodec::append(appends.back().blob, it->second, posting);
+        } else {
+            merges.emplace_back(wordId, posting);
+        }
+    }
+
+    for (size_t begin = 0; begin < inserts.size(); begin += BATCH_ROWS) {
+        const size_t end = std::min(inserts.size(), begin + BATCH_ROWS);
+
+        std::ostringstream sql;
+        sql << "INSERT INTO word_postings (word_id, document_count, last_document_id, postings) VALUES ";
+        appendRowPlaceholders(sql, end - begin, {"::bigint", "::integer", "::bigint", "::bytea"});
+        sql << " ON CONFLICT (word_id) DO NOTHING RETURNING word_id";
+
+        pqxx::params params;
+        for (size_t i = begin; i < end; ++i) {
+            params.append(inserts[i].wordId);
+            params.append(1);
+            params.append(documentId);
+            params.append(asBytesView(inserts[i].blob));
+        }
+
+        std::unordered_set<WordIdType> inserted;
+        for (const auto& row : txn.exec(sql.str(), params)) {
+            inserted.insert(row[0].as<WordIdType>());
+        }
+
+        // Слово успели вставить параллельно после нашей блокировки: сливаем с его списком
+        for (size_t i = begin; i < end; ++i) {
+            if (inserted.count(inserts[i].wordId) == 0) {
+                merges.emplace_back(inserts[i].wordId, inserts[i].posting);
+            }
+        }
+    }
+
+    for (size_t begin = 0; begin < appends.size(); begin += BATCH_ROWS) {
+        const size_t end = std::min(appends.size(), begin + BATCH_ROWS);
+
+        // $1 - ID документа, далее пары (word_id, дописываемые байты)
+        std::ostringstream sql;
+        sql << R"(
+            UPDATE word_postings AS wp
+            SET postings = wp.postings || v.postings,
+                document_count = wp.document_count + 1,
+                last_document_id = $1
+            FROM (VALUES )";
+        appendRowPlaceholders(sql, end - begin, {"::bigint", "::bytea"}, 2);
+        sql << R"() AS v(word_id, postings)
+            WHERE wp.word_id = v.word_id
+        )";
+
+        pqxx::params params;
+        params.append(documentId);
+        for (size_t i = begin; i < end; ++i) {
+            params.append(appends[i].wordId);
+            params.append(asBytesView(appends[i].blob));
+        }
+
+        txn.exec(sql.str(), params);
+    }
+
+    for (const auto& [wordId, posting] : merges) {
+        mergePosting(txn, wordId, posting);
+    }
+}
+
+void PostgresPackedWordRepository::mergePosting(pqxx::work& txn, WordIdType wordId,
+                                                const PostingListCodec::Posting& posting) {
+    const pqxx::result current = txn.exec(
+        "SELECT postings FROM word_postings WHERE word_id = $1 FOR UPDATE", pqxx::params(wordId));
+
+    std::vector<PostingListCodec::Posting> postings;
+    if (!current.empty()) {
+        const auto blob = current[0][0].as<pqxx::bytes>();
+        postings = PostingListCodec::decode(blob.data(), blob.size());
+    }
+
+    const auto it = std::lower_bound(postings.begin(), postings.end(), posting.documentId,
+                                     [](const PostingListCodec::Posting& lhs, DocumentIdType documentId) {
+                                         return lhs.documentId < documentId;
+                                     });
+
+    if (it != postings.end() && it->documentId == posting.documentId) {
+        it->frequency = posting.frequency;
+    } else {
+        postings.insert(it, posting);
+    }
+
+    const std::string sql = R"(
+        INSERT INTO word_postings (word_id, document_count, last_document_id, postings)
+        VALUES ($1, $2, $3, $4)
+        ON CONFLICT (word_id) DO UPDATE
+        SET document_count = EXCLUDED.document_count,
+            last_document_id = EXCLUDED.last_document_id,
+            postings = EXCLUDED.postings
+    )";
+
+    const auto blob = PostingListCodec::encode(postings);
+    txn.exec(sql, pqxx::params(wordId, static_cast<int64_t>(postings.size()), postings.back().documentId,
+                               asBytesView(blob)));
+}
+} // namespace Infrastructure::Database
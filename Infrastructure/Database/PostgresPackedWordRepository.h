@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "PostgresWordRepository.h"
+#include "PostingListCodec.h"
+
+namespace Infrastructure::Database {
+/**
+ * @brief PostgreSQL репозиторий слов с упакованными постингами
+ *
+ * Вместо строки word_frequencies на каждую пару (документ, слово) хранит
+ * одну строку word_postings на слово: все постинги слова в blob,
+ * закодированном PostingListCodec. URL документов читаются так же, как
+ * в PostgresWordRepository.
+ *
+ * Новые документы получают возрастающие ID, поэтому обычно постинг
+ * дописывается в конец blob без его чтения; переиндексация уже известного
+ * документа перекодирует список слова целиком.
+ */
+class PostgresPackedWordRepository : public PostgresWordRepository {
+  public:
+    using WordIdType = Core::Domain::Model::Word::IdType;
+    using DocumentIdType = PostingListCodec::DocumentIdType;
+    using FrequencyType = PostingListCodec::FrequencyType;
+
+    /**
+     * @brief Размеры хранилищ постингов после перестроения
+     */
+    struct RebuildStatistics {
+        int64_t wordCount = 0;
+        int64_t postingCount = 0;
+        int64_t rowStorageBytes = 0;     // word_frequencies вместе с индексами
+        int64_t packedStorageBytes = 0;  // word_postings вместе с индексами и TOAST
+    };
+
+    /**
+     * @brief Конструктор
+     * @param dbConnection Соединение с базой данных
+     * @param cancellationWatchdog Сторож отмены поисковых запросов (может быть nullptr)
+     */
+    explicit PostgresPackedWordRepository(
+        std::shared_ptr<DatabaseConnection> dbConnection,
+        std::shared_ptr<QueryCancellationWatchdog> cancellationWatchdog = nullptr);
+
+    ~PostgresPackedWordRepository() override = default;
+
+    /**
+     * @brief Сохраняет частотность слова в документе
+     */
+    void saveFrequency(const Core::Domain::Model::WordFrequency& frequency) override;
+
+    /**
+     * @brief Сохраняет частотности всех слов документа
+     * @param documentId ID документа
+     * @param wordFrequencies Карта: слово -> частота
+     */
+    void saveWordFrequencies(Core::Domain::Model::Document::IdType documentId,
+                             const std::map<std::string, int>& wordFrequencies) override;
+
+    /**
+     * @brief Находит постинги слов
+     *
+     * Читает blob каждого слова одним запросом и декодирует его в список.
+     */
+    std::vector<Core::Domain::Model::PostingList> findPostings(
+        const std::vector<std::string>& words, const Core::Ports::RequestDeadline& deadline) override;
+
+    /**
+     * @brief Перестраивает word_postings из word_frequencies
+     *
+     * Нужно один раз при переходе существующей базы на упакованное хранение:
+     * после перехода word_frequencies не обновляется, и повторное перестроение
+     * потеряло бы новые постинги.
+     * @return Количество слов и постингов и размеры обоих хранилищ
+     */
+    RebuildStatistics rebuildFromRows();
+
+  private:
+    // Строк в одном пакетном INSERT/UPDATE (ограничение на число параметров запроса)
+    static constexpr size_t BATCH_ROWS = 1000;
+
+    /**
+     * @brief Записывает постинги документа в word_postings
+     * @param txn Текущая транзакция
+     * @param documentId ID документа
+     * @param postings Пары {ID слова, частота}
+     */
+    static void savePostings(pqxx::work& txn, DocumentIdType documentId,
+                             std::vector<std::pair<WordIdType, FrequencyType>> postings);
+
+    /**
+     * @brief Вставляет или заменяет постинг документа с перекодированием всего списка слова
+     */
+    static void mergePosting(pqxx::work& txn, WordIdType wordId, const PostingListCodec::Posting& posting);
+};
+} // namespace Infrastructure::Database
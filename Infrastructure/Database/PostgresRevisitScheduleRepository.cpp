@@ -0,0 +1,149 @@
+#include "PostgresRevisitScheduleRepository.h"
+
+#include <stdexcept>
+
+namespace Infrastructure::Database {
+PostgresRevisitScheduleRepository::PostgresRevisitScheduleRepository(
+    std::shared_ptr<DatabaseConnection> dbConnection)
+    : dbConnection_(std::move(dbConnection)) {
+    if (!dbConnection_) {
+        throw std::invalid_argument("DatabaseConnection не может быть nullptr");
+    }
+}
+
+std::optional<Core::Domain::Model::RevisitSchedule> PostgresRevisitScheduleRepository::findByUrl(
+    const std::string& url) {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        const std::string sql = R"(
+            SELECT url, visit_count, change_count, observed_seconds, last_visit_at, next_visit_at
+            FROM revisit_schedule
+            WHERE url = $1
+        )";
+        pqxx::result result = txn.exec(sql, pqxx::params(url));
+
+        if (result.empty()) {
+            return std::nullopt;
+        }
+
+        return scheduleFromRow(result[0]);
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при поиске расписания посещения: " + std::string(e.what()));
+    }
+}
+
+void PostgresRevisitScheduleRepository::save(const Core::Domain::Model::RevisitSchedule& schedule) {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        const std::string sql = R"(
+            INSERT INTO revisit_schedule
+                (url, visit_count, change_count, observed_seconds, last_visit_at, next_visit_at)
+            VALUES ($1, $2, $3, $4, $5, $6)
+            ON CONFLICT (url) DO UPDATE SET
+                visit_count = EXCLUDED.visit_count,
+                change_count = EXCLUDED.change_count,
+                observed_seconds = EXCLUDED.observed_seconds,
+                last_visit_at = EXCLUDED.last_visit_at,
+                next_visit_at = EXCLUDED.next_visit_at
+        )";
+
+        txn.exec(sql, pqxx::params(schedule.getUrl(), schedule.getVisitCount(),
+                                   schedule.getChangeCount(), schedule.getObservedSeconds(),
+                                   schedule.getLastVisitAt(), schedule.getNextVisitAt()));
+        txn.commit();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при сохранении расписания посещения: " +
+                                 std::string(e.what()));
+    }
+}
+
+std::vector<Core::Domain::Model::RevisitSchedule> PostgresRevisitScheduleRepository::takeDue(
+    Core::Domain::Model::RevisitSchedule::TimestampType now,
+    size_t limit,
+    Core::Domain::Model::RevisitSchedule::TimestampType leaseUntil) {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        // RETURNING не гарантирует порядок - сортируем в обёртке
+        const std::string sql = R"(
+            WITH due AS (
+                SELECT url
+                FROM revisit_schedule
+                WHERE next_visit_at <= $1
+                ORDER BY next_visit_at
+                LIMIT $2
+                FOR UPDATE SKIP LOCKED
+            ), taken AS (
+                UPDATE revisit_schedule rs
+                SET next_visit_at = $3
+                FROM due
+                WHERE rs.url = due.url
+                RETURNING rs.url, rs.visit_count, rs.change_count, rs.observed_seconds,
+                          rs.last_visit_at, rs.next_visit_at
+            )
+            SELECT * FROM taken ORDER BY last_visit_at
+        )";
+
+        pqxx::result result =
+            txn.exec(sql, pqxx::params(now, static_cast<int64_t>(limit), leaseUntil));
+        txn.commit();
+
+        std::vector<Core::Domain::Model::RevisitSchedule> schedules;
+        schedules.reserve(result.size());
+
+        for (const auto& row : result) {
+            schedules.push_back(scheduleFromRow(row));
+        }
+
+        return schedules;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при извлечении страниц для посещения: " +
+                                 std::string(e.what()));
+    }
+}
+
+std::optional<Core::Domain::Model::RevisitSchedule::TimestampType>
+PostgresRevisitScheduleRepository::findNextVisitTime() {
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection_->getConnection());
+
+        pqxx::result result = txn.exec("SELECT MIN(next_visit_at) FROM revisit_schedule");
+
+        if (result.empty() || result[0][0].is_null()) {
+            return std::nullopt;
+        }
+
+        return result[0][0].as<Core::Domain::Model::RevisitSchedule::TimestampType>();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при поиске времени следующего посещения: " +
+                                 std::string(e.what()));
+    }
+}
+
+Core::Domain::Model::RevisitSchedule PostgresRevisitScheduleRepository::scheduleFromRow(
+    const pqxx::row& row) {
+    using Schedule = Core::Domain::Model::RevisitSchedule;
+
+    return Schedule(row[0].as<std::string>(), row[1].as<Schedule::CounterType>(),
+                    row[2].as<Schedule::CounterType>(), row[3].as<double>(),
+                    row[4].as<Schedule::TimestampType>(), row[5].as<Schedule::TimestampType>());
+}
+} // namespace Infrastructure::Database
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <memory>
+
+#include "../../Core/Ports/IRevisitScheduleRepository.h"
+#include "DatabaseConnection.h"
+
+namespace Infrastructure::Database {
+/**
+ * @brief PostgreSQL реализация репозитория расписаний повторного посещения
+ *
+ * Работает с таблицей revisit_schedule. Индекс по next_visit_at делает
+ * таблицу персистентной очередью с приоритетом по времени посещения.
+ */
+class PostgresRevisitScheduleRepository : public Core::Ports::IRevisitScheduleRepository {
+  public:
+    /**
+     * @brief Конструктор
+     * @param dbConnection Соединение с базой данных
+     */
+    explicit PostgresRevisitScheduleRepository(std::shared_ptr<DatabaseConnection> dbConnection);
+
+    ~PostgresRevisitScheduleRepository() override = default;
+
+    /**
+     * @brief Находит расписание страницы по URL
+     * @param url URL страницы
+     * @return Расписание, если страница уже посещалась
+     */
+    std::optional<Core::Domain::Model::RevisitSchedule> findByUrl(const std::string& url) override;
+
+    /**
+     * @brief Сохраняет расписание (INSERT ... ON CONFLICT)
+     * @param schedule Расписание для сохранения
+     */
+    void save(const Core::Domain::Model::RevisitSchedule& schedule) override;
+
+    /**
+     * @brief Извлекает страницы, время посещения которых наступило
+     * @param now Текущее время (секунды с начала эпохи)
+     * @param limit Максимальное количество страниц
+     * @param leaseUntil Новое время посещения извлечённых страниц
+     * @return Расписания в порядке возрастания времени посещения
+     *
+     * Выборка и перенос времени выполняются одним UPDATE ... RETURNING.
+     * FOR UPDATE SKIP LOCKED позволяет нескольким процессам Spider
+     * извлекать страницы без пересечений.
+     */
+    std::vector<Core::Domain::Model::RevisitSchedule> takeDue(
+        Core::Domain::Model::RevisitSchedule::TimestampType now,
+        size_t limit,
+        Core::Domain::Model::RevisitSchedule::TimestampType leaseUntil) override;
+
+    /**
+     * @brief Возвращает ближайшее запланированное время посещения
+     * @return Время посещения, если расписания есть
+     */
+    std::optional<Core::Domain::Model::RevisitSchedule::TimestampType> findNextVisitTime() override;
+
+  private:
+    std::shared_ptr<DatabaseConnection> dbConnection_;
+
+    /**
+     * @brief Создаёт расписание из строки результата
+     */
+    static Core::Domain::Model::RevisitSchedule scheduleFromRow(const pqxx::row& row);
+};
+} // namespace Infrastructure::Database
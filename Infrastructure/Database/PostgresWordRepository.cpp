@@ -2,10 +2,15 @@
 
 #include <sstream>
 #include <stdexcept>
+#include <utility>
+
+#include "../../Core/Ports/ITracer.h"
+#include "../Logging/Logger.h"
 
 namespace Infrastructure::Database {
-PostgresWordRepository::PostgresWordRepository(std::shared_ptr<DatabaseConnection> dbConnection)
-    : dbConnection_(std::move(dbConnection)) {
+PostgresWordRepository::PostgresWordRepository(std::shared_ptr<DatabaseConnection> dbConnection,
+                                               std::shared_ptr<QueryCancellationWatchdog> cancellationWatchdog)
+    : dbConnection_(std::move(dbConnection)), cancellationWatchdog_(std::move(cancellationWatchdog)) {
     if (!dbConnection_) {
         throw std::invalid_argument("DatabaseConnection не может быть nullptr");
     }
@@ -92,6 +97,8 @@ void PostgresWordRepository::saveFrequency(const Core::Domain::Model::WordFreque
 void PostgresWordRepository::saveWordFrequencies(
     Core::Domain::Model::Document::IdType documentId,
     const std::map<std::string, int>& wordFrequencies) {
+    Core::Ports::TraceSpan span("db.words.save", "db");
+
     if (!dbConnection_->isConnected()) {
         throw std::runtime_error("Нет соединения с базой данных");
     }
@@ -104,19 +111,7 @@ void PostgresWordRepository::saveWordFrequencies(
         pqxx::work txn(dbConnection_->getConnection());
 
         // Шаг 1: Создаём все слова (если не существуют) и получаем их ID
-        std::map<std::string, Core::Domain::Model::Word::IdType> wordIds;
-
-        for (const auto& [wordText, frequency] : wordFrequencies) {
-            const std::string wordSql = R"(
-                INSERT INTO words (text)
-                VALUES ($1)
-                ON CONFLICT (text) DO UPDATE SET text = EXCLUDED.text
-                RETURNING id
-            )";
-
-            pqxx::result wordResult = txn.exec(wordSql, pqxx::params(wordText));
-            wordIds[wordText] = wordResult[0][0].as<Core::Domain::Model::Word::IdType>();
-        }
+        auto wordIds = upsertWords(txn, wordFrequencies);
 
         // Шаг 2: Пакетная вставка частотностей
         // Строим один большой INSERT для всех записей
@@ -152,6 +147,8 @@ void PostgresWordRepository::saveWordFrequencies(
 
         // Выполняем пакетную вставку
         if (!allParams.empty()) {
+            Core::Ports::TraceSpan insertSpan("db.frequencies.insert", "db");
+
             // Создаём params с правильным количеством параметров
             pqxx::params params;
             for (const auto& param : allParams) {
@@ -168,8 +165,11 @@ void PostgresWordRepository::saveWordFrequencies(
     }
 }
 
-std::vector<Core::Domain::Model::SearchResult> PostgresWordRepository::search(
-    const std::vector<std::string>& words) {
+std::vector<Core::Domain::Model::PostingList> PostgresWordRepository::findPostings(
+    const std::vector<std::string>& words,
+    const Core::Ports::RequestDeadline& deadline) {
+    Core::Ports::TraceSpan span("db.postings.find", "db");
+
     if (!dbConnection_->isConnected()) {
         throw std::runtime_error("Нет соединения с базой данных");
     }
@@ -179,64 +179,117 @@ std::vector<Core::Domain::Model::SearchResult> PostgresWordRepository::search(
     }
 
     try {
-        pqxx::work txn(dbConnection_->getConnection());
+        return runSearchQuery(deadline, [&words](pqxx::read_transaction& txn) {
+            // Постинги всех слов одним запросом, по возрастанию document_id внутри слова
+            // (index-only scan по idx_word_frequencies_word_document)
+            std::ostringstream sql;
+            sql << R"(
+                SELECT w.text, wf.document_id, wf.frequency
+                FROM words w
+                INNER JOIN word_frequencies wf ON wf.word_id = w.id
+                WHERE w.text IN ()";
 
-        // Сложный SQL-запрос для поиска документов, содержащих ВСЕ указанные слова
-        // Используем GROUP BY и HAVING для проверки, что документ содержит все
-        // слова
-        std::ostringstream sql;
-        sql << R"(
-            SELECT
-                d.id AS document_id,
-                d.url,
-                SUM(wf.frequency) AS relevance
-            FROM documents d
-            INNER JOIN word_frequencies wf ON d.id = wf.document_id
-            INNER JOIN words w ON wf.word_id = w.id
-            WHERE w.text IN (
-        )";
+            pqxx::params params;
+            for (size_t i = 0; i < words.size(); ++i) {
+                sql << (i > 0 ? ", $" : "$") << (i + 1);
+                params.append(words[i]);
+            }
+            sql << R"()
+                ORDER BY w.id, wf.document_id
+            )";
 
-        // Добавляем плейсхолдеры для слов
-        for (size_t i = 0; i < words.size(); ++i) {
-            if (i > 0) {
-                sql << ", ";
+            using DocumentIdType = Core::Domain::Model::PostingList::DocumentIdType;
+            using FrequencyType = Core::Domain::Model::PostingList::FrequencyType;
+            std::map<std::string, std::pair<std::vector<DocumentIdType>, std::vector<FrequencyType>>> lists;
+
+            for (const auto& row : txn.exec(sql.str(), params)) {
+                auto& [documentIds, frequencies] = lists[row[0].as<std::string>()];
+                documentIds.push_back(row[1].as<DocumentIdType>());
+                frequencies.push_back(row[2].as<FrequencyType>());
             }
-            sql << "$" << (i + 1);
-        }
 
-        sql << R"(
-            )
-            GROUP BY d.id, d.url
-            HAVING COUNT(DISTINCT w.id) = $)"
-            << (words.size() + 1) << R"(
-            ORDER BY relevance DESC
-        )";
+            std::vector<Core::Domain::Model::PostingList> postings;
+            postings.reserve(words.size());
+
+            for (const auto& word : words) {
+                auto it = lists.find(word);
+                if (it == lists.end()) {
+                    postings.emplace_back();
+                } else {
+                    postings.emplace_back(std::move(it->second.first), std::move(it->second.second));
+                    lists.erase(it);
+                }
+            }
 
-        // Создаём параметры
-        pqxx::params params;
-        for (const auto& word : words) {
-            params.append(word);
-        }
-        params.append(static_cast<int64_t>(words.size()));
+            return postings;
+        });
+    } catch (const Core::Ports::RequestCancelledError&) {
+        throw;
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при поиске постингов слов: " + std::string(e.what()));
+    }
+}
+
+std::unordered_map<Core::Domain::Model::Document::IdType, std::string> PostgresWordRepository::findDocumentUrls(
+    const std::vector<Core::Domain::Model::Document::IdType>& documentIds,
+    const Core::Ports::RequestDeadline& deadline) {
+    Core::Ports::TraceSpan span("db.documents.urls", "db");
+
+    if (!dbConnection_->isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
 
-        pqxx::result result = txn.exec(sql.str(), params);
+    if (documentIds.empty()) {
+        return {};
+    }
 
-        // Преобразуем результаты в SearchResult
-        std::vector<Core::Domain::Model::SearchResult> results;
-        results.reserve(result.size());
+    try {
+        return runSearchQuery(deadline, [&documentIds](pqxx::read_transaction& txn) {
+            // ID передаются одним параметром-массивом, а не плейсхолдером на каждый документ
+            std::ostringstream idArray;
+            idArray << "{";
+            for (size_t i = 0; i < documentIds.size(); ++i) {
+                idArray << (i > 0 ? "," : "") << documentIds[i];
+            }
+            idArray << "}";
 
-        for (const auto& row : result) {
-            results.emplace_back(row[0].as<Core::Domain::Model::SearchResult::DocumentIdType>(),
-                                 row[1].as<std::string>(),
-                                 row[2].as<Core::Domain::Model::SearchResult::RelevanceType>());
-        }
+            std::unordered_map<Core::Domain::Model::Document::IdType, std::string> urls;
+            urls.reserve(documentIds.size());
+            const std::string sql = "SELECT id, url FROM documents WHERE id = ANY($1::bigint[])";
+            for (const auto& row : txn.exec(sql, pqxx::params(idArray.str()))) {
+                urls.emplace(row[0].as<Core::Domain::Model::Document::IdType>(), row[1].as<std::string>());
+            }
 
-        return results;
+            return urls;
+        });
+    } catch (const Core::Ports::RequestCancelledError&) {
+        throw;
     } catch (const std::exception& e) {
-        throw std::runtime_error("Ошибка при поиске документов: " + std::string(e.what()));
+        throw std::runtime_error("Ошибка при загрузке URL документов: " + std::string(e.what()));
     }
 }
 
+std::map<std::string, Core::Domain::Model::Word::IdType> PostgresWordRepository::upsertWords(
+    pqxx::work& txn, const std::map<std::string, int>& wordFrequencies) {
+    Core::Ports::TraceSpan span("db.words.upsert", "db");
+
+    std::map<std::string, Core::Domain::Model::Word::IdType> wordIds;
+
+    for (const auto& [wordText, frequency] : wordFrequencies) {
+        const std::string wordSql = R"(
+            INSERT INTO words (text)
+            VALUES ($1)
+            ON CONFLICT (text) DO UPDATE SET text = EXCLUDED.text
+            RETURNING id
+        )";
+
+        pqxx::result wordResult = txn.exec(wordSql, pqxx::params(wordText));
+        wordIds[wordText] = wordResult[0][0].as<Core::Domain::Model::Word::IdType>();
+    }
+
+    return wordIds;
+}
+
 Core::Domain::Model::Word::IdType PostgresWordRepository::getOrCreateWordId(
     const std::string& text) {
     const std::string sql = R"(
@@ -252,4 +305,25 @@ Core::Domain::Model::Word::IdType PostgresWordRepository::getOrCreateWordId(
 
     return result[0][0].as<Core::Domain::Model::Word::IdType>();
 }
+
+void PostgresWordRepository::drainCancel(
+    pqxx::connection& connection,
+    std::optional<QueryCancellationWatchdog::Registration>& registration) noexcept {
+    if (!registration.has_value() || !registration->release()) {
+        return;
+    }
+
+    // Отмена либо уже прервала запрос, либо прервёт этот пустой запрос, либо
+    // придёт к простаивающему соединению и будет сервером проигнорирована
+    try {
+        pqxx::nontransaction txn(connection);
+        txn.exec("SELECT 1");
+    } catch (const pqxx::sql_error& e) {
+        if (e.sqlstate() != QUERY_CANCELED_SQLSTATE) {
+            LOG_WARNING("database", "Ошибка запроса после отмены поиска: ", e.what());
+        }
+    } catch (const std::exception& e) {
+        LOG_WARNING("database", "Ошибка запроса после отмены поиска: ", e.what());
+    }
+}
 } // namespace Infrastructure::Database
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
 
 #include "../../Core/Ports/IWordRepository.h"
 #include "DatabaseConnection.h"
+#include "QueryCancellationWatchdog.h"
 
 namespace Infrastructure::Database {
 /**
@@ -11,14 +17,21 @@ namespace Infrastructure::Database {
  *
  * Работает с таблицами words и word_frequencies.
  * Реализует операции сохранения слов, частотности и сложные поисковые запросы.
+ *
+ * Поисковые запросы выполняются по очереди (соединение одно, а ищут несколько
+ * потоков сервера) и ограничены сроком запроса: ожидание соединения - до срока,
+ * statement_timeout - на остаток срока, а сторож отмены прерывает запрос,
+ * если клиент отключился.
  */
 class PostgresWordRepository : public Core::Ports::IWordRepository {
   public:
     /**
      * @brief Конструктор
      * @param dbConnection Соединение с базой данных
+     * @param cancellationWatchdog Сторож отмены поисковых запросов (может быть nullptr)
      */
-    explicit PostgresWordRepository(std::shared_ptr<DatabaseConnection> dbConnection);
+    explicit PostgresWordRepository(std::shared_ptr<DatabaseConnection> dbConnection,
+                                    std::shared_ptr<QueryCancellationWatchdog> cancellationWatchdog = nullptr);
 
     ~PostgresWordRepository() override = default;
 
@@ -59,20 +72,104 @@ class PostgresWordRepository : public Core::Ports::IWordRepository {
                              const std::map<std::string, int>& wordFrequencies) override;
 
     /**
-     * @brief Ищет документы, содержащие все указанные слова
-     * @param words Список слов для поиска
-     * @return Список результатов поиска с релевантностью
+     * @brief Находит постинги слов
+     * @param words Слова (нормализованные, в нижнем регистре)
+     * @return Списки постингов в порядке слов; для неизвестного слова - пустой список
      *
-     * Выполняет сложный JOIN-запрос для поиска документов, содержащих ВСЕ слова.
-     * Релевантность рассчитывается как сумма частот всех найденных слов.
-     * Результаты сортируются по релевантности (по убыванию).
+     * Читает строки word_frequencies всех слов одним запросом, упорядоченными
+     * по слову и document_id. Пересечение списков выполняет вызывающий код.
      */
-    std::vector<Core::Domain::Model::SearchResult> search(
-        const std::vector<std::string>& words) override;
+    std::vector<Core::Domain::Model::PostingList> findPostings(
+        const std::vector<std::string>& words, const Core::Ports::RequestDeadline& deadline) override;
 
-  private:
+    /**
+     * @brief Находит URL документов одним запросом
+     * @param documentIds ID документов
+     * @return Карта: ID документа -> URL
+     */
+    std::unordered_map<Core::Domain::Model::Document::IdType, std::string> findDocumentUrls(
+        const std::vector<Core::Domain::Model::Document::IdType>& documentIds,
+        const Core::Ports::RequestDeadline& deadline) override;
+
+  protected:
     std::shared_ptr<DatabaseConnection> dbConnection_;
 
+    /**
+     * @brief Выполняет поисковый запрос в читающей транзакции с учётом срока запроса
+     * @param deadline Срок запроса
+     * @param query Функция, выполняющая запрос: query(pqxx::read_transaction&)
+     * @return Результат query
+     * @throws Core::Ports::RequestCancelledError если срок истёк или запрос отменён
+     */
+    template <typename Function>
+    auto runSearchQuery(const Core::Ports::RequestDeadline& deadline, Function&& query) {
+        std::unique_lock<std::timed_mutex> lock(searchMutex_, std::defer_lock);
+        if (!deadline.hasExpiry()) {
+            lock.lock();
+        } else if (!lock.try_lock_until(deadline.getExpiresAt())) {
+            throw Core::Ports::RequestCancelledError("Истёк срок ожидания соединения с базой данных");
+        }
+        deadline.throwIfCancelled();
+
+        pqxx::connection& connection = dbConnection_->getConnection();
+
+        // Регистрация снимается раньше, чем освобождается соединение
+        std::optional<QueryCancellationWatchdog::Registration> registration;
+        if (cancellationWatchdog_ && deadline.isCancellable()) {
+            registration.emplace(cancellationWatchdog_->watch(connection, deadline));
+        }
+
+        try {
+            auto result = [&] {
+                pqxx::read_transaction txn(connection);
+                if (deadline.hasExpiry()) {
+                    // SET LOCAL действует до конца транзакции; 0 означал бы "без ограничения"
+                    const int64_t timeoutMs = std::max<int64_t>(deadline.getRemaining().count(), 1);
+                    txn.exec("SET LOCAL statement_timeout = " + std::to_string(timeoutMs));
+                }
+                return query(txn);
+            }();
+            drainCancel(connection, registration);
+            return result;
+        } catch (const pqxx::sql_error& e) {
+            drainCancel(connection, registration);
+            // query_canceled: statement_timeout или отмена сторожем
+            if (e.sqlstate() == QUERY_CANCELED_SQLSTATE) {
+                throw Core::Ports::RequestCancelledError("Запрос к базе данных прерван: " + std::string(e.what()));
+            }
+            throw;
+        } catch (...) {
+            drainCancel(connection, registration);
+            throw;
+        }
+    }
+
+    /**
+     * @brief Создаёт слова (если не существуют) и возвращает их ID
+     * @param txn Текущая транзакция
+     * @param wordFrequencies Карта: слово -> частота
+     * @return Карта: слово -> ID слова
+     */
+    static std::map<std::string, Core::Domain::Model::Word::IdType> upsertWords(
+        pqxx::work& txn, const std::map<std::string, int>& wordFrequencies);
+
+  private:
+    static constexpr const char* QUERY_CANCELED_SQLSTATE = "57014";
+
+    std::shared_ptr<QueryCancellationWatchdog> cancellationWatchdog_;
+    std::timed_mutex searchMutex_;
+
+    /**
+     * @brief Снимает регистрацию запроса у сторожа и поглощает отправленную им отмену
+     *
+     * Отмена доходит до сервера асинхронно: без пустого запроса она могла бы
+     * прервать следующий поиск на том же соединении. Не бросает исключений.
+     * @param connection Соединение поискового запроса (searchMutex_ захвачен)
+     * @param registration Регистрация запроса (может быть пустой)
+     */
+    static void drainCancel(pqxx::connection& connection,
+                            std::optional<QueryCancellationWatchdog::Registration>& registration) noexcept;
+
     /**
      * @brief Получает ID слова, создавая его при необходимости
      * @param text Текст слова
@@ -0,0 +1,79 @@
+#include "PostingListCodec.h"
+
+#include <stdexcept>
+
+namespace Infrastructure::Database {
+void PostingListCodec::append(Bytes& blob, DocumentIdType previousDocumentId, const Posting& posting) {
+    if (posting.documentId <= previousDocumentId) {
+        throw std::invalid_argument("Постинги должны добавляться по возрастанию ID документа");
+    }
+
+    appendVarint(blob, static_cast<uint64_t>(posting.documentId - previousDocumentId));
+    appendVarint(blob, static_cast<uint32_t>(posting.frequency));
+}
+
+PostingListCodec::Bytes PostingListCodec::encode(const std::vector<Posting>& postings) {
+    Bytes blob;
+    // Типичный постинг занимает 2-3 байта
+    blob.reserve(postings.size() * 3);
+
+    DocumentIdType previousDocumentId = 0;
+    for (const auto& posting : postings) {
+        append(blob, previousDocumentId, posting);
+        previousDocumentId = posting.documentId;
+    }
+
+    return blob;
+}
+
+std::vector<PostingListCodec::Posting> PostingListCodec::decode(const std::byte* data, size_t size) {
+    std::vector<Posting> postings;
+    postings.reserve(size / 2);
+
+    Cursor cursor(data, size);
+    Posting posting;
+    while (cursor.next(posting)) {
+        postings.push_back(posting);
+    }
+
+    return postings;
+}
+
+bool PostingListCodec::Cursor::next(Posting& posting) {
+    if (data_ == end_) {
+        return false;
+    }
+
+    documentId_ += static_cast<DocumentIdType>(readVarint());
+    posting.documentId = documentId_;
+    posting.frequency = static_cast<FrequencyType>(readVarint());
+    return true;
+}
+
+uint64_t PostingListCodec::Cursor::readVarint() {
+    uint64_t value = 0;
+
+    for (int shift = 0; shift <= VARINT_MAX_SHIFT; shift += VARINT_PAYLOAD_BITS) {
+        if (data_ == end_) {
+            throw std::runtime_error("Повреждён список постингов: обрыв varint");
+        }
+
+        const auto byte = static_cast<unsigned>(*data_++);
+        value |= static_cast<uint64_t>(byte & VARINT_PAYLOAD_MASK) << shift;
+
+        if ((byte & VARINT_CONTINUATION_BIT) == 0) {
+            return value;
+        }
+    }
+
+    throw std::runtime_error("Повреждён список постингов: слишком длинный varint");
+}
+
+void PostingListCodec::appendVarint(Bytes& blob, uint64_t value) {
+    while (value >= VARINT_CONTINUATION_BIT) {
+        blob.push_back(static_cast<std::byte>((value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUATION_BIT));
+        value >>= VARINT_PAYLOAD_BITS;
+    }
+    blob.push_back(static_cast<std::byte>(value));
+}
+} // namespace Infrastructure::Database
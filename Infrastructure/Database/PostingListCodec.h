@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../Core/Domain/Model/WordFrequency.h"
+
+namespace Infrastructure::Database {
+/**
+ * @brief Кодирование списка постингов слова в компактный blob
+ *
+ * Постинги отсортированы по ID документа; каждый кодируется парой varint:
+ * разность ID с предыдущим постингом (для первого - сам ID) и частота.
+ * Количество постингов в blob не хранится, поэтому новый постинг с ID больше
+ * последнего дописывается в конец без перекодирования списка.
+ */
+class PostingListCodec {
+  public:
+    using Bytes = std::basic_string<std::byte>;
+    using DocumentIdType = Core::Domain::Model::WordFrequency::DocumentIdType;
+    using FrequencyType = Core::Domain::Model::WordFrequency::FrequencyType;
+
+    /**
+     * @brief Постинг: документ и частота слова в нём
+     */
+    struct Posting {
+        DocumentIdType documentId = 0;
+        FrequencyType frequency = 0;
+    };
+
+    /**
+     * @brief Дописывает постинг в конец blob
+     * @param blob Закодированный список
+     * @param previousDocumentId ID последнего документа в blob (0 для пустого)
+     * @param posting Постинг; ID документа должен быть больше previousDocumentId
+     */
+    static void append(Bytes& blob, DocumentIdType previousDocumentId, const Posting& posting);
+
+    /**
+     * @brief Кодирует отсортированный по ID документа список постингов
+     */
+    static Bytes encode(const std::vector<Posting>& postings);
+
+    /**
+     * @brief Декодирует список постингов целиком
+     * @throws std::runtime_error если blob повреждён
+     */
+    static std::vector<Posting> decode(const std::byte* data, size_t size);
+
+    /**
+     * @brief Последовательное декодирование без материализации списка
+     */
+    class Cursor {
+      public:
+        Cursor(const std::byte* data, size_t size) : data_(data), end_(data + size) {}
+
+        /**
+         * @brief Декодирует следующий постинг
+         * @return false, если список закончился
+         * @throws std::runtime_error если blob повреждён
+         */
+        bool next(Posting& posting);
+
+      private:
+        const std::byte* data_;
+        const std::byte* end_;
+        DocumentIdType documentId_ = 0;
+
+        uint64_t readVarint();
+    };
+
+  private:
+    static constexpr int VARINT_PAYLOAD_BITS = 7;
+    static constexpr unsigned VARINT_PAYLOAD_MASK = 0x7FU;
+    static constexpr unsigned VARINT_CONTINUATION_BIT = 0x80U;
+    static constexpr int VARINT_MAX_SHIFT = 63;
+
+    static void appendVarint(Bytes& blob, uint64_t value);
+};
+} // namespace Infrastructure::Database
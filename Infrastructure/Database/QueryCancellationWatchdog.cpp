@@ -0,0 +1,88 @@
+#include "QueryCancellationWatchdog.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "../Logging/Logger.h"
+
+namespace Infrastructure::Database {
+QueryCancellationWatchdog::Registration::~Registration() {
+    release();
+}
+
+bool QueryCancellationWatchdog::Registration::release() {
+    if (watchdog_ == nullptr) {
+        return false;
+    }
+
+    auto* watchdog = std::exchange(watchdog_, nullptr);
+    return watchdog->unregister(entry_);
+}
+
+QueryCancellationWatchdog::Registration::Registration(Registration&& other) noexcept
+    : watchdog_(other.watchdog_), entry_(other.entry_) {
+    other.watchdog_ = nullptr;
+}
+
+QueryCancellationWatchdog::QueryCancellationWatchdog(std::chrono::milliseconds pollInterval)
+    : pollInterval_(std::max(pollInterval, std::chrono::milliseconds(1))) {
+    thread_ = std::thread([this] { run(); });
+}
+
+QueryCancellationWatchdog::~QueryCancellationWatchdog() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wakeUp_.notify_one();
+    thread_.join();
+}
+
+QueryCancellationWatchdog::Registration QueryCancellationWatchdog::watch(
+    pqxx::connection& connection, const Core::Ports::RequestDeadline& deadline) {
+    std::list<Entry>::iterator entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entry = entries_.insert(entries_.end(), Entry{&connection, &deadline});
+    }
+    // Срок нового запроса может оказаться ближайшим
+    wakeUp_.notify_one();
+    return Registration(this, entry);
+}
+
+bool QueryCancellationWatchdog::unregister(std::list<Entry>::iterator entry) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const bool cancelled = entry->cancelled;
+    entries_.erase(entry);
+    return cancelled;
+}
+
+void QueryCancellationWatchdog::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopping_) {
+        const auto now = Clock::now();
+        auto wakeAt = now + pollInterval_;
+
+        for (auto& entry : entries_) {
+            if (entry.cancelled) {
+                continue;
+            }
+
+            if (entry.deadline->shouldCancel(now)) {
+                try {
+                    entry.connection->cancel_query();
+                    cancelled_.fetch_add(1, std::memory_order_relaxed);
+                } catch (const std::exception& e) {
+                    LOG_ERROR("database", "Не удалось отменить запрос к БД: ", e.what());
+                }
+                entry.cancelled = true;
+            } else if (entry.deadline->hasExpiry()) {
+                wakeAt = std::min(wakeAt, entry.deadline->getExpiresAt());
+            }
+        }
+
+        wakeUp_.wait_until(lock, wakeAt);
+    }
+}
+} // namespace Infrastructure::Database
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <pqxx/pqxx>
+#include <thread>
+
+#include "../../Core/Ports/RequestDeadline.h"
+
+namespace Infrastructure::Database {
+/**
+ * @brief Сторож, прерывающий запросы к PostgreSQL, результат которых уже не нужен
+ *
+ * Отдельный поток раз в pollInterval (и к ближайшему сроку) проверяет
+ * зарегистрированные запросы и отправляет серверу отмену (cancel_query), если
+ * срок запроса истёк или клиент отключился. Срок ограничивает и statement_timeout,
+ * а сторож нужен, чтобы не ждать его, когда клиента уже нет.
+ *
+ * Отмена отправляется под мьютексом сторожа, а снятие регистрации его ждёт,
+ * поэтому после снятия регистрации новая отмена на соединение не уходит. Но уже
+ * отправленная отмена доходит до процесса сервера асинхронно и может прервать
+ * следующий запрос того же соединения: release() сообщает о ней, и вызывающая
+ * сторона поглощает её пустым запросом, пока соединение ещё захвачено.
+ */
+class QueryCancellationWatchdog {
+  public:
+    /**
+     * @brief Регистрация запроса; снимается при уничтожении
+     */
+    class Registration {
+      public:
+        ~Registration();
+
+        /**
+         * @brief Снимает регистрацию раньше уничтожения
+         * @return true, если серверу была отправлена отмена запроса
+         */
+        bool release();
+
+        Registration(const Registration&) = delete;
+        Registration& operator=(const Registration&) = delete;
+        Registration(Registration&& other) noexcept;
+        Registration& operator=(Registration&&) = delete;
+
+      private:
+        friend class QueryCancellationWatchdog;
+
+        struct Entry {
+            pqxx::connection* connection;
+            const Core::Ports::RequestDeadline* deadline;
+            bool cancelled = false;
+        };
+
+        Registration(QueryCancellationWatchdog* watchdog, std::list<Entry>::iterator entry)
+            : watchdog_(watchdog), entry_(entry) {}
+
+        QueryCancellationWatchdog* watchdog_;
+        std::list<Entry>::iterator entry_;
+    };
+
+    /**
+     * @brief Конструктор; запускает поток сторожа
+     * @param pollInterval Как часто проверяется отключение клиентов
+     */
+    explicit QueryCancellationWatchdog(std::chrono::milliseconds pollInterval = std::chrono::milliseconds(50));
+
+    /**
+     * @brief Деструктор; останавливает поток сторожа
+     */
+    ~QueryCancellationWatchdog();
+
+    QueryCancellationWatchdog(const QueryCancellationWatchdog&) = delete;
+    QueryCancellationWatchdog& operator=(const QueryCancellationWatchdog&) = delete;
+
+    /**
+     * @brief Регистрирует запрос, выполняемый на соединении
+     *
+     * Соединение и срок должны жить, пока существует регистрация.
+     */
+    Registration watch(pqxx::connection& connection, const Core::Ports::RequestDeadline& deadline);
+
+    /**
+     * @brief Количество отправленных отмен
+     */
+    uint64_t getCancelledCount() const {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    using Entry = Registration::Entry;
+    using Clock = Core::Ports::RequestDeadline::Clock;
+
+    std::chrono::milliseconds pollInterval_;
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::list<Entry> entries_;
+    bool stopping_ = false;
+    std::atomic<uint64_t> cancelled_{0};
+
+    std::thread thread_;
+
+    void run();
+
+    /**
+     * @brief Снимает регистрацию
+     * @return true, если по ней была отправлена отмена
+     */
+    bool unregister(std::list<Entry>::iterator entry);
+};
+} // namespace Infrastructure::Database
@@ -0,0 +1,509 @@
+#include "FileCrawlFrontierStore.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "../../Core/Domain/Service/ContentHashService.h"
+#include "../Logging/Logger.h"
+
+namespace Infrastructure::Frontier {
+/**
+ * @brief Накопитель состояния очереди при воспроизведении снимка и журнала
+ *
+ * Воспроизведение идемпотентно: повторная постановка уже посещённого URL
+ * и повторное завершение игнорируются. Поэтому журнал, оставшийся
+ * после аварии между записью снимка и очисткой журнала, безопасен.
+ */
+class FrontierReplay {
+  public:
+    void enqueue(Core::Ports::FrontierEntry entry) {
+        const auto fingerprint = Core::Domain::Service::ContentHashService::hash(entry.url);
+        if (!visited_.insert(fingerprint).second) {
+            return;
+        }
+
+        pendingIndex_.emplace(fingerprint, pending_.size());
+        pending_.push_back(std::move(entry));
+        completed_.push_back(false);
+    }
+
+    void complete(uint64_t fingerprint) {
+        auto it = pendingIndex_.find(fingerprint);
+        if (it == pendingIndex_.end()) {
+            return;
+        }
+
+        completed_[it->second] = true;
+        pendingIndex_.erase(it);
+    }
+
+    void addVisited(uint64_t fingerprint) { visited_.insert(fingerprint); }
+
+    /**
+     * @brief Резервирует место под ожидаемое количество URL (избегает перехеширования)
+     */
+    void reserve(size_t expectedCount) {
+        visited_.reserve(expectedCount);
+        pendingIndex_.reserve(expectedCount);
+        pending_.reserve(expectedCount);
+    }
+
+    size_t pendingCount() const { return pendingIndex_.size(); }
+
+    size_t visitedCount() const { return visited_.size(); }
+
+    Core::Ports::RecoveredFrontier release() {
+        Core::Ports::RecoveredFrontier result;
+
+        result.pending.reserve(pendingIndex_.size());
+        for (size_t i = 0; i < pending_.size(); ++i) {
+            if (!completed_[i]) {
+                result.pending.push_back(std::move(pending_[i]));
+            }
+        }
+
+        result.visited.assign(visited_.begin(), visited_.end());
+        return result;
+    }
+
+  private:
+    std::unordered_set<uint64_t> visited_;
+    std::vector<Core::Ports::FrontierEntry> pending_;
+    std::vector<bool> completed_;
+    std::unordered_map<uint64_t, size_t> pendingIndex_;
+};
+
+namespace {
+
+/**
+ * @brief Размер файла или 0, если файла нет
+ */
+uintmax_t fileSizeOrZero(const std::filesystem::path& path) {
+    std::error_code error;
+    const uintmax_t size = std::filesystem::file_size(path, error);
+    return error ? 0 : size;
+}
+
+/**
+ * @brief Разбирает запись постановки в очередь
+ */
+bool parseEnqueued(FrontierRecordFormat::Reader& reader, Core::Ports::FrontierEntry& entry) {
+    uint32_t depth = 0;
+    if (!reader.readUint32(depth) || !reader.readString(entry.url) || !reader.atEnd()) {
+        return false;
+    }
+
+    entry.depth = static_cast<int>(depth);
+    return true;
+}
+
+/**
+ * @brief Кодирует запись постановки в очередь
+ */
+std::string encodeEnqueued(uint8_t type, const Core::Ports::FrontierEntry& entry) {
+    std::string payload;
+    payload.reserve(sizeof(uint8_t) + 2 * sizeof(uint32_t) + entry.url.size());
+    FrontierRecordFormat::appendUint8(payload, type);
+    FrontierRecordFormat::appendUint32(payload, static_cast<uint32_t>(entry.depth));
+    FrontierRecordFormat::appendString(payload, entry.url);
+    return payload;
+}
+} // namespace
+
+FileCrawlFrontierStore::FileCrawlFrontierStore(const std::string& directory,
+                                               std::chrono::milliseconds groupCommitInterval,
+                                               size_t snapshotThreshold)
+    : groupCommitInterval_(groupCommitInterval), snapshotThreshold_(std::max<size_t>(1, snapshotThreshold)) {
+    const std::filesystem::path root(directory);
+    std::filesystem::create_directories(root);
+
+    logPath_ = root / "frontier.log";
+    oldLogPath_ = root / "frontier.log.old";
+    snapshotPath_ = root / "frontier.snapshot";
+    snapshotTempPath_ = root / "frontier.snapshot.tmp";
+}
+
+FileCrawlFrontierStore::~FileCrawlFrontierStore() {
+    if (compactionThread_.joinable()) {
+        compactionThread_.join();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        stopping_ = true;
+    }
+    flushCv_.notify_all();
+
+    if (flusherThread_.joinable()) {
+        flusherThread_.join();
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(fileMutex_);
+        flushLocked();
+    } catch (const std::exception& e) {
+        LOG_ERROR("frontier", "Не удалось сохранить журнал очереди краулинга: ", e.what());
+    }
+}
+
+Core::Ports::RecoveredFrontier FileCrawlFrontierStore::recover() {
+    std::lock_guard<std::mutex> lock(fileMutex_);
+
+    if (logFile_) {
+        throw std::runtime_error("Журнал очереди краулинга уже открыт");
+    }
+
+    FrontierReplay replay;
+    std::string payload;
+
+    // Оценка количества URL по размеру файлов (запись URL занимает не меньше ~32 байт)
+    static constexpr uintmax_t MIN_RECORD_BYTES = 32;
+    const uintmax_t totalBytes =
+        fileSizeOrZero(snapshotPath_) + fileSizeOrZero(oldLogPath_) + fileSizeOrZero(logPath_);
+    replay.reserve(static_cast<size_t>(totalBytes / MIN_RECORD_BYTES));
+
+    // 1. Снимок. Он заменяется атомарно, поэтому повреждённый снимок -
+    // это порча данных на диске, а не последствие аварии процесса
+    if (auto snapshot = FrontierRecordFormat::openFile(snapshotPath_, "rb")) {
+        uint32_t magic = 0;
+        uint32_t version = 0;
+        if (!FrontierRecordFormat::readRecord(snapshot.get(), payload)) {
+            throw std::runtime_error("Повреждён снимок очереди краулинга: " + snapshotPath_.string());
+        }
+
+        FrontierRecordFormat::Reader header(payload);
+        if (!header.readUint32(magic) || !header.readUint32(version) || magic != SNAPSHOT_MAGIC ||
+            version != SNAPSHOT_VERSION) {
+            throw std::runtime_error("Неподдерживаемый формат снимка очереди краулинга: " +
+                                     snapshotPath_.string());
+        }
+
+        bool complete = false;
+        while (!complete && FrontierRecordFormat::readRecord(snapshot.get(), payload)) {
+            FrontierRecordFormat::Reader reader(payload);
+            uint8_t type = 0;
+            reader.readUint8(type);
+
+            if (type == RECORD_ENQUEUED) {
+                Core::Ports::FrontierEntry entry;
+                if (!parseEnqueued(reader, entry)) {
+                    break;
+                }
+                replay.enqueue(std::move(entry));
+            } else if (type == RECORD_VISITED_BATCH) {
+                uint64_t fingerprint = 0;
+                while (reader.readUint64(fingerprint)) {
+                    replay.addVisited(fingerprint);
+                }
+            } else if (type == RECORD_SNAPSHOT_END) {
+                uint64_t pendingCount = 0;
+                uint64_t visitedCount = 0;
+                complete = reader.readUint64(pendingCount) && reader.readUint64(visitedCount) &&
+                           pendingCount == replay.pendingCount() && visitedCount == replay.visitedCount();
+                if (!complete) {
+                    break;
+                }
+            } else {
+                break;
+            }
+        }
+
+        if (!complete) {
+            throw std::runtime_error("Повреждён снимок очереди краулинга: " + snapshotPath_.string());
+        }
+    }
+
+    // 2. Журнал до снимка, оставшийся от прерванного сжатия (дописан целиком перед переносом)
+    replayLog(oldLogPath_, replay);
+
+    // 3. Журнал. Запись с неверной контрольной суммой означает оборванный
+    // при аварии хвост: всё, начиная с неё, отбрасывается
+    const uintmax_t validBytes = replayLog(logPath_, replay);
+
+    if (std::filesystem::exists(logPath_) && std::filesystem::file_size(logPath_) > validBytes) {
+        LOG_WARNING("frontier", "Журнал очереди краулинга обрезан до последней целой записи (",
+                    std::filesystem::file_size(logPath_) - validBytes, " байт отброшено)");
+        std::filesystem::resize_file(logPath_, validBytes);
+    }
+
+    openLog(false);
+    flusherThread_ = std::thread(&FileCrawlFrontierStore::flusherLoop, this);
+
+    return replay.release();
+}
+
+void FileCrawlFrontierStore::appendEnqueued(const Core::Ports::FrontierEntry& entry) {
+    appendRecord(encodeEnqueued(RECORD_ENQUEUED, entry));
+}
+
+void FileCrawlFrontierStore::appendCompleted(uint64_t fingerprint) {
+    std::string payload;
+    payload.reserve(sizeof(uint8_t) + sizeof(uint64_t));
+    FrontierRecordFormat::appendUint8(payload, RECORD_COMPLETED);
+    FrontierRecordFormat::appendUint64(payload, fingerprint);
+    appendRecord(payload);
+}
+
+bool FileCrawlFrontierStore::isCompactionDue() const {
+    return !compacting_ && recordsSinceSnapshot_ >= snapshotThreshold_;
+}
+
+void FileCrawlFrontierStore::compact(std::shared_ptr<const Core::Ports::IFrontierSnapshotSource> source) {
+    // Предыдущий поток сжатия уже завершился: пока он работает, сжатие не начинается
+    if (compactionThread_.joinable()) {
+        compactionThread_.join();
+    }
+
+    compacting_ = true;
+    {
+        // Записи до этого момента уходят в журнал до снимка, последующие - в новый журнал
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        rotatedBuffer_.append(buffer_);
+        buffer_.clear();
+        rotationPending_ = true;
+    }
+    recordsSinceSnapshot_ = 0;
+
+    compactionThread_ = std::thread([this, source = std::move(source)] { compactInBackground(*source); });
+}
+
+void FileCrawlFrontierStore::flush() {
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    flushLocked();
+}
+
+void FileCrawlFrontierStore::reset() {
+    if (compactionThread_.joinable()) {
+        compactionThread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    {
+        std::lock_guard<std::mutex> bufferLock(bufferMutex_);
+        buffer_.clear();
+        rotatedBuffer_.clear();
+        rotationPending_ = false;
+    }
+
+    // Сначала снимок: если процесс упадёт до очистки журналов, в них останутся
+    // только завершённые URL, и восстановление не найдёт необработанных
+    std::filesystem::remove(snapshotPath_);
+    std::filesystem::remove(oldLogPath_);
+    if (logFile_) {
+        openLog(true);
+    } else {
+        std::filesystem::remove(logPath_);
+    }
+    recordsSinceSnapshot_ = 0;
+}
+
+void FileCrawlFrontierStore::flusherLoop() {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(bufferMutex_);
+            flushCv_.wait_for(lock, groupCommitInterval_,
+                              [this] { return stopping_ || buffer_.size() >= MAX_BUFFERED_BYTES; });
+            if (stopping_) {
+                return;
+            }
+        }
+
+        try {
+            std::lock_guard<std::mutex> lock(fileMutex_);
+            flushLocked();
+        } catch (const std::exception& e) {
+            LOG_ERROR("frontier", "Ошибка записи журнала очереди краулинга: ", e.what());
+        }
+    }
+}
+
+void FileCrawlFrontierStore::flushLocked() {
+    std::string rotated;
+    std::string pending;
+    bool rotate = false;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        rotate = rotationPending_;
+        rotationPending_ = false;
+        rotated.swap(rotatedBuffer_);
+        pending.swap(buffer_);
+    }
+
+    if (!logFile_) {
+        return;
+    }
+
+    if (rotate) {
+        rotateLog(rotated);
+    }
+
+    if (pending.empty()) {
+        return;
+    }
+
+    // Один fsync на все записи, накопленные за интервал (group commit)
+    FrontierRecordFormat::writeAll(logFile_.get(), pending);
+    FrontierRecordFormat::syncFile(logFile_.get());
+}
+
+void FileCrawlFrontierStore::rotateLog(const std::string& records) {
+    FrontierRecordFormat::writeAll(logFile_.get(), records);
+    FrontierRecordFormat::syncFile(logFile_.get());
+
+    if (std::filesystem::exists(oldLogPath_)) {
+        return;
+    }
+
+    logFile_.reset();
+    std::filesystem::rename(logPath_, oldLogPath_);
+    openLog(true);
+}
+
+void FileCrawlFrontierStore::compactInBackground(const Core::Ports::IFrontierSnapshotSource& source) {
+    try {
+        // Переключаем журнал до записи снимка: если процесс упадёт во время записи,
+        // восстановление пойдёт по старому снимку и обоим журналам
+        {
+            std::lock_guard<std::mutex> lock(fileMutex_);
+            flushLocked();
+        }
+
+        writeSnapshot(source);
+
+        // Снимок на месте, записи до него больше не нужны. Авария до удаления
+        // безопасна: воспроизведение журнала поверх снимка идемпотентно
+        std::filesystem::remove(oldLogPath_);
+    } catch (const std::exception& e) {
+        LOG_ERROR("frontier", "Не удалось записать снимок очереди краулинга: ", e.what());
+    }
+
+    compacting_ = false;
+}
+
+uintmax_t FileCrawlFrontierStore::replayLog(const std::filesystem::path& path, FrontierReplay& replay) {
+    auto log = FrontierRecordFormat::openFile(path, "rb");
+    if (!log) {
+        return 0;
+    }
+
+    uintmax_t validBytes = 0;
+    std::string payload;
+    while (FrontierRecordFormat::readRecord(log.get(), payload)) {
+        FrontierRecordFormat::Reader reader(payload);
+        uint8_t type = 0;
+        reader.readUint8(type);
+
+        if (type == RECORD_ENQUEUED) {
+            Core::Ports::FrontierEntry entry;
+            if (!parseEnqueued(reader, entry)) {
+                break;
+            }
+            replay.enqueue(std::move(entry));
+        } else if (type == RECORD_COMPLETED) {
+            uint64_t fingerprint = 0;
+            if (!reader.readUint64(fingerprint) || !reader.atEnd()) {
+                break;
+            }
+            replay.complete(fingerprint);
+        } else {
+            break;
+        }
+
+        validBytes += FrontierRecordFormat::HEADER_SIZE + payload.size();
+        recordsSinceSnapshot_++;
+    }
+    return validBytes;
+}
+
+void FileCrawlFrontierStore::appendRecord(const std::string& payload) {
+    bool bufferFull = false;
+    {
+        std::lock_guard<std::mutex> lock(bufferMutex_);
+        FrontierRecordFormat::appendRecord(buffer_, payload);
+        bufferFull = buffer_.size() >= MAX_BUFFERED_BYTES;
+    }
+
+    recordsSinceSnapshot_++;
+
+    if (bufferFull) {
+        flushCv_.notify_one();
+    }
+}
+
+void FileCrawlFrontierStore::writeSnapshot(const Core::Ports::IFrontierSnapshotSource& source) {
+    auto file = FrontierRecordFormat::openFile(snapshotTempPath_, "wb");
+    if (!file) {
+        throw std::runtime_error("Не удалось создать снимок очереди краулинга: " + snapshotTempPath_.string());
+    }
+
+    std::string buffer;
+    std::string payload;
+    uint64_t pendingCount = 0;
+    uint64_t visitedCount = 0;
+
+    const auto flushIfFull = [&] {
+        if (buffer.size() >= FrontierRecordFormat::FILE_BUFFER_SIZE) {
+            FrontierRecordFormat::writeAll(file.get(), buffer);
+            buffer.clear();
+        }
+    };
+
+    FrontierRecordFormat::appendUint32(payload, SNAPSHOT_MAGIC);
+    FrontierRecordFormat::appendUint32(payload, SNAPSHOT_VERSION);
+    FrontierRecordFormat::appendRecord(buffer, payload);
+
+    // Необработанные URL записываются раньше посещённых: при восстановлении
+    // постановка в очередь сама отмечает URL посещённым
+    source.forEachPending([&](const Core::Ports::FrontierEntry& entry) {
+        FrontierRecordFormat::appendRecord(buffer, encodeEnqueued(RECORD_ENQUEUED, entry));
+        pendingCount++;
+        flushIfFull();
+    });
+
+    payload.clear();
+    size_t batchCount = 0;
+    const auto appendVisitedBatch = [&] {
+        if (batchCount > 0) {
+            FrontierRecordFormat::appendRecord(buffer, payload);
+            flushIfFull();
+        }
+        payload.clear();
+        FrontierRecordFormat::appendUint8(payload, RECORD_VISITED_BATCH);
+        batchCount = 0;
+    };
+
+    appendVisitedBatch();
+    source.forEachVisited([&](uint64_t fingerprint) {
+        FrontierRecordFormat::appendUint64(payload, fingerprint);
+        visitedCount++;
+        if (++batchCount == VISITED_BATCH_SIZE) {
+            appendVisitedBatch();
+        }
+    });
+    appendVisitedBatch();
+
+    payload.clear();
+    FrontierRecordFormat::appendUint8(payload, RECORD_SNAPSHOT_END);
+    FrontierRecordFormat::appendUint64(payload, pendingCount);
+    FrontierRecordFormat::appendUint64(payload, visitedCount);
+    FrontierRecordFormat::appendRecord(buffer, payload);
+
+    FrontierRecordFormat::writeAll(file.get(), buffer);
+    FrontierRecordFormat::syncFile(file.get());
+    file.reset();
+
+    std::filesystem::rename(snapshotTempPath_, snapshotPath_);
+}
+
+void FileCrawlFrontierStore::openLog(bool truncate) {
+    logFile_.reset();
+    logFile_ = FrontierRecordFormat::openFile(logPath_, truncate ? "wb" : "ab");
+
+    if (!logFile_) {
+        throw std::runtime_error("Не удалось открыть журнал очереди краулинга: " + logPath_.string());
+    }
+}
+} // namespace Infrastructure::Frontier
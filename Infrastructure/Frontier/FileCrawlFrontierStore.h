@@ -0,0 +1,156 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "../../Core/Ports/ICrawlFrontierStore.h"
+#include "FrontierRecordFormat.h"
+
+namespace Infrastructure::Frontier {
+class FrontierReplay;
+
+/**
+ * @brief Файловое хранилище очереди краулинга: журнал + снимки
+ *
+ * Каждая постановка URL в очередь и каждое завершение обработки
+ * дописываются в журнал frontier.log. Записи копятся в памяти и
+ * сбрасываются на диск одним fsync раз в groupCommitInterval (group commit),
+ * поэтому стоимость fsync не зависит от скорости краулинга.
+ *
+ * Когда журнал вырастает до snapshotThreshold записей, журнал переключается:
+ * записи до снимка остаются в frontier.log.old, новые идут в чистый frontier.log.
+ * Снимок пишется в фоновом потоке в frontier.snapshot (через временный файл
+ * и rename), после чего frontier.log.old удаляется. Восстановление: снимок +
+ * воспроизведение frontier.log.old (если остался) и frontier.log.
+ */
+class FileCrawlFrontierStore : public Core::Ports::ICrawlFrontierStore {
+  public:
+    /**
+     * @brief Конструктор
+     * @param directory Каталог для файлов журнала и снимка (создаётся при необходимости)
+     * @param groupCommitInterval Интервал сброса журнала на диск
+     * @param snapshotThreshold Количество записей в журнале, после которого делается снимок
+     */
+    FileCrawlFrontierStore(const std::string& directory,
+                           std::chrono::milliseconds groupCommitInterval,
+                           size_t snapshotThreshold);
+
+    ~FileCrawlFrontierStore() override;
+
+    FileCrawlFrontierStore(const FileCrawlFrontierStore&) = delete;
+    FileCrawlFrontierStore& operator=(const FileCrawlFrontierStore&) = delete;
+
+    /**
+     * @brief Восстанавливает состояние и открывает журнал для записи
+     *
+     * Должен быть вызван один раз до первой записи. Оборванный при аварии
+     * хвост журнала отбрасывается.
+     */
+    Core::Ports::RecoveredFrontier recover() override;
+
+    void appendEnqueued(const Core::Ports::FrontierEntry& entry) override;
+    void appendCompleted(uint64_t fingerprint) override;
+
+    /**
+     * @brief Пора ли сжимать журнал (не во время записи предыдущего снимка)
+     */
+    bool isCompactionDue() const override;
+
+    /**
+     * @brief Переключает журнал и запускает запись снимка в фоновом потоке
+     *
+     * Под блокировкой вызывающего только перекладывает буфер записей, без обращения к диску.
+     */
+    void compact(std::shared_ptr<const Core::Ports::IFrontierSnapshotSource> source) override;
+
+    void flush() override;
+    void reset() override;
+
+  private:
+    // Типы записей журнала и снимка
+    static constexpr uint8_t RECORD_ENQUEUED = 1;
+    static constexpr uint8_t RECORD_COMPLETED = 2;
+    static constexpr uint8_t RECORD_VISITED_BATCH = 3;
+    static constexpr uint8_t RECORD_SNAPSHOT_END = 4;
+
+    static constexpr uint32_t SNAPSHOT_MAGIC = 0x53524653;  // "SFRS"
+    static constexpr uint32_t SNAPSHOT_VERSION = 1;
+    static constexpr size_t VISITED_BATCH_SIZE = 4096;
+    static constexpr size_t MAX_BUFFERED_BYTES = 4 * 1024 * 1024;
+
+    std::filesystem::path logPath_;
+    std::filesystem::path oldLogPath_;
+    std::filesystem::path snapshotPath_;
+    std::filesystem::path snapshotTempPath_;
+    std::chrono::milliseconds groupCommitInterval_;
+    size_t snapshotThreshold_;
+
+    // Блокировки берутся в порядке fileMutex_ -> bufferMutex_
+    std::mutex fileMutex_;  // Доступ к файлу журнала
+    FilePtr logFile_;
+
+    std::mutex bufferMutex_;  // Буфер ещё не записанных записей
+    std::condition_variable flushCv_;
+    std::string buffer_;
+    std::string rotatedBuffer_;     // Записи до начала сжатия: дописываются в журнал перед переключением
+    bool rotationPending_ = false;  // Журнал нужно переключить при следующем сбросе
+    bool stopping_ = false;
+
+    std::atomic<size_t> recordsSinceSnapshot_{0};
+    std::atomic<bool> compacting_{false};  // Снимок пишется в фоне
+    std::thread flusherThread_;
+    std::thread compactionThread_;
+
+    /**
+     * @brief Цикл фонового потока group commit
+     */
+    void flusherLoop();
+
+    /**
+     * @brief Записывает буфер в журнал и выполняет fsync (fileMutex_ должен быть захвачен)
+     *
+     * Если начато сжатие, сначала дописывает записи до него и переключает журнал.
+     */
+    void flushLocked();
+
+    /**
+     * @brief Дописывает записи до снимка в журнал и переносит его в frontier.log.old
+     *
+     * Если frontier.log.old остался от неудавшегося сжатия, журнал не переносится:
+     * записи до снимка остаются в нём, а воспроизведение поверх снимка идемпотентно.
+     */
+    void rotateLog(const std::string& records);
+
+    /**
+     * @brief Записывает снимок и удаляет журнал до него (в фоновом потоке)
+     */
+    void compactInBackground(const Core::Ports::IFrontierSnapshotSource& source);
+
+    /**
+     * @brief Воспроизводит журнал до первой повреждённой записи
+     * @return Размер целых записей в байтах
+     */
+    uintmax_t replayLog(const std::filesystem::path& path, FrontierReplay& replay);
+
+    /**
+     * @brief Дописывает запись в буфер журнала
+     */
+    void appendRecord(const std::string& payload);
+
+    /**
+     * @brief Записывает снимок во временный файл и атомарно заменяет им старый
+     */
+    void writeSnapshot(const Core::Ports::IFrontierSnapshotSource& source);
+
+    /**
+     * @brief Открывает файл журнала
+     * @param truncate Очистить журнал
+     */
+    void openLog(bool truncate);
+};
+} // namespace Infrastructure::Frontier
@@ -0,0 +1,175 @@
+#include "FrontierRecordFormat.h"
+
+#include <array>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Infrastructure::Frontier {
+namespace {
+constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320U;
+constexpr size_t CRC32_TABLE_SIZE = 256;
+constexpr int BITS_PER_BYTE = 8;
+
+constexpr std::array<uint32_t, CRC32_TABLE_SIZE> makeCrc32Table() {
+    std::array<uint32_t, CRC32_TABLE_SIZE> table{};
+    for (uint32_t i = 0; i < CRC32_TABLE_SIZE; ++i) {
+        uint32_t value = i;
+        for (int bit = 0; bit < BITS_PER_BYTE; ++bit) {
+            value = (value & 1U) != 0 ? (value >> 1) ^ CRC32_POLYNOMIAL : value >> 1;
+        }
+        table[i] = value;
+    }
+    return table;
+}
+
+constexpr auto CRC32_TABLE = makeCrc32Table();
+} // namespace
+
+uint32_t FrontierRecordFormat::crc32(const void* data, size_t size) {
+    const auto* ptr = static_cast<const unsigned char*>(data);
+    uint32_t crc = 0xFFFFFFFFU;
+
+    for (size_t i = 0; i < size; ++i) {
+        crc = CRC32_TABLE[(crc ^ ptr[i]) & 0xFFU] ^ (crc >> BITS_PER_BYTE);
+    }
+
+    return crc ^ 0xFFFFFFFFU;
+}
+
+void FrontierRecordFormat::appendRecord(std::string& buffer, const std::string& payload) {
+    appendUint32(buffer, static_cast<uint32_t>(payload.size()));
+    appendUint32(buffer, crc32(payload.data(), payload.size()));
+    buffer += payload;
+}
+
+bool FrontierRecordFormat::readRecord(std::FILE* file, std::string& payload) {
+    unsigned char header[HEADER_SIZE];
+    if (std::fread(header, 1, HEADER_SIZE, file) != HEADER_SIZE) {
+        return false;
+    }
+
+    const uint32_t size = decodeUint32(header);
+    const uint32_t expectedCrc = decodeUint32(header + sizeof(uint32_t));
+
+    // Мусор вместо длины не должен приводить к огромному выделению памяти
+    if (size > MAX_PAYLOAD_SIZE) {
+        return false;
+    }
+
+    payload.resize(size);
+    if (size > 0 && std::fread(payload.data(), 1, size, file) != size) {
+        return false;
+    }
+
+    return crc32(payload.data(), payload.size()) == expectedCrc;
+}
+
+void FrontierRecordFormat::appendUint8(std::string& buffer, uint8_t value) {
+    buffer.push_back(static_cast<char>(value));
+}
+
+void FrontierRecordFormat::appendUint32(std::string& buffer, uint32_t value) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        buffer.push_back(static_cast<char>((value >> (i * BITS_PER_BYTE)) & 0xFFU));
+    }
+}
+
+void FrontierRecordFormat::appendUint64(std::string& buffer, uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        buffer.push_back(static_cast<char>((value >> (i * BITS_PER_BYTE)) & 0xFFU));
+    }
+}
+
+void FrontierRecordFormat::appendString(std::string& buffer, const std::string& value) {
+    appendUint32(buffer, static_cast<uint32_t>(value.size()));
+    buffer += value;
+}
+
+bool FrontierRecordFormat::Reader::readUint8(uint8_t& value) {
+    if (payload_.size() - offset_ < sizeof(value)) {
+        return false;
+    }
+
+    value = static_cast<uint8_t>(payload_[offset_]);
+    offset_ += sizeof(value);
+    return true;
+}
+
+bool FrontierRecordFormat::Reader::readUint32(uint32_t& value) {
+    if (payload_.size() - offset_ < sizeof(value)) {
+        return false;
+    }
+
+    value = decodeUint32(reinterpret_cast<const unsigned char*>(payload_.data() + offset_));
+    offset_ += sizeof(value);
+    return true;
+}
+
+bool FrontierRecordFormat::Reader::readUint64(uint64_t& value) {
+    if (payload_.size() - offset_ < sizeof(value)) {
+        return false;
+    }
+
+    value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        value |= static_cast<uint64_t>(static_cast<unsigned char>(payload_[offset_ + i])) << (i * BITS_PER_BYTE);
+    }
+    offset_ += sizeof(value);
+    return true;
+}
+
+bool FrontierRecordFormat::Reader::readString(std::string& value) {
+    uint32_t size = 0;
+    if (!readUint32(size) || payload_.size() - offset_ < size) {
+        return false;
+    }
+
+    value.assign(payload_, offset_, size);
+    offset_ += size;
+    return true;
+}
+
+void FrontierRecordFormat::syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        throw std::runtime_error("Не удалось записать файл");
+    }
+
+#ifdef _WIN32
+    const int result = _commit(_fileno(file));
+#else
+    const int result = fsync(fileno(file));
+#endif
+
+    if (result != 0) {
+        throw std::runtime_error("Не удалось сбросить файл на диск");
+    }
+}
+
+FilePtr FrontierRecordFormat::openFile(const std::filesystem::path& path, const char* mode) {
+    FilePtr file(std::fopen(path.string().c_str(), mode));
+    if (file) {
+        // Крупный буфер: файлы очереди читаются и пишутся строго последовательно
+        std::setvbuf(file.get(), nullptr, _IOFBF, FILE_BUFFER_SIZE);
+    }
+    return file;
+}
+
+void FrontierRecordFormat::writeAll(std::FILE* file, const std::string& data) {
+    if (!data.empty() && std::fwrite(data.data(), 1, data.size(), file) != data.size()) {
+        throw std::runtime_error("Не удалось записать файл");
+    }
+}
+
+uint32_t FrontierRecordFormat::decodeUint32(const unsigned char* ptr) {
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); ++i) {
+        value |= static_cast<uint32_t>(ptr[i]) << (i * BITS_PER_BYTE);
+    }
+    return value;
+}
+} // namespace Infrastructure::Frontier
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace Infrastructure::Frontier {
+/**
+ * @brief Закрывает файл при уничтожении FilePtr
+ */
+struct FileCloser {
+    void operator()(std::FILE* file) const {
+        if (file != nullptr) {
+            std::fclose(file);
+        }
+    }
+};
+
+using FilePtr = std::unique_ptr<std::FILE, FileCloser>;
+
+/**
+ * @brief Формат записей файлов очереди краулинга
+ *
+ * Запись: [длина полезной нагрузки: u32][CRC32 нагрузки: u32][нагрузка].
+ * Числа хранятся в little-endian независимо от платформы.
+ * Контрольная сумма позволяет отличить оборванный при аварии хвост файла
+ * от корректных данных.
+ */
+class FrontierRecordFormat {
+  public:
+    static constexpr size_t HEADER_SIZE = 8;
+    static constexpr uint32_t MAX_PAYLOAD_SIZE = 64 * 1024 * 1024;
+    static constexpr size_t FILE_BUFFER_SIZE = 1024 * 1024;
+
+    /**
+     * @brief Вычисляет CRC32 (полином 0xEDB88320, как в zlib)
+     */
+    static uint32_t crc32(const void* data, size_t size);
+
+    /**
+     * @brief Дописывает в буфер запись с заголовком и контрольной суммой
+     * @param buffer Буфер для записи
+     * @param payload Полезная нагрузка
+     */
+    static void appendRecord(std::string& buffer, const std::string& payload);
+
+    /**
+     * @brief Читает следующую запись из файла
+     * @param file Открытый файл
+     * @param payload Буфер для полезной нагрузки
+     * @return true, если прочитана целая запись с верной контрольной суммой
+     */
+    static bool readRecord(std::FILE* file, std::string& payload);
+
+    static void appendUint8(std::string& buffer, uint8_t value);
+    static void appendUint32(std::string& buffer, uint32_t value);
+    static void appendUint64(std::string& buffer, uint64_t value);
+    static void appendString(std::string& buffer, const std::string& value);
+
+    /**
+     * @brief Последовательное чтение полей полезной нагрузки
+     *
+     * При выходе за границы нагрузки возвращает false и больше ничего не читает.
+     */
+    class Reader {
+      public:
+        explicit Reader(const std::string& payload) : payload_(payload) {}
+
+        bool readUint8(uint8_t& value);
+        bool readUint32(uint32_t& value);
+        bool readUint64(uint64_t& value);
+        bool readString(std::string& value);
+
+        bool atEnd() const { return offset_ == payload_.size(); }
+
+      private:
+        const std::string& payload_;
+        size_t offset_ = 0;
+    };
+
+    /**
+     * @brief Сбрасывает буферы файла и дожидается записи на диск (fsync)
+     * @throws std::runtime_error при ошибке записи
+     */
+    static void syncFile(std::FILE* file);
+
+    /**
+     * @brief Открывает файл с буфером ввода-вывода увеличенного размера
+     * @param path Путь к файлу
+     * @param mode Режим fopen ("rb", "wb", "ab")
+     * @return Открытый файл или nullptr, если файл не удалось открыть
+     */
+    static FilePtr openFile(const std::filesystem::path& path, const char* mode);
+
+    /**
+     * @brief Записывает данные в файл
+     * @throws std::runtime_error при ошибке записи
+     */
+    static void writeAll(std::FILE* file, const std::string& data);
+
+  private:
+    static uint32_t decodeUint32(const unsigned char* ptr);
+};
+} // namespace Infrastructure::Frontier
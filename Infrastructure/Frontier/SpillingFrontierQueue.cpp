@@ -0,0 +1,335 @@
+#include "SpillingFrontierQueue.h"
+
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+
+#include "FrontierRecordFormat.h"
+
+namespace Infrastructure::Frontier {
+namespace {
+constexpr const char* SEGMENT_PREFIX = "segment-";
+constexpr const char* SEGMENT_EXTENSION = ".bin";
+
+/**
+ * @brief Случайный идентификатор экземпляра очереди для имён файлов сегментов
+ */
+std::string makeInstanceId() {
+    std::random_device device;
+    std::ostringstream oss;
+    oss << std::hex << std::setfill('0') << std::setw(8) << device() << std::setw(8) << device();
+    return oss.str();
+}
+
+/**
+ * @brief Путь к файлу сегмента, удаляющий файл вместе с последней ссылкой
+ */
+std::shared_ptr<const std::filesystem::path> makeSegmentFile(std::filesystem::path path) {
+    return std::shared_ptr<const std::filesystem::path>(new std::filesystem::path(std::move(path)),
+                                                        [](const std::filesystem::path* file) {
+                                                            std::error_code error;
+                                                            std::filesystem::remove(*file, error);
+                                                            delete file;
+                                                        });
+}
+} // namespace
+
+SpillingFrontierQueue::SpillingFrontierQueue(const std::string& spillDirectory,
+                                             size_t highWatermark,
+                                             size_t lowWatermark)
+    : spillDirectory_(spillDirectory),
+      spillEnabled_(!spillDirectory.empty()),
+      highWatermark_(spillEnabled_ ? highWatermark : std::numeric_limits<size_t>::max()),
+      lowWatermark_(lowWatermark),
+      segmentCapacity_(0),
+      instanceId_(makeInstanceId()) {
+    if (lowWatermark_ >= highWatermark_) {
+        throw std::runtime_error("Нижняя граница очереди краулинга должна быть меньше верхней");
+    }
+
+    // Сегмент дополняет голову от нижней границы до верхней
+    segmentCapacity_ = highWatermark_ - lowWatermark_;
+
+    if (spillEnabled_) {
+        std::filesystem::create_directories(spillDirectory_);
+    }
+}
+
+SpillingFrontierQueue::~SpillingFrontierQueue() {
+    // Дожидаемся фоновых операций, прежде чем удалять их файлы
+    if (prefetch_.valid()) {
+        prefetch_.wait();
+    }
+
+    // Файлы сегментов удаляются вместе с segments_ (если на них не ссылается снимок)
+    for (const auto& segment : segments_) {
+        segment.written.wait();
+    }
+}
+
+void SpillingFrontierQueue::push(Core::Ports::FrontierEntry entry) {
+    size_++;
+
+    // Пока на диске ничего нет, новые URL идут прямо в голову
+    if (segments_.empty() && tail_.empty() && head_.size() < highWatermark_) {
+        head_.push_back(std::move(entry));
+        return;
+    }
+
+    tail_.push_back(std::move(entry));
+
+    if (tail_.size() >= segmentCapacity_) {
+        spillTail();
+    }
+}
+
+std::optional<Core::Ports::FrontierEntry> SpillingFrontierQueue::pop() {
+    if (head_.empty()) {
+        refill(true);
+    }
+
+    if (head_.empty()) {
+        return std::nullopt;
+    }
+
+    // Голову пополняем до извлечения: если чтение сегмента завершилось ошибкой,
+    // URL из головы остаётся в очереди
+    if (head_.size() <= lowWatermark_ + 1) {
+        refill(false);
+    }
+
+    auto entry = std::move(head_.front());
+    head_.pop_front();
+    size_--;
+
+    return entry;
+}
+
+std::function<void()> SpillingFrontierQueue::pendingRead() {
+    if (!head_.empty() || segments_.empty()) {
+        return {};
+    }
+
+    if (!prefetch_.valid()) {
+        startPrefetch();
+    }
+
+    if (prefetch_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        return {};
+    }
+
+    return [prefetch = prefetch_] { prefetch.wait(); };
+}
+
+std::function<void()> SpillingFrontierQueue::pendingWrite() {
+    while (!writes_.empty() && writes_.front().wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        writes_.pop_front();
+    }
+
+    // Пока пишется больше MAX_PENDING_WRITES сегментов, каждый добавляющий поток ждёт
+    // запись после своего push(): иначе при быстром росте очереди незаписанные сегменты
+    // копились бы в памяти
+    if (writes_.size() <= MAX_PENDING_WRITES) {
+        return {};
+    }
+
+    return [written = writes_.front()] { written.wait(); };
+}
+
+bool SpillingFrontierQueue::empty() const {
+    return size_ == 0;
+}
+
+size_t SpillingFrontierQueue::size() const {
+    return size_;
+}
+
+void SpillingFrontierQueue::forEach(const std::function<void(const Core::Ports::FrontierEntry&)>& visitor) const {
+    for (const auto& entry : head_) {
+        visitor(entry);
+    }
+
+    // Сегменты читаются с диска потоково и целиком в память не загружаются
+    for (const auto& segment : segments_) {
+        segment.written.get();
+        readSegment(*segment.path, [&visitor](Core::Ports::FrontierEntry&& entry) { visitor(entry); });
+    }
+
+    for (const auto& entry : tail_) {
+        visitor(entry);
+    }
+}
+
+Core::Ports::FrontierSnapshot SpillingFrontierQueue::snapshot() const {
+    auto head = std::make_shared<const std::vector<Core::Ports::FrontierEntry>>(head_.begin(), head_.end());
+    auto segments = std::make_shared<const std::vector<Segment>>(segments_.begin(), segments_.end());
+    auto tail = std::make_shared<const std::vector<Core::Ports::FrontierEntry>>(tail_);
+
+    return [head, segments, tail](const std::function<void(const Core::Ports::FrontierEntry&)>& visitor) {
+        for (const auto& entry : *head) {
+            visitor(entry);
+        }
+
+        for (const auto& segment : *segments) {
+            segment.written.get();
+            readSegment(*segment.path, [&visitor](Core::Ports::FrontierEntry&& entry) { visitor(entry); });
+        }
+
+        for (const auto& entry : *tail) {
+            visitor(entry);
+        }
+    };
+}
+
+void SpillingFrontierQueue::removeStaleSegments(const std::string& spillDirectory) {
+    std::error_code error;
+    if (spillDirectory.empty() || !std::filesystem::is_directory(spillDirectory, error)) {
+        return;
+    }
+
+    for (const auto& file : std::filesystem::directory_iterator(spillDirectory)) {
+        const std::string name = file.path().filename().string();
+        if (name.rfind(SEGMENT_PREFIX, 0) == 0 && file.path().extension() == SEGMENT_EXTENSION) {
+            std::filesystem::remove(file.path(), error);
+        }
+    }
+}
+
+void SpillingFrontierQueue::spillTail() {
+    Segment segment;
+    segment.path = makeSegmentFile(spillDirectory_ / (SEGMENT_PREFIX + instanceId_ + "-" +
+                                                      std::to_string(nextSegmentNumber_++) + SEGMENT_EXTENSION));
+    segment.count = tail_.size();
+
+    // Запись идёт в фоне, чтобы не держать вызывающий поток (и блокировку очереди) на диске;
+    // отставание записи ограничивает pendingWrite()
+    auto entries = std::make_shared<std::vector<Core::Ports::FrontierEntry>>(std::move(tail_));
+    tail_.clear();
+
+    // Состояние std::async хранит лямбду вместе с захваченными данными до уничтожения
+    // future, поэтому записываемые URL забираются в локальную переменную
+    segment.written = std::async(std::launch::async, [path = *segment.path, entries]() mutable {
+                          const auto written = std::move(entries);
+                          writeSegment(path, *written);
+                      }).share();
+
+    writes_.push_back(segment.written);
+    segments_.push_back(std::move(segment));
+}
+
+void SpillingFrontierQueue::refill(bool wait) {
+    if (segments_.empty()) {
+        // На диске ничего нет: хвост непосредственно следует за головой
+        for (auto& entry : tail_) {
+            head_.push_back(std::move(entry));
+        }
+        tail_.clear();
+        return;
+    }
+
+    if (!prefetch_.valid()) {
+        startPrefetch();
+    }
+
+    if (!wait && prefetch_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+
+    // Файл удаляется вместе с последней ссылкой на сегмент
+    auto prefetch = std::move(prefetch_);
+    prefetch_ = {};
+    const size_t count = segments_.front().count;
+    segments_.pop_front();
+
+    std::shared_ptr<std::vector<Core::Ports::FrontierEntry>> entries;
+    try {
+        entries = prefetch.get();
+    } catch (...) {
+        // Нечитаемый сегмент уже выброшен, иначе каждый pop() упирался бы в ту же ошибку
+        size_ -= count;
+        throw;
+    }
+
+    for (auto& entry : *entries) {
+        head_.push_back(std::move(entry));
+    }
+
+    if (head_.size() <= lowWatermark_ && !segments_.empty()) {
+        startPrefetch();
+    }
+}
+
+void SpillingFrontierQueue::startPrefetch() {
+    prefetch_ = std::async(std::launch::async, [segment = segments_.front()] {
+                    // Сегмент мог ещё не дописаться; get() пробросит ошибку записи
+                    segment.written.get();
+
+                    auto entries = std::make_shared<std::vector<Core::Ports::FrontierEntry>>();
+                    entries->reserve(segment.count);
+                    readSegment(*segment.path, [&entries](Core::Ports::FrontierEntry&& entry) {
+                        entries->push_back(std::move(entry));
+                    });
+
+                    if (entries->size() != segment.count) {
+                        throw std::runtime_error("Повреждён сегмент очереди краулинга: " +
+                                                 segment.path->string());
+                    }
+
+                    return entries;
+                }).share();
+}
+
+void SpillingFrontierQueue::writeSegment(const std::filesystem::path& path,
+                                         const std::vector<Core::Ports::FrontierEntry>& entries) {
+    auto file = FrontierRecordFormat::openFile(path, "wb");
+    if (!file) {
+        throw std::runtime_error("Не удалось создать сегмент очереди краулинга: " + path.string());
+    }
+
+    std::string buffer;
+    std::string payload;
+
+    for (const auto& entry : entries) {
+        payload.clear();
+        FrontierRecordFormat::appendUint32(payload, static_cast<uint32_t>(entry.depth));
+        FrontierRecordFormat::appendString(payload, entry.url);
+        FrontierRecordFormat::appendRecord(buffer, payload);
+
+        if (buffer.size() >= FrontierRecordFormat::FILE_BUFFER_SIZE) {
+            FrontierRecordFormat::writeAll(file.get(), buffer);
+            buffer.clear();
+        }
+    }
+
+    // fsync не нужен: сегменты временные, после аварии очередь восстанавливается из журнала
+    FrontierRecordFormat::writeAll(file.get(), buffer);
+    if (std::fflush(file.get()) != 0) {
+        throw std::runtime_error("Не удалось записать сегмент очереди краулинга: " + path.string());
+    }
+}
+
+void SpillingFrontierQueue::readSegment(const std::filesystem::path& path,
+                                        const std::function<void(Core::Ports::FrontierEntry&&)>& visitor) {
+    auto file = FrontierRecordFormat::openFile(path, "rb");
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть сегмент очереди краулинга: " + path.string());
+    }
+
+    std::string payload;
+    while (FrontierRecordFormat::readRecord(file.get(), payload)) {
+        FrontierRecordFormat::Reader reader(payload);
+        Core::Ports::FrontierEntry entry;
+        uint32_t depth = 0;
+
+        if (!reader.readUint32(depth) || !reader.readString(entry.url) || !reader.atEnd()) {
+            throw std::runtime_error("Повреждён сегмент очереди краулинга: " + path.string());
+        }
+
+        entry.depth = static_cast<int>(depth);
+        visitor(std::move(entry));
+    }
+}
+} // namespace Infrastructure::Frontier
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../../Core/Ports/IFrontierQueue.h"
+
+namespace Infrastructure::Frontier {
+/**
+ * @brief Двухуровневая очередь краулинга с вытеснением на диск
+ *
+ * Порядок элементов: голова (в памяти) -> сегменты (файлы на диске) -> хвост (в памяти).
+ * Пока очередь короче верхней границы, всё хранится в голове. Дальше новые URL
+ * копятся в хвосте и пачками по (high - low) записываются в последовательные
+ * файлы-сегменты. Когда голова опускается до нижней границы, следующий сегмент
+ * заранее читается в фоне (read-ahead), поэтому рабочие потоки почти не ждут диск.
+ * Сегменты тоже пишутся в фоне; если запись отстаёт больше чем на сегмент,
+ * добавляющий поток ждёт её через pendingWrite() вне блокировки очереди.
+ *
+ * Потребление памяти ограничено границами и не зависит от длины очереди.
+ */
+class SpillingFrontierQueue : public Core::Ports::IFrontierQueue {
+  public:
+    /**
+     * @brief Конструктор
+     * @param spillDirectory Каталог для сегментов (пусто - очередь только в памяти)
+     * @param highWatermark Максимум URL в голове очереди
+     * @param lowWatermark Размер головы, при котором начинается чтение следующего сегмента
+     * @throws std::runtime_error если lowWatermark >= highWatermark
+     */
+    SpillingFrontierQueue(const std::string& spillDirectory, size_t highWatermark, size_t lowWatermark);
+
+    ~SpillingFrontierQueue() override;
+
+    SpillingFrontierQueue(const SpillingFrontierQueue&) = delete;
+    SpillingFrontierQueue& operator=(const SpillingFrontierQueue&) = delete;
+
+    void push(Core::Ports::FrontierEntry entry) override;
+    std::optional<Core::Ports::FrontierEntry> pop() override;
+    std::function<void()> pendingRead() override;
+    std::function<void()> pendingWrite() override;
+    bool empty() const override;
+    size_t size() const override;
+    void forEach(const std::function<void(const Core::Ports::FrontierEntry&)>& visitor) const override;
+
+    /**
+     * @brief Перебор URL на момент вызова
+     *
+     * Копирует только URL в памяти (их число ограничено границами). Сегменты
+     * читаются с диска при переборе; их файлы не удаляются, пока жив снимок.
+     */
+    Core::Ports::FrontierSnapshot snapshot() const override;
+
+    /**
+     * @brief Удаляет сегменты, оставшиеся после аварийного завершения
+     *
+     * Сегменты не являются источником истины (им служит журнал очереди),
+     * поэтому при запуске их можно безопасно удалить.
+     */
+    static void removeStaleSegments(const std::string& spillDirectory);
+
+  private:
+    /**
+     * @brief Сегмент очереди на диске
+     */
+    struct Segment {
+        // Файл удаляется с последней ссылкой: её держат очередь, фоновое чтение и снимки
+        std::shared_ptr<const std::filesystem::path> path;
+        size_t count = 0;
+        std::shared_future<void> written;  // Завершение фоновой записи файла
+    };
+
+    // Фоновых записей сегментов, после которых добавляющие потоки ждут диск
+    static constexpr size_t MAX_PENDING_WRITES = 1;
+
+    std::filesystem::path spillDirectory_;
+    bool spillEnabled_;
+    size_t highWatermark_;
+    size_t lowWatermark_;
+    size_t segmentCapacity_;
+
+    std::deque<Core::Ports::FrontierEntry> head_;
+    std::deque<Segment> segments_;
+    std::vector<Core::Ports::FrontierEntry> tail_;
+    // Чтение segments_.front(); разделяемое, чтобы его можно было ждать вне блокировки очереди
+    std::shared_future<std::shared_ptr<std::vector<Core::Ports::FrontierEntry>>> prefetch_;
+    // Фоновые записи сегментов в порядке запуска; завершённые убираются из начала
+    std::deque<std::shared_future<void>> writes_;
+
+    size_t size_ = 0;
+    std::string instanceId_;
+    uint64_t nextSegmentNumber_ = 0;
+
+    /**
+     * @brief Записывает хвост в новый сегмент (в фоне)
+     */
+    void spillTail();
+
+    /**
+     * @brief Пополняет голову из следующего сегмента или хвоста
+     * @param wait Ждать чтения сегмента (голова пуста)
+     * @throws std::runtime_error если сегмент не удалось прочитать (сегмент выбрасывается из очереди)
+     */
+    void refill(bool wait);
+
+    /**
+     * @brief Начинает фоновое чтение первого сегмента
+     */
+    void startPrefetch();
+
+    static void writeSegment(const std::filesystem::path& path,
+                             const std::vector<Core::Ports::FrontierEntry>& entries);
+
+    static void readSegment(const std::filesystem::path& path,
+                            const std::function<void(Core::Ports::FrontierEntry&&)>& visitor);
+};
+} // namespace Infrastructure::Frontier
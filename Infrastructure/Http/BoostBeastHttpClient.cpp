@@ -8,9 +8,10 @@
 #include <boost/beast/http.hpp>
 #include <boost/beast/ssl.hpp>
 #include <boost/beast/version.hpp>
-#include <iostream>
 #include <regex>
-#include <sstream>
+
+#include "../../Core/Ports/ITracer.h"
+#include "../Logging/Logger.h"
 
 namespace beast = boost::beast;
 namespace http = beast::http;
@@ -20,14 +21,65 @@ namespace ssl = boost::asio::ssl;
 using tcp = boost::asio::ip::tcp;
 
 namespace Infrastructure::Http {
-BoostBeastHttpClient::BoostBeastHttpClient(std::chrono::seconds timeout) : timeout_(timeout) {}
+namespace {
+/**
+ * @brief Добавляет в запрос заголовки условного GET
+ */
+void applyValidators(http::request<http::string_body>& req,
+                     const Core::DTO::CacheValidatorsDTO& validators) {
+    if (!validators.etag.empty()) {
+        req.set(http::field::if_none_match, validators.etag);
+    }
+    if (!validators.lastModified.empty()) {
+        req.set(http::field::if_modified_since, validators.lastModified);
+    }
+}
+
+/**
+ * @brief Копирует статус, тело и заголовки ответа Beast в результат
+ */
+template <typename Response, typename Result>
+void extractResponse(Response& res, Result& response) {
+    response.statusCode = static_cast<int>(res.result_int());
+    response.body = std::move(res.body());
+
+    for (const auto& field : res) {
+        response.headers[std::string(field.name_string())] = std::string(field.value());
+    }
 
-void BoostBeastHttpClient::setWorkerId(int workerId) {
-    workerId_ = workerId;
+    // Извлекаем заголовок Location (для редиректов)
+    auto locationIt = res.find(http::field::location);
+    if (locationIt != res.end()) {
+        response.locationHeader = std::string(locationIt->value());
+    }
+
+    // Валидаторы для следующего условного запроса
+    auto etagIt = res.find(http::field::etag);
+    if (etagIt != res.end()) {
+        response.validators.etag = std::string(etagIt->value());
+    }
+
+    auto lastModifiedIt = res.find(http::field::last_modified);
+    if (lastModifiedIt != res.end()) {
+        response.validators.lastModified = std::string(lastModifiedIt->value());
+    }
 }
+}  // namespace
+
+BoostBeastHttpClient::BoostBeastHttpClient(std::chrono::seconds timeout) : timeout_(timeout) {}
 
 std::optional<std::string> BoostBeastHttpClient::get(const std::string& url) {
-    return handleRedirect(url, 0);
+    auto result = handleRedirect(url, {}, 0);
+    if (!result.hasContent()) {
+        return std::nullopt;
+    }
+    return std::move(result.body);
+}
+
+Core::Ports::HttpFetchResult BoostBeastHttpClient::fetch(
+    const std::string& url,
+    const Core::DTO::CacheValidatorsDTO& validators) {
+    return handleRedirect(url, validators, 0);
 }
 
 bool BoostBeastHttpClient::isAccessible(const std::string& url) {
@@ -40,9 +92,9 @@ bool BoostBeastHttpClient::isAccessible(const std::string& url) {
         HttpResponse response;
 
         if (parsedUrl.scheme == "https") {
-            response = performHttpsGet(parsedUrl);
+            response = performHttpsGet(parsedUrl, {});
         } else {
-            response = performHttpGet(parsedUrl);
+            response = performHttpGet(parsedUrl, {});
         }
 
         // Считаем URL доступным, если статус 2xx или 3xx
@@ -72,7 +124,9 @@ BoostBeastHttpClient::ParsedUrl BoostBeastHttpClient::parseUrl(const std::string
     // Порт (если не указан, используем стандартный)
     if (matches[3].matched) {
         result.port = matches[3].str();
+        result.authority = result.host + ":" + result.port;
     } else {
+        result.authority = result.host;
         result.port = (result.scheme == "https") ? std::to_string(DEFAULT_HTTPS_PORT)
                                                  : std::to_string(DEFAULT_HTTP_PORT);
     }
@@ -85,59 +139,60 @@ BoostBeastHttpClient::ParsedUrl BoostBeastHttpClient::parseUrl(const std::string
 }
 
 BoostBeastHttpClient::HttpResponse BoostBeastHttpClient::performHttpGet(
-    const ParsedUrl& parsedUrl) const {
+    const ParsedUrl& parsedUrl,
+    const Core::DTO::CacheValidatorsDTO& validators) const {
     try {
         // IO context для всех I/O операций
         net::io_context ioc;
 
         // Резолвим адрес
         tcp::resolver resolver(ioc);
+        Core::Ports::TraceSpan dnsSpan("http.dns", "http");
         const auto results = resolver.resolve(parsedUrl.host, parsedUrl.port);
+        dnsSpan.end();
 
         // Создаём сокет и устанавливаем таймаут
         beast::tcp_stream stream(ioc);
         stream.expires_after(timeout_);
 
         // Подключаемся с таймаутом
+        Core::Ports::TraceSpan connectSpan("http.connect", "http");
         stream.connect(results);
+        connectSpan.end();
 
         // Формируем HTTP GET запрос
         http::request<http::string_body> req{http::verb::get, parsedUrl.path, HTTP_VERSION};
         req.set(http::field::host, parsedUrl.host);
         req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+        applyValidators(req, validators);
 
-        // Отправляем запрос
+        // Отправляем запрос и получаем ответ
+        Core::Ports::TraceSpan downloadSpan("http.download", "http");
         http::write(stream, req);
 
-        // Получаем ответ
         beast::flat_buffer buffer;
         http::response<http::string_body> res;
         http::read(stream, buffer, res);
+        downloadSpan.end();
 
         // Закрываем соединение
         beast::error_code errc;
         stream.socket().shutdown(tcp::socket::shutdown_both, errc);
 
-        // Извлекаем заголовок Location (для редиректов)
+        // Статус, тело, заголовки и валидаторы ответа
         HttpResponse response;
-        response.body = res.body();
-        response.statusCode = static_cast<int>(res.result_int());
-
-        auto locationIt = res.find(http::field::location);
-        if (locationIt != res.end()) {
-            response.locationHeader = std::string(locationIt->value());
-        }
+        extractResponse(res, response);
 
         return response;
     } catch (const std::exception& e) {
-        std::cerr << "HTTP ошибка для " << parsedUrl.host << parsedUrl.path << ": " << e.what()
-                  << "\n";
-        return {"", 0, ""};
+        LOG_WARNING("http_client", "HTTP ошибка для ", parsedUrl.host, parsedUrl.path, ": ", e.what());
+        return {};
     }
 }
 
 BoostBeastHttpClient::HttpResponse BoostBeastHttpClient::performHttpsGet(
-    const ParsedUrl& parsedUrl) const {
+    const ParsedUrl& parsedUrl,
+    const Core::DTO::CacheValidatorsDTO& validators) const {
     try {
         // IO context для всех I/O операций
         net::io_context ioc;
@@ -154,9 +209,8 @@ BoostBeastHttpClient::HttpResponse BoostBeastHttpClient::performHttpsGet(
                 // Попытка 2: системные пути
                 ctx.set_default_verify_paths();
             } catch (const std::exception& e2) {
-                std::cerr << getLogPrefix()
-                          << "Предупреждение: не удалось загрузить SSL сертификаты. "
-                          << "Скачайте cacert.pem с https://curl.se/docs/caextract.html\n";
+                LOG_WARNING("http_client", "Не удалось загрузить SSL сертификаты. ",
+                            "Скачайте cacert.pem с https://curl.se/docs/caextract.html");
             }
         }
 
@@ -164,7 +218,9 @@ BoostBeastHttpClient::HttpResponse BoostBeastHttpClient::performHttpsGet(
 
         // Резолвим адрес
         tcp::resolver resolver(ioc);
+        Core::Ports::TraceSpan dnsSpan("http.dns", "http");
         const auto results = resolver.resolve(parsedUrl.host, parsedUrl.port);
+        dnsSpan.end();
 
         // Создаём SSL stream
         beast::ssl_stream<beast::tcp_stream> stream(ioc, ctx);
@@ -180,23 +236,29 @@ BoostBeastHttpClient::HttpResponse BoostBeastHttpClient::performHttpsGet(
         }
 
         // Подключаемся с таймаутом
+        Core::Ports::TraceSpan connectSpan("http.connect", "http");
         beast::get_lowest_layer(stream).connect(results);
+        connectSpan.end();
 
         // SSL handshake с таймаутом
+        Core::Ports::TraceSpan tlsSpan("http.tls", "http");
         stream.handshake(ssl::stream_base::client);
+        tlsSpan.end();
 
         // Формируем HTTP GET запрос
         http::request<http::string_body> req{http::verb::get, parsedUrl.path, HTTP_VERSION};
         req.set(http::field::host, parsedUrl.host);
         req.set(http::field::user_agent, BOOST_BEAST_VERSION_STRING);
+        applyValidators(req, validators);
 
-        // Отправляем запрос
+        // Отправляем запрос и получаем ответ
+        Core::Ports::TraceSpan downloadSpan("http.download", "http");
         http::write(stream, req);
 
-        // Получаем ответ
         beast::flat_buffer buffer;
         http::response<http::string_body> res;
         http::read(stream, buffer, res);
+        downloadSpan.end();
 
         // Закрываем соединение
         beast::error_code errc;
@@ -204,39 +266,32 @@ BoostBeastHttpClient::HttpResponse BoostBeastHttpClient::performHttpsGet(
         // Игнорируем ошибки при закрытии SSL (некоторые серверы закрывают
         // соединение некорректно)
 
-        // Извлекаем заголовок Location (для редиректов)
+        // Статус, тело, заголовки и валидаторы ответа
         HttpResponse response;
-        response.body = res.body();
-        response.statusCode = static_cast<int>(res.result_int());
-
-        auto locationIt = res.find(http::field::location);
-        if (locationIt != res.end()) {
-            response.locationHeader = std::string(locationIt->value());
-        }
+        extractResponse(res, response);
 
         return response;
     } catch (const std::exception& e) {
-        std::cerr << "HTTPS ошибка для " << parsedUrl.host << parsedUrl.path << ": " << e.what()
-                  << "\n";
-        return {"", 0, ""};
+        LOG_WARNING("http_client", "HTTPS ошибка для ", parsedUrl.host, parsedUrl.path, ": ", e.what());
+        return {};
     }
 }
 
-std::optional<std::string> BoostBeastHttpClient::handleRedirect(
+Core::Ports::HttpFetchResult BoostBeastHttpClient::handleRedirect(
     const std::string& url,
+    const Core::DTO::CacheValidatorsDTO& validators,
     int redirectCount,
     std::vector<std::string> visitedUrls) {
     if (redirectCount >= MAX_REDIRECTS) {
-        std::cerr << getLogPrefix() << "Превышено максимальное количество редиректов для " << url
-                  << "\n";
-        return std::nullopt;
+        LOG_WARNING("http_client", "Превышено максимальное количество редиректов для ", url);
+        return {};
     }
 
     // Проверка на циклические редиректы
     for (const auto& visitedUrl : visitedUrls) {
         if (visitedUrl == url) {
-            std::cerr << getLogPrefix() << "Обнаружен циклический редирект: " << url << "\n";
-            return std::nullopt;
+            LOG_WARNING("http_client", "Обнаружен циклический редирект: ", url);
+            return {};
         }
     }
 
@@ -245,33 +300,35 @@ std::optional<std::string> BoostBeastHttpClient::handleRedirect(
 
     const ParsedUrl parsedUrl = parseUrl(url);
     if (!parsedUrl.valid) {
-        std::cerr << getLogPrefix() << "Некорректный URL: " << url << "\n";
-        return std::nullopt;
+        LOG_WARNING("http_client", "Некорректный URL: ", url);
+        return {};
     }
 
     try {
         HttpResponse response;
 
+        Core::Ports::TraceSpan fetchSpan("http.fetch", "http", url);
         if (parsedUrl.scheme == "https") {
-            response = performHttpsGet(parsedUrl);
+            response = performHttpsGet(parsedUrl, validators);
         } else {
-            response = performHttpGet(parsedUrl);
+            response = performHttpGet(parsedUrl, validators);
         }
+        fetchSpan.end();
 
         // Проверяем статус ответа
-        if (response.statusCode >= HTTP_STATUS_OK &&
-            response.statusCode < HTTP_STATUS_MULTIPLE_CHOICES) {
-            // Успешный ответ (2xx)
-            return response.body;
+        if ((response.statusCode >= HTTP_STATUS_OK &&
+             response.statusCode < HTTP_STATUS_MULTIPLE_CHOICES) ||
+            response.statusCode == HTTP_STATUS_NOT_MODIFIED) {
+            // Успешный ответ (2xx) или 304 Not Modified (тело не передаётся)
+            return toFetchResult(std::move(response));
         }
 
         if (response.statusCode >= HTTP_STATUS_MULTIPLE_CHOICES &&
             response.statusCode < HTTP_STATUS_BAD_REQUEST) {
             // Редирект (3xx)
             if (response.locationHeader.empty()) {
-                std::cerr << getLogPrefix() << "Редирект обнаружен для " << url
-                          << ", но заголовок Location отсутствует\n";
-                return response.body;
+                LOG_WARNING("http_client", "Редирект обнаружен для ", url, ", но заголовок Location отсутствует");
+                return toFetchResult(std::move(response));
             }
 
             // Определяем абсолютный URL для редиректа
@@ -283,39 +340,39 @@ std::optional<std::string> BoostBeastHttpClient::handleRedirect(
                 redirectUrl = parsedUrl.scheme + ":" + redirectUrl;
             } else if (redirectUrl[0] == '/') {
                 // Относительный путь от корня
-                redirectUrl = parsedUrl.scheme + "://" + parsedUrl.host + redirectUrl;
+                redirectUrl = parsedUrl.scheme + "://" + parsedUrl.authority + redirectUrl;
             } else if (redirectUrl.substr(0, 4) != "http") {
                 // Относительный путь от текущего
                 const size_t lastSlash = parsedUrl.path.find_last_of('/');
                 const std::string basePath = (lastSlash != std::string::npos)
                                                  ? parsedUrl.path.substr(0, lastSlash + 1)
                                                  : "/";
-                redirectUrl = parsedUrl.scheme + "://" + parsedUrl.host + basePath + redirectUrl;
+                redirectUrl = parsedUrl.scheme + "://" + parsedUrl.authority + basePath + redirectUrl;
             }
 
-            std::cerr << getLogPrefix() << "Редирект: " << url << " -> " << redirectUrl << "\n";
+            LOG_DEBUG("http_client", "Редирект: ", url, " -> ", redirectUrl);
 
-            // Рекурсивно следуем по редиректу
-            return handleRedirect(redirectUrl, redirectCount + 1, visitedUrls);
+            // Рекурсивно следуем по редиректу. Валидаторы относятся к исходному URL, а не
+            // к цели редиректа: с ними другой ресурс мог бы ответить ложным 304
+            return handleRedirect(redirectUrl, {}, redirectCount + 1, visitedUrls);
         }
 
         // Ошибка клиента (4xx) или сервера (5xx)
-        std::cerr << getLogPrefix() << "HTTP ошибка " << response.statusCode << " для " << url
-                  << "\n";
-        return std::nullopt;
+        LOG_WARNING("http_client", "HTTP ошибка ", response.statusCode, " для ", url);
+        return toFetchResult(std::move(response));
 
     } catch (const std::exception& e) {
-        std::cerr << getLogPrefix() << "Исключение при запросе " << url << ": " << e.what() << "\n";
-        return std::nullopt;
+        LOG_WARNING("http_client", "Исключение при запросе ", url, ": ", e.what());
+        return {};
     }
 }
 
-std::string BoostBeastHttpClient::getLogPrefix() const {
-    if (workerId_ == 0) {
-        return "";  // Не установлен workerId
-    }
-    std::ostringstream oss;
-    oss << "[Поток " << workerId_ << "] ";
-    return oss.str();
+Core::Ports::HttpFetchResult BoostBeastHttpClient::toFetchResult(HttpResponse response) {
+    Core::Ports::HttpFetchResult result;
+    result.statusCode = response.statusCode;
+    result.body = std::move(response.body);
+    result.headers = std::move(response.headers);
+    result.validators = std::move(response.validators);
+    return result;
 }
 }  // namespace Infrastructure::Http
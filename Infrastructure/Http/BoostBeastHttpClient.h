@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <map>
 #include <string>
 #include <vector>
 
@@ -34,6 +35,19 @@ class BoostBeastHttpClient : public Core::Ports::IHttpClient {
      */
     std::optional<std::string> get(const std::string& url) override;
 
+    /**
+     * @brief Выполняет условный GET-запрос по указанному URL
+     * @param url URL для запроса (поддерживает http:// и https://)
+     * @param validators ETag / Last-Modified прошлого ответа
+     * @return Статус, заголовки, тело и новые валидаторы
+     *
+     * Отправляет If-None-Match / If-Modified-Since, если валидаторы заданы;
+     * запросы по редиректам отправляются без них. Ответ 304 Not Modified
+     * возвращается без тела и не считается ошибкой.
+     */
+    Core::Ports::HttpFetchResult fetch(const std::string& url,
+                                       const Core::DTO::CacheValidatorsDTO& validators = {}) override;
+
     /**
      * @brief Проверяет, доступен ли URL
      * @param url URL для проверки
@@ -41,15 +55,8 @@ class BoostBeastHttpClient : public Core::Ports::IHttpClient {
      */
     bool isAccessible(const std::string& url) override;
 
-    /**
-     * @brief Устанавливает ID рабочего потока для логирования
-     * @param workerId Номер потока (1, 2, 3...)
-     */
-    void setWorkerId(int workerId) override;
-
   private:
     std::chrono::seconds timeout_;
-    int workerId_ = 0;  // ID рабочего потока для логирования
 
     static constexpr int MAX_REDIRECTS = 5;
     static constexpr int HTTP_VERSION = 11;
@@ -57,6 +64,7 @@ class BoostBeastHttpClient : public Core::Ports::IHttpClient {
     static constexpr int DEFAULT_HTTPS_PORT = 443;
     static constexpr int HTTP_STATUS_OK = 200;
     static constexpr int HTTP_STATUS_MULTIPLE_CHOICES = 300;
+    static constexpr int HTTP_STATUS_NOT_MODIFIED = 304;
     static constexpr int HTTP_STATUS_BAD_REQUEST = 400;
     static constexpr int HTTP_REQUEST_TIMEOUT_SEC = 10;
 
@@ -68,6 +76,7 @@ class BoostBeastHttpClient : public Core::Ports::IHttpClient {
         std::string host;
         std::string port;
         std::string path;
+        std::string authority;  // host или host:port, как в исходном URL (для относительных редиректов)
         bool valid;
     };
 
@@ -76,8 +85,10 @@ class BoostBeastHttpClient : public Core::Ports::IHttpClient {
      */
     struct HttpResponse {
         std::string body;
-        int statusCode;
-        std::string locationHeader;  // Заголовок Location для редиректов
+        int statusCode = 0;
+        std::string locationHeader;                  // Заголовок Location для редиректов
+        std::map<std::string, std::string> headers;  // Все заголовки ответа
+        Core::DTO::CacheValidatorsDTO validators;    // ETag / Last-Modified
     };
 
     /**
@@ -90,32 +101,37 @@ class BoostBeastHttpClient : public Core::Ports::IHttpClient {
     /**
      * @brief Выполняет HTTP GET-запрос (без SSL)
      * @param parsedUrl Распарсенный URL
+     * @param validators Валидаторы для условного запроса
      * @return HTTP ответ (тело, статус, заголовки)
      */
-    HttpResponse performHttpGet(const ParsedUrl& parsedUrl) const;
+    HttpResponse performHttpGet(const ParsedUrl& parsedUrl,
+                                const Core::DTO::CacheValidatorsDTO& validators) const;
 
     /**
      * @brief Выполняет HTTPS GET-запрос (с SSL)
      * @param parsedUrl Распарсенный URL
+     * @param validators Валидаторы для условного запроса
      * @return HTTP ответ (тело, статус, заголовки)
      */
-    HttpResponse performHttpsGet(const ParsedUrl& parsedUrl) const;
+    HttpResponse performHttpsGet(const ParsedUrl& parsedUrl,
+                                 const Core::DTO::CacheValidatorsDTO& validators) const;
 
     /**
      * @brief Обрабатывает редиректы
      * @param location URL для редиректа
+     * @param validators Валидаторы для условного запроса (только для первого запроса цепочки)
      * @param redirectCount Текущее количество редиректов
      * @param visitedUrls Список посещённых URL для детектирования циклов
-     * @return Содержимое страницы после редиректа
+     * @return Результат запроса после всех редиректов (статус 0 при ошибке сети)
      */
-    std::optional<std::string> handleRedirect(const std::string& location,
-                                              int redirectCount,
-                                              std::vector<std::string> visitedUrls = {});
+    Core::Ports::HttpFetchResult handleRedirect(const std::string& location,
+                                                const Core::DTO::CacheValidatorsDTO& validators,
+                                                int redirectCount,
+                                                std::vector<std::string> visitedUrls = {});
 
     /**
-     * @brief Формирует префикс лог-сообщения с ID потока
-     * @return Строка вида "[Поток X] " для логов
+     * @brief Преобразует внутренний ответ в результат порта
      */
-    std::string getLogPrefix() const;
+    static Core::Ports::HttpFetchResult toFetchResult(HttpResponse response);
 };
 } // namespace Infrastructure::Http
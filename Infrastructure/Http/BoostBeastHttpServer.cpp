@@ -1,178 +1,226 @@
 #include "BoostBeastHttpServer.h"
 
-#include <iostream>
+#include <algorithm>
+#include <string>
 
 #include <boost/asio/strand.hpp>
 #include <boost/beast/core.hpp>
-#include <boost/beast/http.hpp>
-#include <boost/beast/version.hpp>
 
-#include "../../Core/Ports/IHttpServer.h"
+#include "../Logging/Logger.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace beast = boost::beast;
-namespace http = beast::http;
 namespace net = boost::asio;
 using tcp = boost::asio::ip::tcp;
 
 namespace Infrastructure::Http {
-BoostBeastHttpServer::BoostBeastHttpServer(unsigned int threadCount)
-    : threadCount_(threadCount), ioc_(nullptr) {}
+namespace {
+#ifdef SO_REUSEPORT
+using ReusePortOption = net::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+constexpr bool REUSE_PORT_SUPPORTED = true;
+#else
+constexpr bool REUSE_PORT_SUPPORTED = false;
+#endif
+
+/**
+ * @brief Привязывает текущий поток к ядру
+ * @return false, если платформа не поддерживает привязку или она не удалась
+ */
+bool pinCurrentThread(unsigned int core) {
+#ifdef _WIN32
+    constexpr unsigned int MASK_BITS = sizeof(DWORD_PTR) * 8;
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << (core % MASK_BITS)) != 0;
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core % CPU_SETSIZE, &cpuSet);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+    (void)core;
+    return false;
+#endif
+}
+} // namespace
+
+BoostBeastHttpServer::BoostBeastHttpServer(const HttpServerSettings& settings,
+                                           std::shared_ptr<Core::Ports::IMetricsRegistry> metrics)
+    : settings_(settings), metricsRegistry_(std::move(metrics)) {
+    settings_.threadCount = std::max(settings_.threadCount, 1U);
+    if (metricsRegistry_) {
+        metrics_ = HttpServerMetrics::create(metricsRegistry_);
+    }
+}
 
 BoostBeastHttpServer::~BoostBeastHttpServer() {
     stop();
 }
 
 void BoostBeastHttpServer::start(int port, RequestHandler handler) {
-    handler_ = std::move(handler);
-
-    // Создаём io_context
-    ioc_ = std::make_unique<net::io_context>(static_cast<int>(threadCount_));
-
-    // Создаём acceptor
-    auto acceptor = std::make_shared<tcp::acceptor>(*ioc_);
-    const tcp::endpoint endpoint{tcp::v4(), static_cast<unsigned short>(port)};
-
-    beast::error_code errc;
-
-    // Открываем acceptor
-    acceptor->open(endpoint.protocol(), errc);
-    if (errc) {
-        std::cerr << "Ошибка открытия acceptor: " << errc.message() << "\n";
-        return;
+    if (metricsRegistry_) {
+        // Метрики отдаются до обработчика приложения, чтобы их можно было снимать при любой его загрузке
+        handler = [inner = std::move(handler),
+                   registry = metricsRegistry_](const Core::Ports::HttpRequestView& request) {
+            if (request.method == "GET" && request.target == "/metrics") {
+                auto response = Core::Ports::HttpResponse::text(registry->render());
+                response.setHeader("Content-Type", "text/plain; version=0.0.4; charset=utf-8");
+                return response;
+            }
+            return inner(request);
+        };
     }
+    handler_ = std::make_shared<const RequestHandler>(std::move(handler));
 
-    // Устанавливаем SO_REUSEADDR
-    acceptor->set_option(net::socket_base::reuse_address(true), errc);
-    if (errc) {
-        std::cerr << "Ошибка установки опции reuse_address: " << errc.message() << "\n";
-        return;
+    bool reusePort = settings_.reusePort;
+    if (reusePort && !REUSE_PORT_SUPPORTED) {
+        LOG_WARNING("http_server", "SO_REUSEPORT не поддерживается, используется общий acceptor");
+        reusePort = false;
     }
 
-    // Привязываем к адресу
-    acceptor->bind(endpoint, errc);
-    if (errc) {
-        std::cerr << "Ошибка привязки к порту " << port << ": " << errc.message() << "\n";
-        return;
-    }
+    const unsigned int threadCount = settings_.threadCount;
 
-    // Начинаем прослушивание
-    acceptor->listen(BACKLOG_SIZE, errc);
-    if (errc) {
-        std::cerr << "Ошибка начала прослушивания: " << errc.message() << "\n";
+    // Режим reusePort: по io_context и acceptor на поток, иначе один io_context на все потоки
+    const unsigned int contextCount = reusePort ? threadCount : 1;
+    const int concurrencyHint = reusePort ? 1 : static_cast<int>(threadCount);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopRequested_) {
+        // stop() вызван раньше, чем сервер успел запуститься
         return;
     }
+    contexts_.clear();
+    for (unsigned int i = 0; i < contextCount; ++i) {
+        contexts_.push_back(std::make_unique<net::io_context>(concurrencyHint));
+
+        auto acceptor = openAcceptor(*contexts_.back(), port, reusePort);
+        if (!acceptor) {
+            contexts_.clear();
+            return;
+        }
 
-    std::cout << "HTTP сервер запущен на порту " << port << "\n";
+        // Начинаем принимать соединения
+        doAccept(acceptor, !reusePort);
+    }
 
-    // Начинаем принимать соединения
-    doAccept(acceptor);
+    LOG_INFO("http_server", "HTTP сервер запущен на порту ", port, " (потоков: ", threadCount,
+             reusePort ? ", SO_REUSEPORT" : "", ")");
 
-    // Запускаем пул потоков для io_context
-    threads_.reserve(threadCount_);
-    for (unsigned int i = 0; i < threadCount_; ++i) {
-        threads_.emplace_back([this] { ioc_->run(); });
+    // Запускаем пул потоков: в режиме reusePort i-й поток выполняет i-й io_context
+    threads_.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i) {
+        net::io_context& ioc = *contexts_[i % contextCount];
+        threads_.emplace_back([this, &ioc, i] { runContext(ioc, i); });
     }
+    lock.unlock();
 
     // Ждём завершения всех потоков
     for (auto& thread : threads_) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+        thread.join();
     }
+    threads_.clear();
+
+    LOG_INFO("http_server", "HTTP сервер остановлен");
 }
 
 void BoostBeastHttpServer::stop() {
-    if (ioc_) {
-        ioc_->stop();
+    // Потоки присоединяет start(): stop() вызывается из другого потока, пока start() их ждёт
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopRequested_ = true;
+    for (auto& ioc : contexts_) {
+        ioc->stop();
     }
-
-    for (auto& thread : threads_) {
-        if (thread.joinable()) {
-            thread.join();
-        }
-    }
-
-    threads_.clear();
-    std::cout << "HTTP сервер остановлен\n";
 }
 
-void BoostBeastHttpServer::doAccept(const std::shared_ptr<tcp::acceptor>& acceptor) {
-    acceptor->async_accept(
-        net::make_strand(*ioc_), [this, acceptor](beast::error_code errc, tcp::socket socket) {
-            if (!errc) {
-                // Обрабатываем соединение в отдельной задаче
-                net::post(socket.get_executor(), [this, sck = std::move(socket)]() mutable {
-                    handleSession(std::move(sck));
-                });
-            } else {
-                std::cerr << "Ошибка принятия соединения: " << errc.message() << "\n";
-            }
-
-            // Принимаем следующее соединение
-            doAccept(acceptor);
-        });
-}
+std::shared_ptr<tcp::acceptor> BoostBeastHttpServer::openAcceptor(net::io_context& ioc,
+                                                                  int port,
+                                                                  bool reusePort) {
+    auto acceptor = std::make_shared<tcp::acceptor>(ioc);
+    const tcp::endpoint endpoint{tcp::v4(), static_cast<unsigned short>(port)};
 
-void BoostBeastHttpServer::handleSession(tcp::socket socket) {
     beast::error_code errc;
 
-    // Буфер для чтения
-    beast::flat_buffer buffer;
-
-    // Читаем HTTP-запрос
-    http::request<http::string_body> req;
-    http::read(socket, buffer, req, errc);
-
-    if (errc == http::error::end_of_stream) {
-        // Клиент закрыл соединение
-        socket.shutdown(tcp::socket::shutdown_send, errc);
-        return;
+    // Открываем acceptor
+    acceptor->open(endpoint.protocol(), errc);
+    if (errc) {
+        LOG_ERROR("http_server", "Ошибка открытия acceptor: ", errc.message());
+        return nullptr;
     }
 
+    // Устанавливаем SO_REUSEADDR
+    acceptor->set_option(net::socket_base::reuse_address(true), errc);
     if (errc) {
-        std::cerr << "Ошибка чтения запроса: " << errc.message() << "\n";
-        return;
+        LOG_ERROR("http_server", "Ошибка установки опции reuse_address: ", errc.message());
+        return nullptr;
     }
 
-    // Вызываем обработчик запроса
-    Core::Ports::HttpResponse httpResponse;
-    http::status responseStatus = http::status::ok;
-
-    try {
-        httpResponse =
-            handler_(std::string(req.method_string()), std::string(req.target()), req.body());
-        responseStatus = static_cast<http::status>(httpResponse.statusCode);
-    } catch (const std::exception& e) {
-        httpResponse.body = R"({"error": "Internal server error"})";
-        httpResponse.headers["Content-Type"] = "application/json";
-        responseStatus = http::status::internal_server_error;
-        std::cerr << "Ошибка обработки запроса: " << e.what() << "\n";
+#ifdef SO_REUSEPORT
+    // Несколько acceptor на одном порту: ядро распределяет между ними новые соединения
+    if (reusePort) {
+        acceptor->set_option(ReusePortOption(true), errc);
+        if (errc) {
+            LOG_ERROR("http_server", "Ошибка установки опции reuse_port: ", errc.message());
+            return nullptr;
+        }
     }
+#else
+    (void)reusePort;
+#endif
 
-    // Создаём HTTP-ответ
-    http::response<http::string_body> res{responseStatus, req.version()};
-    res.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+    // Привязываем к адресу
+    acceptor->bind(endpoint, errc);
+    if (errc) {
+        LOG_ERROR("http_server", "Ошибка привязки к порту ", port, ": ", errc.message());
+        return nullptr;
+    }
 
-    // Устанавливаем все заголовки из HttpResponse
-    for (const auto& [name, value] : httpResponse.headers) {
-        res.set(name, value);
+    // Начинаем прослушивание
+    acceptor->listen(BACKLOG_SIZE, errc);
+    if (errc) {
+        LOG_ERROR("http_server", "Ошибка начала прослушивания: ", errc.message());
+        return nullptr;
     }
 
-    res.keep_alive(req.keep_alive());
-    res.body() = httpResponse.body;
-    res.prepare_payload();
+    return acceptor;
+}
 
-    // Отправляем ответ
-    http::write(socket, res, errc);
+void BoostBeastHttpServer::doAccept(const std::shared_ptr<tcp::acceptor>& acceptor, bool useStrand) {
+    auto onAccept = [this, acceptor, useStrand](beast::error_code errc, tcp::socket socket) {
+        if (!errc) {
+            // Соединение обслуживается асинхронно в executor своего сокета
+            std::make_shared<BoostBeastHttpSession>(std::move(socket), handler_, settings_.session, metrics_)
+                ->run();
+        } else {
+            LOG_WARNING("http_server", "Ошибка принятия соединения: ", errc.message());
+        }
 
-    if (errc) {
-        std::cerr << "Ошибка отправки ответа: " << errc.message() << "\n";
-        return;
+        // Принимаем следующее соединение
+        doAccept(acceptor, useStrand);
+    };
+
+    // io_context с одним потоком не нуждается в strand: сокет получает executor acceptor
+    if (useStrand) {
+        acceptor->async_accept(net::make_strand(acceptor->get_executor()), std::move(onAccept));
+    } else {
+        acceptor->async_accept(std::move(onAccept));
     }
+}
+
+void BoostBeastHttpServer::runContext(net::io_context& ioc, unsigned int threadIndex) const {
+    Logging::setThreadName("HTTP " + std::to_string(threadIndex));
 
-    // Закрываем соединение, если не keep-alive
-    if (!req.keep_alive()) {
-        socket.shutdown(tcp::socket::shutdown_send, errc);
+    if (settings_.pinThreads) {
+        // Потоков может быть больше, чем ядер: тогда ядра назначаются по кругу
+        const unsigned int core = threadIndex % std::max(std::thread::hardware_concurrency(), 1U);
+        if (!pinCurrentThread(core)) {
+            LOG_WARNING("http_server", "Не удалось привязать поток ", threadIndex, " к ядру ", core);
+        }
     }
+
+    ioc.run();
 }
 } // namespace Infrastructure::Http
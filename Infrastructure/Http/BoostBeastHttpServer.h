@@ -1,28 +1,51 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
 #include "../../Core/Ports/IHttpServer.h"
+#include "BoostBeastHttpSession.h"
 
 namespace Infrastructure::Http {
+/**
+ * @brief Настройки HTTP-сервера
+ */
+struct HttpServerSettings {
+    unsigned int threadCount = 4;
+    bool reusePort = false;   // Свой io_context и свой acceptor (SO_REUSEPORT) на каждый поток
+    bool pinThreads = false;  // Привязать i-й поток к i-му ядру (по кругу, если потоков больше)
+    HttpSessionSettings session;
+};
+
 /**
  * @brief Асинхронный HTTP-сервер на основе Boost.Beast и Boost.Asio
  *
  * Многопоточный HTTP/1.1 сервер для REST API поисковой системы.
- * Использует пул потоков для обработки запросов.
+ * Использует пул потоков для обработки запросов. Каждое соединение
+ * обслуживается BoostBeastHttpSession (keep-alive, pipelining, таймауты).
+ *
+ * Два режима:
+ * - общий: один io_context и один acceptor, io_context выполняют все потоки;
+ * - reusePort: у каждого потока свой io_context и свой acceptor на том же порту
+ *   (SO_REUSEPORT). Соединения между потоками распределяет ядро ОС, и соединение
+ *   от принятия до закрытия обслуживает один поток, без передачи между потоками
+ *   и без strand. Если платформа не поддерживает SO_REUSEPORT, используется общий режим.
  */
 class BoostBeastHttpServer : public Core::Ports::IHttpServer {
   public:
     /**
-     * @brief Конструктор с настройкой количества потоков
-     * @param threadCount Количество потоков для обработки запросов (по умолчанию
-     * 4)
+     * @brief Конструктор
+     * @param settings Количество потоков, режим работы и настройки соединений
+     * @param metrics Реестр метрик: сервер ведёт в нём метрики соединений
+     *                и отдаёт его содержимое по GET /metrics (nullptr - без метрик)
      */
-    explicit BoostBeastHttpServer(unsigned int threadCount = 4);
+    explicit BoostBeastHttpServer(const HttpServerSettings& settings = {},
+                                  std::shared_ptr<Core::Ports::IMetricsRegistry> metrics = nullptr);
 
     ~BoostBeastHttpServer() override;
 
@@ -39,28 +62,46 @@ class BoostBeastHttpServer : public Core::Ports::IHttpServer {
     /**
      * @brief Останавливает HTTP-сервер
      *
-     * Останавливает прием новых соединений и завершает работу всех потоков.
+     * Останавливает прием новых соединений и завершает работу всех потоков;
+     * start() возвращается, когда потоки завершатся. Можно вызывать из любого потока.
      */
     void stop() override;
 
   private:
-    unsigned int threadCount_;
-    std::unique_ptr<boost::asio::io_context> ioc_;
+    HttpServerSettings settings_;
+    std::shared_ptr<const RequestHandler> handler_;
+    std::shared_ptr<Core::Ports::IMetricsRegistry> metricsRegistry_;
+    std::shared_ptr<const HttpServerMetrics> metrics_;
+    std::mutex mutex_;  // Защищает contexts_ и stopRequested_: stop() вызывается из других потоков
+    bool stopRequested_ = false;
+    std::vector<std::unique_ptr<boost::asio::io_context>> contexts_;
     std::vector<std::thread> threads_;
-    RequestHandler handler_;
 
     static constexpr int BACKLOG_SIZE = 128;
 
+    /**
+     * @brief Открывает acceptor на порту
+     * @param ioc io_context, в котором будут приниматься соединения
+     * @param port Порт для прослушивания
+     * @param reusePort Установить SO_REUSEPORT
+     * @return Acceptor или nullptr (ошибка уже выведена)
+     */
+    static std::shared_ptr<boost::asio::ip::tcp::acceptor> openAcceptor(boost::asio::io_context& ioc,
+                                                                        int port,
+                                                                        bool reusePort);
+
     /**
      * @brief Запускает прием соединений
      * @param acceptor TCP acceptor для принятия соединений
+     * @param useStrand Обслуживать соединения через strand (io_context выполняют несколько потоков)
      */
-    void doAccept(const std::shared_ptr<boost::asio::ip::tcp::acceptor>& acceptor);
+    void doAccept(const std::shared_ptr<boost::asio::ip::tcp::acceptor>& acceptor, bool useStrand);
 
     /**
-     * @brief Обрабатывает одно соединение
-     * @param socket TCP сокет для соединения
+     * @brief Выполняет io_context в текущем потоке
+     * @param ioc io_context
+     * @param threadIndex Номер потока (определяет ядро для привязки)
      */
-    void handleSession(boost::asio::ip::tcp::socket socket);
+    void runContext(boost::asio::io_context& ioc, unsigned int threadIndex) const;
 };
 } // namespace Infrastructure::Http
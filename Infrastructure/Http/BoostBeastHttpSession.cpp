@@ -0,0 +1,406 @@
+#include "BoostBeastHttpSession.h"
+
+#include <chrono>
+#include <string_view>
+
+#include <boost/asio/dispatch.hpp>
+#include <boost/beast/version.hpp>
+
+#include "../Logging/Logger.h"
+#include "ResponseCompressor.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+
+#include <cerrno>
+#endif
+
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = boost::asio::ip::tcp;
+
+namespace Infrastructure::Http {
+namespace {
+/**
+ * @brief Проверяет, что ошибка - обычное завершение соединения, а не сбой
+ */
+bool isDisconnect(const beast::error_code& errc) {
+    return errc == http::error::end_of_stream || errc == net::error::eof || errc == beast::error::timeout ||
+           errc == net::error::operation_aborted || errc == net::error::connection_reset;
+}
+
+std::string_view toStringView(beast::string_view value) {
+    return {value.data(), value.size()};
+}
+
+/**
+ * @brief Ищет заголовок в полях запроса Beast (для HttpRequestView)
+ */
+std::string_view findRequestHeader(const void* headers, std::string_view name) {
+    const auto& fields = *static_cast<const http::fields*>(headers);
+    const auto it = fields.find(beast::string_view(name.data(), name.size()));
+    return it != fields.end() ? toStringView(it->value()) : std::string_view();
+}
+
+/**
+ * @brief Ответ 500 на исключение обработчика в формате, который ждёт клиент
+ *
+ * Браузеры (Accept с text/html) получают страницу, остальные клиенты - JSON, как от API.
+ */
+Core::Ports::HttpResponse makeInternalErrorResponse(const http::fields& requestHeaders) {
+    const std::string_view accept = toStringView(requestHeaders[http::field::accept]);
+    if (accept.find("text/html") != std::string_view::npos) {
+        return Core::Ports::HttpResponse::html(
+            "<!DOCTYPE html><html><head><meta charset=\"utf-8\"><title>500</title></head>"
+            "<body><h1>Внутренняя ошибка сервера</h1></body></html>",
+            500);
+    }
+    return Core::Ports::HttpResponse::json(R"({"error": "Internal server error"})", 500);
+}
+
+/**
+ * @brief Проверяет, закрыл ли клиент соединение, не забирая данные из сокета
+ *
+ * Вызывается из потока сторожа отмены, пока обработчик занимает поток сессии,
+ * и параллельно с ним может идти async_write предыдущего ответа. Поэтому объект
+ * сокета Asio (его состояние меняют асинхронные операции) не используется:
+ * recv с MSG_PEEK идёт напрямую в дескриптор, не ждёт данных и не меняет их очередь.
+ */
+bool isPeerClosed(tcp::socket::native_handle_type handle) {
+    char byte = 0;
+#ifdef _WIN32
+    // Сокет переведён в неблокирующий режим в конструкторе сессии
+    const int received = ::recv(handle, &byte, 1, MSG_PEEK);
+    if (received == SOCKET_ERROR) {
+        return WSAGetLastError() != WSAEWOULDBLOCK;
+    }
+#else
+    const ssize_t received = ::recv(handle, &byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    if (received < 0) {
+        return errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR;
+    }
+#endif
+    return received == 0;
+}
+
+/**
+ * @brief Сжимает тело ответа, если клиент принимает сжатие и тело того стоит
+ */
+void compressResponse(const http::fields& requestFields,
+                      Core::Ports::HttpResponse& response,
+                      const HttpSessionSettings& settings) {
+    if (settings.compressionMinSize == 0 || response.body.size() < settings.compressionMinSize ||
+        response.findHeader("Content-Encoding") != nullptr) {
+        return;
+    }
+
+    const std::string* contentType = response.findHeader("Content-Type");
+    if (contentType == nullptr || !ResponseCompressor::isCompressibleType(*contentType)) {
+        return;
+    }
+
+    // Ответ зависит от Accept-Encoding, даже если этот клиент получит его без сжатия
+    response.setHeader("Vary", "Accept-Encoding");
+
+    const auto encoding = ResponseCompressor::negotiate(toStringView(requestFields[http::field::accept_encoding]));
+    if (encoding == ContentEncoding::IDENTITY) {
+        return;
+    }
+
+    const auto startedAt = std::chrono::steady_clock::now();
+    std::string compressed = ResponseCompressor::compress(response.body, encoding, settings.compressionLevel);
+    ResponseCompressor::recordCompression(response.body.size(), compressed.size(),
+                                          std::chrono::steady_clock::now() - startedAt);
+
+    response.body = std::move(compressed);
+    response.setHeader("Content-Encoding", ResponseCompressor::getEncodingName(encoding));
+}
+} // namespace
+
+std::shared_ptr<const HttpServerMetrics> HttpServerMetrics::create(
+    std::shared_ptr<Core::Ports::IMetricsRegistry> registry) {
+    auto metrics = std::make_shared<HttpServerMetrics>();
+    metrics->connections = &registry->counter("http_connections_total", "Accepted HTTP connections");
+    metrics->activeConnections = &registry->gauge("http_connections_active", "Open HTTP connections");
+    metrics->requestsInFlight = &registry->gauge("http_requests_in_flight", "HTTP requests being handled");
+    metrics->requestRead = &registry->histogram("http_request_read_duration_seconds",
+                                                "Time from the first request byte to the parsed request");
+    metrics->requestHandling = &registry->histogram("http_request_duration_seconds",
+                                                    "Request handling time including response compression");
+    for (size_t statusClass = 0; statusClass < metrics->responses.size(); ++statusClass) {
+        metrics->responses[statusClass] =
+            &registry->counter("http_responses_total", "HTTP responses by status class",
+                               "code=\"" + std::to_string(statusClass + 1) + "xx\"");
+    }
+    metrics->registry = std::move(registry);
+    return metrics;
+}
+
+BoostBeastHttpSession::BoostBeastHttpSession(tcp::socket&& socket,
+                                             std::shared_ptr<const RequestHandler> handler,
+                                             const HttpSessionSettings& settings,
+                                             std::shared_ptr<const HttpServerMetrics> metrics)
+    : stream_(std::move(socket)),
+      readTimer_(stream_.get_executor()),
+      handler_(std::move(handler)),
+      settings_(settings),
+      metrics_(std::move(metrics)) {
+    if (metrics_) {
+        metrics_->connections->add();
+        metrics_->activeConnections->add(1);
+    }
+
+    beast::error_code errc;
+    const auto endpoint = stream_.socket().remote_endpoint(errc);
+    if (!errc) {
+        remoteAddress_ = endpoint.address().to_string();
+    }
+
+    // Только для проверки отключения клиента; на асинхронные операции не влияет
+    stream_.socket().non_blocking(true, errc);
+}
+
+BoostBeastHttpSession::~BoostBeastHttpSession() {
+    if (metrics_) {
+        metrics_->activeConnections->add(-1);
+    }
+}
+
+void BoostBeastHttpSession::run() {
+    // Все операции соединения выполняются в executor его сокета (strand или io_context с одним потоком)
+    net::dispatch(stream_.get_executor(), [self = shared_from_this()] { self->waitForRequest(); });
+}
+
+void BoostBeastHttpSession::waitForRequest() {
+    reading_ = true;
+
+    // Клиент уже прислал следующий запрос вместе с предыдущим (pipelining)
+    if (buffer_.size() > 0) {
+        readRequest();
+        return;
+    }
+
+    armReadTimer(settings_.keepAliveTimeout);
+    stream_.socket().async_read_some(
+        buffer_.prepare(IDLE_READ_SIZE),
+        beast::bind_front_handler(&BoostBeastHttpSession::onIdleRead, shared_from_this()));
+}
+
+void BoostBeastHttpSession::onIdleRead(beast::error_code errc, size_t bytesTransferred) {
+    if (errc) {
+        readTimer_.cancel();
+        reading_ = false;
+        readingStopped_ = true;
+
+        if (!isDisconnect(errc)) {
+            LOG_WARNING("http_server", "Ошибка чтения запроса: ", errc.message());
+        } else if (errc == net::error::eof && responses_.empty()) {
+            close();
+        }
+        return;
+    }
+
+    buffer_.commit(bytesTransferred);
+    readRequest();
+}
+
+void BoostBeastHttpSession::readRequest() {
+    parser_.emplace();
+    parser_->body_limit(settings_.maxBodySize);
+    if (metrics_) {
+        readStartedAt_ = std::chrono::steady_clock::now();
+    }
+
+    // Начатый запрос должен прийти целиком за readTimeout, как бы медленно клиент ни слал байты
+    armReadTimer(settings_.readTimeout);
+    http::async_read(stream_.socket(), buffer_, *parser_,
+                     beast::bind_front_handler(&BoostBeastHttpSession::onRead, shared_from_this()));
+}
+
+void BoostBeastHttpSession::onRead(beast::error_code errc, size_t /*bytesTransferred*/) {
+    reading_ = false;
+    readTimer_.cancel();
+
+    if (errc) {
+        readingStopped_ = true;
+
+        if (errc == http::error::end_of_stream) {
+            if (responses_.empty()) {
+                close();
+            }
+        } else if (!isDisconnect(errc)) {
+            LOG_WARNING("http_server", "Ошибка чтения запроса: ", errc.message());
+        }
+        return;
+    }
+
+    if (metrics_) {
+        metrics_->requestRead->record(std::chrono::steady_clock::now() - readStartedAt_);
+    }
+
+    ++requestCount_;
+    auto request = parser_->release();
+
+    // Последний запрос соединения: после ответа на него соединение закрывается
+    const bool keepAlive = request.keep_alive() && requestCount_ < settings_.maxRequestsPerConnection;
+    if (!keepAlive) {
+        readingStopped_ = true;
+    }
+
+    queueResponse(handleRequest(std::move(request), keepAlive));
+    continueReading();
+}
+
+void BoostBeastHttpSession::armReadTimer(std::chrono::seconds timeout) {
+    readTimer_.expires_after(timeout);
+    readTimer_.async_wait(beast::bind_front_handler(&BoostBeastHttpSession::onReadTimeout, shared_from_this()));
+}
+
+void BoostBeastHttpSession::onReadTimeout(beast::error_code errc) {
+    // Таймер отменён или перезапущен, пока его обработчик ждал в очереди
+    if (errc == net::error::operation_aborted || !reading_ ||
+        readTimer_.expiry() > std::chrono::steady_clock::now()) {
+        return;
+    }
+
+    readingStopped_ = true;
+    if (responses_.empty()) {
+        abort();
+        return;
+    }
+
+    // Запись ответов идёт со своим сроком: соединение закроется, когда она завершится
+    readTimedOut_ = true;
+}
+
+http::response<http::string_body> BoostBeastHttpSession::handleRequest(http::request<http::string_body>&& request,
+                                                                       bool keepAlive) {
+    // Обработчик видит буферы запроса напрямую: они живы до конца вызова
+    Core::Ports::HttpRequestView requestView;
+    requestView.method = toStringView(request.method_string());
+    requestView.target = toStringView(request.target());
+    requestView.body = request.body();
+    requestView.remoteAddress = remoteAddress_;
+
+    // Дескриптор берётся здесь, в executor сокета: пока идёт обработчик, сокет не
+    // закрывается (закрытие тоже выполняется в executor), а срок запроса не переживает вызов
+    auto disconnectProbe = [handle = stream_.socket().native_handle()] { return isPeerClosed(handle); };
+    if (settings_.requestTimeout.count() > 0) {
+        requestView.deadline = Core::Ports::RequestDeadline(
+            Core::Ports::RequestDeadline::Clock::now() + settings_.requestTimeout, disconnectProbe);
+    } else {
+        requestView.deadline = Core::Ports::RequestDeadline(disconnectProbe);
+    }
+    requestView.headers = &request.base();
+    requestView.headerLookup = &findRequestHeader;
+
+    Core::Ports::HttpResponse httpResponse;
+    Core::Ports::ScopedLatency handlingLatency(metrics_ ? metrics_->requestHandling : nullptr);
+    if (metrics_) {
+        metrics_->requestsInFlight->add(1);
+    }
+
+    try {
+        httpResponse = (*handler_)(requestView);
+    } catch (const std::exception& e) {
+        httpResponse = makeInternalErrorResponse(request.base());
+        LOG_ERROR("http_server", "Ошибка обработки запроса: ", e.what());
+    }
+
+    try {
+        compressResponse(request.base(), httpResponse, settings_);
+    } catch (const std::exception& e) {
+        // Без сжатия ответ остаётся корректным
+        LOG_ERROR("http_server", "Ошибка сжатия ответа: ", e.what());
+    }
+    ResponseCompressor::recordResponse(httpResponse.body.size());
+
+    if (metrics_) {
+        metrics_->requestsInFlight->add(-1);
+        const auto statusClass = static_cast<size_t>(httpResponse.statusCode / 100);
+        if (statusClass >= 1 && statusClass <= metrics_->responses.size()) {
+            metrics_->responses[statusClass - 1]->add();
+        }
+    }
+
+    http::response<http::string_body> response{static_cast<http::status>(httpResponse.statusCode),
+                                               request.version()};
+    response.set(http::field::server, BOOST_BEAST_VERSION_STRING);
+
+    for (const auto& header : httpResponse.headers) {
+        response.set(header.name, header.value);
+    }
+
+    response.keep_alive(keepAlive);
+    // Тело ответа не копируется: строка обработчика становится буфером Beast
+    response.body() = std::move(httpResponse.body);
+    response.prepare_payload();
+
+    return response;
+}
+
+void BoostBeastHttpSession::queueResponse(http::response<http::string_body>&& response) {
+    responses_.push(std::move(response));
+
+    if (responses_.size() == 1) {
+        writeResponse();
+    }
+}
+
+void BoostBeastHttpSession::writeResponse() {
+    // Срок потока относится только к записи (чтение идёт мимо него): у каждого ответа свой
+    stream_.expires_after(settings_.readTimeout);
+
+    const bool keepAlive = responses_.front().keep_alive();
+    http::async_write(stream_, responses_.front(),
+                      beast::bind_front_handler(&BoostBeastHttpSession::onWrite, shared_from_this(), keepAlive));
+}
+
+void BoostBeastHttpSession::onWrite(bool keepAlive, beast::error_code errc, size_t /*bytesTransferred*/) {
+    if (errc) {
+        if (!isDisconnect(errc)) {
+            LOG_WARNING("http_server", "Ошибка отправки ответа: ", errc.message());
+        }
+        return;
+    }
+
+    if (!keepAlive) {
+        close();
+        return;
+    }
+
+    responses_.pop();
+
+    if (!responses_.empty()) {
+        writeResponse();
+    } else if (readTimedOut_) {
+        // Срок чтения истёк во время записи: ответы отправлены, ожидающее чтение прерывается
+        abort();
+        return;
+    } else if (readingStopped_ && !reading_) {
+        // Клиент закрыл свою сторону, а все ответы ему уже отправлены
+        close();
+        return;
+    }
+
+    // Очередь могла быть заполнена: чтение продолжается, когда в ней освобождается место
+    continueReading();
+}
+
+void BoostBeastHttpSession::continueReading() {
+    if (!reading_ && !readingStopped_ && responses_.size() < settings_.maxPipelinedRequests) {
+        waitForRequest();
+    }
+}
+
+void BoostBeastHttpSession::close() {
+    beast::error_code errc;
+    stream_.socket().shutdown(tcp::socket::shutdown_send, errc);
+}
+
+void BoostBeastHttpSession::abort() {
+    beast::error_code errc;
+    stream_.socket().close(errc);
+}
+} // namespace Infrastructure::Http
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include "../../Core/Ports/IHttpServer.h"
+#include "../../Core/Ports/IMetricsRegistry.h"
+
+namespace Infrastructure::Http {
+/**
+ * @brief Настройки HTTP-соединения сервера
+ */
+struct HttpSessionSettings {
+    std::chrono::seconds readTimeout{10};        // Чтение запроса после его первого байта и запись каждого ответа
+    std::chrono::seconds keepAliveTimeout{30};   // Ожидание первого байта следующего запроса
+    unsigned int maxRequestsPerConnection = 1000;
+    size_t maxPipelinedRequests = 16;            // Ответов в очереди, после которых чтение приостанавливается
+    size_t maxBodySize = 1024 * 1024;
+    size_t compressionMinSize = 1024;            // Меньшие тела не сжимаются; 0 - не сжимать ответы
+    int compressionLevel = 6;                    // Уровень gzip (1-9)
+    std::chrono::milliseconds requestTimeout{0}; // Срок обработки запроса; 0 - без срока
+};
+
+/**
+ * @brief Метрики соединений и запросов HTTP-сервера
+ *
+ * Создаются один раз в реестре и разделяются всеми соединениями.
+ */
+struct HttpServerMetrics {
+    std::shared_ptr<Core::Ports::IMetricsRegistry> registry;  // Держит метрики живыми
+    Core::Ports::ICounter* connections = nullptr;
+    Core::Ports::IGauge* activeConnections = nullptr;
+    Core::Ports::IGauge* requestsInFlight = nullptr;
+    Core::Ports::ILatencyHistogram* requestRead = nullptr;    // От первого байта запроса до его разбора
+    Core::Ports::ILatencyHistogram* requestHandling = nullptr;  // Обработчик и сжатие ответа
+    std::array<Core::Ports::ICounter*, 5> responses{};        // По классам статуса: 1xx ... 5xx
+
+    /**
+     * @brief Регистрирует метрики сервера в реестре
+     */
+    static std::shared_ptr<const HttpServerMetrics> create(
+        std::shared_ptr<Core::Ports::IMetricsRegistry> registry);
+};
+
+/**
+ * @brief Одно HTTP/1.1 соединение сервера
+ *
+ * Асинхронно читает запросы и пишет ответы, пока клиент держит соединение
+ * (keep-alive). Следующий запрос читается, не дожидаясь записи ответа
+ * на предыдущий (pipelining); ответы отправляются строго в порядке запросов.
+ *
+ * Ожидание следующего запроса и чтение начатого запроса ограничены разными
+ * таймаутами: медленный клиент (slowloris) не удерживает соединение дольше
+ * readTimeout, а простаивающее - дольше keepAliveTimeout. Сроки чтения ведёт
+ * отдельный таймер, а срок потока (tcp_stream) отведён записи: каждый ответ
+ * получает свои readTimeout на запись, и истёкшее ожидание запроса не обрывает
+ * начатую запись - соединение закрывается после отправки ответов.
+ *
+ * Текстовые ответы от compressionMinSize байт сжимаются gzip, если клиент
+ * принимает его (Accept-Encoding); ответы с уже заданным Content-Encoding
+ * (например, сжатые заранее) отправляются как есть.
+ *
+ * Обработчик получает срок запроса (requestTimeout) и проверку отключения
+ * клиента, по которым репозитории прерывают ненужные уже запросы к БД.
+ *
+ * Объект живёт, пока на него ссылаются незавершённые асинхронные операции.
+ */
+class BoostBeastHttpSession : public std::enable_shared_from_this<BoostBeastHttpSession> {
+  public:
+    using RequestHandler = Core::Ports::IHttpServer::RequestHandler;
+
+    /**
+     * @brief Конструктор
+     * @param socket Принятое соединение
+     * @param handler Обработчик запросов (общий для всех соединений)
+     * @param settings Таймауты и ограничения соединения
+     * @param metrics Метрики сервера (nullptr - без метрик)
+     */
+    BoostBeastHttpSession(boost::asio::ip::tcp::socket&& socket,
+                          std::shared_ptr<const RequestHandler> handler,
+                          const HttpSessionSettings& settings,
+                          std::shared_ptr<const HttpServerMetrics> metrics = nullptr);
+
+    ~BoostBeastHttpSession();
+
+    BoostBeastHttpSession(const BoostBeastHttpSession&) = delete;
+    BoostBeastHttpSession& operator=(const BoostBeastHttpSession&) = delete;
+
+    /**
+     * @brief Начинает обработку соединения
+     */
+    void run();
+
+  private:
+    // Байт, читаемых за раз при ожидании следующего запроса
+    static constexpr size_t IDLE_READ_SIZE = 4096;
+
+    boost::beast::tcp_stream stream_;  // Запросы читаются из его сокета в обход сроков потока
+    boost::asio::steady_timer readTimer_;  // Срок ожидания или чтения запроса
+    boost::beast::flat_buffer buffer_;
+    std::shared_ptr<const RequestHandler> handler_;
+    HttpSessionSettings settings_;
+    std::string remoteAddress_;  // Адрес клиента определяется один раз на соединение
+    std::shared_ptr<const HttpServerMetrics> metrics_;
+    std::chrono::steady_clock::time_point readStartedAt_;
+
+    std::optional<boost::beast::http::request_parser<boost::beast::http::string_body>> parser_;
+    // Ответ остаётся в очереди до завершения его записи (deque не перемещает элементы при push)
+    std::queue<boost::beast::http::response<boost::beast::http::string_body>> responses_;
+    unsigned int requestCount_ = 0;
+    bool reading_ = false;
+    bool readingStopped_ = false;  // Клиент закрыл соединение, запрос без keep-alive или исчерпан лимит
+    bool readTimedOut_ = false;    // Срок чтения истёк во время записи ответов
+
+    /**
+     * @brief Ждёт первый байт следующего запроса (таймаут keep-alive)
+     */
+    void waitForRequest();
+
+    void onIdleRead(boost::beast::error_code errc, size_t bytesTransferred);
+
+    /**
+     * @brief Читает запрос целиком (таймаут чтения)
+     */
+    void readRequest();
+
+    void onRead(boost::beast::error_code errc, size_t bytesTransferred);
+
+    /**
+     * @brief Запускает таймер чтения (предыдущий срок отменяется)
+     */
+    void armReadTimer(std::chrono::seconds timeout);
+
+    void onReadTimeout(boost::beast::error_code errc);
+
+    /**
+     * @brief Вызывает обработчик и строит ответ на запрос
+     */
+    boost::beast::http::response<boost::beast::http::string_body> handleRequest(
+        boost::beast::http::request<boost::beast::http::string_body>&& request,
+        bool keepAlive);
+
+    /**
+     * @brief Ставит ответ в очередь и начинает запись, если очередь была пуста
+     */
+    void queueResponse(boost::beast::http::response<boost::beast::http::string_body>&& response);
+
+    void writeResponse();
+
+    void onWrite(bool keepAlive, boost::beast::error_code errc, size_t bytesTransferred);
+
+    /**
+     * @brief Продолжает чтение, если оно не остановлено и очередь ответов не переполнена
+     */
+    void continueReading();
+
+    /**
+     * @brief Закрывает соединение на запись (клиент дочитывает отправленное)
+     */
+    void close();
+
+    /**
+     * @brief Закрывает сокет, прерывая незавершённые операции
+     */
+    void abort();
+};
+} // namespace Infrastructure::Http
@@ -0,0 +1,142 @@
+#include "HtmlTemplate.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace Infrastructure::Http {
+namespace {
+// Больше не резервируется: единичная огромная страница не должна раздувать все ответы потока
+constexpr size_t MAX_RESERVED_CAPACITY = 1024 * 1024;
+
+// Запас сверх недавних страниц (1/RESERVE_HEADROOM): страницы одного вида различаются
+// числом результатов и длиной URL. За каждую отрисовку резерв уменьшается на
+// 1/RESERVE_DECAY, если страницы стали меньше
+constexpr size_t RESERVE_HEADROOM = 8;
+constexpr size_t RESERVE_DECAY = 64;
+
+/**
+ * @brief Ёмкость, резервируемая потоком под следующую страницу
+ */
+size_t& threadPageReserve() {
+    thread_local size_t reserve = 0;
+    return reserve;
+}
+} // namespace
+
+void appendHtmlEscaped(std::string& out, std::string_view text) {
+    // Обычный текст дописывается кусками между спецсимволами
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const char* replacement = nullptr;
+        switch (text[i]) {
+            case '&':
+                replacement = "&amp;";
+                break;
+            case '<':
+                replacement = "&lt;";
+                break;
+            case '>':
+                replacement = "&gt;";
+                break;
+            case '"':
+                replacement = "&quot;";
+                break;
+            case '\'':
+                replacement = "&#39;";
+                break;
+            default:
+                continue;
+        }
+
+        out.append(text.data() + start, i - start);
+        out += replacement;
+        start = i + 1;
+    }
+    out.append(text.data() + start, text.size() - start);
+}
+
+HtmlTemplate::HtmlTemplate(std::string_view source, std::vector<std::string> slotNames)
+    : slotNames_(std::move(slotNames)) {
+    size_t position = 0;
+    while (true) {
+        const size_t open = source.find("{{", position);
+        if (open == std::string_view::npos) {
+            parts_.push_back({std::string(source.substr(position)), NO_SLOT});
+            break;
+        }
+
+        const size_t close = source.find("}}", open + 2);
+        if (close == std::string_view::npos) {
+            throw std::runtime_error("Незакрытый слот в HTML-шаблоне");
+        }
+
+        const std::string_view name = source.substr(open + 2, close - open - 2);
+        const auto it = std::find(slotNames_.begin(), slotNames_.end(), name);
+        if (it == slotNames_.end()) {
+            throw std::runtime_error("Неизвестный слот в HTML-шаблоне: " + std::string(name));
+        }
+
+        parts_.push_back({std::string(source.substr(position, open - position)),
+                          static_cast<size_t>(it - slotNames_.begin())});
+        position = close + 2;
+    }
+
+    for (const auto& part : parts_) {
+        staticSize_ += part.text.size();
+    }
+}
+
+void HtmlTemplate::render(std::string& out, std::initializer_list<std::string_view> values) const {
+    if (values.size() != slotNames_.size()) {
+        throw std::invalid_argument("Число значений не совпадает с числом слотов HTML-шаблона");
+    }
+
+    const std::string_view* slotValues = values.begin();
+    for (const auto& part : parts_) {
+        out += part.text;
+        if (part.slot != NO_SLOT) {
+            appendHtmlEscaped(out, slotValues[part.slot]);
+        }
+    }
+}
+
+std::atomic<uint64_t> RenderBuffer::renders_{0};
+std::atomic<uint64_t> RenderBuffer::bufferGrowths_{0};
+std::atomic<uint64_t> RenderBuffer::responseAllocations_{0};
+std::atomic<int64_t> RenderBuffer::renderTimeNs_{0};
+
+RenderBuffer::RenderBuffer() {
+    const size_t reserve = threadPageReserve();
+    if (reserve > 0) {
+        buffer_.reserve(reserve + reserve / RESERVE_HEADROOM);
+        responseAllocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    initialCapacity_ = buffer_.capacity();
+    startTime_ = Clock::now();
+}
+
+std::string RenderBuffer::take() {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - startTime_);
+    renders_.fetch_add(1, std::memory_order_relaxed);
+    renderTimeNs_.fetch_add(elapsed.count(), std::memory_order_relaxed);
+    if (buffer_.capacity() != initialCapacity_) {
+        bufferGrowths_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t& reserve = threadPageReserve();
+    reserve = std::min(MAX_RESERVED_CAPACITY, std::max(buffer_.size(), reserve - reserve / RESERVE_DECAY));
+
+    return std::move(buffer_);
+}
+
+RenderStatistics RenderBuffer::getStatistics() {
+    RenderStatistics statistics;
+    statistics.renders = renders_.load(std::memory_order_relaxed);
+    statistics.bufferGrowths = bufferGrowths_.load(std::memory_order_relaxed);
+    statistics.responseAllocations = responseAllocations_.load(std::memory_order_relaxed);
+    statistics.renderTime = std::chrono::nanoseconds(renderTimeNs_.load(std::memory_order_relaxed));
+    return statistics;
+}
+} // namespace Infrastructure::Http
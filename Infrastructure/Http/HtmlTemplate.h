@@ -0,0 +1,136 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Infrastructure::Http {
+/**
+ * @brief Дописывает текст в HTML, экранируя & < > " '
+ *
+ * Результат безопасен и в тексте элемента, и в значении атрибута в кавычках.
+ */
+void appendHtmlEscaped(std::string& out, std::string_view text);
+
+/**
+ * @brief HTML-шаблон, разобранный на статические фрагменты и слоты
+ *
+ * Текст шаблона разбирается один раз при запуске: отрисовка только дописывает
+ * в буфер готовые фрагменты и экранированные значения слотов, без разбора
+ * и без промежуточных строк.
+ *
+ * Слот записывается как {{имя}}; одно имя может встречаться несколько раз.
+ * Значения передаются в render в порядке имён, заданных в конструкторе.
+ */
+class HtmlTemplate {
+  public:
+    /**
+     * @brief Разбирает шаблон
+     * @param source Текст шаблона
+     * @param slotNames Имена слотов в порядке передачи значений в render
+     * @throws std::runtime_error если в шаблоне есть незакрытый или неизвестный слот
+     */
+    HtmlTemplate(std::string_view source, std::vector<std::string> slotNames = {});
+
+    /**
+     * @brief Дописывает шаблон в буфер
+     * @param out Буфер страницы
+     * @param values Значения слотов (экранируются)
+     * @throws std::invalid_argument если число значений не совпадает с числом слотов
+     */
+    void render(std::string& out, std::initializer_list<std::string_view> values = {}) const;
+
+    /**
+     * @brief Суммарная длина статических фрагментов (нижняя граница размера отрисовки)
+     */
+    size_t getStaticSize() const {
+        return staticSize_;
+    }
+
+  private:
+    struct Part {
+        std::string text;    // Статический фрагмент перед слотом
+        size_t slot = 0;     // Номер значения; NO_SLOT у завершающего фрагмента
+    };
+
+    static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+    std::vector<std::string> slotNames_;
+    std::vector<Part> parts_;
+    size_t staticSize_ = 0;
+};
+
+/**
+ * @brief Счётчики отрисовки страниц
+ */
+struct RenderStatistics {
+    uint64_t renders = 0;
+    uint64_t bufferGrowths = 0;        // Отрисовок, при которых зарезервированной ёмкости не хватило
+    uint64_t responseAllocations = 0;  // Выделений памяти под готовые тела ответов
+    std::chrono::nanoseconds renderTime{0};
+
+    /**
+     * @brief Среднее число выделений памяти на ответ (оценка снизу: рост буфера считается за одно)
+     */
+    double getAllocationsPerRender() const {
+        return renders > 0 ? static_cast<double>(bufferGrowths + responseAllocations) / renders : 0.0;
+    }
+
+    /**
+     * @brief Среднее время отрисовки
+     */
+    std::chrono::nanoseconds getAverageRenderTime() const {
+        return renders > 0 ? renderTime / static_cast<int64_t>(renders) : std::chrono::nanoseconds(0);
+    }
+};
+
+/**
+ * @brief Буфер отрисовки с ёмкостью по недавним страницам потока
+ *
+ * Каждый поток сервера помнит размер недавних страниц и заранее резервирует
+ * под новую страницу столько же: отрисовка идёт в строку нужной ёмкости
+ * (одно выделение памяти), и готовая строка без копирования переносится
+ * в тело ответа. Крупная страница увеличивает резерв сразу, а после неё
+ * резерв постепенно возвращается к обычному размеру.
+ */
+class RenderBuffer {
+  public:
+    RenderBuffer();
+
+    RenderBuffer(const RenderBuffer&) = delete;
+    RenderBuffer& operator=(const RenderBuffer&) = delete;
+
+    /**
+     * @brief Буфер страницы (пустой при получении)
+     */
+    std::string& get() {
+        return buffer_;
+    }
+
+    /**
+     * @brief Отдаёт готовую страницу (без копирования) и учитывает отрисовку в статистике
+     */
+    std::string take();
+
+    /**
+     * @brief Счётчики отрисовки всех потоков
+     */
+    static RenderStatistics getStatistics();
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    std::string buffer_;
+    size_t initialCapacity_ = 0;
+    Clock::time_point startTime_;
+
+    static std::atomic<uint64_t> renders_;
+    static std::atomic<uint64_t> bufferGrowths_;
+    static std::atomic<uint64_t> responseAllocations_;
+    static std::atomic<int64_t> renderTimeNs_;
+};
+} // namespace Infrastructure::Http
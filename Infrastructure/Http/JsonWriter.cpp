@@ -0,0 +1,222 @@
+#include "JsonWriter.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace Infrastructure::Http {
+namespace {
+// U+FFFD в UTF-8: замена некорректных последовательностей
+constexpr std::string_view REPLACEMENT_CHARACTER = "\xEF\xBF\xBD";
+
+/**
+ * @brief Последовательность UTF-8, начинающаяся с байта >= 0x80
+ */
+struct Utf8Sequence {
+    size_t length;  // Длина корректной последовательности или её некорректного начала
+    bool valid;
+};
+
+/**
+ * @brief Проверяет последовательность UTF-8 (RFC 3629: без overlong, суррогатов и кодов больше U+10FFFF)
+ *
+ * Некорректное начало (ведущий байт и подходящие за ним продолжения) заменяется
+ * одним U+FFFD, как это делают браузеры.
+ */
+Utf8Sequence scanUtf8(std::string_view text, size_t position) {
+    const auto lead = static_cast<unsigned char>(text[position]);
+
+    size_t continuationCount = 0;
+    unsigned char low = 0x80;
+    unsigned char high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF) {
+        continuationCount = 1;
+    } else if (lead >= 0xE0 && lead <= 0xEF) {
+        continuationCount = 2;
+        low = lead == 0xE0 ? 0xA0 : low;
+        high = lead == 0xED ? 0x9F : high;
+    } else if (lead >= 0xF0 && lead <= 0xF4) {
+        continuationCount = 3;
+        low = lead == 0xF0 ? 0x90 : low;
+        high = lead == 0xF4 ? 0x8F : high;
+    } else {
+        return {1, false};
+    }
+
+    // Допустимый диапазон ограничен только у первого байта продолжения
+    for (size_t length = 1; length <= continuationCount; ++length) {
+        if (position + length >= text.size()) {
+            return {length, false};
+        }
+
+        const auto c = static_cast<unsigned char>(text[position + length]);
+        if (c < low || c > high) {
+            return {length, false};
+        }
+        low = 0x80;
+        high = 0xBF;
+    }
+    return {continuationCount + 1, true};
+}
+} // namespace
+
+JsonWriter& JsonWriter::beginObject() {
+    return open('{');
+}
+
+JsonWriter& JsonWriter::endObject() {
+    return close('}');
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    return open('[');
+}
+
+JsonWriter& JsonWriter::endArray() {
+    return close(']');
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    separate();
+    writeString(name);
+    out_ += ':';
+    afterKey_ = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    separate();
+    writeString(text);
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    separate();
+    out_ += flag ? "true" : "false";
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number, int precision) {
+    separate();
+    if (!std::isfinite(number)) {
+        out_ += "null";
+        return *this;
+    }
+
+    // Больше 17 значащих цифр double не содержит; так запись всегда помещается в буфер
+    char digits[32];
+    const int length = std::snprintf(digits, sizeof(digits), "%.*g", std::clamp(precision, 1, 17), number);
+    out_.append(digits, static_cast<size_t>(length));
+    return *this;
+}
+
+JsonWriter& JsonWriter::newline() {
+    out_ += '\n';
+    return *this;
+}
+
+void JsonWriter::separate() {
+    if (afterKey_) {
+        afterKey_ = false;
+        return;
+    }
+
+    if (depth_ > 0 && hasElements_[depth_]) {
+        out_ += ',';
+    }
+    hasElements_[depth_] = true;
+}
+
+JsonWriter& JsonWriter::open(char bracket) {
+    separate();
+    if (depth_ + 1 >= MAX_DEPTH) {
+        throw std::runtime_error("Слишком глубокая вложенность JSON");
+    }
+
+    out_ += bracket;
+    hasElements_[++depth_] = false;
+    return *this;
+}
+
+JsonWriter& JsonWriter::close(char bracket) {
+    if (depth_ == 0) {
+        throw std::runtime_error("Закрытие JSON без открытия");
+    }
+
+    out_ += bracket;
+    --depth_;
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeInteger(int64_t number) {
+    separate();
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+    out_.append(digits, end);
+    return *this;
+}
+
+JsonWriter& JsonWriter::writeUnsigned(uint64_t number) {
+    separate();
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), number).ptr;
+    out_.append(digits, end);
+    return *this;
+}
+
+void JsonWriter::writeString(std::string_view text) {
+    static constexpr char HEX[] = "0123456789abcdef";
+
+    out_ += '"';
+
+    // Обычные символы (включая корректный UTF-8) дописываются кусками между экранируемыми
+    size_t start = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        const auto c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x80) {
+            const auto sequence = scanUtf8(text, i);
+            if (!sequence.valid) {
+                out_.append(text.data() + start, i - start);
+                out_ += REPLACEMENT_CHARACTER;
+                start = i + sequence.length;
+            }
+            i += sequence.length - 1;
+            continue;
+        }
+
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+
+        out_.append(text.data() + start, i - start);
+        switch (c) {
+            case '"':
+                out_ += "\\\"";
+                break;
+            case '\\':
+                out_ += "\\\\";
+                break;
+            case '\n':
+                out_ += "\\n";
+                break;
+            case '\r':
+                out_ += "\\r";
+                break;
+            case '\t':
+                out_ += "\\t";
+                break;
+            default: {
+                const char escaped[] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0x0F]};
+                out_.append(escaped, sizeof(escaped));
+                break;
+            }
+        }
+        start = i + 1;
+    }
+    out_.append(text.data() + start, text.size() - start);
+
+    out_ += '"';
+}
+} // namespace Infrastructure::Http
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Infrastructure::Http {
+/**
+ * @brief Потоковая запись JSON прямо в буфер ответа
+ *
+ * Элементы дописываются в строку по мере вызовов, без промежуточного дерева
+ * документа; запятые между элементами расставляются сами. Числа форматируются
+ * в буфер на стеке, так что при достаточной ёмкости строки запись не выделяет
+ * память.
+ *
+ * Строки ожидаются в UTF-8: некорректные последовательности (например, из обрезанного
+ * текста документа) заменяются на U+FFFD, чтобы ответ оставался валидным JSON.
+ *
+ * Для NDJSON после каждого документа верхнего уровня вызывается newline().
+ */
+class JsonWriter {
+  public:
+    /**
+     * @brief Конструктор
+     * @param out Строка, в конец которой пишется JSON
+     */
+    explicit JsonWriter(std::string& out) : out_(out) {}
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    /**
+     * @brief Записывает ключ поля объекта (значение - следующим вызовом)
+     */
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const char* text) {
+        return value(std::string_view(text));
+    }
+    JsonWriter& value(bool flag);
+
+    /**
+     * @brief Записывает число с плавающей точкой (NaN и бесконечность - как null)
+     * @param precision Значащих цифр
+     */
+    JsonWriter& value(double number, int precision = 6);
+
+    template <typename Integer,
+              typename = std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>>>
+    JsonWriter& value(Integer number) {
+        if constexpr (std::is_signed_v<Integer>) {
+            return writeInteger(static_cast<int64_t>(number));
+        } else {
+            return writeUnsigned(static_cast<uint64_t>(number));
+        }
+    }
+
+    /**
+     * @brief Завершает строку NDJSON (после документа верхнего уровня)
+     */
+    JsonWriter& newline();
+
+  private:
+    static constexpr size_t MAX_DEPTH = 32;
+
+    std::string& out_;
+    // Для каждого уровня вложенности: были ли в нём уже элементы (нужна ли запятая)
+    std::array<bool, MAX_DEPTH> hasElements_{};
+    size_t depth_ = 0;
+    bool afterKey_ = false;
+
+    /**
+     * @brief Ставит запятую перед элементом, если он не первый на своём уровне
+     */
+    void separate();
+
+    JsonWriter& open(char bracket);
+    JsonWriter& close(char bracket);
+    JsonWriter& writeInteger(int64_t number);
+    JsonWriter& writeUnsigned(uint64_t number);
+    void writeString(std::string_view text);
+};
+} // namespace Infrastructure::Http
@@ -0,0 +1,69 @@
+#include "QueryString.h"
+
+namespace Infrastructure::Http {
+namespace {
+/**
+ * @brief Значение шестнадцатеричной цифры или -1
+ */
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+} // namespace
+
+std::string urlDecode(std::string_view encoded) {
+    std::string decoded;
+    decoded.reserve(encoded.size());
+
+    for (size_t i = 0; i < encoded.size(); ++i) {
+        if (encoded[i] == '+') {
+            decoded += ' ';
+            continue;
+        }
+
+        if (encoded[i] == '%' && i + 2 < encoded.size()) {
+            const int high = hexDigit(encoded[i + 1]);
+            const int low = hexDigit(encoded[i + 2]);
+            if (high >= 0 && low >= 0) {
+                decoded += static_cast<char>(high * 16 + low);
+                i += 2;
+                continue;
+            }
+        }
+
+        decoded += encoded[i];
+    }
+    return decoded;
+}
+
+std::string_view getQueryString(std::string_view target) {
+    const size_t queryStart = target.find('?');
+    return queryStart == std::string_view::npos ? std::string_view() : target.substr(queryStart + 1);
+}
+
+std::optional<std::string> findQueryParameter(std::string_view parameters, std::string_view name) {
+    while (!parameters.empty()) {
+        const size_t separator = parameters.find('&');
+        const std::string_view parameter = parameters.substr(0, separator);
+
+        const size_t equals = parameter.find('=');
+        if (parameter.substr(0, equals) == name) {
+            return equals == std::string_view::npos ? std::string() : urlDecode(parameter.substr(equals + 1));
+        }
+
+        if (separator == std::string_view::npos) {
+            break;
+        }
+        parameters.remove_prefix(separator + 1);
+    }
+    return std::nullopt;
+}
+} // namespace Infrastructure::Http
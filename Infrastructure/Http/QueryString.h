@@ -0,0 +1,27 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Infrastructure::Http {
+/**
+ * @brief URL-декодирование строки (%XX и '+' как пробел)
+ *
+ * Некорректные последовательности %XX остаются как есть.
+ */
+std::string urlDecode(std::string_view encoded);
+
+/**
+ * @brief Возвращает query string из цели запроса (часть после '?', без '?')
+ */
+std::string_view getQueryString(std::string_view target);
+
+/**
+ * @brief Находит параметр в строке вида a=1&b=2 (query string или тело формы)
+ * @param parameters Параметры, разделённые '&'
+ * @param name Имя параметра
+ * @return Раскодированное значение первого параметра с этим именем или nullopt
+ */
+std::optional<std::string> findQueryParameter(std::string_view parameters, std::string_view name);
+} // namespace Infrastructure::Http
@@ -0,0 +1,207 @@
+#include "ResponseCompressor.h"
+
+#include <cctype>
+#include <stdexcept>
+
+#include <zlib.h>
+
+namespace Infrastructure::Http {
+namespace {
+// 15 бит окна и +16 - формат gzip вместо zlib
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+constexpr int MEMORY_LEVEL = 8;
+
+std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+bool equalsIgnoreCase(std::string_view left, std::string_view right) {
+    if (left.size() != right.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < left.size(); ++i) {
+        const auto leftChar = static_cast<unsigned char>(left[i]);
+        const auto rightChar = static_cast<unsigned char>(right[i]);
+        if (std::tolower(leftChar) != std::tolower(rightChar)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool startsWithIgnoreCase(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && equalsIgnoreCase(text.substr(0, prefix.size()), prefix);
+}
+
+/**
+ * @brief Проверяет, запрещает ли параметр q кодирование (q=0, q=0.0, ...)
+ */
+bool hasZeroQuality(std::string_view parameters) {
+    while (!parameters.empty()) {
+        const size_t separator = parameters.find(';');
+        const std::string_view parameter = trim(parameters.substr(0, separator));
+
+        if (startsWithIgnoreCase(parameter, "q=")) {
+            const std::string_view quality = parameter.substr(2);
+            return !quality.empty() && quality.front() == '0' &&
+                   quality.find_first_not_of("0.") == std::string_view::npos;
+        }
+
+        if (separator == std::string_view::npos) {
+            break;
+        }
+        parameters.remove_prefix(separator + 1);
+    }
+    return false;
+}
+
+/**
+ * @brief Состояние deflate потока, переиспользуемое между ответами
+ */
+class ThreadDeflater {
+  public:
+    ThreadDeflater() = default;
+
+    ~ThreadDeflater() {
+        if (initialized_) {
+            deflateEnd(&stream_);
+        }
+    }
+
+    ThreadDeflater(const ThreadDeflater&) = delete;
+    ThreadDeflater& operator=(const ThreadDeflater&) = delete;
+
+    std::string compress(std::string_view input, int level) {
+        prepare(level);
+
+        std::string output;
+        output.resize(deflateBound(&stream_, static_cast<uLong>(input.size())));
+
+        stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+        stream_.avail_in = static_cast<uInt>(input.size());
+        stream_.next_out = reinterpret_cast<Bytef*>(output.data());
+        stream_.avail_out = static_cast<uInt>(output.size());
+
+        // deflateBound гарантирует, что весь вывод помещается за один вызов
+        if (deflate(&stream_, Z_FINISH) != Z_STREAM_END) {
+            throw std::runtime_error("Ошибка сжатия ответа");
+        }
+
+        output.resize(stream_.total_out);
+        return output;
+    }
+
+  private:
+    z_stream stream_{};
+    bool initialized_ = false;
+    int level_ = 0;
+
+    void prepare(int level) {
+        if (!initialized_) {
+            if (deflateInit2(&stream_, level, Z_DEFLATED, GZIP_WINDOW_BITS, MEMORY_LEVEL, Z_DEFAULT_STRATEGY) !=
+                Z_OK) {
+                throw std::runtime_error("Не удалось инициализировать zlib");
+            }
+            initialized_ = true;
+            level_ = level;
+            return;
+        }
+
+        deflateReset(&stream_);
+        if (level != level_) {
+            deflateParams(&stream_, level, Z_DEFAULT_STRATEGY);
+            level_ = level;
+        }
+    }
+};
+} // namespace
+
+std::atomic<uint64_t> ResponseCompressor::responses_{0};
+std::atomic<uint64_t> ResponseCompressor::bytesOut_{0};
+std::atomic<uint64_t> ResponseCompressor::compressedResponses_{0};
+std::atomic<uint64_t> ResponseCompressor::compressedBytesIn_{0};
+std::atomic<uint64_t> ResponseCompressor::compressedBytesOut_{0};
+std::atomic<int64_t> ResponseCompressor::compressionTimeNs_{0};
+
+ContentEncoding ResponseCompressor::negotiate(std::string_view acceptEncoding) {
+    // Явно указанный gzip важнее "*": "gzip;q=0, *" запрещает gzip
+    bool gzipListed = false;
+    bool gzipAccepted = false;
+    bool wildcardAccepted = false;
+
+    while (!acceptEncoding.empty()) {
+        const size_t comma = acceptEncoding.find(',');
+        const std::string_view item = acceptEncoding.substr(0, comma);
+
+        const size_t semicolon = item.find(';');
+        const std::string_view coding = trim(item.substr(0, semicolon));
+        const std::string_view parameters =
+            semicolon == std::string_view::npos ? std::string_view() : item.substr(semicolon + 1);
+
+        if (equalsIgnoreCase(coding, "gzip") || equalsIgnoreCase(coding, "x-gzip")) {
+            gzipListed = true;
+            gzipAccepted = gzipAccepted || !hasZeroQuality(parameters);
+        } else if (coding == "*") {
+            wildcardAccepted = !hasZeroQuality(parameters);
+        }
+
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        acceptEncoding.remove_prefix(comma + 1);
+    }
+
+    const bool accepted = gzipListed ? gzipAccepted : wildcardAccepted;
+    return accepted ? ContentEncoding::GZIP : ContentEncoding::IDENTITY;
+}
+
+bool ResponseCompressor::isCompressibleType(std::string_view contentType) {
+    return startsWithIgnoreCase(contentType, "text/") || startsWithIgnoreCase(contentType, "application/json") ||
+           startsWithIgnoreCase(contentType, "application/x-ndjson") ||
+           startsWithIgnoreCase(contentType, "application/xml") ||
+           startsWithIgnoreCase(contentType, "application/javascript") ||
+           startsWithIgnoreCase(contentType, "image/svg+xml");
+}
+
+const char* ResponseCompressor::getEncodingName(ContentEncoding encoding) {
+    return encoding == ContentEncoding::GZIP ? "gzip" : "identity";
+}
+
+std::string ResponseCompressor::compress(std::string_view body, ContentEncoding encoding, int level) {
+    if (encoding != ContentEncoding::GZIP) {
+        throw std::invalid_argument("Неподдерживаемое кодирование ответа");
+    }
+
+    thread_local ThreadDeflater deflater;
+    return deflater.compress(body, level);
+}
+
+void ResponseCompressor::recordCompression(size_t bytesIn, size_t bytesOut, std::chrono::nanoseconds time) {
+    compressedResponses_.fetch_add(1, std::memory_order_relaxed);
+    compressedBytesIn_.fetch_add(bytesIn, std::memory_order_relaxed);
+    compressedBytesOut_.fetch_add(bytesOut, std::memory_order_relaxed);
+    compressionTimeNs_.fetch_add(time.count(), std::memory_order_relaxed);
+}
+
+void ResponseCompressor::recordResponse(size_t bytesOut) {
+    responses_.fetch_add(1, std::memory_order_relaxed);
+    bytesOut_.fetch_add(bytesOut, std::memory_order_relaxed);
+}
+
+CompressionStatistics ResponseCompressor::getStatistics() {
+    CompressionStatistics statistics;
+    statistics.responses = responses_.load(std::memory_order_relaxed);
+    statistics.bytesOut = bytesOut_.load(std::memory_order_relaxed);
+    statistics.compressedResponses = compressedResponses_.load(std::memory_order_relaxed);
+    statistics.compressedBytesIn = compressedBytesIn_.load(std::memory_order_relaxed);
+    statistics.compressedBytesOut = compressedBytesOut_.load(std::memory_order_relaxed);
+    statistics.compressionTime = std::chrono::nanoseconds(compressionTimeNs_.load(std::memory_order_relaxed));
+    return statistics;
+}
+} // namespace Infrastructure::Http
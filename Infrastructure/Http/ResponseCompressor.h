@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Infrastructure::Http {
+/**
+ * @brief Кодирование тела ответа
+ */
+enum class ContentEncoding { IDENTITY, GZIP };
+
+/**
+ * @brief Счётчики отправленных тел ответов и их сжатия
+ */
+struct CompressionStatistics {
+    uint64_t responses = 0;
+    uint64_t bytesOut = 0;                 // Тела всех ответов в том виде, в каком отправлены
+    uint64_t compressedResponses = 0;      // Ответов, сжатых при отправке
+    uint64_t compressedBytesIn = 0;        // Их тела до сжатия
+    uint64_t compressedBytesOut = 0;       // И после
+    std::chrono::nanoseconds compressionTime{0};
+
+    /**
+     * @brief Доля размера после сжатия от размера до него (для сжатых при отправке)
+     */
+    double getCompressionRatio() const {
+        return compressedBytesIn > 0 ? static_cast<double>(compressedBytesOut) / compressedBytesIn : 1.0;
+    }
+};
+
+/**
+ * @brief Сжатие тел HTTP-ответов
+ *
+ * У каждого потока сервера своё состояние zlib: оно создаётся при первом
+ * сжатии в потоке и затем только сбрасывается (deflateReset), без повторного
+ * выделения окна и хеш-таблиц на каждый ответ.
+ */
+class ResponseCompressor {
+  public:
+    /**
+     * @brief Выбирает кодирование по заголовку Accept-Encoding
+     * @return GZIP, если клиент принимает gzip (или *) с q > 0, иначе IDENTITY
+     */
+    static ContentEncoding negotiate(std::string_view acceptEncoding);
+
+    /**
+     * @brief Проверяет, имеет ли смысл сжимать тело такого типа (текст, JSON, XML, JavaScript)
+     */
+    static bool isCompressibleType(std::string_view contentType);
+
+    /**
+     * @brief Значение Content-Encoding для кодирования
+     */
+    static const char* getEncodingName(ContentEncoding encoding);
+
+    /**
+     * @brief Сжимает тело
+     * @param body Тело ответа
+     * @param encoding Кодирование (не IDENTITY)
+     * @param level Уровень сжатия zlib (1-9)
+     * @throws std::runtime_error при ошибке zlib
+     */
+    static std::string compress(std::string_view body, ContentEncoding encoding, int level);
+
+    /**
+     * @brief Учитывает сжатие тела при отправке
+     */
+    static void recordCompression(size_t bytesIn, size_t bytesOut, std::chrono::nanoseconds time);
+
+    /**
+     * @brief Учитывает отправленное тело ответа
+     */
+    static void recordResponse(size_t bytesOut);
+
+    /**
+     * @brief Счётчики всех потоков
+     */
+    static CompressionStatistics getStatistics();
+
+  private:
+    static std::atomic<uint64_t> responses_;
+    static std::atomic<uint64_t> bytesOut_;
+    static std::atomic<uint64_t> compressedResponses_;
+    static std::atomic<uint64_t> compressedBytesIn_;
+    static std::atomic<uint64_t> compressedBytesOut_;
+    static std::atomic<int64_t> compressionTimeNs_;
+};
+} // namespace Infrastructure::Http
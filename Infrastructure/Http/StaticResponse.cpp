@@ -0,0 +1,107 @@
+#include "StaticResponse.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+namespace Infrastructure::Http {
+namespace {
+/**
+ * @brief Сильный ETag по 64-битному хешу FNV-1a тела
+ */
+std::string computeEtag(std::string_view body) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (const char c : body) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+
+    char etag[24];
+    std::snprintf(etag, sizeof(etag), "\"%016llx\"", static_cast<unsigned long long>(hash));
+    return etag;
+}
+
+std::string_view trim(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+} // namespace
+
+StaticResponse::StaticResponse(Core::Ports::HttpResponse response) {
+    // Один раз при запуске можно сжимать так сильно, как умеет zlib
+    constexpr int STATIC_COMPRESSION_LEVEL = 9;
+
+    const std::string* contentType = response.findHeader("Content-Type");
+    const bool compressible = contentType != nullptr && ResponseCompressor::isCompressibleType(*contentType);
+
+    const std::string etag = computeEtag(response.body);
+    response.setHeader("ETag", etag);
+    response.setHeader("Cache-Control", "no-cache");
+
+    if (!compressible) {
+        variants_.push_back({ContentEncoding::IDENTITY, std::move(response), etag});
+        return;
+    }
+
+    response.setHeader("Vary", "Accept-Encoding");
+
+    Variant gzip{ContentEncoding::GZIP, response, etag.substr(0, etag.size() - 1) + "-gzip\""};
+    gzip.response.body =
+        ResponseCompressor::compress(response.body, ContentEncoding::GZIP, STATIC_COMPRESSION_LEVEL);
+    gzip.response.setHeader("Content-Encoding", ResponseCompressor::getEncodingName(ContentEncoding::GZIP));
+    gzip.response.setHeader("ETag", gzip.etag);
+
+    variants_.push_back({ContentEncoding::IDENTITY, std::move(response), etag});
+    variants_.push_back(std::move(gzip));
+}
+
+Core::Ports::HttpResponse StaticResponse::respond(const Core::Ports::HttpRequestView& request) const {
+    const ContentEncoding encoding = ResponseCompressor::negotiate(request.getHeader("Accept-Encoding"));
+
+    const Variant* selected = &variants_.front();
+    for (const auto& variant : variants_) {
+        if (variant.encoding == encoding) {
+            selected = &variant;
+        }
+    }
+
+    if (!matchesEtag(request.getHeader("If-None-Match"), selected->etag)) {
+        return selected->response;
+    }
+
+    Core::Ports::HttpResponse notModified;
+    notModified.statusCode = 304;
+    notModified.setHeader("ETag", selected->etag);
+    notModified.setHeader("Cache-Control", "no-cache");
+    if (variants_.size() > 1) {
+        notModified.setHeader("Vary", "Accept-Encoding");
+    }
+    return notModified;
+}
+
+bool StaticResponse::matchesEtag(std::string_view ifNoneMatch, std::string_view etag) {
+    while (!ifNoneMatch.empty()) {
+        const size_t comma = ifNoneMatch.find(',');
+        std::string_view candidate = trim(ifNoneMatch.substr(0, comma));
+
+        // Слабое сравнение (RFC 9110): W/"x" совпадает с "x"
+        if (candidate.substr(0, 2) == "W/") {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == "*" || candidate == etag) {
+            return true;
+        }
+
+        if (comma == std::string_view::npos) {
+            break;
+        }
+        ifNoneMatch.remove_prefix(comma + 1);
+    }
+    return false;
+}
+} // namespace Infrastructure::Http
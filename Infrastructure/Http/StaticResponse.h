@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../../Core/Ports/IHttpServer.h"
+#include "ResponseCompressor.h"
+
+namespace Infrastructure::Http {
+/**
+ * @brief Неизменяемый ответ, собранный при запуске, с проверкой ETag
+ *
+ * Тело сжимается при создании всеми поддерживаемыми кодированиями (с наибольшим
+ * уровнем: это делается один раз), и ответ выбирается по Accept-Encoding
+ * без сжатия на каждый запрос.
+ *
+ * ETag вычисляется по телу; у сжатого варианта он свой, как того требует
+ * сильный ETag. Клиент, приславший совпадающий If-None-Match, получает 304
+ * без тела; остальные - копию готового ответа. Ответ помечается
+ * Cache-Control: no-cache, чтобы браузер перепроверял его при каждом
+ * обращении и новая версия сервера сразу была видна.
+ */
+class StaticResponse {
+  public:
+    /**
+     * @brief Конструктор
+     * @param response Готовый ответ (к его заголовкам добавляются ETag, Cache-Control и Vary)
+     */
+    explicit StaticResponse(Core::Ports::HttpResponse response);
+
+    /**
+     * @brief Возвращает ответ на запрос: 304, если у клиента та же версия, иначе копию ответа
+     */
+    Core::Ports::HttpResponse respond(const Core::Ports::HttpRequestView& request) const;
+
+  private:
+    struct Variant {
+        ContentEncoding encoding = ContentEncoding::IDENTITY;
+        Core::Ports::HttpResponse response;
+        std::string etag;
+    };
+
+    // Первый вариант - без сжатия
+    std::vector<Variant> variants_;
+
+    /**
+     * @brief Проверяет, есть ли ETag в значении If-None-Match (список через запятую или *)
+     */
+    static bool matchesEtag(std::string_view ifNoneMatch, std::string_view etag);
+};
+} // namespace Infrastructure::Http
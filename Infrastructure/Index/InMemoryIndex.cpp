@@ -0,0 +1,129 @@
+#include "InMemoryIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace Infrastructure::Index {
+InMemoryIndex::Builder::Builder() : index_(new InMemoryIndex()) {
+    index_->urlOffsets_.push_back(0);
+}
+
+void InMemoryIndex::Builder::addDocument(DocumentIdType documentId, const std::string& url) {
+    if (!index_->documentIds_.empty() && documentId <= index_->documentIds_.back()) {
+        throw std::runtime_error("Документы индекса должны добавляться по возрастанию ID");
+    }
+
+    if (index_->documentIds_.size() >= std::numeric_limits<DocumentOrdinal>::max()) {
+        throw std::runtime_error("Слишком много документов для индекса в памяти");
+    }
+
+    index_->documentIds_.push_back(documentId);
+    index_->urlData_ += url;
+    index_->urlOffsets_.push_back(index_->urlData_.size());
+}
+
+void InMemoryIndex::Builder::beginTerm(WordIdType wordId, const std::string& text) {
+    finishTerm();
+
+    TermEntry entry;
+    entry.wordId = wordId;
+    entry.offset = index_->postingDocuments_.size();
+
+    currentTerm_ = text;
+    currentTermOffset_ = entry.offset;
+    hasCurrentTerm_ = true;
+    index_->terms_[currentTerm_] = entry;
+}
+
+bool InMemoryIndex::Builder::addPosting(DocumentIdType documentId, FrequencyType frequency) {
+    if (!hasCurrentTerm_) {
+        throw std::runtime_error("Постинг добавлен до начала терма");
+    }
+
+    const auto& ids = index_->documentIds_;
+    if (!std::binary_search(ids.begin(), ids.end(), documentId)) {
+        return false;
+    }
+
+    if (index_->postingDocuments_.size() > currentTermOffset_ && index_->postingDocuments_.back() >= documentId) {
+        throw std::runtime_error("Постинги терма должны добавляться по возрастанию ID документа");
+    }
+
+    index_->postingDocuments_.push_back(documentId);
+    index_->postingFrequencies_.push_back(frequency);
+    return true;
+}
+
+std::shared_ptr<const InMemoryIndex> InMemoryIndex::Builder::build() {
+    finishTerm();
+
+    index_->postingDocuments_.shrink_to_fit();
+    index_->postingFrequencies_.shrink_to_fit();
+    index_->documentIds_.shrink_to_fit();
+    index_->urlOffsets_.shrink_to_fit();
+    index_->urlData_.shrink_to_fit();
+
+    std::shared_ptr<const InMemoryIndex> result(index_.release());
+    index_.reset(new InMemoryIndex());
+    index_->urlOffsets_.push_back(0);
+
+    return result;
+}
+
+void InMemoryIndex::Builder::finishTerm() {
+    if (!hasCurrentTerm_) {
+        return;
+    }
+
+    auto it = index_->terms_.find(currentTerm_);
+    it->second.count = index_->postingDocuments_.size() - it->second.offset;
+
+    const auto frequencies = index_->postingFrequencies_.begin() + static_cast<ptrdiff_t>(it->second.offset);
+    if (it->second.count > 0) {
+        it->second.maxFrequency = *std::max_element(frequencies, index_->postingFrequencies_.end());
+    }
+
+    // Терм без единого постинга (все документы неизвестны) искать бессмысленно
+    if (it->second.count == 0) {
+        index_->terms_.erase(it);
+    }
+
+    hasCurrentTerm_ = false;
+}
+
+std::optional<std::pair<WordIdType, PostingRange>> InMemoryIndex::findTerm(const std::string& text) const {
+    const auto it = terms_.find(text);
+    if (it == terms_.end()) {
+        return std::nullopt;
+    }
+
+    return std::make_pair(it->second.wordId, getPostings(it->second));
+}
+
+DocumentTable InMemoryIndex::getDocumentTable() const {
+    DocumentTable table;
+    table.ids = documentIds_.data();
+    table.urlOffsets = urlOffsets_.data();
+    table.urlData = urlData_.data();
+    table.count = documentIds_.size();
+    return table;
+}
+
+void InMemoryIndex::forEachTerm(
+    const std::function<void(const std::string& text, WordIdType wordId, const PostingRange& postings)>& visitor)
+    const {
+    for (const auto& [text, entry] : terms_) {
+        visitor(text, entry.wordId, getPostings(entry));
+    }
+}
+
+PostingRange InMemoryIndex::getPostings(const TermEntry& entry) const {
+    PostingRange range;
+    range.documents = postingDocuments_.data() + entry.offset;
+    range.frequencies = postingFrequencies_.data() + entry.offset;
+    range.count = entry.count;
+    range.maxFrequency = entry.maxFrequency;
+    return range;
+}
+} // namespace Infrastructure::Index
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SearchIndex.h"
+
+namespace Infrastructure::Index {
+/**
+ * @brief Неизменяемый инвертированный индекс в оперативной памяти
+ *
+ * Состоит из словаря термов, плоских массивов постингов (отсортированные
+ * ID документов и частоты) и таблицы документов (ID и URL) в порядке
+ * возрастания ID. Постинги хранят сами ID, чтобы отдавать их поиску
+ * без преобразования и копирования.
+ */
+class InMemoryIndex : public SearchIndex {
+  public:
+    /**
+     * @brief Пошаговое построение индекса
+     *
+     * Документы добавляются в порядке возрастания ID, затем термы,
+     * и для каждого терма - его постинги в порядке возрастания ID документа.
+     */
+    class Builder {
+      public:
+        Builder();
+
+        /**
+         * @brief Добавляет документ
+         * @throws std::runtime_error если ID не возрастают
+         */
+        void addDocument(DocumentIdType documentId, const std::string& url);
+
+        /**
+         * @brief Начинает постинги нового терма
+         */
+        void beginTerm(WordIdType wordId, const std::string& text);
+
+        /**
+         * @brief Добавляет постинг текущего терма
+         * @return false, если документ неизвестен (постинг пропущен)
+         * @throws std::runtime_error если ID документов не возрастают
+         */
+        bool addPosting(DocumentIdType documentId, FrequencyType frequency);
+
+        /**
+         * @brief Завершает построение
+         */
+        std::shared_ptr<const InMemoryIndex> build();
+
+      private:
+        std::unique_ptr<InMemoryIndex> index_;
+        std::string currentTerm_;
+        size_t currentTermOffset_ = 0;
+        bool hasCurrentTerm_ = false;
+
+        void finishTerm();
+    };
+
+    std::optional<std::pair<WordIdType, PostingRange>> findTerm(const std::string& text) const override;
+    DocumentTable getDocumentTable() const override;
+    size_t getTermCount() const override { return terms_.size(); }
+    size_t getPostingCount() const override { return postingDocuments_.size(); }
+
+    /**
+     * @brief Перебирает все термы индекса (в произвольном порядке)
+     */
+    void forEachTerm(
+        const std::function<void(const std::string& text, WordIdType wordId, const PostingRange& postings)>&
+            visitor) const;
+
+  private:
+    /**
+     * @brief Запись словаря: ID слова и диапазон его постингов
+     */
+    struct TermEntry {
+        WordIdType wordId = 0;
+        size_t offset = 0;
+        size_t count = 0;
+        FrequencyType maxFrequency = 0;
+    };
+
+    InMemoryIndex() = default;
+
+    PostingRange getPostings(const TermEntry& entry) const;
+
+    // Словарь термов
+    std::unordered_map<std::string, TermEntry> terms_;
+
+    // Постинги всех термов подряд: ID документа и частота
+    std::vector<DocumentIdType> postingDocuments_;
+    std::vector<FrequencyType> postingFrequencies_;
+
+    // Таблица документов
+    std::vector<DocumentIdType> documentIds_;
+    std::vector<uint64_t> urlOffsets_;
+    std::string urlData_;
+};
+} // namespace Infrastructure::Index
@@ -0,0 +1,66 @@
+#include "InMemoryWordRepository.h"
+
+#include <stdexcept>
+#include <utility>
+
+namespace Infrastructure::Index {
+InMemoryWordRepository::InMemoryWordRepository(std::shared_ptr<const SearchIndex> index)
+    : index_(std::move(index)) {
+    if (!index_) {
+        throw std::invalid_argument("SearchIndex не может быть nullptr");
+    }
+}
+
+Core::Domain::Model::Word::IdType InMemoryWordRepository::save(Core::Domain::Model::Word& /*word*/) {
+    throw std::runtime_error("Индекс в памяти доступен только для чтения");
+}
+
+std::optional<Core::Domain::Model::Word> InMemoryWordRepository::findByText(const std::string& text) {
+    return index_->findWord(text);
+}
+
+void InMemoryWordRepository::saveFrequency(const Core::Domain::Model::WordFrequency& /*frequency*/) {
+    throw std::runtime_error("Индекс в памяти доступен только для чтения");
+}
+
+void InMemoryWordRepository::saveWordFrequencies(Core::Domain::Model::Document::IdType /*documentId*/,
+                                                 const std::map<std::string, int>& /*wordFrequencies*/) {
+    throw std::runtime_error("Индекс в памяти доступен только для чтения");
+}
+
+std::vector<Core::Domain::Model::PostingList> InMemoryWordRepository::findPostings(
+    const std::vector<std::string>& words,
+    const Core::Ports::RequestDeadline& /*deadline*/) {
+    std::vector<Core::Domain::Model::PostingList> postings;
+    postings.reserve(words.size());
+
+    for (const auto& word : words) {
+        const auto term = index_->findTerm(word);
+        if (!term.has_value()) {
+            postings.emplace_back();
+            continue;
+        }
+
+        const PostingRange& range = term->second;
+        postings.emplace_back(index_, range.documents, range.frequencies, range.count, range.maxFrequency);
+    }
+
+    return postings;
+}
+
+std::unordered_map<Core::Domain::Model::Document::IdType, std::string> InMemoryWordRepository::findDocumentUrls(
+    const std::vector<Core::Domain::Model::Document::IdType>& documentIds,
+    const Core::Ports::RequestDeadline& /*deadline*/) {
+    std::unordered_map<Core::Domain::Model::Document::IdType, std::string> urls;
+    urls.reserve(documentIds.size());
+
+    for (const auto documentId : documentIds) {
+        auto url = index_->findDocumentUrl(documentId);
+        if (url.has_value()) {
+            urls.emplace(documentId, std::move(*url));
+        }
+    }
+
+    return urls;
+}
+} // namespace Infrastructure::Index
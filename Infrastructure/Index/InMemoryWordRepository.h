@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+
+#include "../../Core/Ports/IWordRepository.h"
+#include "SearchIndex.h"
+
+namespace Infrastructure::Index {
+/**
+ * @brief Реализация репозитория слов поверх индекса в памяти
+ *
+ * Отвечает на поисковые запросы полностью внутри процесса, без обращения к БД.
+ * Индекс может быть построен в памяти (InMemoryIndex) или отображён из файла (MappedIndex).
+ * Индекс неизменяем, поэтому репозиторий доступен только для чтения:
+ * операции записи бросают исключение.
+ */
+class InMemoryWordRepository : public Core::Ports::IWordRepository {
+  public:
+    /**
+     * @brief Конструктор
+     * @param index Загруженный индекс
+     */
+    explicit InMemoryWordRepository(std::shared_ptr<const SearchIndex> index);
+
+    ~InMemoryWordRepository() override = default;
+
+    /**
+     * @brief Не поддерживается (индекс только для чтения)
+     * @throws std::runtime_error
+     */
+    Core::Domain::Model::Word::IdType save(Core::Domain::Model::Word& word) override;
+
+    /**
+     * @brief Находит слово в словаре индекса
+     * @param text Текст слова
+     * @return Слово, если оно встречается хотя бы в одном документе
+     */
+    std::optional<Core::Domain::Model::Word> findByText(const std::string& text) override;
+
+    /**
+     * @brief Не поддерживается (индекс только для чтения)
+     * @throws std::runtime_error
+     */
+    void saveFrequency(const Core::Domain::Model::WordFrequency& frequency) override;
+
+    /**
+     * @brief Не поддерживается (индекс только для чтения)
+     * @throws std::runtime_error
+     */
+    void saveWordFrequencies(Core::Domain::Model::Document::IdType documentId,
+                             const std::map<std::string, int>& wordFrequencies) override;
+
+    /**
+     * @brief Находит постинги слов
+     *
+     * Списки ссылаются на память индекса без копирования и продлевают его жизнь.
+     * Поиск в памяти не блокируется, поэтому срок запроса не проверяется.
+     */
+    std::vector<Core::Domain::Model::PostingList> findPostings(
+        const std::vector<std::string>& words, const Core::Ports::RequestDeadline& deadline) override;
+
+    /**
+     * @brief Находит URL документов в таблице документов индекса
+     */
+    std::unordered_map<Core::Domain::Model::Document::IdType, std::string> findDocumentUrls(
+        const std::vector<Core::Domain::Model::Document::IdType>& documentIds,
+        const Core::Ports::RequestDeadline& deadline) override;
+
+  private:
+    std::shared_ptr<const SearchIndex> index_;
+};
+} // namespace Infrastructure::Index
@@ -0,0 +1,55 @@
+#include "IndexSegmentFormat.h"
+
+#include <algorithm>
+
+#include "../../Core/Domain/Service/ContentHashService.h"
+
+namespace Infrastructure::Index::IndexSegmentFormat {
+using Core::Domain::Service::ContentHashService;
+
+SectionChecksum::SectionChecksum() {
+    block_.reserve(CHECKSUM_BLOCK_SIZE);
+}
+
+void SectionChecksum::update(const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+
+    while (size > 0) {
+        const size_t chunk = std::min(size, CHECKSUM_BLOCK_SIZE - block_.size());
+        block_.insert(block_.end(), bytes, bytes + chunk);
+        bytes += chunk;
+        size -= chunk;
+
+        if (block_.size() == CHECKSUM_BLOCK_SIZE) {
+            hash_ = ContentHashService::hash(block_.data(), block_.size(), hash_);
+            block_.clear();
+        }
+    }
+}
+
+uint64_t SectionChecksum::finish() {
+    if (!block_.empty()) {
+        hash_ = ContentHashService::hash(block_.data(), block_.size(), hash_);
+        block_.clear();
+    }
+
+    const uint64_t result = hash_;
+    hash_ = 0;
+    return result;
+}
+
+uint64_t computeChecksum(const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint64_t hash = 0;
+
+    for (size_t offset = 0; offset < size; offset += CHECKSUM_BLOCK_SIZE) {
+        hash = ContentHashService::hash(bytes + offset, std::min(CHECKSUM_BLOCK_SIZE, size - offset), hash);
+    }
+
+    return hash;
+}
+
+uint64_t computeHeaderChecksum(const Header& header) {
+    return ContentHashService::hash(&header, offsetof(Header, headerChecksum));
+}
+} // namespace Infrastructure::Index::IndexSegmentFormat
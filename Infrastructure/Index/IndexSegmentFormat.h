@@ -0,0 +1,129 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SearchIndex.h"
+
+namespace Infrastructure::Index {
+/**
+ * @brief Формат файла неизменяемого сегмента индекса
+ *
+ * Файл состоит из заголовка и секций, выровненных на 8 байт. Секции - это
+ * массивы фиксированного размера в порядке байт little-endian, которые
+ * MappedIndex использует напрямую из отображённой памяти, без разбора.
+ *
+ * Каждая секция защищена контрольной суммой: XXH64 по блокам CHECKSUM_BLOCK_SIZE,
+ * где хеш предыдущего блока - seed следующего. Заголовок защищён своей суммой.
+ */
+namespace IndexSegmentFormat {
+constexpr char MAGIC[8] = {'S', 'S', 'I', 'N', 'D', 'E', 'X', '\0'};
+constexpr uint32_t VERSION = 3;
+constexpr uint64_t SECTION_ALIGNMENT = 8;
+constexpr size_t CHECKSUM_BLOCK_SIZE = 1024 * 1024;
+
+/**
+ * @brief Секции файла (порядок совпадает с порядком в файле)
+ */
+enum Section : uint32_t {
+    DOCUMENT_IDS = 0,       // int64[documentCount], по возрастанию
+    URL_OFFSETS,            // uint64[documentCount + 1]
+    URL_DATA,               // char[]
+    TERM_TEXT_OFFSETS,      // uint64[termCount + 1]
+    TERM_TEXT_DATA,         // char[], термы отсортированы побайтово
+    TERM_ENTRIES,           // TermEntry[termCount], в порядке термов
+    POSTING_DOCUMENTS,      // int64[postingCount], ID документов
+    POSTING_FREQUENCIES,    // int32[postingCount]
+    SECTION_COUNT
+};
+
+/**
+ * @brief Положение и контрольная сумма секции
+ */
+struct SectionDescriptor {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t checksum;
+};
+
+/**
+ * @brief Запись словаря: ID слова, диапазон постингов в секциях POSTING_*
+ * и максимальная частота (верхняя оценка вклада слова в релевантность)
+ */
+struct TermEntry {
+    int64_t wordId;
+    uint64_t offset;
+    uint32_t count;
+    int32_t maxFrequency;
+};
+
+/**
+ * @brief Заголовок файла
+ */
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t sectionCount;
+    uint64_t fileSize;
+    uint64_t documentCount;
+    uint64_t termCount;
+    uint64_t postingCount;
+    SectionDescriptor sections[SECTION_COUNT];
+    uint64_t headerChecksum;  // XXH64 всех предыдущих байт заголовка
+};
+
+static_assert(sizeof(SectionDescriptor) == 24, "Неожиданный размер SectionDescriptor");
+static_assert(sizeof(TermEntry) == 24, "Неожиданный размер TermEntry");
+static_assert(sizeof(Header) == 48 + 24 * SECTION_COUNT + 8, "Неожиданный размер заголовка индекса");
+static_assert(sizeof(Header) % SECTION_ALIGNMENT == 0, "Заголовок индекса должен быть выровнен");
+
+// Секции отображаются в память как массивы этих типов
+static_assert(sizeof(DocumentIdType) == 8 && sizeof(WordIdType) == 8, "ID должны быть 64-битными");
+static_assert(sizeof(FrequencyType) == 4, "Частоты должны быть 32-битными");
+
+/**
+ * @brief Накопитель контрольной суммы секции
+ *
+ * Принимает данные порциями произвольного размера; результат не зависит
+ * от того, как данные разбиты на порции.
+ */
+class SectionChecksum {
+  public:
+    SectionChecksum();
+
+    void update(const void* data, size_t size);
+
+    uint64_t finish();
+
+  private:
+    std::vector<unsigned char> block_;
+    uint64_t hash_ = 0;
+};
+
+/**
+ * @brief Контрольная сумма секции, целиком лежащей в памяти
+ */
+uint64_t computeChecksum(const void* data, size_t size);
+
+/**
+ * @brief Контрольная сумма заголовка (без поля headerChecksum)
+ */
+uint64_t computeHeaderChecksum(const Header& header);
+
+/**
+ * @brief Проверяет, что платформа little-endian (секции пишутся и читаются как есть)
+ */
+inline bool isNativeByteOrder() {
+    const uint16_t probe = 1;
+    return *reinterpret_cast<const unsigned char*>(&probe) == 1;
+}
+
+/**
+ * @brief Округляет смещение вверх до выравнивания секций
+ */
+constexpr uint64_t alignOffset(uint64_t offset) {
+    return (offset + SECTION_ALIGNMENT - 1) / SECTION_ALIGNMENT * SECTION_ALIGNMENT;
+}
+} // namespace IndexSegmentFormat
+} // namespace Infrastructure::Index
@@ -0,0 +1,193 @@
+#include "IndexSegmentWriter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <vector>
+
+#include "../Frontier/FrontierRecordFormat.h"
+#include "IndexSegmentFormat.h"
+
+namespace Infrastructure::Index {
+namespace {
+using Frontier::FrontierRecordFormat;
+namespace Format = IndexSegmentFormat;
+
+/**
+ * @brief Последовательная запись секций с подсчётом их контрольных сумм
+ */
+class SectionOutput {
+  public:
+    SectionOutput(std::FILE* file, Format::Header& header) : file_(file), header_(header) {
+        buffer_.reserve(FrontierRecordFormat::FILE_BUFFER_SIZE);
+    }
+
+    void begin(Format::Section section) {
+        // Выравнивание нулями; в секцию и её контрольную сумму не входит
+        const uint64_t aligned = Format::alignOffset(position_);
+        buffer_.append(static_cast<size_t>(aligned - position_), '\0');
+        position_ = aligned;
+
+        section_ = section;
+        header_.sections[section].offset = position_;
+    }
+
+    void write(const void* data, size_t size) {
+        checksum_.update(data, size);
+        buffer_.append(static_cast<const char*>(data), size);
+        position_ += size;
+
+        if (buffer_.size() >= FrontierRecordFormat::FILE_BUFFER_SIZE) {
+            FrontierRecordFormat::writeAll(file_, buffer_);
+            buffer_.clear();
+        }
+    }
+
+    template <typename T>
+    void writeValue(const T& value) {
+        write(&value, sizeof(value));
+    }
+
+    void end() {
+        auto& descriptor = header_.sections[section_];
+        descriptor.size = position_ - descriptor.offset;
+        descriptor.checksum = checksum_.finish();
+    }
+
+    uint64_t finish() {
+        FrontierRecordFormat::writeAll(file_, buffer_);
+        buffer_.clear();
+        return position_;
+    }
+
+  private:
+    std::FILE* file_;
+    Format::Header& header_;
+    std::string buffer_;
+    Format::SectionChecksum checksum_;
+    Format::Section section_ = Format::DOCUMENT_IDS;
+    uint64_t position_ = sizeof(Format::Header);
+};
+
+/**
+ * @brief Терм словаря со ссылкой на постинги индекса в памяти
+ */
+struct TermRecord {
+    const std::string* text;
+    WordIdType wordId;
+    PostingRange postings;
+};
+} // namespace
+
+void IndexSegmentWriter::write(const InMemoryIndex& index, const std::string& path) {
+    if (!Format::isNativeByteOrder()) {
+        throw std::runtime_error("Запись сегмента индекса поддерживается только на little-endian платформах");
+    }
+
+    // Словарь в файле отсортирован побайтово: поиск терма - бинарный поиск
+    std::vector<TermRecord> terms;
+    terms.reserve(index.getTermCount());
+    index.forEachTerm([&terms](const std::string& text, WordIdType wordId, const PostingRange& postings) {
+        terms.push_back({&text, wordId, postings});
+    });
+    std::sort(terms.begin(), terms.end(),
+              [](const TermRecord& lhs, const TermRecord& rhs) { return *lhs.text < *rhs.text; });
+
+    const DocumentTable documents = index.getDocumentTable();
+
+    Format::Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Format::MAGIC, sizeof(header.magic));
+    header.version = Format::VERSION;
+    header.sectionCount = Format::SECTION_COUNT;
+    header.documentCount = documents.count;
+    header.termCount = terms.size();
+    header.postingCount = index.getPostingCount();
+
+    const std::filesystem::path targetPath(path);
+    const std::filesystem::path tempPath = targetPath.string() + ".tmp";
+
+    try {
+        auto file = FrontierRecordFormat::openFile(tempPath, "wb");
+        if (!file) {
+            throw std::runtime_error("Не удалось создать файл: " + tempPath.string());
+        }
+
+        // Место под заголовок; он пишется последним, когда известны секции
+        FrontierRecordFormat::writeAll(file.get(), std::string(sizeof(header), '\0'));
+
+        SectionOutput output(file.get(), header);
+
+        output.begin(Format::DOCUMENT_IDS);
+        output.write(documents.ids, documents.count * sizeof(DocumentIdType));
+        output.end();
+
+        output.begin(Format::URL_OFFSETS);
+        output.write(documents.urlOffsets, (documents.count + 1) * sizeof(uint64_t));
+        output.end();
+
+        output.begin(Format::URL_DATA);
+        output.write(documents.urlData, documents.urlOffsets[documents.count]);
+        output.end();
+
+        output.begin(Format::TERM_TEXT_OFFSETS);
+        uint64_t textOffset = 0;
+        output.writeValue(textOffset);
+        for (const auto& term : terms) {
+            textOffset += term.text->size();
+            output.writeValue(textOffset);
+        }
+        output.end();
+
+        output.begin(Format::TERM_TEXT_DATA);
+        for (const auto& term : terms) {
+            output.write(term.text->data(), term.text->size());
+        }
+        output.end();
+
+        // Постинги лежат в порядке словаря
+        output.begin(Format::TERM_ENTRIES);
+        uint64_t postingOffset = 0;
+        for (const auto& term : terms) {
+            Format::TermEntry entry;
+            entry.wordId = term.wordId;
+            entry.offset = postingOffset;
+            entry.count = static_cast<uint32_t>(term.postings.count);
+            entry.maxFrequency = term.postings.maxFrequency;
+            output.writeValue(entry);
+            postingOffset += term.postings.count;
+        }
+        output.end();
+
+        output.begin(Format::POSTING_DOCUMENTS);
+        for (const auto& term : terms) {
+            output.write(term.postings.documents, term.postings.count * sizeof(DocumentIdType));
+        }
+        output.end();
+
+        output.begin(Format::POSTING_FREQUENCIES);
+        for (const auto& term : terms) {
+            output.write(term.postings.frequencies, term.postings.count * sizeof(FrequencyType));
+        }
+        output.end();
+
+        header.fileSize = output.finish();
+        header.headerChecksum = Format::computeHeaderChecksum(header);
+
+        if (std::fseek(file.get(), 0, SEEK_SET) != 0) {
+            throw std::runtime_error("Не удалось перейти к заголовку файла: " + tempPath.string());
+        }
+        FrontierRecordFormat::writeAll(file.get(),
+                                       std::string(reinterpret_cast<const char*>(&header), sizeof(header)));
+        FrontierRecordFormat::syncFile(file.get());
+        file.reset();
+
+        std::filesystem::rename(tempPath, targetPath);
+    } catch (const std::exception& e) {
+        std::error_code error;
+        std::filesystem::remove(tempPath, error);
+        throw std::runtime_error("Ошибка при записи сегмента индекса: " + std::string(e.what()));
+    }
+}
+} // namespace Infrastructure::Index
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+#include "InMemoryIndex.h"
+
+namespace Infrastructure::Index {
+/**
+ * @brief Запись индекса в файл сегмента (формат IndexSegmentFormat)
+ *
+ * Файл пишется во временный файл рядом с целевым и атомарно переименовывается,
+ * поэтому работающие серверы никогда не видят недописанный сегмент.
+ */
+class IndexSegmentWriter {
+  public:
+    /**
+     * @brief Записывает индекс в файл
+     * @param index Индекс, построенный в памяти
+     * @param path Путь к файлу сегмента
+     * @throws std::runtime_error при ошибке записи
+     */
+    static void write(const InMemoryIndex& index, const std::string& path);
+};
+} // namespace Infrastructure::Index
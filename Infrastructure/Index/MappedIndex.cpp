@@ -0,0 +1,223 @@
+#include "MappedIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+
+namespace Infrastructure::Index {
+namespace Format = IndexSegmentFormat;
+
+namespace {
+/**
+ * @brief Текст терма с номером index из секций словаря
+ */
+std::string_view getTermText(const uint64_t* offsets, const char* data, uint64_t index) {
+    return std::string_view(data + offsets[index], static_cast<size_t>(offsets[index + 1] - offsets[index]));
+}
+} // namespace
+
+std::shared_ptr<const MappedIndex> MappedIndex::open(const std::string& path) {
+    try {
+        return std::shared_ptr<const MappedIndex>(new MappedIndex(path));
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Не удалось открыть индекс " + path + ": " + e.what());
+    }
+}
+
+MappedIndex::MappedIndex(const std::string& path)
+    : path_(path),
+      file_(path.c_str(), boost::interprocess::read_only),
+      region_(file_, boost::interprocess::read_only) {
+    if (!Format::isNativeByteOrder()) {
+        throw std::runtime_error("чтение сегмента индекса поддерживается только на little-endian платформах");
+    }
+
+    validateHeader();
+
+    documentIds_ = static_cast<const DocumentIdType*>(getSection(Format::DOCUMENT_IDS));
+    urlOffsets_ = static_cast<const uint64_t*>(getSection(Format::URL_OFFSETS));
+    urlData_ = static_cast<const char*>(getSection(Format::URL_DATA));
+    termTextOffsets_ = static_cast<const uint64_t*>(getSection(Format::TERM_TEXT_OFFSETS));
+    termTextData_ = static_cast<const char*>(getSection(Format::TERM_TEXT_DATA));
+    termEntries_ = static_cast<const Format::TermEntry*>(getSection(Format::TERM_ENTRIES));
+    postingDocuments_ = static_cast<const DocumentIdType*>(getSection(Format::POSTING_DOCUMENTS));
+    postingFrequencies_ = static_cast<const FrequencyType*>(getSection(Format::POSTING_FREQUENCIES));
+
+    // Обращения к словарю и постингам случайны, упреждающее чтение ОС только мешает
+    region_.advise(boost::interprocess::mapped_region::advice_random);
+}
+
+void MappedIndex::validateHeader() {
+    const uint64_t fileSize = region_.get_size();
+    if (fileSize < sizeof(Format::Header)) {
+        throw std::runtime_error("файл слишком мал для индекса");
+    }
+
+    header_ = static_cast<const Format::Header*>(region_.get_address());
+    const Format::Header& header = *header_;
+
+    if (std::memcmp(header.magic, Format::MAGIC, sizeof(header.magic)) != 0) {
+        throw std::runtime_error("файл не является сегментом индекса");
+    }
+
+    if (header.version != Format::VERSION) {
+        throw std::runtime_error("неподдерживаемая версия сегмента индекса: " + std::to_string(header.version));
+    }
+
+    if (header.sectionCount != Format::SECTION_COUNT ||
+        header.headerChecksum != Format::computeHeaderChecksum(header)) {
+        throw std::runtime_error("повреждён заголовок сегмента индекса");
+    }
+
+    if (header.fileSize != fileSize) {
+        throw std::runtime_error("размер файла не совпадает с заголовком (файл обрезан?)");
+    }
+
+    // Каждый элемент секций занимает не меньше байта, поэтому произведения ниже не переполняются
+    if (header.documentCount >= std::numeric_limits<DocumentOrdinal>::max() || header.termCount >= fileSize ||
+        header.postingCount >= fileSize) {
+        throw std::runtime_error("некорректные размеры индекса в заголовке");
+    }
+
+    const uint64_t expectedSizes[Format::SECTION_COUNT] = {
+        header.documentCount * sizeof(DocumentIdType),
+        (header.documentCount + 1) * sizeof(uint64_t),
+        header.sections[Format::URL_DATA].size,
+        (header.termCount + 1) * sizeof(uint64_t),
+        header.sections[Format::TERM_TEXT_DATA].size,
+        header.termCount * sizeof(Format::TermEntry),
+        header.postingCount * sizeof(DocumentIdType),
+        header.postingCount * sizeof(FrequencyType),
+    };
+
+    for (uint32_t section = 0; section < Format::SECTION_COUNT; ++section) {
+        const auto& descriptor = header.sections[section];
+
+        if (descriptor.offset % Format::SECTION_ALIGNMENT != 0 || descriptor.offset < sizeof(Format::Header) ||
+            descriptor.offset > fileSize || descriptor.size > fileSize - descriptor.offset ||
+            descriptor.size != expectedSizes[section]) {
+            throw std::runtime_error("некорректное положение секции " + std::to_string(section));
+        }
+    }
+
+    // Концы таблиц смещений должны совпадать с размерами данных, на которые они указывают
+    const auto* urlOffsets = static_cast<const uint64_t*>(getSection(Format::URL_OFFSETS));
+    const auto* termTextOffsets = static_cast<const uint64_t*>(getSection(Format::TERM_TEXT_OFFSETS));
+
+    if (urlOffsets[header.documentCount] != header.sections[Format::URL_DATA].size ||
+        termTextOffsets[header.termCount] != header.sections[Format::TERM_TEXT_DATA].size) {
+        throw std::runtime_error("таблицы смещений не согласованы с данными");
+    }
+}
+
+const void* MappedIndex::getSection(Format::Section section) const {
+    return static_cast<const char*>(region_.get_address()) + header_->sections[section].offset;
+}
+
+void MappedIndex::verify() const {
+    const Format::Header& header = *header_;
+    const auto fail = [this](const std::string& reason) {
+        throw std::runtime_error("Индекс " + path_ + " повреждён: " + reason);
+    };
+
+    uint64_t previousEnd = sizeof(Format::Header);
+    for (uint32_t section = 0; section < Format::SECTION_COUNT; ++section) {
+        const auto& descriptor = header.sections[section];
+
+        if (descriptor.offset < previousEnd) {
+            fail("секции " + std::to_string(section) + " пересекаются");
+        }
+        previousEnd = descriptor.offset + descriptor.size;
+
+        const auto* data = getSection(static_cast<Format::Section>(section));
+        if (Format::computeChecksum(data, static_cast<size_t>(descriptor.size)) != descriptor.checksum) {
+            fail("неверная контрольная сумма секции " + std::to_string(section));
+        }
+    }
+
+    for (uint64_t i = 0; i < header.documentCount; ++i) {
+        if (i > 0 && documentIds_[i] <= documentIds_[i - 1]) {
+            fail("ID документов не возрастают");
+        }
+        if (urlOffsets_[i] > urlOffsets_[i + 1]) {
+            fail("смещения URL не возрастают");
+        }
+    }
+
+    if (urlOffsets_[0] != 0 || termTextOffsets_[0] != 0) {
+        fail("таблицы смещений должны начинаться с нуля");
+    }
+
+    for (uint64_t i = 0; i < header.termCount; ++i) {
+        if (termTextOffsets_[i] > termTextOffsets_[i + 1]) {
+            fail("смещения термов не возрастают");
+        }
+        if (i > 0 && getTermText(termTextOffsets_, termTextData_, i - 1) >=
+                         getTermText(termTextOffsets_, termTextData_, i)) {
+            fail("словарь не отсортирован");
+        }
+
+        const auto& entry = termEntries_[i];
+        if (entry.count == 0 || entry.offset > header.postingCount ||
+            entry.count > header.postingCount - entry.offset) {
+            fail("некорректный диапазон постингов терма " + std::to_string(i));
+        }
+
+        // Постинг с ID вне таблицы документов безопасен: такой документ просто не получит URL
+        FrequencyType maxFrequency = postingFrequencies_[entry.offset];
+        for (uint64_t posting = entry.offset + 1; posting < entry.offset + entry.count; ++posting) {
+            if (postingDocuments_[posting] <= postingDocuments_[posting - 1]) {
+                fail("некорректные постинги терма " + std::to_string(i));
+            }
+            maxFrequency = std::max(maxFrequency, postingFrequencies_[posting]);
+        }
+
+        // Заниженный максимум молча выбросил бы документы из выдачи
+        if (entry.maxFrequency != maxFrequency) {
+            fail("неверная максимальная частота терма " + std::to_string(i));
+        }
+    }
+}
+
+std::optional<std::pair<WordIdType, PostingRange>> MappedIndex::findTerm(const std::string& text) const {
+    const std::string_view target(text);
+
+    uint64_t low = 0;
+    uint64_t high = header_->termCount;
+
+    while (low < high) {
+        const uint64_t middle = low + (high - low) / 2;
+        const int comparison = getTermText(termTextOffsets_, termTextData_, middle).compare(target);
+
+        if (comparison == 0) {
+            const auto& entry = termEntries_[middle];
+
+            PostingRange range;
+            range.documents = postingDocuments_ + entry.offset;
+            range.frequencies = postingFrequencies_ + entry.offset;
+            range.count = static_cast<size_t>(entry.count);
+            range.maxFrequency = entry.maxFrequency;
+            return std::make_pair(entry.wordId, range);
+        }
+
+        if (comparison < 0) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return std::nullopt;
+}
+
+DocumentTable MappedIndex::getDocumentTable() const {
+    DocumentTable table;
+    table.ids = documentIds_;
+    table.urlOffsets = urlOffsets_;
+    table.urlData = urlData_;
+    table.count = static_cast<size_t>(header_->documentCount);
+    return table;
+}
+} // namespace Infrastructure::Index
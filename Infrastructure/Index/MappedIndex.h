@@ -0,0 +1,72 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "IndexSegmentFormat.h"
+#include "SearchIndex.h"
+
+namespace Infrastructure::Index {
+/**
+ * @brief Индекс, отображённый в память из файла сегмента
+ *
+ * Секции файла используются как есть, без десериализации: открытие занимает
+ * миллисекунды независимо от размера индекса, страницы подгружаются ОС по
+ * мере обращения, а несколько процессов делят один page cache.
+ * Словарь отсортирован, поиск терма - бинарный поиск.
+ */
+class MappedIndex : public SearchIndex {
+  public:
+    /**
+     * @brief Открывает файл сегмента
+     *
+     * Проверяет заголовок и границы секций (O(1)); полную проверку
+     * контрольных сумм выполняет verify(). Содержимое секций после open()
+     * считается корректным, поэтому файлы следует проверять после копирования.
+     *
+     * @param path Путь к файлу сегмента
+     * @throws std::runtime_error если файл не открывается или заголовок некорректен
+     */
+    static std::shared_ptr<const MappedIndex> open(const std::string& path);
+
+    /**
+     * @brief Полная проверка файла: контрольные суммы и согласованность секций
+     * @throws std::runtime_error с описанием первой найденной ошибки
+     */
+    void verify() const;
+
+    std::optional<std::pair<WordIdType, PostingRange>> findTerm(const std::string& text) const override;
+    DocumentTable getDocumentTable() const override;
+    size_t getTermCount() const override { return static_cast<size_t>(header_->termCount); }
+    size_t getPostingCount() const override { return static_cast<size_t>(header_->postingCount); }
+
+    /**
+     * @brief Размер файла в байтах
+     */
+    uint64_t getFileSize() const { return header_->fileSize; }
+
+  private:
+    explicit MappedIndex(const std::string& path);
+
+    void validateHeader();
+
+    const void* getSection(IndexSegmentFormat::Section section) const;
+
+    std::string path_;
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+
+    const IndexSegmentFormat::Header* header_ = nullptr;
+    const DocumentIdType* documentIds_ = nullptr;
+    const uint64_t* urlOffsets_ = nullptr;
+    const char* urlData_ = nullptr;
+    const uint64_t* termTextOffsets_ = nullptr;
+    const char* termTextData_ = nullptr;
+    const IndexSegmentFormat::TermEntry* termEntries_ = nullptr;
+    const DocumentIdType* postingDocuments_ = nullptr;
+    const FrequencyType* postingFrequencies_ = nullptr;
+};
+} // namespace Infrastructure::Index
@@ -0,0 +1,84 @@
+#include "PostgresIndexLoader.h"
+
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include "../Database/PostingListCodec.h"
+
+namespace Infrastructure::Index {
+std::shared_ptr<const InMemoryIndex> PostgresIndexLoader::load(Database::DatabaseConnection& dbConnection,
+                                                              bool packedPostings) {
+    if (!dbConnection.isConnected()) {
+        throw std::runtime_error("Нет соединения с базой данных");
+    }
+
+    try {
+        pqxx::work txn(dbConnection.getConnection());
+        InMemoryIndex::Builder builder;
+
+        // Таблица документов в порядке возрастания ID (его требует Builder)
+        for (auto [documentId, url] :
+             txn.stream<DocumentIdType, std::string>("SELECT id, url FROM documents ORDER BY id")) {
+            builder.addDocument(documentId, url);
+        }
+
+        if (packedPostings) {
+            const std::string packedSql = R"(
+                SELECT w.id, w.text, wp.postings
+                FROM word_postings wp
+                INNER JOIN words w ON w.id = wp.word_id
+            )";
+
+            for (auto [wordId, text, postings] : txn.stream<WordIdType, std::string, pqxx::bytes>(packedSql)) {
+                builder.beginTerm(wordId, text);
+
+                Database::PostingListCodec::Cursor cursor(postings.data(), postings.size());
+                Database::PostingListCodec::Posting posting;
+                while (cursor.next(posting)) {
+                    builder.addPosting(posting.documentId, posting.frequency);
+                }
+            }
+
+            txn.commit();
+            return builder.build();
+        }
+
+        std::unordered_map<WordIdType, std::string> words;
+        for (auto [wordId, text] : txn.stream<WordIdType, std::string>("SELECT id, text FROM words")) {
+            words.emplace(wordId, std::move(text));
+        }
+
+        // Постинги, сгруппированные по слову и отсортированные по документу
+        const std::string postingsSql = R"(
+            SELECT word_id, document_id, frequency
+            FROM word_frequencies
+            ORDER BY word_id, document_id
+        )";
+
+        bool hasCurrentWord = false;
+        WordIdType currentWordId = 0;
+
+        for (auto [wordId, documentId, frequency] :
+             txn.stream<WordIdType, DocumentIdType, FrequencyType>(postingsSql)) {
+            if (!hasCurrentWord || wordId != currentWordId) {
+                const auto it = words.find(wordId);
+                if (it == words.end()) {
+                    continue;
+                }
+
+                builder.beginTerm(wordId, it->second);
+                currentWordId = wordId;
+                hasCurrentWord = true;
+            }
+
+            builder.addPosting(documentId, frequency);
+        }
+
+        txn.commit();
+        return builder.build();
+    } catch (const std::exception& e) {
+        throw std::runtime_error("Ошибка при загрузке индекса в память: " + std::string(e.what()));
+    }
+}
+} // namespace Infrastructure::Index
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+
+#include "../Database/DatabaseConnection.h"
+#include "InMemoryIndex.h"
+
+namespace Infrastructure::Index {
+/**
+ * @brief Загрузчик индекса в память из таблиц PostgreSQL
+ *
+ * Читает documents, words и word_frequencies (или word_postings) потоково
+ * (COPY через pqxx::stream), не материализуя весь результат в памяти клиента.
+ */
+class PostgresIndexLoader {
+  public:
+    /**
+     * @brief Загружает индекс
+     * @param dbConnection Соединение с базой данных
+     * @param packedPostings Читать упакованные постинги word_postings вместо word_frequencies
+     * @return Построенный индекс
+     * @throws std::runtime_error при ошибке чтения
+     */
+    static std::shared_ptr<const InMemoryIndex> load(Database::DatabaseConnection& dbConnection,
+                                                     bool packedPostings = false);
+};
+} // namespace Infrastructure::Index
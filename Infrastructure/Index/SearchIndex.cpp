@@ -0,0 +1,25 @@
+#include "SearchIndex.h"
+
+#include <algorithm>
+
+namespace Infrastructure::Index {
+std::optional<Core::Domain::Model::Word> SearchIndex::findWord(const std::string& text) const {
+    const auto term = findTerm(text);
+    if (!term.has_value()) {
+        return std::nullopt;
+    }
+
+    return Core::Domain::Model::Word(term->first, text);
+}
+
+std::optional<std::string> SearchIndex::findDocumentUrl(DocumentIdType documentId) const {
+    const DocumentTable documents = getDocumentTable();
+    const DocumentIdType* const end = documents.ids + documents.count;
+    const DocumentIdType* const it = std::lower_bound(documents.ids, end, documentId);
+    if (it == end || *it != documentId) {
+        return std::nullopt;
+    }
+
+    return documents.getUrl(static_cast<DocumentOrdinal>(it - documents.ids));
+}
+} // namespace Infrastructure::Index
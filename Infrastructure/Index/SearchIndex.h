@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "../../Core/Domain/Model/Document.h"
+#include "../../Core/Domain/Model/Word.h"
+#include "../../Core/Domain/Model/WordFrequency.h"
+
+namespace Infrastructure::Index {
+using DocumentOrdinal = uint32_t;  // Плотный номер документа в индексе
+using DocumentIdType = Core::Domain::Model::Document::IdType;
+using WordIdType = Core::Domain::Model::Word::IdType;
+using FrequencyType = Core::Domain::Model::WordFrequency::FrequencyType;
+
+/**
+ * @brief Постинги одного терма: отсортированные ID документов и частоты
+ */
+struct PostingRange {
+    const DocumentIdType* documents = nullptr;
+    const FrequencyType* frequencies = nullptr;
+    size_t count = 0;
+    FrequencyType maxFrequency = 0;
+};
+
+/**
+ * @brief Таблица документов индекса: ID и URL по номеру документа
+ *
+ * URL хранятся одной строкой: URL документа i - это urlData[urlOffsets[i], urlOffsets[i+1]).
+ */
+struct DocumentTable {
+    const DocumentIdType* ids = nullptr;
+    const uint64_t* urlOffsets = nullptr;
+    const char* urlData = nullptr;
+    size_t count = 0;
+
+    std::string getUrl(DocumentOrdinal ordinal) const {
+        return std::string(urlData + urlOffsets[ordinal], urlOffsets[ordinal + 1] - urlOffsets[ordinal]);
+    }
+};
+
+/**
+ * @brief Неизменяемый поисковый индекс
+ *
+ * Общий интерфейс индекса в памяти и индекса, отображённого из файла.
+ * Реализации потокобезопасны без блокировок.
+ */
+class SearchIndex {
+  public:
+    virtual ~SearchIndex() = default;
+
+    /**
+     * @brief Находит постинги терма
+     * @param text Текст терма (нормализованный, в нижнем регистре)
+     * @return ID слова и постинги, если терм есть в индексе
+     */
+    virtual std::optional<std::pair<WordIdType, PostingRange>> findTerm(const std::string& text) const = 0;
+
+    /**
+     * @brief Таблица документов
+     */
+    virtual DocumentTable getDocumentTable() const = 0;
+
+    virtual size_t getTermCount() const = 0;
+
+    virtual size_t getPostingCount() const = 0;
+
+    size_t getDocumentCount() const { return getDocumentTable().count; }
+
+    /**
+     * @brief Находит слово в словаре
+     */
+    std::optional<Core::Domain::Model::Word> findWord(const std::string& text) const;
+
+    /**
+     * @brief Находит URL документа по ID (бинарный поиск по таблице документов)
+     */
+    std::optional<std::string> findDocumentUrl(DocumentIdType documentId) const;
+};
+} // namespace Infrastructure::Index
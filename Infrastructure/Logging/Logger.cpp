@@ -0,0 +1,538 @@
+#include "Logger.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace Infrastructure::Logging {
+/**
+ * @brief Кольцевой буфер записей одного потока: пишет поток-владелец, читает фоновый поток журнала
+ */
+struct AsyncLogger::ThreadBuffer {
+    ThreadBuffer(size_t capacity, std::string threadName)
+        : records(new LogRecord[capacity]), mask(capacity - 1), name(std::move(threadName)) {}
+
+    std::unique_ptr<LogRecord[]> records;
+    const size_t mask;
+
+    alignas(64) std::atomic<uint64_t> head{0};  // Следующая запись; меняет только владелец
+    alignas(64) std::atomic<uint64_t> tail{0};  // Первая не выведенная; меняет только читатель
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> abandoned{false};  // Поток завершился
+
+    // Сколько потерь уже выведено (только под outputMutex_)
+    uint64_t reportedDropped = 0;
+
+    std::mutex nameMutex;
+    std::string name;
+};
+
+namespace {
+constexpr int64_t NANOSECONDS_PER_SECOND = 1000000000;
+constexpr int64_t NANOSECONDS_PER_MILLISECOND = 1000000;
+
+constexpr const char* TEXT_LEVEL_NAMES[] = {"DEBUG", "INFO ", "WARN ", "ERROR"};
+constexpr const char* JSON_LEVEL_NAMES[] = {"debug", "info", "warning", "error"};
+
+// Текущий журнал; мьютекс берётся при его создании, уничтожении и при появлении пишущего потока
+std::mutex loggerMutex;
+AsyncLogger* currentLogger = nullptr;
+uint64_t loggerCount = 0;
+// Номер текущего журнала (0 - журнала нет): поток сверяет с ним свой буфер без мьютекса
+std::atomic<uint64_t> activeGeneration{0};
+
+std::atomic<uint64_t> suppressedTotal{0};
+
+/**
+ * @brief Состояние журнала в пишущем потоке
+ */
+struct ThreadState {
+    std::shared_ptr<AsyncLogger::ThreadBuffer> buffer;
+    uint64_t generation = 0;  // Журнал, в котором зарегистрирован buffer
+    std::string name;
+    LogRecord direct;  // Запись, выводимая сразу (журнала нет)
+
+    ThreadState() = default;
+
+    ~ThreadState() {
+        if (buffer) {
+            buffer->abandoned.store(true, std::memory_order_release);
+        }
+    }
+
+    ThreadState(const ThreadState&) = delete;
+    ThreadState& operator=(const ThreadState&) = delete;
+};
+
+ThreadState& getThreadState() {
+    thread_local ThreadState state;
+    return state;
+}
+
+void registerThread(ThreadState& state) {
+    std::lock_guard<std::mutex> lock(loggerMutex);
+    if (state.buffer) {
+        state.buffer->abandoned.store(true, std::memory_order_release);
+        state.buffer.reset();
+    }
+    state.generation = activeGeneration.load(std::memory_order_relaxed);
+    if (currentLogger != nullptr) {
+        state.buffer = currentLogger->createThreadBuffer(state.name);
+    }
+}
+
+/**
+ * @brief Проверяет ограничение частоты места вызова
+ * @param suppressed Сколько записей этого места отброшено с прошлой пропущенной
+ */
+bool admit(LogSite& site, int64_t second, uint32_t& suppressed) {
+    const uint32_t limit = detail::rateLimitPerSecond.load(std::memory_order_relaxed);
+    if (limit == 0) {
+        return true;
+    }
+
+    int64_t window = site.windowSecond.load(std::memory_order_relaxed);
+    if (window != second &&
+        site.windowSecond.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+        site.windowCount.store(0, std::memory_order_relaxed);
+    }
+
+    if (site.windowCount.fetch_add(1, std::memory_order_relaxed) < limit) {
+        if (site.suppressed.load(std::memory_order_relaxed) != 0) {
+            suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    site.suppressed.fetch_add(1, std::memory_order_relaxed);
+    suppressedTotal.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void appendPadded(std::string& out, int64_t value, int width) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    out.append(static_cast<size_t>(std::max<int64_t>(0, width - (end - digits))), '0');
+    out.append(digits, end);
+}
+
+/**
+ * @brief Дописывает время UTC: 2026-01-31 12:34:56.789 (или 2026-01-31T12:34:56.789Z для JSON)
+ */
+void appendTime(std::string& out, int64_t timeNs, bool iso) {
+    const int64_t milliseconds = timeNs / NANOSECONDS_PER_MILLISECOND;
+    int64_t days = milliseconds / 86400000;
+    int64_t msOfDay = milliseconds % 86400000;
+    if (msOfDay < 0) {
+        msOfDay += 86400000;
+        --days;
+    }
+
+    // Дата по числу дней с 1970-01-01 (алгоритм civil_from_days Говарда Хиннанта)
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int64_t dayOfEra = days - era * 146097;
+    const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int64_t monthIndex = (5 * dayOfYear + 2) / 153;
+    const int64_t day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+    const int64_t month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+    const int64_t year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    appendPadded(out, year, 4);
+    out += '-';
+    appendPadded(out, month, 2);
+    out += '-';
+    appendPadded(out, day, 2);
+    out += iso ? 'T' : ' ';
+    appendPadded(out, msOfDay / 3600000, 2);
+    out += ':';
+    appendPadded(out, msOfDay / 60000 % 60, 2);
+    out += ':';
+    appendPadded(out, msOfDay / 1000 % 60, 2);
+    out += '.';
+    appendPadded(out, msOfDay % 1000, 3);
+    if (iso) {
+        out += 'Z';
+    }
+}
+
+void appendJsonString(std::string& out, std::string_view text) {
+    static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+
+    out += '"';
+    for (const char symbol : text) {
+        const auto byte = static_cast<unsigned char>(symbol);
+        if (symbol == '"' || symbol == '\\') {
+            out += '\\';
+            out += symbol;
+        } else if (byte < 0x20) {
+            out += "\\u00";
+            out += HEX_DIGITS[byte >> 4];
+            out += HEX_DIGITS[byte & 0x0F];
+        } else {
+            out += symbol;
+        }
+    }
+    out += '"';
+}
+
+void formatRecord(std::string& out, const LogRecord& record, const std::string& threadName, LogFormat format) {
+    const auto levelIndex = std::min<size_t>(static_cast<size_t>(record.site->level), 3);
+    const std::string_view message(record.message, record.length);
+
+    if (format == LogFormat::JSON) {
+        out += "{\"time\":\"";
+        appendTime(out, record.timeNs, true);
+        out += "\",\"level\":\"";
+        out += JSON_LEVEL_NAMES[levelIndex];
+        out += "\",\"component\":";
+        appendJsonString(out, record.site->component);
+        if (!threadName.empty()) {
+            out += ",\"thread\":";
+            appendJsonString(out, threadName);
+        }
+        out += ",\"message\":";
+        appendJsonString(out, message);
+        if (record.truncated) {
+            out += ",\"truncated\":true";
+        }
+        if (record.suppressed != 0) {
+            out += ",\"suppressed\":";
+            appendPadded(out, record.suppressed, 0);
+        }
+        out += "}\n";
+        return;
+    }
+
+    appendTime(out, record.timeNs, false);
+    out += ' ';
+    out += TEXT_LEVEL_NAMES[levelIndex];
+    out += ' ';
+    out += record.site->component;
+    if (!threadName.empty()) {
+        out += " [";
+        out += threadName;
+        out += ']';
+    }
+    out += ' ';
+    out += message;
+    if (record.truncated) {
+        out += "...";
+    }
+    if (record.suppressed != 0) {
+        out += " (пропущено похожих: ";
+        appendPadded(out, record.suppressed, 0);
+        out += ')';
+    }
+    out += '\n';
+}
+
+bool isErrorStream(const LogRecord& record) {
+    return record.site->level >= LogLevel::WARNING;
+}
+
+void writeStream(std::FILE* stream, std::string& text) {
+    if (!text.empty()) {
+        std::fwrite(text.data(), 1, text.size(), stream);
+        std::fflush(stream);
+        text.clear();
+    }
+}
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value) {
+        result *= 2;
+    }
+    return result;
+}
+
+LogSite droppedSite{LogLevel::WARNING, "logger"};
+} // namespace
+
+void LogRecord::append(std::string_view text) {
+    if (truncated) {
+        return;
+    }
+
+    size_t count = text.size();
+    const size_t available = MESSAGE_CAPACITY - length;
+    if (count > available) {
+        // Не разрезаем многобайтовый символ UTF-8
+        count = available;
+        while (count > 0 && (static_cast<unsigned char>(text[count]) & 0xC0) == 0x80) {
+            --count;
+        }
+        truncated = true;
+    }
+
+    std::memcpy(message + length, text.data(), count);
+    length = static_cast<uint16_t>(length + count);
+}
+
+LogLevel parseLogLevel(const std::string& name) {
+    if (name == "debug") {
+        return LogLevel::DEBUG;
+    }
+    if (name == "info") {
+        return LogLevel::INFO;
+    }
+    if (name == "warning") {
+        return LogLevel::WARNING;
+    }
+    if (name == "error") {
+        return LogLevel::ERR;
+    }
+    if (name == "off") {
+        return LogLevel::OFF;
+    }
+    throw std::invalid_argument("Неизвестный уровень журнала: " + name);
+}
+
+LogFormat parseLogFormat(const std::string& name) {
+    if (name == "text") {
+        return LogFormat::TEXT;
+    }
+    if (name == "json") {
+        return LogFormat::JSON;
+    }
+    throw std::invalid_argument("Неизвестный формат журнала: " + name);
+}
+
+namespace detail {
+LogRecord* beginRecord(LogSite& site) {
+    const int64_t nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::system_clock::now().time_since_epoch())
+                              .count();
+
+    uint32_t suppressed = 0;
+    if (!admit(site, nowNs / NANOSECONDS_PER_SECOND, suppressed)) {
+        return nullptr;
+    }
+
+    ThreadState& state = getThreadState();
+    LogRecord* record = &state.direct;
+
+    const uint64_t generation = activeGeneration.load(std::memory_order_acquire);
+    if (generation != 0) {
+        if (state.generation != generation) {
+            registerThread(state);
+        }
+        if (state.buffer) {
+            auto& buffer = *state.buffer;
+            const uint64_t head = buffer.head.load(std::memory_order_relaxed);
+            if (head - buffer.tail.load(std::memory_order_acquire) > buffer.mask) {
+                buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+                return nullptr;
+            }
+            record = &buffer.records[head & buffer.mask];
+        }
+    }
+
+    record->timeNs = nowNs;
+    record->site = &site;
+    record->suppressed = suppressed;
+    record->length = 0;
+    record->truncated = false;
+    return record;
+}
+
+void commitRecord(LogRecord& record) {
+    ThreadState& state = getThreadState();
+    if (&record == &state.direct) {
+        // Журнала нет: выводим сразу, одной записью в поток вывода
+        std::string line;
+        formatRecord(line, record, state.name, LogFormat::TEXT);
+        writeStream(isErrorStream(record) ? stderr : stdout, line);
+        return;
+    }
+
+    auto& buffer = *state.buffer;
+    buffer.head.store(buffer.head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void appendArg(LogRecord& record, std::string_view text) {
+    record.append(text);
+}
+
+void appendArg(LogRecord& record, int64_t value) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    record.append(std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+void appendArg(LogRecord& record, uint64_t value) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    record.append(std::string_view(digits, static_cast<size_t>(end - digits)));
+}
+
+void appendArg(LogRecord& record, double value) {
+    char digits[32];
+    const int length = std::snprintf(digits, sizeof(digits), "%.6g", value);
+    if (length > 0) {
+        record.append(std::string_view(digits, std::min(static_cast<size_t>(length), sizeof(digits) - 1)));
+    }
+}
+} // namespace detail
+
+void setThreadName(std::string_view name) {
+    ThreadState& state = getThreadState();
+    state.name.assign(name);
+    if (state.buffer) {
+        std::lock_guard<std::mutex> lock(state.buffer->nameMutex);
+        state.buffer->name = state.name;
+    }
+}
+
+AsyncLogger::AsyncLogger(LoggerSettings settings)
+    : settings_(settings), bufferCapacity_(roundUpToPowerOfTwo(settings.threadBufferRecords)) {
+    {
+        std::lock_guard<std::mutex> lock(loggerMutex);
+        if (currentLogger != nullptr) {
+            throw std::runtime_error("Журнал уже создан");
+        }
+        currentLogger = this;
+        activeGeneration.store(++loggerCount, std::memory_order_release);
+    }
+
+    detail::currentLevel.store(static_cast<uint8_t>(settings_.level), std::memory_order_relaxed);
+    detail::rateLimitPerSecond.store(settings_.rateLimitPerSecond, std::memory_order_relaxed);
+
+    writer_ = std::thread([this] { run(); });
+}
+
+AsyncLogger::~AsyncLogger() {
+    {
+        std::lock_guard<std::mutex> lock(loggerMutex);
+        currentLogger = nullptr;
+        activeGeneration.store(0, std::memory_order_release);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex_);
+        stopping_ = true;
+    }
+    wakeCv_.notify_all();
+    writer_.join();
+
+    flush();
+}
+
+void AsyncLogger::setLevel(LogLevel level) {
+    detail::currentLevel.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+}
+
+LogLevel AsyncLogger::getLevel() const {
+    return static_cast<LogLevel>(detail::currentLevel.load(std::memory_order_relaxed));
+}
+
+uint64_t AsyncLogger::getDroppedCount() const {
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    uint64_t total = retiredDropped_;
+    for (const auto& buffer : buffers_) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t AsyncLogger::getSuppressedCount() {
+    return suppressedTotal.load(std::memory_order_relaxed);
+}
+
+std::shared_ptr<AsyncLogger::ThreadBuffer> AsyncLogger::createThreadBuffer(std::string threadName) {
+    auto buffer = std::make_shared<ThreadBuffer>(bufferCapacity_, std::move(threadName));
+
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    buffers_.push_back(buffer);
+    return buffer;
+}
+
+void AsyncLogger::run() {
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    while (!wakeCv_.wait_for(lock, settings_.flushInterval, [this] { return stopping_; })) {
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+}
+
+void AsyncLogger::flush() {
+    std::lock_guard<std::mutex> outputLock(outputMutex_);
+
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        std::lock_guard<std::mutex> lock(buffersMutex_);
+        buffers = buffers_;
+    }
+
+    struct Pending {
+        const LogRecord* record;
+        const std::string* threadName;
+    };
+    std::vector<Pending> pending;
+    std::vector<std::string> names(buffers.size());
+    std::vector<uint64_t> heads(buffers.size());
+
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        ThreadBuffer& buffer = *buffers[i];
+        {
+            std::lock_guard<std::mutex> lock(buffer.nameMutex);
+            names[i] = buffer.name;
+        }
+
+        const uint64_t tail = buffer.tail.load(std::memory_order_relaxed);
+        heads[i] = buffer.head.load(std::memory_order_acquire);
+        for (uint64_t position = tail; position != heads[i]; ++position) {
+            pending.push_back({&buffer.records[position & buffer.mask], &names[i]});
+        }
+    }
+
+    // Записи разных потоков - в порядке времени
+    std::stable_sort(pending.begin(), pending.end(), [](const Pending& left, const Pending& right) {
+        return left.record->timeNs < right.record->timeNs;
+    });
+    for (const auto& entry : pending) {
+        formatRecord(isErrorStream(*entry.record) ? err_ : out_, *entry.record, *entry.threadName,
+                     settings_.format);
+    }
+
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        ThreadBuffer& buffer = *buffers[i];
+        buffer.tail.store(heads[i], std::memory_order_release);
+
+        const uint64_t dropped = buffer.dropped.load(std::memory_order_relaxed);
+        if (dropped != buffer.reportedDropped) {
+            LogRecord record;
+            record.timeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::system_clock::now().time_since_epoch())
+                                .count();
+            record.site = &droppedSite;
+            record.append("Буфер журнала потока переполнен, потеряно записей: ");
+            detail::appendArg(record, dropped - buffer.reportedDropped);
+            formatRecord(err_, record, names[i], settings_.format);
+            buffer.reportedDropped = dropped;
+        }
+    }
+
+    writeStream(stdout, out_);
+    writeStream(stderr, err_);
+
+    // Буферы завершившихся потоков удаляются, когда из них всё выведено
+    std::lock_guard<std::mutex> lock(buffersMutex_);
+    buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+                                  [this](const std::shared_ptr<ThreadBuffer>& buffer) {
+                                      if (!buffer->abandoned.load(std::memory_order_acquire) ||
+                                          buffer->head.load(std::memory_order_acquire) !=
+                                              buffer->tail.load(std::memory_order_relaxed)) {
+                                          return false;
+                                      }
+                                      retiredDropped_ += buffer->dropped.load(std::memory_order_relaxed);
+                                      return true;
+                                  }),
+                   buffers_.end());
+}
+} // namespace Infrastructure::Logging
@@ -0,0 +1,256 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Infrastructure::Logging {
+/**
+ * @brief Уровень записи журнала
+ *
+ * ERR, а не ERROR: ERROR - макрос из windows.h.
+ */
+enum class LogLevel : uint8_t { DEBUG, INFO, WARNING, ERR, OFF };
+
+/**
+ * @brief Формат строк журнала
+ */
+enum class LogFormat {
+    TEXT,  // время, уровень, компонент, поток и сообщение
+    JSON   // один JSON-объект на строку
+};
+
+/**
+ * @brief Разбирает уровень из конфигурации: debug, info, warning, error, off
+ * @throws std::invalid_argument при неизвестном уровне
+ */
+LogLevel parseLogLevel(const std::string& name);
+
+/**
+ * @brief Разбирает формат из конфигурации: text, json
+ * @throws std::invalid_argument при неизвестном формате
+ */
+LogFormat parseLogFormat(const std::string& name);
+
+/**
+ * @brief Место вызова макроса LOG_*: уровень, компонент и окно ограничения частоты
+ *
+ * Ограничение частоты - по местам вызова: повторяющаяся ошибка (недоступный
+ * хост, обрыв соединений) не вытесняет остальные записи.
+ */
+struct LogSite {
+    LogLevel level;
+    const char* component;
+    std::atomic<int64_t> windowSecond{-1};
+    std::atomic<uint32_t> windowCount{0};
+    std::atomic<uint32_t> suppressed{0};
+
+    LogSite(LogLevel siteLevel, const char* siteComponent) : level(siteLevel), component(siteComponent) {}
+};
+
+/**
+ * @brief Запись журнала фиксированного размера в буфере потока
+ *
+ * Сообщение форматируется сразу в запись, без выделения памяти;
+ * не поместившееся обрезается по границе символа UTF-8.
+ */
+struct LogRecord {
+    static constexpr size_t MESSAGE_CAPACITY = 232;
+
+    int64_t timeNs = 0;  // system_clock, с начала эпохи
+    const LogSite* site = nullptr;
+    uint32_t suppressed = 0;  // Сколько записей этого места отброшено ограничением частоты перед этой
+    uint16_t length = 0;
+    bool truncated = false;
+    char message[MESSAGE_CAPACITY];
+
+    void append(std::string_view text);
+};
+
+namespace detail {
+// Текущий уровень и ограничение частоты: читаются на каждом вызове, поэтому не в объекте журнала
+inline std::atomic<uint8_t> currentLevel{static_cast<uint8_t>(LogLevel::INFO)};
+inline std::atomic<uint32_t> rateLimitPerSecond{20};
+
+/**
+ * @brief Занимает запись в буфере текущего потока
+ * @return nullptr, если запись отброшена ограничением частоты или буфер полон
+ */
+LogRecord* beginRecord(LogSite& site);
+
+/**
+ * @brief Публикует запись, занятую beginRecord
+ */
+void commitRecord(LogRecord& record);
+
+void appendArg(LogRecord& record, std::string_view text);
+void appendArg(LogRecord& record, int64_t value);
+void appendArg(LogRecord& record, uint64_t value);
+void appendArg(LogRecord& record, double value);
+
+inline void appendArg(LogRecord& record, const char* text) {
+    appendArg(record, std::string_view(text));
+}
+
+inline void appendArg(LogRecord& record, const std::string& text) {
+    appendArg(record, std::string_view(text));
+}
+
+inline void appendArg(LogRecord& record, char symbol) {
+    appendArg(record, std::string_view(&symbol, 1));
+}
+
+template <typename T>
+std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>> appendArg(
+    LogRecord& record, T value) {
+    if constexpr (std::is_signed_v<T>) {
+        appendArg(record, static_cast<int64_t>(value));
+    } else {
+        appendArg(record, static_cast<uint64_t>(value));
+    }
+}
+} // namespace detail
+
+inline bool isEnabled(LogLevel level) {
+    return static_cast<uint8_t>(level) >= detail::currentLevel.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Пишет запись: аргументы (строки и числа) выводятся подряд
+ *
+ * Не блокирует: при полном буфере потока запись отбрасывается и учитывается
+ * в счётчике потерянных.
+ */
+template <typename... Args>
+void write(LogSite& site, const Args&... args) {
+    LogRecord* record = detail::beginRecord(site);
+    if (record == nullptr) {
+        return;
+    }
+    (detail::appendArg(*record, args), ...);
+    detail::commitRecord(*record);
+}
+
+/**
+ * @brief Задаёт имя текущего потока в журнале ("Поток 3", "HTTP 0")
+ */
+void setThreadName(std::string_view name);
+
+/**
+ * @brief Настройки асинхронного журнала
+ */
+struct LoggerSettings {
+    LogLevel level = LogLevel::INFO;
+    LogFormat format = LogFormat::TEXT;
+    // Записей в буфере каждого пишущего потока (округляется вверх до степени двойки)
+    size_t threadBufferRecords = 1024;
+    // Записей в секунду с одного места вызова, остальные отбрасываются с подсчётом (0 - без ограничения)
+    uint32_t rateLimitPerSecond = 20;
+    // Как часто фоновый поток выводит накопленные записи
+    std::chrono::milliseconds flushInterval{50};
+};
+
+/**
+ * @brief Асинхронный журнал: буфер записей на поток и фоновый поток вывода
+ *
+ * Пишущий поток копирует сообщение в свой кольцевой буфер (один писатель, один
+ * читатель) и не ждёт ни вывода, ни других потоков. Фоновый поток раз в
+ * flushInterval забирает записи из всех буферов, форматирует их и выводит:
+ * DEBUG и INFO - в stdout, WARNING и ERR - в stderr.
+ *
+ * Пока объект жив, через него пишут макросы LOG_*; без него записи выводятся
+ * сразу, в пишущем потоке (утилиты, запуск до чтения конфигурации). Объект
+ * один на процесс и уничтожается после остановки пишущих потоков: при
+ * уничтожении он выводит всё накопленное.
+ */
+class AsyncLogger {
+  public:
+    /**
+     * @throws std::runtime_error если журнал уже создан
+     */
+    explicit AsyncLogger(LoggerSettings settings);
+
+    ~AsyncLogger();
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    void setLevel(LogLevel level);
+
+    LogLevel getLevel() const;
+
+    /**
+     * @brief Записи, отброшенные из-за полного буфера потока
+     */
+    uint64_t getDroppedCount() const;
+
+    /**
+     * @brief Записи, отброшенные ограничением частоты (за всё время работы процесса)
+     */
+    static uint64_t getSuppressedCount();
+
+    /**
+     * @brief Выводит всё, что уже записано (в вызывающем потоке)
+     */
+    void flush();
+
+    struct ThreadBuffer;
+
+    /**
+     * @brief Регистрирует буфер нового пишущего потока
+     */
+    std::shared_ptr<ThreadBuffer> createThreadBuffer(std::string threadName);
+
+  private:
+    const LoggerSettings settings_;
+    const size_t bufferCapacity_;
+
+    // Буферы потоков; мьютекс берётся при появлении потока и коротко при выводе
+    mutable std::mutex buffersMutex_;
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+    // Потерянные записи буферов, уже удалённых после завершения их потоков
+    uint64_t retiredDropped_ = 0;
+
+    // Вывод идёт из одного потока за раз (фоновый поток или flush())
+    std::mutex outputMutex_;
+    std::string out_;
+    std::string err_;
+
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCv_;
+    bool stopping_ = false;
+    std::thread writer_;
+
+    void run();
+};
+} // namespace Infrastructure::Logging
+
+/**
+ * Запись журнала: LOG_WARNING("http_client", "HTTP ошибка ", status, " для ", url);
+ * Аргументы не вычисляются, если уровень выключен.
+ */
+#define SEARCH_LOG(level, component, ...)                                                            \
+    do {                                                                                             \
+        if (::Infrastructure::Logging::isEnabled(level)) {                                           \
+            static ::Infrastructure::Logging::LogSite searchLogSite{level, component};               \
+            ::Infrastructure::Logging::write(searchLogSite, __VA_ARGS__);                            \
+        }                                                                                            \
+    } while (false)
+
+#define LOG_DEBUG(component, ...) \
+    SEARCH_LOG(::Infrastructure::Logging::LogLevel::DEBUG, component, __VA_ARGS__)
+#define LOG_INFO(component, ...) \
+    SEARCH_LOG(::Infrastructure::Logging::LogLevel::INFO, component, __VA_ARGS__)
+#define LOG_WARNING(component, ...) \
+    SEARCH_LOG(::Infrastructure::Logging::LogLevel::WARNING, component, __VA_ARGS__)
+#define LOG_ERROR(component, ...) \
+    SEARCH_LOG(::Infrastructure::Logging::LogLevel::ERR, component, __VA_ARGS__)
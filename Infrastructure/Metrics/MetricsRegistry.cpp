@@ -0,0 +1,327 @@
+#include "MetricsRegistry.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+namespace Infrastructure::Metrics {
+namespace {
+constexpr double SUMMARY_QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+constexpr double NANOSECONDS_PER_SECOND = 1e9;
+
+/**
+ * @brief Номер старшего единичного бита (v > 0)
+ */
+int floorLog2(uint64_t value) {
+    int result = 0;
+    for (int shift = 32; shift > 0; shift /= 2) {
+        if ((value >> shift) != 0) {
+            value >>= shift;
+            result += shift;
+        }
+    }
+    return result;
+}
+
+void appendNumber(std::string& out, double value) {
+    // snprintf и to_chars не зависят от глобальной локали (её меняет Boost.Locale)
+    char digits[32];
+    const int length = std::snprintf(digits, sizeof(digits), "%.9g", value);
+    out.append(digits, static_cast<size_t>(length));
+}
+
+void appendNumber(std::string& out, uint64_t value) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    out.append(digits, end);
+}
+
+void appendNumber(std::string& out, int64_t value) {
+    char digits[24];
+    const auto end = std::to_chars(digits, digits + sizeof(digits), value).ptr;
+    out.append(digits, end);
+}
+
+/**
+ * @brief Дописывает имя и метки: name{labels,extra}
+ */
+void appendSeries(std::string& out,
+                  const std::string& name,
+                  const std::string& labels,
+                  const std::string& extra = "") {
+    out += name;
+    if (labels.empty() && extra.empty()) {
+        out += ' ';
+        return;
+    }
+    out += '{';
+    out += labels;
+    if (!labels.empty() && !extra.empty()) {
+        out += ',';
+    }
+    out += extra;
+    out += "} ";
+}
+} // namespace
+
+size_t getThreadShard() {
+    static std::atomic<size_t> nextShard{0};
+    thread_local const size_t shard = nextShard.fetch_add(1, std::memory_order_relaxed) % METRIC_SHARD_COUNT;
+    return shard;
+}
+
+uint64_t ShardedCounter::get() const {
+    uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+LatencyHistogram::LatencyHistogram() : shards_(new Shard[METRIC_SHARD_COUNT]) {}
+
+size_t LatencyHistogram::getBucketIndex(uint64_t valueNs) {
+    if (valueNs < LINEAR_BUCKET_COUNT) {
+        return static_cast<size_t>(valueNs);
+    }
+
+    const int exponent = floorLog2(valueNs);
+    if (exponent > MAX_EXPONENT) {
+        return BUCKET_COUNT - 1;
+    }
+
+    // Старшие SUB_BUCKET_BITS бит после ведущей единицы - номер корзины внутри степени двойки
+    const auto subBucket = static_cast<size_t>(valueNs >> (exponent - SUB_BUCKET_BITS)) - SUB_BUCKET_COUNT;
+    const auto powerIndex = static_cast<size_t>(exponent - SUB_BUCKET_BITS - 1);
+    return LINEAR_BUCKET_COUNT + powerIndex * SUB_BUCKET_COUNT + subBucket;
+}
+
+uint64_t LatencyHistogram::getBucketLowerBound(size_t index) {
+    if (index < LINEAR_BUCKET_COUNT) {
+        return index;
+    }
+
+    const size_t offset = index - LINEAR_BUCKET_COUNT;
+    const int exponent = static_cast<int>(offset / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS + 1;
+    const uint64_t subBucket = offset % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + subBucket) << (exponent - SUB_BUCKET_BITS);
+}
+
+uint64_t LatencyHistogram::getBucketUpperBound(size_t index) {
+    if (index < LINEAR_BUCKET_COUNT) {
+        return index + 1;
+    }
+
+    const int exponent =
+        static_cast<int>((index - LINEAR_BUCKET_COUNT) / SUB_BUCKET_COUNT) + SUB_BUCKET_BITS + 1;
+    return getBucketLowerBound(index) + (uint64_t{1} << (exponent - SUB_BUCKET_BITS));
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+    const uint64_t valueNs = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+
+    Shard& shard = shards_[getThreadShard()];
+    shard.buckets[getBucketIndex(valueNs)].fetch_add(1, std::memory_order_relaxed);
+    shard.sumNs.fetch_add(valueNs, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const {
+    Snapshot snapshot;
+    snapshot.buckets.assign(BUCKET_COUNT, 0);
+
+    for (size_t i = 0; i < METRIC_SHARD_COUNT; ++i) {
+        const Shard& shard = shards_[i];
+        for (size_t bucket = 0; bucket < BUCKET_COUNT; ++bucket) {
+            snapshot.buckets[bucket] += shard.buckets[bucket].load(std::memory_order_relaxed);
+        }
+        snapshot.sumNs += shard.sumNs.load(std::memory_order_relaxed);
+    }
+
+    // Количество - сумма корзин, поэтому квантили с ним согласованы
+    for (const uint64_t bucketCount : snapshot.buckets) {
+        snapshot.count += bucketCount;
+    }
+    return snapshot;
+}
+
+Core::Ports::LatencySummary LatencyHistogram::getSummary() const {
+    const auto histogram = snapshot();
+    const auto quantile = [&histogram](double q) {
+        return std::chrono::nanoseconds(static_cast<int64_t>(histogram.getQuantileNs(q)));
+    };
+
+    Core::Ports::LatencySummary summary;
+    summary.count = histogram.count;
+    summary.sum = std::chrono::nanoseconds(static_cast<int64_t>(histogram.sumNs));
+    summary.p50 = quantile(0.5);
+    summary.p90 = quantile(0.9);
+    summary.p99 = quantile(0.99);
+    return summary;
+}
+
+double LatencyHistogram::Snapshot::getQuantileNs(double quantile) const {
+    if (count == 0) {
+        return 0.0;
+    }
+
+    const auto rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (size_t index = 0; index < buckets.size(); ++index) {
+        seen += buckets[index];
+        if (seen >= rank) {
+            return (static_cast<double>(getBucketLowerBound(index)) +
+                    static_cast<double>(getBucketUpperBound(index))) /
+                   2.0;
+        }
+    }
+    return static_cast<double>(getBucketLowerBound(buckets.size() - 1));
+}
+
+std::pair<MetricsRegistry::Metric*, bool> MetricsRegistry::findOrCreate(const std::string& name,
+                                                                        const std::string& help,
+                                                                        MetricType type,
+                                                                        const std::string& labels) {
+    Family* family = nullptr;
+    for (const auto& existing : families_) {
+        if (existing->name == name) {
+            family = existing.get();
+            break;
+        }
+    }
+
+    if (family == nullptr) {
+        families_.push_back(std::make_unique<Family>(Family{name, help, type, {}}));
+        family = families_.back().get();
+    } else if (family->type != type) {
+        throw std::invalid_argument("Метрика " + name + " уже зарегистрирована с другим типом");
+    }
+
+    for (const auto& metric : family->metrics) {
+        if (metric->labels == labels) {
+            return {metric.get(), false};
+        }
+    }
+
+    family->metrics.push_back(std::make_unique<Metric>());
+    family->metrics.back()->labels = labels;
+    return {family->metrics.back().get(), true};
+}
+
+Core::Ports::ICounter& MetricsRegistry::counter(const std::string& name,
+                                                const std::string& help,
+                                                const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [metric, created] = findOrCreate(name, help, MetricType::COUNTER, labels);
+    if (created) {
+        metric->counter = std::make_unique<ShardedCounter>();
+    } else if (!metric->counter) {
+        throw std::invalid_argument("Метрика " + name + " вычисляется при чтении");
+    }
+    return *metric->counter;
+}
+
+Core::Ports::IGauge& MetricsRegistry::gauge(const std::string& name,
+                                            const std::string& help,
+                                            const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [metric, created] = findOrCreate(name, help, MetricType::GAUGE, labels);
+    if (created) {
+        metric->gauge = std::make_unique<AtomicGauge>();
+    } else if (!metric->gauge) {
+        throw std::invalid_argument("Метрика " + name + " вычисляется при чтении");
+    }
+    return *metric->gauge;
+}
+
+Core::Ports::ILatencyHistogram& MetricsRegistry::histogram(const std::string& name,
+                                                           const std::string& help,
+                                                           const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [metric, created] = findOrCreate(name, help, MetricType::HISTOGRAM, labels);
+    if (created) {
+        metric->histogram = std::make_unique<LatencyHistogram>();
+    }
+    return *metric->histogram;
+}
+
+void MetricsRegistry::callback(const std::string& name,
+                               const std::string& help,
+                               bool isCounter,
+                               std::function<double()> read,
+                               const std::string& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto [metric, created] =
+        findOrCreate(name, help, isCounter ? MetricType::COUNTER : MetricType::GAUGE, labels);
+    if (!created) {
+        throw std::invalid_argument("Метрика " + name + " уже зарегистрирована");
+    }
+    metric->read = std::move(read);
+}
+
+std::string MetricsRegistry::render() const {
+    std::string out;
+    out.reserve(8192);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& family : families_) {
+        out += "# HELP ";
+        out += family->name;
+        out += ' ';
+        out += family->help;
+        out += "\n# TYPE ";
+        out += family->name;
+        switch (family->type) {
+        case MetricType::COUNTER:
+            out += " counter\n";
+            break;
+        case MetricType::GAUGE:
+            out += " gauge\n";
+            break;
+        case MetricType::HISTOGRAM:
+            out += " summary\n";
+            break;
+        }
+
+        for (const auto& metric : family->metrics) {
+            renderMetric(out, *family, *metric);
+        }
+    }
+    return out;
+}
+
+void MetricsRegistry::renderMetric(std::string& out, const Family& family, const Metric& metric) {
+    if (metric.read) {
+        appendSeries(out, family.name, metric.labels);
+        appendNumber(out, metric.read());
+        out += '\n';
+    } else if (metric.counter) {
+        appendSeries(out, family.name, metric.labels);
+        appendNumber(out, metric.counter->get());
+        out += '\n';
+    } else if (metric.gauge) {
+        appendSeries(out, family.name, metric.labels);
+        appendNumber(out, metric.gauge->get());
+        out += '\n';
+    } else if (metric.histogram) {
+        const auto snapshot = metric.histogram->snapshot();
+        for (const double quantile : SUMMARY_QUANTILES) {
+            std::string quantileLabel = "quantile=\"";
+            appendNumber(quantileLabel, quantile);
+            quantileLabel += '"';
+
+            appendSeries(out, family.name, metric.labels, quantileLabel);
+            appendNumber(out, snapshot.getQuantileNs(quantile) / NANOSECONDS_PER_SECOND);
+            out += '\n';
+        }
+        appendSeries(out, family.name + "_sum", metric.labels);
+        appendNumber(out, static_cast<double>(snapshot.sumNs) / NANOSECONDS_PER_SECOND);
+        out += '\n';
+        appendSeries(out, family.name + "_count", metric.labels);
+        appendNumber(out, snapshot.count);
+        out += '\n';
+    }
+}
+} // namespace Infrastructure::Metrics
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../Core/Ports/IMetricsRegistry.h"
+
+namespace Infrastructure::Metrics {
+// Шарды счётчиков и гистограмм: поток пишет в свой, чтение суммирует все
+constexpr size_t METRIC_SHARD_COUNT = 16;
+
+/**
+ * @brief Возвращает шард текущего потока
+ */
+size_t getThreadShard();
+
+/**
+ * @brief Счётчик с шардом на поток
+ *
+ * Запись - relaxed-инкремент в своей строке кеша, без блокировок и без
+ * конкуренции за строку с другими потоками (пока потоков не больше шардов).
+ */
+class ShardedCounter : public Core::Ports::ICounter {
+  public:
+    void add(uint64_t value = 1) override {
+        shards_[getThreadShard()].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t get() const override;
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> value{0};
+    };
+
+    std::array<Shard, METRIC_SHARD_COUNT> shards_;
+};
+
+/**
+ * @brief Текущее значение
+ */
+class AtomicGauge : public Core::Ports::IGauge {
+  public:
+    void add(int64_t delta) override {
+        value_.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    void set(int64_t value) override {
+        value_.store(value, std::memory_order_relaxed);
+    }
+
+    int64_t get() const override {
+        return value_.load(std::memory_order_relaxed);
+    }
+
+  private:
+    std::atomic<int64_t> value_{0};
+};
+
+/**
+ * @brief Гистограмма длительностей с логарифмически-линейными корзинами (как HdrHistogram)
+ *
+ * Каждая степень двойки наносекунд делится на 2^SUB_BUCKET_BITS равных корзин,
+ * поэтому ширина корзины не больше 1/8 её нижней границы при любой величине,
+ * от наносекунд до минут. Запись - relaxed-инкремент корзины и сложение суммы в шарде
+ * текущего потока; количество и квантили считаются только при чтении.
+ */
+class LatencyHistogram : public Core::Ports::ILatencyHistogram {
+  public:
+    static constexpr int SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t{1} << SUB_BUCKET_BITS;
+    // Значения меньше 2 * SUB_BUCKET_COUNT нс хранятся точно, по корзине на значение
+    static constexpr size_t LINEAR_BUCKET_COUNT = 2 * SUB_BUCKET_COUNT;
+    // Наибольшая степень двойки: 2^40 нс ~ 18 минут; большие значения попадают в последнюю корзину
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr size_t BUCKET_COUNT =
+        LINEAR_BUCKET_COUNT + (MAX_EXPONENT - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+    /**
+     * @brief Суммы по всем шардам
+     */
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t count = 0;
+        uint64_t sumNs = 0;
+
+        /**
+         * @brief Квантиль в наносекундах (середина корзины); 0 без записей
+         */
+        double getQuantileNs(double quantile) const;
+    };
+
+    LatencyHistogram();
+
+    void record(std::chrono::nanoseconds duration) override;
+
+    Core::Ports::LatencySummary getSummary() const override;
+
+    Snapshot snapshot() const;
+
+    static size_t getBucketIndex(uint64_t valueNs);
+
+    static uint64_t getBucketLowerBound(size_t index);
+
+    static uint64_t getBucketUpperBound(size_t index);
+
+  private:
+    struct alignas(64) Shard {
+        std::atomic<uint64_t> sumNs{0};
+        std::array<std::atomic<uint64_t>, BUCKET_COUNT> buckets{};
+    };
+
+    std::unique_ptr<Shard[]> shards_;
+};
+
+/**
+ * @brief Реестр метрик с выводом в текстовом формате Prometheus
+ *
+ * Регистрация и вывод идут под мьютексом, обновление метрик - без него.
+ * Гистограммы выводятся как summary: квантили 0.5, 0.9, 0.99, 0.999 с начала работы,
+ * сумма в секундах и количество.
+ */
+class MetricsRegistry : public Core::Ports::IMetricsRegistry {
+  public:
+    MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @throws std::invalid_argument если имя уже зарегистрировано с другим типом
+     */
+    Core::Ports::ICounter& counter(const std::string& name,
+                                   const std::string& help,
+                                   const std::string& labels = "") override;
+
+    Core::Ports::IGauge& gauge(const std::string& name,
+                               const std::string& help,
+                               const std::string& labels = "") override;
+
+    Core::Ports::ILatencyHistogram& histogram(const std::string& name,
+                                              const std::string& help,
+                                              const std::string& labels = "") override;
+
+    void callback(const std::string& name,
+                  const std::string& help,
+                  bool isCounter,
+                  std::function<double()> read,
+                  const std::string& labels = "") override;
+
+    std::string render() const override;
+
+  private:
+    enum class MetricType { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Metric {
+        std::string labels;
+        std::unique_ptr<ShardedCounter> counter;
+        std::unique_ptr<AtomicGauge> gauge;
+        std::unique_ptr<LatencyHistogram> histogram;
+        std::function<double()> read;
+    };
+
+    struct Family {
+        std::string name;
+        std::string help;
+        MetricType type;
+        std::vector<std::unique_ptr<Metric>> metrics;
+    };
+
+    mutable std::mutex mutex_;
+    std::vector<std::unique_ptr<Family>> families_;
+
+    /**
+     * @brief Находит или создаёт метрику (мьютекс должен быть захвачен)
+     * @return Метрика и признак того, что она только что создана
+     */
+    std::pair<Metric*, bool> findOrCreate(const std::string& name,
+                                          const std::string& help,
+                                          MetricType type,
+                                          const std::string& labels);
+
+    static void renderMetric(std::string& out, const Family& family, const Metric& metric);
+};
+} // namespace Infrastructure::Metrics
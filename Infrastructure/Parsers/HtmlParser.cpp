@@ -2,8 +2,12 @@
 
 #include <gumbo.h>
 
+#include "../../Core/Ports/ITracer.h"
+
 namespace Infrastructure::Parsers {
 std::string HtmlParser::extractText(const std::string& html) {
+    Core::Ports::TraceSpan span("html.text", "parse");
+
     // Парсим HTML с помощью Gumbo
     GumboOutput* output = gumbo_parse(html.c_str());
 
@@ -40,6 +44,8 @@ void HtmlParser::extractTextFromNode(void* nodePtr, std::string& text) {
 
 std::vector<std::string> HtmlParser::extractLinks(const std::string& html,
                                                   const std::string& baseUrl) {
+    Core::Ports::TraceSpan span("html.links", "parse");
+
     // Парсим HTML с помощью Gumbo
     GumboOutput* output = gumbo_parse(html.c_str());
 
@@ -31,6 +31,13 @@ class HtmlParser : public Core::Ports::IHtmlParser {
     std::vector<std::string> extractLinks(const std::string& html,
                                           const std::string& baseUrl) override;
 
+    /**
+     * @brief Преобразует относительный URL в абсолютный
+     * @param relativeUrl Ссылка со страницы ("/path", "page.html", "//host/path")
+     * @param baseUrl URL страницы
+     */
+    std::string resolveUrl(const std::string& relativeUrl, const std::string& baseUrl);
+
   private:
     /**
      * @brief Рекурсивно извлекает текст из узла Gumbo
@@ -44,11 +51,6 @@ class HtmlParser : public Core::Ports::IHtmlParser {
                               std::vector<std::string>& links,
                               const std::string& baseUrl);
 
-    /**
-     * @brief Преобразует относительный URL в абсолютный
-     */
-    std::string resolveUrl(const std::string& relativeUrl, const std::string& baseUrl);
-
     /**
      * @brief Проверяет, является ли URL абсолютным
      */
@@ -1,5 +1,7 @@
 #include "BoostLocaleTextProcessor.h"
 
+#include "../../Core/Ports/ITracer.h"
+
 namespace Infrastructure::Text {
 BoostLocaleTextProcessor::BoostLocaleTextProcessor(const std::string& localeName) {
     // Генерируем локаль
@@ -11,6 +13,8 @@ BoostLocaleTextProcessor::BoostLocaleTextProcessor(const std::string& localeName
 }
 
 std::string BoostLocaleTextProcessor::toLowercase(const std::string& text) {
+    Core::Ports::TraceSpan span("text.lowercase", "text");
+
     // Используем Boost.Locale для корректного приведения к нижнему регистру
     // с учётом правил локали (например, турецкий I -> ı, русский Ё -> ё)
     return boost::locale::to_lower(text, locale_);
@@ -24,6 +28,8 @@ std::string BoostLocaleTextProcessor::normalize(const std::string& text) {
     static constexpr size_t FIRST_CHAR_INDEX = 0;
     static constexpr size_t SINGLE_CHAR_COUNT = 1;
 
+    Core::Ports::TraceSpan span("text.normalize", "text");
+
     std::string result;
     result.reserve(text.size());
 
@@ -0,0 +1,129 @@
+#include "ChromeTraceWriter.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "../Http/JsonWriter.h"
+#include "../Logging/Logger.h"
+
+namespace Infrastructure::Tracing {
+namespace {
+// Время в файле - микросекунды; дробная часть сохраняет отрезки короче микросекунды
+constexpr int TIME_PRECISION = 15;
+
+int64_t toNanoseconds(Core::Ports::ITracer::Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+}
+
+double toMicroseconds(int64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1000.0;
+}
+} // namespace
+
+ChromeTraceWriter::ChromeTraceWriter(const std::string& filePath, uint64_t maxEvents) : maxEvents_(maxEvents) {
+    file_.reset(std::fopen(filePath.c_str(), "wb"));
+    if (!file_) {
+        throw std::runtime_error("Не удалось открыть файл трассировки: " + filePath);
+    }
+    std::fputs("[\n", file_.get());
+}
+
+ChromeTraceWriter::~ChromeTraceWriter() {
+    Core::Ports::ITracer* self = this;
+    Core::Ports::Tracing::activeTracer.compare_exchange_strong(self, nullptr);
+
+    flush();
+    std::fputs("\n]\n", file_.get());
+}
+
+void ChromeTraceWriter::recordSpan(const char* name,
+                                   const char* category,
+                                   std::string_view detail,
+                                   Clock::time_point start,
+                                   Clock::time_point end) {
+    const uint64_t index = eventCount_.fetch_add(1, std::memory_order_relaxed);
+    if (maxEvents_ != 0 && index >= maxEvents_) {
+        if (index == maxEvents_) {
+            LOG_WARNING("tracing", "Записано ", maxEvents_, " событий трассировки, дальнейшие не записываются");
+        }
+        return;
+    }
+
+    const uint32_t threadId = getThreadId();
+    Event event{name, category, std::string(detail), threadId, toNanoseconds(start - startedAt_),
+                toNanoseconds(end - start)};
+
+    std::vector<Event> full;
+    {
+        Shard& shard = shards_[threadId % SHARD_COUNT];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.events.push_back(std::move(event));
+        if (shard.events.size() >= SHARD_FLUSH_EVENTS) {
+            full.swap(shard.events);
+        }
+    }
+
+    if (!full.empty()) {
+        writeEvents(full);
+    }
+}
+
+uint64_t ChromeTraceWriter::getEventCount() const {
+    const uint64_t count = eventCount_.load(std::memory_order_relaxed);
+    return maxEvents_ != 0 ? std::min(count, maxEvents_) : count;
+}
+
+void ChromeTraceWriter::flush() {
+    for (auto& shard : shards_) {
+        std::vector<Event> events;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            events.swap(shard.events);
+        }
+        writeEvents(events);
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    std::fflush(file_.get());
+}
+
+void ChromeTraceWriter::writeEvents(std::vector<Event>& events) {
+    if (events.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(fileMutex_);
+    buffer_.clear();
+    for (const auto& event : events) {
+        if (hasWrittenEvents_) {
+            buffer_ += ",\n";
+        }
+        hasWrittenEvents_ = true;
+
+        Http::JsonWriter json(buffer_);
+        json.beginObject();
+        json.key("name").value(event.name);
+        json.key("cat").value(event.category);
+        json.key("ph").value("X");
+        json.key("pid").value(1);
+        json.key("tid").value(event.threadId);
+        json.key("ts").value(toMicroseconds(event.startNs), TIME_PRECISION);
+        json.key("dur").value(toMicroseconds(event.durationNs), TIME_PRECISION);
+        if (!event.detail.empty()) {
+            json.key("args").beginObject();
+            json.key("detail").value(event.detail);
+            json.endObject();
+        }
+        json.endObject();
+    }
+    std::fwrite(buffer_.data(), 1, buffer_.size(), file_.get());
+    events.clear();
+}
+
+uint32_t ChromeTraceWriter::getThreadId() {
+    static std::atomic<uint32_t> nextThreadId{1};
+    thread_local const uint32_t threadId = nextThreadId.fetch_add(1, std::memory_order_relaxed);
+    return threadId;
+}
+} // namespace Infrastructure::Tracing
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "../../Core/Ports/ITracer.h"
+
+namespace Infrastructure::Tracing {
+/**
+ * @brief Запись отрезков трассировки в файл формата Chrome Trace Event
+ *
+ * Файл - JSON-массив событий "X" (полный отрезок) с временем в микросекундах
+ * от создания объекта. Открывается в chrome://tracing и ui.perfetto.dev:
+ * по потокам видно, сколько страница провела в DNS, TLS, разборе HTML и
+ * каждом запросе к базе.
+ *
+ * События копятся в памяти по шардам (шард выбирается по потоку) и
+ * дописываются в файл пачками, так что потоки почти не ждут друг друга и
+ * диска. После maxEvents событий запись прекращается: трассировка
+ * длительного краулинга не заполняет диск.
+ */
+class ChromeTraceWriter : public Core::Ports::ITracer {
+  public:
+    /**
+     * @brief Конструктор
+     * @param filePath Файл трассировки (перезаписывается)
+     * @param maxEvents Сколько событий записать (0 - без ограничения)
+     * @throws std::runtime_error если файл не удалось открыть
+     */
+    ChromeTraceWriter(const std::string& filePath, uint64_t maxEvents);
+
+    /**
+     * @brief Дописывает накопленные события и закрывает JSON-массив
+     *
+     * Если трассировщик процесса - этот объект, трассировка выключается.
+     */
+    ~ChromeTraceWriter() override;
+
+    ChromeTraceWriter(const ChromeTraceWriter&) = delete;
+    ChromeTraceWriter& operator=(const ChromeTraceWriter&) = delete;
+
+    void recordSpan(const char* name,
+                    const char* category,
+                    std::string_view detail,
+                    Clock::time_point start,
+                    Clock::time_point end) override;
+
+    /**
+     * @brief Записано событий (включая ещё не сброшенные в файл)
+     */
+    uint64_t getEventCount() const;
+
+    /**
+     * @brief Дописывает в файл все накопленные события
+     */
+    void flush();
+
+  private:
+    static constexpr size_t SHARD_COUNT = 16;
+    // Событий в шарде, после которых шард дописывается в файл
+    static constexpr size_t SHARD_FLUSH_EVENTS = 4096;
+
+    struct Event {
+        const char* name;
+        const char* category;
+        std::string detail;
+        uint32_t threadId;
+        int64_t startNs;  // От создания объекта
+        int64_t durationNs;
+    };
+
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        std::vector<Event> events;
+    };
+
+    struct FileCloser {
+        void operator()(std::FILE* file) const {
+            std::fclose(file);
+        }
+    };
+
+    const Clock::time_point startedAt_ = Clock::now();
+    const uint64_t maxEvents_;
+    std::atomic<uint64_t> eventCount_{0};
+
+    std::array<Shard, SHARD_COUNT> shards_;
+
+    std::mutex fileMutex_;
+    std::unique_ptr<std::FILE, FileCloser> file_;
+    bool hasWrittenEvents_ = false;
+    std::string buffer_;  // Буфер форматирования, под fileMutex_
+
+    /**
+     * @brief Дописывает события в файл и очищает вектор
+     */
+    void writeEvents(std::vector<Event>& events);
+
+    /**
+     * @brief Номер вызывающего потока в трассировке (1, 2, ... в порядке первого отрезка)
+     */
+    static uint32_t getThreadId();
+};
+} // namespace Infrastructure::Tracing
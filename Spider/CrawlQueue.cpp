@@ -0,0 +1,211 @@
+#include "CrawlQueue.h"
+
+#include <vector>
+
+#include "../Core/Domain/Service/ContentHashService.h"
+#include "../Infrastructure/Logging/Logger.h"
+
+namespace {
+/**
+ * @brief Состояние очереди, зафиксированное для снимка хранилища
+ */
+class CapturedFrontier : public Core::Ports::IFrontierSnapshotSource {
+  public:
+    using VisitedBlocks = std::vector<std::shared_ptr<const std::vector<uint64_t>>>;
+
+    CapturedFrontier(std::vector<Core::Ports::FrontierEntry> inFlight,
+                     Core::Ports::FrontierSnapshot queued,
+                     VisitedBlocks visited)
+        : inFlight_(std::move(inFlight)), queued_(std::move(queued)), visited_(std::move(visited)) {}
+
+    void forEachPending(const std::function<void(const Core::Ports::FrontierEntry&)>& visitor) const override {
+        // URL в обработке тоже считаются необработанными: после аварии их нужно скачать снова
+        for (const auto& entry : inFlight_) {
+            visitor(entry);
+        }
+
+        queued_(visitor);
+    }
+
+    void forEachVisited(const std::function<void(uint64_t)>& visitor) const override {
+        for (const auto& block : visited_) {
+            for (const auto urlFingerprint : *block) {
+                visitor(urlFingerprint);
+            }
+        }
+    }
+
+  private:
+    std::vector<Core::Ports::FrontierEntry> inFlight_;
+    Core::Ports::FrontierSnapshot queued_;
+    VisitedBlocks visited_;
+};
+} // namespace
+
+CrawlQueue::CrawlQueue(std::unique_ptr<Core::Ports::IFrontierQueue> pending,
+                       std::shared_ptr<Core::Ports::ICrawlFrontierStore> store)
+    : queue_(std::move(pending)), store_(std::move(store)) {}
+
+void CrawlQueue::restore(const Core::Ports::RecoveredFrontier& frontier) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    visited_.reserve(frontier.visited.size());
+    for (const auto urlFingerprint : frontier.visited) {
+        markVisited(urlFingerprint);
+    }
+
+    // Состояние уже есть в хранилище, поэтому в журнал ничего не пишем. Рабочие
+    // потоки ещё не запущены, и запись на диск можно ждать под блокировкой
+    for (const auto& entry : frontier.pending) {
+        markVisited(fingerprint(entry.url));
+        queue_->push(entry);
+        if (auto waitForWrite = queue_->pendingWrite()) {
+            waitForWrite();
+        }
+    }
+
+    cv_.notify_all();
+}
+
+void CrawlQueue::push(const std::string& url, int depth) {
+    std::function<void()> waitForWrite;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // Проверяем, не обрабатывали ли мы уже этот URL
+        if (!markVisited(fingerprint(url))) {
+            return;
+        }
+
+        Core::Ports::FrontierEntry entry{url, depth};
+
+        if (store_) {
+            store_->appendEnqueued(entry);
+        }
+
+        queue_->push(std::move(entry));
+        waitForWrite = queue_->pendingWrite();
+
+        cv_.notify_one();
+    }
+
+    // Запись вытесненных URL на диск отстаёт: ждём её без блокировки, чтобы остальные
+    // потоки могли извлекать и завершать URL
+    if (waitForWrite) {
+        waitForWrite();
+    }
+}
+
+std::optional<std::pair<std::string, int>> CrawlQueue::pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::optional<Core::Ports::FrontierEntry> next;
+
+    while (true) {
+        // Пустая очередь без активных задач - новых URL уже не появится
+        cv_.wait(lock, [this] { return !queue_->empty() || activeCount_ == 0 || done_; });
+
+        // Следующий сегмент ещё читается с диска: ждём без блокировки, чтобы
+        // остальные потоки могли добавлять и завершать URL
+        if (auto waitForRead = queue_->pendingRead()) {
+            lock.unlock();
+            waitForRead();
+            lock.lock();
+            continue;
+        }
+
+        try {
+            next = queue_->pop();
+            break;
+        } catch (const std::exception& e) {
+            // Нечитаемый сегмент очередь уже выбросила: продолжаем со следующими URL
+            LOG_ERROR("spider", "Ошибка чтения очереди краулинга, часть URL пропущена: ", e.what());
+        }
+    }
+
+    if (!next.has_value()) {
+        done_ = true;
+        cv_.notify_all();
+        return std::nullopt;
+    }
+
+    auto entry = std::move(next.value());
+    activeCount_++;
+
+    if (store_) {
+        inFlight_.emplace(fingerprint(entry.url), entry);
+    }
+
+    return std::make_pair(std::move(entry.url), entry.depth);
+}
+
+void CrawlQueue::markCompleted(const std::string& url) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    activeCount_--;
+
+    if (store_) {
+        const auto urlFingerprint = fingerprint(url);
+        inFlight_.erase(urlFingerprint);
+        store_->appendCompleted(urlFingerprint);
+
+        // Состояние фиксируется под блокировкой очереди, чтобы снимок совпал с позицией
+        // в журнале; на диск его пишет фоновый поток хранилища
+        if (store_->isCompactionDue()) {
+            store_->compact(captureSnapshot());
+        }
+    }
+
+    // Если очередь пуста и нет активных задач - работа завершена
+    if (queue_->empty() && activeCount_ == 0) {
+        done_ = true;
+        cv_.notify_all();
+    }
+}
+
+bool CrawlQueue::isDone() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return done_ && queue_->empty() && activeCount_ == 0;
+}
+
+size_t CrawlQueue::getVisitedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return visited_.size();
+}
+
+size_t CrawlQueue::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_->size() + static_cast<size_t>(activeCount_);
+}
+
+uint64_t CrawlQueue::fingerprint(const std::string& url) {
+    return Core::Domain::Service::ContentHashService::hash(url);
+}
+
+bool CrawlQueue::markVisited(uint64_t urlFingerprint) {
+    if (!visited_.insert(urlFingerprint).second) {
+        return false;
+    }
+
+    if (store_) {
+        visitedTail_.push_back(urlFingerprint);
+        if (visitedTail_.size() == VISITED_BLOCK_SIZE) {
+            visitedBlocks_.push_back(std::make_shared<const std::vector<uint64_t>>(std::move(visitedTail_)));
+            visitedTail_.clear();
+            visitedTail_.reserve(VISITED_BLOCK_SIZE);
+        }
+    }
+    return true;
+}
+
+std::shared_ptr<const Core::Ports::IFrontierSnapshotSource> CrawlQueue::captureSnapshot() const {
+    std::vector<Core::Ports::FrontierEntry> inFlight;
+    inFlight.reserve(inFlight_.size());
+    for (const auto& [urlFingerprint, entry] : inFlight_) {
+        inFlight.push_back(entry);
+    }
+
+    // Копируется только неполный последний блок отпечатков
+    auto visitedBlocks = visitedBlocks_;
+    visitedBlocks.push_back(std::make_shared<const std::vector<uint64_t>>(visitedTail_));
+
+    return std::make_shared<CapturedFrontier>(std::move(inFlight), queue_->snapshot(), std::move(visitedBlocks));
+}
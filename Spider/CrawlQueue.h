@@ -0,0 +1,107 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "../Core/Ports/ICrawlFrontierStore.h"
+#include "../Core/Ports/IFrontierQueue.h"
+
+/**
+ * @brief Многопоточная очередь URL для краулинга
+ *
+ * Посещённые URL хранятся в виде 64-битных отпечатков (XXH64), а не строк.
+ * Сами ожидающие URL хранит IFrontierQueue (может вытеснять их на диск).
+ * Если задано хранилище, каждая постановка и завершение записываются в его
+ * журнал, и после перезапуска краулинг продолжается с места остановки.
+ */
+class CrawlQueue {
+  public:
+    /**
+     * @brief Конструктор
+     * @param pending Хранилище ожидающих URL
+     * @param store Персистентное хранилище очереди (nullptr - без журнала)
+     */
+    explicit CrawlQueue(std::unique_ptr<Core::Ports::IFrontierQueue> pending,
+                        std::shared_ptr<Core::Ports::ICrawlFrontierStore> store = nullptr);
+
+    /**
+     * @brief Загружает состояние, восстановленное из хранилища
+     */
+    void restore(const Core::Ports::RecoveredFrontier& frontier);
+
+    /**
+     * @brief Добавляет URL в очередь с указанной глубиной
+     *
+     * Если запись вытесненных на диск URL отстаёт, ждёт её без блокировки очереди.
+     */
+    void push(const std::string& url, int depth);
+
+    /**
+     * @brief Извлекает URL из очереди (блокирующая операция)
+     *
+     * Чтение вытесненных на диск URL ожидается без блокировки очереди. Ошибка чтения
+     * пишется в журнал: URL нечитаемого сегмента пропускаются, краулинг продолжается.
+     * @return Пара {url, depth} или nullopt если очередь пуста и работа завершена
+     */
+    std::optional<std::pair<std::string, int>> pop();
+
+    /**
+     * @brief Отмечает завершение обработки URL, полученного из pop()
+     */
+    void markCompleted(const std::string& url);
+
+    /**
+     * @brief Проверяет, завершена ли работа
+     */
+    bool isDone() const;
+
+    /**
+     * @brief Получить количество обработанных URL
+     */
+    size_t getVisitedCount() const;
+
+    /**
+     * @brief Получить количество URL, ожидающих обработки
+     */
+    size_t getPendingCount() const;
+
+  private:
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unique_ptr<Core::Ports::IFrontierQueue> queue_;
+    std::unordered_set<uint64_t> visited_;                              // Отпечатки URL
+    std::unordered_map<uint64_t, Core::Ports::FrontierEntry> inFlight_;  // Выданы потокам, не завершены
+    std::shared_ptr<Core::Ports::ICrawlFrontierStore> store_;
+
+    // Те же отпечатки подряд, для снимков (только с хранилищем): заполненные блоки
+    // не меняются и передаются в снимок без копирования
+    static constexpr size_t VISITED_BLOCK_SIZE = 65536;
+    std::vector<std::shared_ptr<const std::vector<uint64_t>>> visitedBlocks_;
+    std::vector<uint64_t> visitedTail_;
+
+    int activeCount_ = 0;
+    bool done_ = false;
+
+    static uint64_t fingerprint(const std::string& url);
+
+    /**
+     * @brief Отмечает отпечаток посещённым
+     * @return false, если URL уже был посещён
+     */
+    bool markVisited(uint64_t urlFingerprint);
+
+    /**
+     * @brief Фиксирует состояние очереди для снимка (mutex_ должен быть захвачен)
+     *
+     * Копирует отпечатки и URL в памяти; хранилище пишет снимок в фоне, не держа mutex_.
+     */
+    std::shared_ptr<const Core::Ports::IFrontierSnapshotSource> captureSnapshot() const;
+};
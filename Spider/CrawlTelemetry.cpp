@@ -0,0 +1,303 @@
+#include "CrawlTelemetry.h"
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+#include "../Core/Application/UseCases/IndexPageUseCase.h"
+#include "../Core/Domain/ValueObject/Url.h"
+
+namespace {
+// Хостов в списке самых медленных на странице /status
+constexpr size_t STATUS_SLOWEST_HOSTS = 5;
+
+// Этапы краулинга в порядке обработки страницы
+constexpr const char* CRAWL_STAGES[] = {"fetch", "parse", "index", "db", "links"};
+
+/**
+ * @brief Дописывает форматированную строку
+ *
+ * snprintf не зависит от глобальной локали (её меняет Boost.Locale), поэтому
+ * числа выводятся с точкой и без разделителей разрядов.
+ */
+void appendFormat(std::string& out, const char* format, ...) {
+    char buffer[256];
+    va_list args;
+    va_start(args, format);
+    const int length = std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (length > 0) {
+        out.append(buffer, std::min(static_cast<size_t>(length), sizeof(buffer) - 1));
+    }
+}
+
+double toMilliseconds(std::chrono::nanoseconds duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+/**
+ * @brief Значение метки: кавычки и обратная косая черта заменяются
+ */
+std::string toLabelValue(const std::string& value) {
+    std::string result = value;
+    std::replace(result.begin(), result.end(), '"', '_');
+    std::replace(result.begin(), result.end(), '\\', '_');
+    return result;
+}
+} // namespace
+
+CrawlTelemetry::CrawlTelemetry(std::shared_ptr<Core::Ports::IMetricsRegistry> registry)
+    : registry_(std::move(registry)) {
+    for (size_t i = 0; i < PAGE_RESULT_COUNT; ++i) {
+        const std::string result = getPageResultName(static_cast<PageResult>(i));
+        pages_[i] = &registry_->counter("spider_pages_total", "Processed URLs by result",
+                                        "result=\"" + result + "\"");
+    }
+    for (size_t i = 0; i < ERROR_CLASS_COUNT; ++i) {
+        const std::string errorClass = getErrorClassName(static_cast<ErrorClass>(i));
+        errors_[i] = &registry_->counter("spider_errors_total", "Crawl errors by class",
+                                         "class=\"" + errorClass + "\"");
+    }
+    bytes_ = &registry_->counter("spider_downloaded_bytes_total", "Downloaded response body bytes");
+    activeWorkers_ = &registry_->gauge("spider_active_workers", "Workers processing a URL");
+    frontierDepth_ = &registry_->gauge("spider_frontier_pending", "URLs waiting in the crawl frontier");
+
+    using Core::Application::UseCases::IndexPageUseCase;
+    fetchLatency_ = IndexPageUseCase::getStageLatency(registry_.get(), "fetch");
+    linksLatency_ = IndexPageUseCase::getStageLatency(registry_.get(), "links");
+    otherHostsLatency_ = &registry_->histogram("spider_host_fetch_duration_seconds",
+                                               "Page download time by host", "host=\"other\"");
+}
+
+CrawlTelemetry::~CrawlTelemetry() {
+    {
+        std::lock_guard<std::mutex> lock(summaryMutex_);
+        stopSummary_ = true;
+    }
+    summaryCv_.notify_all();
+
+    if (summaryThread_.joinable()) {
+        summaryThread_.join();
+    }
+}
+
+void CrawlTelemetry::recordFetch(const std::string& url, std::chrono::nanoseconds duration, size_t bytes) {
+    fetchLatency_->record(duration);
+    getHostLatency(url)->record(duration);
+    bytes_->add(bytes);
+}
+
+void CrawlTelemetry::recordPage(PageResult result) {
+    pages_[static_cast<size_t>(result)]->add();
+}
+
+void CrawlTelemetry::recordError(ErrorClass errorClass) {
+    errors_[static_cast<size_t>(errorClass)]->add();
+}
+
+uint64_t CrawlTelemetry::getPageCount(PageResult result) const {
+    return pages_[static_cast<size_t>(result)]->get();
+}
+
+uint64_t CrawlTelemetry::getErrorCount() const {
+    uint64_t total = 0;
+    for (const auto* counter : errors_) {
+        total += counter->get();
+    }
+    return total;
+}
+
+Core::Ports::ILatencyHistogram* CrawlTelemetry::getHostLatency(const std::string& url) {
+    const auto parsedUrl = Core::Domain::ValueObject::Url::create(url);
+    if (!parsedUrl.has_value()) {
+        return otherHostsLatency_;
+    }
+    const std::string& host = parsedUrl->getHost();
+
+    std::lock_guard<std::mutex> lock(hostsMutex_);
+    const auto it = hostLatency_.find(host);
+    if (it != hostLatency_.end()) {
+        return it->second;
+    }
+    if (hostLatency_.size() >= MAX_TRACKED_HOSTS) {
+        return otherHostsLatency_;
+    }
+
+    auto* histogram = &registry_->histogram("spider_host_fetch_duration_seconds", "Page download time by host",
+                                            "host=\"" + toLabelValue(host) + "\"");
+    hostLatency_.emplace(host, histogram);
+    return histogram;
+}
+
+uint64_t CrawlTelemetry::getTotalPages() const {
+    uint64_t total = 0;
+    for (const auto* counter : pages_) {
+        total += counter->get();
+    }
+    return total;
+}
+
+CrawlTelemetry::Rates CrawlTelemetry::getRates() const {
+    std::lock_guard<std::mutex> lock(ratesMutex_);
+    if (hasRates_) {
+        return lastRates_;
+    }
+
+    const double seconds = std::chrono::duration<double>(Clock::now() - startedAt_).count();
+    Rates rates;
+    if (seconds > 0.0) {
+        rates.pagesPerSecond = static_cast<double>(getTotalPages()) / seconds;
+        rates.bytesPerSecond = static_cast<double>(bytes_->get()) / seconds;
+    }
+    return rates;
+}
+
+std::string CrawlTelemetry::takeSummaryLine() {
+    const auto now = Clock::now();
+    const uint64_t pages = getTotalPages();
+    const uint64_t bytes = bytes_->get();
+
+    uint64_t newPages = 0;
+    Rates rates;
+    {
+        std::lock_guard<std::mutex> lock(ratesMutex_);
+        const double seconds = std::chrono::duration<double>(now - lastSummaryAt_).count();
+        newPages = pages - lastPages_;
+        if (seconds > 0.0) {
+            rates.pagesPerSecond = static_cast<double>(newPages) / seconds;
+            rates.bytesPerSecond = static_cast<double>(bytes - lastBytes_) / seconds;
+        }
+
+        lastSummaryAt_ = now;
+        lastPages_ = pages;
+        lastBytes_ = bytes;
+        lastRates_ = rates;
+        hasRates_ = true;
+    }
+
+    const auto fetch = fetchLatency_->getSummary();
+
+    std::string line;
+    appendFormat(line,
+                 "[Сводка] страниц: %llu (+%llu), %.1f страниц/с, %.1f КБ/с, очередь: %lld, "
+                 "активных потоков: %lld, ошибок: %llu, скачивание p90: %.0f мс",
+                 static_cast<unsigned long long>(pages), static_cast<unsigned long long>(newPages),
+                 rates.pagesPerSecond, rates.bytesPerSecond / 1024.0,
+                 static_cast<long long>(frontierDepth_->get()), static_cast<long long>(activeWorkers_->get()),
+                 static_cast<unsigned long long>(getErrorCount()), toMilliseconds(fetch.p90));
+    return line;
+}
+
+std::string CrawlTelemetry::renderStatus() const {
+    const Rates rates = getRates();
+    const auto uptime = std::chrono::duration_cast<std::chrono::seconds>(Clock::now() - startedAt_);
+
+    std::string status;
+    status.reserve(2048);
+
+    appendFormat(status, "Spider работает %lld с\n\n", static_cast<long long>(uptime.count()));
+    appendFormat(status, "Страниц: %llu (проиндексировано %llu, без изменений %llu, не изменились по 304: %llu, "
+                         "ошибок %llu)\n",
+                 static_cast<unsigned long long>(getTotalPages()),
+                 static_cast<unsigned long long>(getPageCount(PageResult::INDEXED)),
+                 static_cast<unsigned long long>(getPageCount(PageResult::UNCHANGED)),
+                 static_cast<unsigned long long>(getPageCount(PageResult::NOT_MODIFIED)),
+                 static_cast<unsigned long long>(getPageCount(PageResult::FAILED)));
+    appendFormat(status, "Скорость: %.1f страниц/с, %.1f КБ/с\n", rates.pagesPerSecond,
+                 rates.bytesPerSecond / 1024.0);
+    appendFormat(status, "Скачано: %.1f МБ\n", static_cast<double>(bytes_->get()) / (1024.0 * 1024.0));
+    appendFormat(status, "Очередь: %lld, активных потоков: %lld\n\n",
+                 static_cast<long long>(frontierDepth_->get()), static_cast<long long>(activeWorkers_->get()));
+
+    status += "Этапы (среднее / p50 / p90 / p99, мс):\n";
+    for (const char* stage : CRAWL_STAGES) {
+        const auto* histogram =
+            Core::Application::UseCases::IndexPageUseCase::getStageLatency(registry_.get(), stage);
+        const auto summary = histogram->getSummary();
+        appendFormat(status, "  %-6s %9.1f / %9.1f / %9.1f / %9.1f  (%llu)\n", stage,
+                     toMilliseconds(summary.getMean()), toMilliseconds(summary.p50), toMilliseconds(summary.p90),
+                     toMilliseconds(summary.p99), static_cast<unsigned long long>(summary.count));
+    }
+
+    status += "\nОшибки:\n";
+    for (size_t i = 0; i < ERROR_CLASS_COUNT; ++i) {
+        appendFormat(status, "  %-12s %llu\n", getErrorClassName(static_cast<ErrorClass>(i)),
+                     static_cast<unsigned long long>(errors_[i]->get()));
+    }
+
+    // Сводки считаются вне мьютекса: список хостов только растёт, гистограммы живут, пока жив реестр
+    std::vector<std::pair<std::string, const Core::Ports::ILatencyHistogram*>> hosts;
+    {
+        std::lock_guard<std::mutex> lock(hostsMutex_);
+        hosts.assign(hostLatency_.begin(), hostLatency_.end());
+    }
+    hosts.emplace_back("other", otherHostsLatency_);
+
+    std::vector<std::pair<std::string, Core::Ports::LatencySummary>> summaries;
+    summaries.reserve(hosts.size());
+    for (const auto& [host, histogram] : hosts) {
+        auto summary = histogram->getSummary();
+        if (summary.count > 0) {
+            summaries.emplace_back(host, summary);
+        }
+    }
+    std::sort(summaries.begin(), summaries.end(),
+              [](const auto& left, const auto& right) { return left.second.p90 > right.second.p90; });
+    summaries.resize(std::min(summaries.size(), STATUS_SLOWEST_HOSTS));
+
+    status += "\nСамые медленные хосты (p90 скачивания, мс):\n";
+    for (const auto& [host, summary] : summaries) {
+        appendFormat(status, "  %9.1f  %s (%llu)\n", toMilliseconds(summary.p90), host.c_str(),
+                     static_cast<unsigned long long>(summary.count));
+    }
+
+    return status;
+}
+
+void CrawlTelemetry::startSummary(std::chrono::seconds interval) {
+    if (interval.count() <= 0 || summaryThread_.joinable()) {
+        return;
+    }
+
+    summaryThread_ = std::thread([this, interval] {
+        std::unique_lock<std::mutex> lock(summaryMutex_);
+        while (!summaryCv_.wait_for(lock, interval, [this] { return stopSummary_; })) {
+            lock.unlock();
+            std::cout << takeSummaryLine() << std::endl;
+            lock.lock();
+        }
+    });
+}
+
+const char* CrawlTelemetry::getPageResultName(PageResult result) {
+    switch (result) {
+    case PageResult::INDEXED:
+        return "indexed";
+    case PageResult::UNCHANGED:
+        return "unchanged";
+    case PageResult::NOT_MODIFIED:
+        return "not_modified";
+    case PageResult::FAILED:
+        return "failed";
+    }
+    return "unknown";
+}
+
+const char* CrawlTelemetry::getErrorClassName(ErrorClass errorClass) {
+    switch (errorClass) {
+    case ErrorClass::NETWORK:
+        return "network";
+    case ErrorClass::HTTP_STATUS:
+        return "http_status";
+    case ErrorClass::INDEX:
+        return "index";
+    case ErrorClass::EXCEPTION:
+        return "exception";
+    case ErrorClass::REVISIT:
+        return "revisit";
+    }
+    return "unknown";
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "../Core/Ports/IMetricsRegistry.h"
+
+/**
+ * @brief Телеметрия краулинга: счётчики в реестре метрик, страница /status и периодическая сводка
+ *
+ * Потоки краулера отмечают результат каждой страницы, скачанные байты, время
+ * этапов и ошибки по классам. Время скачивания учитывается и по хостам: первые
+ * MAX_TRACKED_HOSTS хостов - каждый отдельно, остальные - вместе, под host="other".
+ *
+ * Скорости (страниц и байт в секунду) считаются по разнице счётчиков между
+ * двумя сводками; до первой сводки - с начала работы.
+ */
+class CrawlTelemetry {
+  public:
+    enum class PageResult { INDEXED, UNCHANGED, NOT_MODIFIED, FAILED };
+
+    enum class ErrorClass {
+        NETWORK,      // Соединение не установлено или оборвалось
+        HTTP_STATUS,  // Сервер ответил ошибкой
+        INDEX,        // Страница скачана, но не проиндексирована
+        EXCEPTION,    // Исключение при обработке URL
+        REVISIT       // Не удалось обновить расписание повторного посещения
+    };
+
+    static constexpr size_t MAX_TRACKED_HOSTS = 32;
+
+    /**
+     * @brief Конструктор
+     * @param registry Реестр метрик (общий с IndexPageUseCase и сервером /metrics)
+     */
+    explicit CrawlTelemetry(std::shared_ptr<Core::Ports::IMetricsRegistry> registry);
+
+    ~CrawlTelemetry();
+
+    CrawlTelemetry(const CrawlTelemetry&) = delete;
+    CrawlTelemetry& operator=(const CrawlTelemetry&) = delete;
+
+    /**
+     * @brief Учитывает скачивание страницы
+     * @param url URL страницы (по нему определяется хост)
+     * @param duration Время запроса
+     * @param bytes Размер тела ответа
+     */
+    void recordFetch(const std::string& url, std::chrono::nanoseconds duration, size_t bytes);
+
+    void recordPage(PageResult result);
+
+    void recordError(ErrorClass errorClass);
+
+    /**
+     * @brief Гистограмма извлечения ссылок со страницы
+     */
+    Core::Ports::ILatencyHistogram* getLinksLatency() const {
+        return linksLatency_;
+    }
+
+    void onWorkerBusy() {
+        activeWorkers_->add(1);
+    }
+
+    void onWorkerIdle() {
+        activeWorkers_->add(-1);
+    }
+
+    void setFrontierDepth(size_t depth) {
+        frontierDepth_->set(static_cast<int64_t>(depth));
+    }
+
+    uint64_t getPageCount(PageResult result) const;
+
+    uint64_t getErrorCount() const;
+
+    /**
+     * @brief Состояние краулинга для /status (текст)
+     */
+    std::string renderStatus() const;
+
+    /**
+     * @brief Строка сводки со скоростями с прошлой сводки
+     */
+    std::string takeSummaryLine();
+
+    /**
+     * @brief Запускает вывод сводки в std::cout раз в interval (до уничтожения объекта)
+     */
+    void startSummary(std::chrono::seconds interval);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr size_t PAGE_RESULT_COUNT = 4;
+    static constexpr size_t ERROR_CLASS_COUNT = 5;
+
+    /**
+     * @brief Скорости за последний интервал сводки
+     */
+    struct Rates {
+        double pagesPerSecond = 0.0;
+        double bytesPerSecond = 0.0;
+    };
+
+    std::shared_ptr<Core::Ports::IMetricsRegistry> registry_;
+    std::array<Core::Ports::ICounter*, PAGE_RESULT_COUNT> pages_{};
+    std::array<Core::Ports::ICounter*, ERROR_CLASS_COUNT> errors_{};
+    Core::Ports::ICounter* bytes_ = nullptr;
+    Core::Ports::IGauge* activeWorkers_ = nullptr;
+    Core::Ports::IGauge* frontierDepth_ = nullptr;
+    Core::Ports::ILatencyHistogram* fetchLatency_ = nullptr;
+    Core::Ports::ILatencyHistogram* linksLatency_ = nullptr;
+
+    // Гистограммы скачивания по хостам; хост ищется под мьютексом один раз на страницу
+    mutable std::mutex hostsMutex_;
+    std::unordered_map<std::string, Core::Ports::ILatencyHistogram*> hostLatency_;
+    Core::Ports::ILatencyHistogram* otherHostsLatency_ = nullptr;
+
+    // Начало работы и последняя сводка
+    const Clock::time_point startedAt_ = Clock::now();
+    mutable std::mutex ratesMutex_;
+    Clock::time_point lastSummaryAt_ = startedAt_;
+    uint64_t lastPages_ = 0;
+    uint64_t lastBytes_ = 0;
+    Rates lastRates_;
+    bool hasRates_ = false;
+
+    // Поток периодической сводки
+    std::mutex summaryMutex_;
+    std::condition_variable summaryCv_;
+    bool stopSummary_ = false;
+    std::thread summaryThread_;
+
+    Core::Ports::ILatencyHistogram* getHostLatency(const std::string& url);
+
+    uint64_t getTotalPages() const;
+
+    /**
+     * @brief Скорости с прошлой сводки (или с начала работы, если сводок не было)
+     */
+    Rates getRates() const;
+
+    static const char* getPageResultName(PageResult result);
+
+    static const char* getErrorClassName(ErrorClass errorClass);
+};
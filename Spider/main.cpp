@@ -1,95 +1,56 @@
-#include <condition_variable>
+#include <algorithm>
+#include <chrono>
 #include <iostream>
-#include <mutex>
-#include <queue>
-#include <set>
+#include <memory>
+#include <string>
 #include <thread>
 #include <vector>
 
 #include <windows.h>
 
+#include "CrawlQueue.h"
+#include "CrawlTelemetry.h"
+#include "../Core/Ports/ITracer.h"
 #include "../Infrastructure/Http/BoostBeastHttpClient.h"
+#include "../Infrastructure/Logging/Logger.h"
 #include "../Infrastructure/Parsers/HtmlParser.h"
 #include "../SpiderData/DIContainer.h"
 
+using PageResult = CrawlTelemetry::PageResult;
+using ErrorClass = CrawlTelemetry::ErrorClass;
+
 /**
- * @brief Многопоточная очередь URL для краулинга
+ * @brief Встроенный HTTP-сервер состояния краулинга (/status и /metrics)
+ *
+ * Работает в своём потоке, пока жив объект.
  */
-class CrawlQueue {
+class StatusServer {
   public:
-    /**
-     * @brief Добавляет URL в очередь с указанной глубиной
-     */
-    void push(const std::string& url, int depth) {
-        std::lock_guard<std::mutex> lock(mutex_);
-
-        // Проверяем, не обрабатывали ли мы уже этот URL
-        if (visited_.count(url) > 0) {
-            return;
-        }
-
-        queue_.push({url, depth});
-        visited_.insert(url);
-        cv_.notify_one();
-    }
-
-    /**
-     * @brief Извлекает URL из очереди (блокирующая операция)
-     * @return Пара {url, depth} или nullopt если очередь пуста и работа завершена
-     */
-    std::optional<std::pair<std::string, int>> pop() {
-        std::unique_lock<std::mutex> lock(mutex_);
-
-        cv_.wait(lock, [this] { return !queue_.empty() || done_; });
-
-        if (queue_.empty()) {
-            return std::nullopt;
-        }
-
-        auto item = queue_.front();
-        queue_.pop();
-        activeCount_++;
-
-        return item;
-    }
-
-    /**
-     * @brief Отмечает завершение обработки одного URL
-     */
-    void markCompleted() {
-        std::lock_guard<std::mutex> lock(mutex_);
-        activeCount_--;
-
-        // Если очередь пуста и нет активных задач - работа завершена
-        if (queue_.empty() && activeCount_ == 0) {
-            done_ = true;
-            cv_.notify_all();
-        }
+    StatusServer(std::shared_ptr<Core::Ports::IHttpServer> server,
+                 int port,
+                 std::shared_ptr<CrawlTelemetry> telemetry)
+        : server_(std::move(server)) {
+        thread_ = std::thread([this, port, telemetry = std::move(telemetry)] {
+            server_->start(port, [telemetry](const Core::Ports::HttpRequestView& request) {
+                if (request.method == "GET" && request.target == "/status") {
+                    return Core::Ports::HttpResponse::text(telemetry->renderStatus());
+                }
+                return Core::Ports::HttpResponse::text("Not found\n", 404);
+            });
+        });
     }
 
-    /**
-     * @brief Проверяет, завершена ли работа
-     */
-    bool isDone() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return done_ && queue_.empty() && activeCount_ == 0;
+    ~StatusServer() {
+        server_->stop();
+        thread_.join();
     }
 
-    /**
-     * @brief Получить количество обработанных URL
-     */
-    size_t getVisitedCount() const {
-        std::lock_guard<std::mutex> lock(mutex_);
-        return visited_.size();
-    }
+    StatusServer(const StatusServer&) = delete;
+    StatusServer& operator=(const StatusServer&) = delete;
 
   private:
-    mutable std::mutex mutex_;
-    std::condition_variable cv_;
-    std::queue<std::pair<std::string, int>> queue_;  // {url, depth}
-    std::set<std::string> visited_;
-    int activeCount_ = 0;
-    bool done_ = false;
+    std::shared_ptr<Core::Ports::IHttpServer> server_;
+    std::thread thread_;
 };
 
 /**
@@ -98,17 +59,22 @@ class CrawlQueue {
 class CrawlerWorker {
   public:
     CrawlerWorker(int workerId, std::shared_ptr<CrawlQueue> queue,
+                  std::shared_ptr<CrawlTelemetry> telemetry,
                   std::shared_ptr<Core::Application::UseCases::IndexPageUseCase> indexPageUseCase,
                   std::shared_ptr<Core::Ports::IHttpClient> httpClient,
-                  std::shared_ptr<Core::Ports::IHtmlParser> htmlParser, int maxDepth)
+                  std::shared_ptr<Core::Ports::IHtmlParser> htmlParser,
+                  std::shared_ptr<Core::Application::UseCases::ScheduleRevisitUseCase> scheduleRevisitUseCase,
+                  int maxDepth)
         : workerId_(workerId),
           queue_(std::move(queue)),
+          telemetry_(std::move(telemetry)),
           indexPageUseCase_(std::move(indexPageUseCase)),
           httpClient_(std::move(httpClient)),
           htmlParser_(std::move(htmlParser)),
+          scheduleRevisitUseCase_(std::move(scheduleRevisitUseCase)),
           maxDepth_(maxDepth) {
-        // Устанавливаем ID потока для логирования в HTTP клиенте
-        httpClient_->setWorkerId(workerId_);
+        // Рабочий объект создаётся в своём потоке: записи журнала этого потока помечаются его номером
+        Infrastructure::Logging::setThreadName("Поток " + std::to_string(workerId_));
     }
 
     void run() {
@@ -120,45 +86,83 @@ class CrawlerWorker {
             }
 
             const auto& [url, depth] = item.value();
+            telemetry_->setFrontierDepth(queue_->getPendingCount());
+            telemetry_->onWorkerBusy();
 
             try {
                 processUrl(url, depth);
             } catch (const std::exception& e) {
-                std::cerr << "[Поток " << workerId_ << "] Ошибка при обработке " << url << ": " << e.what() << "\n";
+                telemetry_->recordPage(PageResult::FAILED);
+                telemetry_->recordError(ErrorClass::EXCEPTION);
+                LOG_ERROR("spider", "Ошибка при обработке ", url, ": ", e.what());
             }
 
-            queue_->markCompleted();
+            telemetry_->onWorkerIdle();
+            queue_->markCompleted(url);
         }
     }
 
   private:
+    // Об успешно обработанных URL не пишем: их счётчики - в периодической сводке и на /status
     void processUrl(const std::string& url, int depth) {
-        std::cout << "[Поток " << workerId_ << "] Обработка [глубина " << depth << "]: " << url << "\n";
-
-        // Скачиваем страницу
-        auto htmlContent = httpClient_->get(url);
+        // Отрезок всей страницы: в трассировке под ним - скачивание, разбор, индексация и запросы к базе
+        Core::Ports::TraceSpan pageSpan("page", "spider", url);
+
+        // Страницу на последнем уровне скачиваем условным запросом с валидаторами прошлого
+        // краулинга. Остальным нужны ссылки: очередь строится заново при каждом запуске,
+        // и ответ 304 без тела оборвал бы обход под страницей. Их переиндексацию
+        // по-прежнему отсекает сравнение хеша в IndexPageUseCase
+        Core::DTO::CacheValidatorsDTO validators;
+        if (depth >= maxDepth_) {
+            validators = indexPageUseCase_->getCacheValidators(url);
+        }
+        const auto fetchStartedAt = std::chrono::steady_clock::now();
+        auto response = httpClient_->fetch(url, validators);
+        telemetry_->recordFetch(url, std::chrono::steady_clock::now() - fetchStartedAt, response.body.size());
+
+        if (response.isNotModified()) {
+            // 304: страница не изменилась, тело не передавалось - индексировать нечего
+            telemetry_->recordPage(PageResult::NOT_MODIFIED);
+            recordRevisit(url, false);
+            return;
+        }
 
-        if (!htmlContent.has_value()) {
-            std::cerr << "[Поток " << workerId_ << "] Не удалось скачать: " << url << "\n";
+        if (!response.hasContent()) {
+            telemetry_->recordPage(PageResult::FAILED);
+            telemetry_->recordError(response.statusCode == Core::Ports::HttpFetchResult::STATUS_NETWORK_ERROR
+                                        ? ErrorClass::NETWORK
+                                        : ErrorClass::HTTP_STATUS);
+            LOG_WARNING("spider", "Не удалось скачать: ", url);
             return;
         }
 
-        // Индексируем страницу
-        const auto documentId = indexPageUseCase_->execute(url, htmlContent.value());
+        const std::string& htmlContent = response.body;
 
-        if (documentId == 0) {
-            std::cerr << "[Поток " << workerId_ << "] Не удалось проиндексировать: " << url << "\n";
+        // Индексируем страницу (пропускается, если HTML не изменился)
+        const auto result = indexPageUseCase_->execute(url, htmlContent, response.validators);
+
+        if (result.documentId == 0) {
+            telemetry_->recordPage(PageResult::FAILED);
+            telemetry_->recordError(ErrorClass::INDEX);
+            LOG_WARNING("spider", "Не удалось проиндексировать: ", url);
             return;
         }
 
-        std::cout << "[Поток " << workerId_ << "] Проиндексирован документ ID=" << documentId << ": " << url << "\n";
+        recordRevisit(url, result.status == Core::DTO::IndexPageResultDTO::Status::Indexed);
+
+        if (result.status == Core::DTO::IndexPageResultDTO::Status::Unchanged) {
+            telemetry_->recordPage(PageResult::UNCHANGED);
+        } else {
+            telemetry_->recordPage(PageResult::INDEXED);
+        }
 
         // Если не достигли максимальной глубины - извлекаем ссылки
         if (depth < maxDepth_) {
-            auto links = htmlParser_->extractLinks(htmlContent.value(), url);
-
-            std::cout << "[Поток " << workerId_ << "] Найдено ссылок: " << links.size() << " на странице " << url
-                      << "\n";
+            std::vector<std::string> links;
+            {
+                Core::Ports::ScopedLatency latency(telemetry_->getLinksLatency());
+                links = htmlParser_->extractLinks(htmlContent, url);
+            }
 
             for (const auto& link : links) {
                 queue_->push(link, depth + 1);
@@ -166,14 +170,90 @@ class CrawlerWorker {
         }
     }
 
+    /**
+     * @brief Обновляет расписание повторного посещения (если повторный краулинг включён)
+     */
+    void recordRevisit(const std::string& url, bool changed) {
+        if (!scheduleRevisitUseCase_) {
+            return;
+        }
+
+        try {
+            scheduleRevisitUseCase_->recordVisit(url, changed);
+        } catch (const std::exception& e) {
+            telemetry_->recordError(ErrorClass::REVISIT);
+            LOG_ERROR("spider", "Не удалось обновить расписание ", url, ": ", e.what());
+        }
+    }
+
     int workerId_;
     std::shared_ptr<CrawlQueue> queue_;
+    std::shared_ptr<CrawlTelemetry> telemetry_;
     std::shared_ptr<Core::Application::UseCases::IndexPageUseCase> indexPageUseCase_;
     std::shared_ptr<Core::Ports::IHttpClient> httpClient_;
     std::shared_ptr<Core::Ports::IHtmlParser> htmlParser_;
+    std::shared_ptr<Core::Application::UseCases::ScheduleRevisitUseCase> scheduleRevisitUseCase_;
     int maxDepth_;
 };
 
+/**
+ * @brief Выполняет один проход краулинга пулом потоков до опустошения очереди
+ *
+ * Если за проход изменились страницы, один раз увеличивает поколение индекса:
+ * HTTPServer сбросит результаты поиска, посчитанные до них.
+ */
+void runCrawlRound(SpiderData::DIContainer& container,
+                   const std::shared_ptr<CrawlQueue>& queue,
+                   const std::shared_ptr<CrawlTelemetry>& telemetry,
+                   int maxDepth,
+                   int threadPoolSize,
+                   bool recrawlEnabled) {
+    const uint64_t indexedBefore = telemetry->getPageCount(PageResult::INDEXED);
+
+    // Создаём пул потоков
+    std::vector<std::thread> threads;
+    threads.reserve(threadPoolSize);
+
+    // ВАЖНО: Каждый поток должен использовать свой собственный IndexPageUseCase
+    // с отдельным подключением к БД, чтобы избежать конфликтов транзакций
+
+    // Запускаем рабочие потоки
+    for (int i = 0; i < threadPoolSize; ++i) {
+        threads.emplace_back([&container, queue, telemetry, maxDepth, recrawlEnabled, workerId = i + 1]() {
+            // Каждый поток создаёт свой собственный IndexPageUseCase
+            // с отдельным подключением к БД
+            auto indexPageUseCase = container.createIndexPageUseCase();
+            auto httpClient = std::make_shared<Infrastructure::Http::BoostBeastHttpClient>();
+            auto htmlParser = std::make_shared<Infrastructure::Parsers::HtmlParser>();
+
+            std::shared_ptr<Core::Application::UseCases::ScheduleRevisitUseCase> scheduleRevisitUseCase;
+            if (recrawlEnabled) {
+                scheduleRevisitUseCase = container.createScheduleRevisitUseCase();
+            }
+
+            CrawlerWorker worker(workerId, queue, telemetry, indexPageUseCase, httpClient, htmlParser,
+                                 scheduleRevisitUseCase, maxDepth);
+            worker.run();
+        });
+    }
+
+    // Ждём завершения всех потоков
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Поколение меняется раз в проход, а не на каждую страницу: иначе во время краулинга
+    // кеш результатов поиска сбрасывался бы непрерывно
+    if (telemetry->getPageCount(PageResult::INDEXED) != indexedBefore) {
+        try {
+            container.getIndexGenerationRepository()->bumpGeneration();
+        } catch (const std::exception& e) {
+            // Устаревшие записи кеша истекут по cache_ttl_sec
+            LOG_ERROR("spider", "Не удалось увеличить поколение индекса: ", e.what());
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
     // Устанавливаем UTF-8 для консоли
     SetConsoleOutputCP(CP_UTF8);
@@ -198,50 +278,102 @@ int main(int argc, char* argv[]) {
         const std::string startUrl = config->getSpiderStartUrl();
         const int maxDepth = config->getSpiderCrawlDepth();
         const int threadPoolSize = config->getSpiderThreadPoolSize();
+        const bool recrawlEnabled = config->getSpiderRecrawlEnabled();
+        const auto recrawlBatchSize = static_cast<size_t>(std::max(1, config->getSpiderRecrawlBatchSize()));
+        const int64_t recrawlMaxSleepSec = std::max(1, config->getSpiderRecrawlMaxSleepSec());
 
         std::cout << "Стартовый URL: " << startUrl << "\n";
         std::cout << "Глубина рекурсии: " << maxDepth << "\n";
         std::cout << "Размер пула потоков: " << threadPoolSize << "\n";
+        std::cout << "Повторный краулинг: " << (recrawlEnabled ? "включён" : "выключен") << "\n";
         std::cout << "\n";
 
-        // Создаём многопоточную очередь
-        auto queue = std::make_shared<CrawlQueue>();
+        // Создаём многопоточную очередь (с журналом на диске, если задан frontier_dir,
+        // и вытеснением на диск длинной очереди, если задан frontier_spill_dir)
+        auto frontierStore = container.createCrawlFrontierStore();
+        auto queue = std::make_shared<CrawlQueue>(container.createFrontierQueue(), frontierStore);
+
+        if (frontierStore) {
+            const auto recovered = frontierStore->recover();
+
+            if (!recovered.pending.empty()) {
+                std::cout << "Очередь восстановлена после перезапуска: ожидают обработки "
+                          << recovered.pending.size() << ", посещено " << recovered.visited.size() << "\n\n";
+                queue->restore(recovered);
+            } else if (!recovered.visited.empty()) {
+                // Прошлый краулинг дошёл до конца, но процесс завершился до очистки журнала:
+                // продолжать нечего, начинаем заново со стартового URL
+                frontierStore->reset();
+            }
+        }
 
-        // Добавляем стартовый URL
+        // Добавляем стартовый URL (игнорируется, если уже посещён до перезапуска)
         queue->push(startUrl, 1);
 
-        // Создаём пул потоков
-        std::vector<std::thread> threads;
-        threads.reserve(threadPoolSize);
+        // Счётчики, время этапов и ошибки краулинга: в периодической сводке, на /status и /metrics
+        auto telemetry = std::make_shared<CrawlTelemetry>(container.getMetricsRegistry());
+        telemetry->startSummary(std::chrono::seconds(std::max(0, config->getSpiderStatusIntervalSec())));
+
+        std::unique_ptr<StatusServer> statusServer;
+        const int statusPort = config->getSpiderStatusPort();
+        if (statusPort > 0) {
+            statusServer = std::make_unique<StatusServer>(container.createStatusServer(), statusPort, telemetry);
+            std::cout << "Состояние краулинга: http://localhost:" << statusPort << "/status\n";
+        }
 
         std::cout << "Запуск " << threadPoolSize << " потоков краулера...\n";
         std::cout << "\n";
 
-        // ВАЖНО: Каждый поток должен использовать свой собственный IndexPageUseCase
-        // с отдельным подключением к БД, чтобы избежать конфликтов транзакций
+        runCrawlRound(container, queue, telemetry, maxDepth, threadPoolSize, recrawlEnabled);
 
-        // Запускаем рабочие потоки
-        for (int i = 0; i < threadPoolSize; ++i) {
-            threads.emplace_back([&container, queue, maxDepth, workerId = i + 1]() {
-                // Каждый поток создаёт свой собственный IndexPageUseCase
-                // с отдельным подключением к БД
-                auto indexPageUseCase = container.createIndexPageUseCase();
-                auto httpClient = std::make_shared<Infrastructure::Http::BoostBeastHttpClient>();
-                auto htmlParser = std::make_shared<Infrastructure::Parsers::HtmlParser>();
-
-                CrawlerWorker worker(workerId, queue, indexPageUseCase, httpClient, htmlParser, maxDepth);
-                worker.run();
-            });
+        // Очередь пуста: краулинг завершён, и журнал больше не нужен. Иначе следующий
+        // запуск восстановил бы все URL посещёнными и ничего не скачал
+        if (frontierStore) {
+            frontierStore->reset();
         }
 
-        // Ждём завершения всех потоков
-        for (auto& thread : threads) {
-            thread.join();
+        // Непрерывный режим: повторно посещаем страницы по расписанию,
+        // построенному по наблюдённой частоте их изменений
+        if (recrawlEnabled) {
+            auto scheduleRevisitUseCase = container.createScheduleRevisitUseCase();
+
+            std::cout << "\n=== Первичный краулинг завершён, переход к повторным посещениям ===\n";
+
+            while (true) {
+                const auto dueUrls = scheduleRevisitUseCase->takeDueUrls(recrawlBatchSize);
+
+                if (dueUrls.empty()) {
+                    // Спим до ближайшего запланированного посещения, но не дольше лимита
+                    const auto untilNext = scheduleRevisitUseCase->secondsUntilNextVisit();
+                    const int64_t sleepSec =
+                        std::clamp<int64_t>(untilNext.value_or(recrawlMaxSleepSec), 1, recrawlMaxSleepSec);
+                    std::this_thread::sleep_for(std::chrono::seconds(sleepSec));
+                    continue;
+                }
+
+                std::cout << "Повторное посещение страниц: " << dueUrls.size() << "\n";
+
+                // Повторно посещённые страницы ставятся с максимальной глубиной:
+                // ссылки с них не обходятся, иначе каждый проход превращался бы
+                // в полный краулинг
+                auto revisitQueue = std::make_shared<CrawlQueue>(container.createFrontierQueue());
+                for (const auto& url : dueUrls) {
+                    revisitQueue->push(url, maxDepth);
+                }
+
+                runCrawlRound(container, revisitQueue, telemetry, maxDepth, threadPoolSize, recrawlEnabled);
+
+                std::cout << telemetry->takeSummaryLine() << "\n";
+            }
         }
 
         std::cout << "\n";
         std::cout << "=== Краулинг завершён ===" << "\n";
         std::cout << "Всего обработано URL: " << queue->getVisitedCount() << "\n";
+        std::cout << "Проиндексировано: " << telemetry->getPageCount(PageResult::INDEXED) << "\n";
+        std::cout << "Без изменений (пропущено): " << telemetry->getPageCount(PageResult::UNCHANGED) << "\n";
+        std::cout << "Не изменились по ответу 304: " << telemetry->getPageCount(PageResult::NOT_MODIFIED) << "\n";
+        std::cout << "Ошибок: " << telemetry->getPageCount(PageResult::FAILED) << "\n";
 
         return 0;
 
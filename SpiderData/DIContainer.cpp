@@ -1,16 +1,75 @@
 #include "DIContainer.h"
 
+#include <algorithm>
 #include <sstream>
+#include <stdexcept>
 
 #include "../Infrastructure/Configuration/IniConfiguration.h"
 #include "../Infrastructure/Database/DatabaseConnection.h"
 #include "../Infrastructure/Database/PostgresDocumentRepository.h"
+#include "../Infrastructure/Database/PostgresIndexGenerationRepository.h"
+#include "../Infrastructure/Database/PostgresPackedWordRepository.h"
+#include "../Infrastructure/Database/PostgresRevisitScheduleRepository.h"
 #include "../Infrastructure/Database/PostgresWordRepository.h"
+#include "../Infrastructure/Frontier/FileCrawlFrontierStore.h"
+#include "../Infrastructure/Frontier/SpillingFrontierQueue.h"
 #include "../Infrastructure/Http/BoostBeastHttpClient.h"
+#include "../Infrastructure/Http/BoostBeastHttpServer.h"
+#include "../Infrastructure/Logging/Logger.h"
+#include "../Infrastructure/Metrics/MetricsRegistry.h"
 #include "../Infrastructure/Parsers/HtmlParser.h"
 #include "../Infrastructure/Text/BoostLocaleTextProcessor.h"
+#include "../Infrastructure/Tracing/ChromeTraceWriter.h"
 
 namespace SpiderData {
+namespace {
+/**
+ * @brief Создаёт репозиторий слов для выбранного в конфигурации хранения постингов
+ */
+std::shared_ptr<Core::Ports::IWordRepository> createWordRepository(
+    const Core::Ports::IConfiguration& configuration,
+    std::shared_ptr<Infrastructure::Database::DatabaseConnection> dbConnection) {
+    const std::string postingStorage = configuration.getDatabasePostingStorage();
+
+    if (postingStorage == "rows") {
+        return std::make_shared<Infrastructure::Database::PostgresWordRepository>(std::move(dbConnection));
+    }
+    if (postingStorage == "packed") {
+        return std::make_shared<Infrastructure::Database::PostgresPackedWordRepository>(std::move(dbConnection));
+    }
+
+    throw std::runtime_error("Неизвестный posting_storage: " + postingStorage);
+}
+
+/**
+ * @brief Настройки журнала из конфигурации
+ */
+Infrastructure::Logging::LoggerSettings createLoggerSettings(const Core::Ports::IConfiguration& configuration) {
+    Infrastructure::Logging::LoggerSettings settings;
+    settings.level = Infrastructure::Logging::parseLogLevel(configuration.getLoggingLevel());
+    settings.format = Infrastructure::Logging::parseLogFormat(configuration.getLoggingFormat());
+    settings.threadBufferRecords = static_cast<size_t>(std::max(configuration.getLoggingBufferRecords(), 2));
+    settings.rateLimitPerSecond = static_cast<uint32_t>(std::max(configuration.getLoggingRateLimitPerSec(), 0));
+    return settings;
+}
+
+/**
+ * @brief Трассировщик из конфигурации; nullptr, если файл трассировки не задан
+ */
+std::shared_ptr<Infrastructure::Tracing::ChromeTraceWriter> createTracer(
+    const Core::Ports::IConfiguration& configuration) {
+    const std::string traceFile = configuration.getTracingFile();
+    if (traceFile.empty()) {
+        return nullptr;
+    }
+
+    const auto maxEvents = static_cast<uint64_t>(std::max(configuration.getTracingMaxEvents(), 0));
+    auto tracer = std::make_shared<Infrastructure::Tracing::ChromeTraceWriter>(traceFile, maxEvents);
+    LOG_INFO("tracing", "Трассировка пишется в ", traceFile);
+    return tracer;
+}
+} // namespace
+
 DIContainer::DIContainer(const std::string& configPath) {
     configuration_ = std::make_shared<Infrastructure::Configuration::IniConfiguration>(configPath);
 
@@ -18,6 +77,26 @@ DIContainer::DIContainer(const std::string& configPath) {
 }
 
 void DIContainer::initialize() {
+    // Журнал создаётся первым: через него пишут компоненты, создаваемые ниже
+    logger_ = std::make_shared<Infrastructure::Logging::AsyncLogger>(createLoggerSettings(*configuration_));
+
+    // Трассировка включается до создания компонентов, чтобы в неё попали все их отрезки
+    tracer_ = createTracer(*configuration_);
+    Core::Ports::Tracing::setTracer(tracer_.get());
+
+    // Сегменты очереди от прошлого запуска не нужны: очередь восстанавливается из журнала
+    Infrastructure::Frontier::SpillingFrontierQueue::removeStaleSegments(
+        configuration_->getSpiderFrontierSpillDir());
+
+    metricsRegistry_ = std::make_shared<Infrastructure::Metrics::MetricsRegistry>();
+
+    const auto logger = logger_;
+    metricsRegistry_->callback("log_records_dropped_total", "Log records dropped because a thread buffer was full",
+                               true, [logger] { return static_cast<double>(logger->getDroppedCount()); });
+    metricsRegistry_->callback(
+        "log_records_suppressed_total", "Log records suppressed by the per-call-site rate limit", true,
+        [] { return static_cast<double>(Infrastructure::Logging::AsyncLogger::getSuppressedCount()); });
+
     httpClient_ = std::make_shared<Infrastructure::Http::BoostBeastHttpClient>();
 
     htmlParser_ = std::make_shared<Infrastructure::Parsers::HtmlParser>();
@@ -35,11 +114,12 @@ void DIContainer::initialize() {
 
     documentRepository_ =
         std::make_shared<Infrastructure::Database::PostgresDocumentRepository>(dbConnection);
-    wordRepository_ =
-        std::make_shared<Infrastructure::Database::PostgresWordRepository>(dbConnection);
+    wordRepository_ = createWordRepository(*configuration_, dbConnection);
+
+    indexGeneration_ = std::make_shared<Infrastructure::Database::PostgresIndexGenerationRepository>(dbConnection);
 
     indexPageUseCase_ = std::make_shared<Core::Application::UseCases::IndexPageUseCase>(
-        documentRepository_, wordRepository_, htmlParser_, textProcessor_);
+        documentRepository_, wordRepository_, htmlParser_, textProcessor_, metricsRegistry_);
 }
 
 std::string DIContainer::createDatabaseConnectionString() const {
@@ -70,13 +150,62 @@ DIContainer::createIndexPageUseCase() {
     // Создаём новые репозитории с новым подключением
     auto documentRepository =
         std::make_shared<Infrastructure::Database::PostgresDocumentRepository>(dbConnection);
-    auto wordRepository =
-        std::make_shared<Infrastructure::Database::PostgresWordRepository>(dbConnection);
+    auto wordRepository = createWordRepository(*configuration_, dbConnection);
 
     // Создаём новый Use Case с новыми репозиториями
     // Используем общие (thread-safe) компоненты для парсинга
     return std::make_shared<Core::Application::UseCases::IndexPageUseCase>(
-        documentRepository, wordRepository, htmlParser_, textProcessor_);
+        documentRepository, wordRepository, htmlParser_, textProcessor_, metricsRegistry_);
+}
+
+std::shared_ptr<Core::Ports::IIndexGenerationRepository> DIContainer::getIndexGenerationRepository() {
+    return indexGeneration_;
+}
+
+std::shared_ptr<Core::Application::UseCases::ScheduleRevisitUseCase>
+DIContainer::createScheduleRevisitUseCase() {
+    const std::string connectionString = createDatabaseConnectionString();
+    auto dbConnection =
+        std::make_shared<Infrastructure::Database::DatabaseConnection>(connectionString);
+
+    auto scheduleRepository =
+        std::make_shared<Infrastructure::Database::PostgresRevisitScheduleRepository>(dbConnection);
+
+    return std::make_shared<Core::Application::UseCases::ScheduleRevisitUseCase>(
+        scheduleRepository);
+}
+
+std::shared_ptr<Core::Ports::ICrawlFrontierStore> DIContainer::createCrawlFrontierStore() {
+    const std::string frontierDir = configuration_->getSpiderFrontierDir();
+    if (frontierDir.empty()) {
+        return nullptr;
+    }
+
+    const int groupCommitMs = std::max(1, configuration_->getSpiderFrontierGroupCommitMs());
+    const int snapshotRecords = std::max(1, configuration_->getSpiderFrontierSnapshotRecords());
+
+    return std::make_shared<Infrastructure::Frontier::FileCrawlFrontierStore>(
+        frontierDir, std::chrono::milliseconds(groupCommitMs), static_cast<size_t>(snapshotRecords));
+}
+
+std::unique_ptr<Core::Ports::IFrontierQueue> DIContainer::createFrontierQueue() {
+    const auto highWatermark =
+        static_cast<size_t>(std::max(2, configuration_->getSpiderFrontierMemoryHighWatermark()));
+    const auto lowWatermark =
+        static_cast<size_t>(std::max(1, configuration_->getSpiderFrontierMemoryLowWatermark()));
+
+    return std::make_unique<Infrastructure::Frontier::SpillingFrontierQueue>(
+        configuration_->getSpiderFrontierSpillDir(), highWatermark, lowWatermark);
+}
+
+std::shared_ptr<Core::Ports::IMetricsRegistry> DIContainer::getMetricsRegistry() {
+    return metricsRegistry_;
+}
+
+std::shared_ptr<Core::Ports::IHttpServer> DIContainer::createStatusServer() {
+    Infrastructure::Http::HttpServerSettings settings;
+    settings.threadCount = 1;
+    return std::make_shared<Infrastructure::Http::BoostBeastHttpServer>(settings, metricsRegistry_);
 }
 
 std::shared_ptr<Core::Ports::IConfiguration> DIContainer::getConfiguration() {
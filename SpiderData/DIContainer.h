@@ -4,14 +4,28 @@
 #include <string>
 
 #include "../Core/Application/UseCases/IndexPageUseCase.h"
+#include "../Core/Application/UseCases/ScheduleRevisitUseCase.h"
 #include "../Core/Ports/IConfiguration.h"
+#include "../Core/Ports/ICrawlFrontierStore.h"
+#include "../Core/Ports/IFrontierQueue.h"
 #include "../Core/Ports/IDocumentRepository.h"
 #include "../Core/Ports/IDatabaseConnection.h"
 #include "../Core/Ports/IHtmlParser.h"
 #include "../Core/Ports/IHttpClient.h"
+#include "../Core/Ports/IHttpServer.h"
+#include "../Core/Ports/IIndexGenerationRepository.h"
+#include "../Core/Ports/IMetricsRegistry.h"
 #include "../Core/Ports/ITextProcessor.h"
 #include "../Core/Ports/IWordRepository.h"
 
+namespace Infrastructure::Logging {
+class AsyncLogger;
+}
+
+namespace Infrastructure::Tracing {
+class ChromeTraceWriter;
+}
+
 namespace SpiderData {
 /**
  * @brief Контейнер зависимостей для приложения Spider
@@ -50,6 +64,49 @@ class DIContainer {
      */
     std::shared_ptr<Core::Application::UseCases::IndexPageUseCase> createIndexPageUseCase();
 
+    /**
+     * @brief Получить счётчик поколений индекса (singleton, соединение основного потока)
+     * Увеличивается после прохода краулинга, изменившего страницы: HTTPServer сбрасывает кеш поиска.
+     * @return Shared pointer на IIndexGenerationRepository
+     */
+    std::shared_ptr<Core::Ports::IIndexGenerationRepository> getIndexGenerationRepository();
+
+    /**
+     * @brief Создать новый Use Case для планирования повторных посещений
+     * Создаёт новый экземпляр с собственным подключением к БД
+     * (по аналогии с createIndexPageUseCase).
+     * @return Shared pointer на новый ScheduleRevisitUseCase
+     */
+    std::shared_ptr<Core::Application::UseCases::ScheduleRevisitUseCase>
+    createScheduleRevisitUseCase();
+
+    /**
+     * @brief Создать персистентное хранилище очереди краулинга
+     * @return Хранилище в каталоге frontier_dir или nullptr, если каталог не задан
+     */
+    std::shared_ptr<Core::Ports::ICrawlFrontierStore> createCrawlFrontierStore();
+
+    /**
+     * @brief Создать очередь ожидающих URL
+     * Очередь держит в памяти не больше frontier_memory_high_watermark URL,
+     * остальное вытесняет в frontier_spill_dir.
+     * @return Unique pointer на новую очередь
+     */
+    std::unique_ptr<Core::Ports::IFrontierQueue> createFrontierQueue();
+
+    /**
+     * @brief Получить реестр метрик краулинга (общий для всех потоков)
+     * @return Shared pointer на IMetricsRegistry
+     */
+    std::shared_ptr<Core::Ports::IMetricsRegistry> getMetricsRegistry();
+
+    /**
+     * @brief Создать HTTP-сервер состояния краулинга
+     * Один поток; отдаёт реестр метрик по /metrics, остальные пути - обработчику.
+     * @return Shared pointer на новый IHttpServer
+     */
+    std::shared_ptr<Core::Ports::IHttpServer> createStatusServer();
+
     /**
      * @brief Получить конфигурацию
      * @return Shared pointer на IConfiguration
@@ -57,6 +114,11 @@ class DIContainer {
     std::shared_ptr<Core::Ports::IConfiguration> getConfiguration();
 
   private:
+    // Журнал объявлен первым, чтобы уничтожаться последним: после потоков остальных компонентов
+    std::shared_ptr<Infrastructure::Logging::AsyncLogger> logger_;
+    // Трассировщик (nullptr - выключена); уничтожается после потоков, пишущих отрезки
+    std::shared_ptr<Infrastructure::Tracing::ChromeTraceWriter> tracer_;
+
     // Configuration
     std::shared_ptr<Core::Ports::IConfiguration> configuration_;
 
@@ -64,11 +126,13 @@ class DIContainer {
     std::shared_ptr<Core::Ports::IHttpClient> httpClient_;
     std::shared_ptr<Core::Ports::IHtmlParser> htmlParser_;
     std::shared_ptr<Core::Ports::ITextProcessor> textProcessor_;
+    std::shared_ptr<Core::Ports::IMetricsRegistry> metricsRegistry_;
 
     // Database
     std::shared_ptr<Core::Ports::IDatabaseConnection> databaseConnection_;
     std::shared_ptr<Core::Ports::IDocumentRepository> documentRepository_;
     std::shared_ptr<Core::Ports::IWordRepository> wordRepository_;
+    std::shared_ptr<Core::Ports::IIndexGenerationRepository> indexGeneration_;
 
     // Use Cases
     std::shared_ptr<Core::Application::UseCases::IndexPageUseCase> indexPageUseCase_;
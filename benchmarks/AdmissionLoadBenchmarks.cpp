@@ -0,0 +1,198 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../Core/Application/AdmissionController.h"
+
+namespace Benchmarks {
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr unsigned RANDOM_SEED = 20240314;
+
+// Бэкенд (пул соединений с БД): BACKEND_CAPACITY поисков одновременно по SERVICE_TIME,
+// то есть насыщение - BACKEND_CAPACITY / SERVICE_TIME запросов в секунду
+constexpr size_t BACKEND_CAPACITY = 4;
+constexpr std::chrono::milliseconds SERVICE_TIME{5};
+
+// Потоки сервера, разбирающие пришедшие запросы, и длительность нагрузки
+constexpr size_t WORKER_THREADS = 32;
+constexpr std::chrono::seconds LOAD_DURATION{3};
+
+/**
+ * @brief Бэкенд с ограниченным числом одновременных запросов; лишние ждут места
+ */
+class Backend {
+  public:
+    void serve() {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            released_.wait(lock, [this] { return active_ < BACKEND_CAPACITY; });
+            ++active_;
+        }
+
+        std::this_thread::sleep_for(SERVICE_TIME);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --active_;
+        }
+        released_.notify_one();
+    }
+
+  private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    size_t active_ = 0;
+};
+
+/**
+ * @brief Итог прогона открытой нагрузки
+ */
+struct OpenLoopResult {
+    std::vector<double> latenciesMs;  // Обслуженные запросы: от запланированного прихода до ответа
+    int64_t rejected = 0;
+    double elapsedSec = 0.0;  // До ответа на последний запрос, вместе с разбором накопленной очереди
+};
+
+/**
+ * @brief Открытая нагрузка: запросы приходят пуассоновским потоком, не дожидаясь ответов
+ *
+ * Задержка считается от запланированного момента прихода, поэтому отставание
+ * генератора не скрывает очередь (coordinated omission).
+ * @param arrivalsPerSecond Интенсивность прихода запросов
+ * @param admission Контроль допуска перед бэкендом (nullptr - без ограничения)
+ */
+OpenLoopResult runOpenLoop(double arrivalsPerSecond, Core::Application::AdmissionController* admission) {
+    Backend backend;
+    OpenLoopResult result;
+    std::mutex resultMutex;
+
+    // Принятые сервером запросы (очередь соединений); в ней копится задержка без допуска
+    std::mutex queueMutex;
+    std::condition_variable arrived;
+    std::deque<Clock::time_point> queue;
+    bool finished = false;
+
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < WORKER_THREADS; ++i) {
+        workers.emplace_back([&] {
+            while (true) {
+                Clock::time_point scheduledAt;
+                {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    arrived.wait(lock, [&] { return !queue.empty() || finished; });
+                    if (queue.empty()) {
+                        return;
+                    }
+                    scheduledAt = queue.front();
+                    queue.pop_front();
+                }
+
+                Core::Application::AdmissionController::Ticket ticket;
+                if (admission != nullptr) {
+                    ticket = admission->acquire();
+                    if (!ticket) {
+                        std::lock_guard<std::mutex> lock(resultMutex);
+                        ++result.rejected;
+                        continue;
+                    }
+                }
+
+                backend.serve();
+                const std::chrono::duration<double, std::milli> latency = Clock::now() - scheduledAt;
+
+                std::lock_guard<std::mutex> lock(resultMutex);
+                result.latenciesMs.push_back(latency.count());
+            }
+        });
+    }
+
+    std::mt19937 random(RANDOM_SEED);
+    std::exponential_distribution<double> gapSec(arrivalsPerSecond);
+    const auto startedAt = Clock::now();
+    auto nextArrival = startedAt;
+    while (nextArrival - startedAt < LOAD_DURATION) {
+        std::this_thread::sleep_until(nextArrival);
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            queue.push_back(nextArrival);
+        }
+        arrived.notify_one();
+        nextArrival += std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(gapSec(random)));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        finished = true;
+    }
+    arrived.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    result.elapsedSec = std::chrono::duration<double>(Clock::now() - startedAt).count();
+    return result;
+}
+
+double percentile(std::vector<double>& values, double share) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<size_t>(share * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(rank), values.end());
+    return values[rank];
+}
+} // namespace
+
+void registerAdmissionLoadBenchmarks() {
+    // Открытая нагрузка на бэкенд из 4 мест по 5 мс (насыщение - 800 запросов/с): без ограничения
+    // и с контролем допуска перед бэкендом. Аргумент - нагрузка в процентах насыщения. Время
+    // замера - длительность прогона; результат - в счётчиках: p50_ms и p99_ms обслуженных
+    // запросов, rejected - доля отказов (503), served_per_second - обслуженные запросы в секунду
+    const auto registerOpenLoop = [](const char* name, bool admission) {
+        benchmark::RegisterBenchmark(name, [admission](benchmark::State& state) {
+            const double saturation =
+                static_cast<double>(BACKEND_CAPACITY) / std::chrono::duration<double>(SERVICE_TIME).count();
+            const double arrivalsPerSecond = saturation * static_cast<double>(state.range(0)) / 100.0;
+
+            OpenLoopResult result;
+            for (auto _ : state) {
+                std::unique_ptr<Core::Application::AdmissionController> controller;
+                if (admission) {
+                    Core::Application::AdmissionSettings settings;
+                    settings.maxConcurrent = BACKEND_CAPACITY;
+                    settings.maxQueued = BACKEND_CAPACITY;
+                    controller = std::make_unique<Core::Application::AdmissionController>(settings);
+                }
+                result = runOpenLoop(arrivalsPerSecond, controller.get());
+            }
+
+            const auto served = static_cast<double>(result.latenciesMs.size());
+            state.counters["rejected"] = static_cast<double>(result.rejected) /
+                                         std::max(1.0, served + static_cast<double>(result.rejected));
+            state.counters["served_per_second"] = served / std::max(result.elapsedSec, 1e-9);
+            state.counters["p50_ms"] = percentile(result.latenciesMs, 0.50);
+            state.counters["p99_ms"] = percentile(result.latenciesMs, 0.99);
+        })
+            ->ArgName("load_percent")
+            ->Arg(50)
+            ->Arg(200)
+            ->Iterations(1)
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+    };
+    registerOpenLoop("AdmissionController/open_loop/unbounded", false);
+    registerOpenLoop("AdmissionController/open_loop/admission", true);
+}
+} // namespace Benchmarks
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <vector>
+
+#include "Corpus.h"
+
+namespace Infrastructure::Parsers {
+class HtmlParser;
+}
+
+namespace Infrastructure::Text {
+class BoostLocaleTextProcessor;
+}
+
+/**
+ * @brief Регистрация бенчмарков по группам
+ *
+ * Корпус и компоненты создаются в main() и живут до конца прогона; бенчмарки
+ * ссылаются на них. Имена бенчмарков: Компонент/метод/вход, например
+ * HtmlParser/extractText/ru_article - по ним фильтрует --benchmark_filter.
+ */
+namespace Benchmarks {
+/**
+ * @brief HtmlParser: extractText, extractLinks и resolveUrl на каждой странице корпуса
+ */
+void registerHtmlParserBenchmarks(const std::vector<CorpusPage>& corpus,
+                                  Infrastructure::Parsers::HtmlParser& parser);
+
+/**
+ * @brief BoostLocaleTextProcessor и IndexingService на тексте каждой страницы корпуса
+ */
+void registerTextBenchmarks(const std::vector<CorpusPage>& corpus,
+                            Infrastructure::Text::BoostLocaleTextProcessor& textProcessor);
+
+/**
+ * @brief Value Objects и доменные сервисы поиска: Url, SearchQuery, RankingService, пересечение постингов
+ */
+void registerDomainBenchmarks(const std::vector<CorpusPage>& corpus);
+
+/**
+ * @brief Инфраструктура поиска и наблюдаемости: кодек постингов, метрики, трассировка, контроль допуска
+ */
+void registerInfrastructureBenchmarks();
+
+/**
+ * @brief Открытая нагрузка на бэкенд ограниченной ёмкости: задержки без ограничения и с AdmissionController
+ */
+void registerAdmissionLoadBenchmarks();
+
+/**
+ * @brief BoostBeastHttpClient против сервера-заглушки на localhost: ответы 200, 304 и редиректы
+ */
+void registerHttpClientBenchmarks();
+
+/**
+ * @brief BoostBeastHttpServer под нагрузкой keep-alive клиентов: req/s по числу потоков и режиму acceptor
+ */
+void registerHttpServerBenchmarks();
+
+/**
+ * @brief Моделирование повторных посещений: свежесть индекса адаптивного и равномерного расписания
+ */
+void registerRevisitBenchmarks();
+} // namespace Benchmarks
@@ -0,0 +1,89 @@
+#include "Corpus.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace Benchmarks {
+namespace {
+std::string readFile(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Не удалось открыть файл корпуса: " + path.string());
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+/**
+ * @brief Значение атрибута в кавычках, начинающееся в позиции begin
+ */
+std::string readQuotedValue(const std::string& html, size_t begin) {
+    const size_t end = html.find('"', begin);
+    return end == std::string::npos ? std::string() : html.substr(begin, end - begin);
+}
+
+std::string findCanonicalUrl(const std::string& html) {
+    static const std::string CANONICAL = "<link rel=\"canonical\" href=\"";
+    const size_t position = html.find(CANONICAL);
+    return position == std::string::npos ? std::string() : readQuotedValue(html, position + CANONICAL.size());
+}
+
+/**
+ * @brief Относительные ссылки <a href>: те же правила отбора, что в HtmlParser::extractLinks
+ */
+std::vector<std::string> findRelativeLinks(const std::string& html) {
+    static const std::string HREF = "<a href=\"";
+
+    std::vector<std::string> links;
+    for (size_t position = html.find(HREF); position != std::string::npos;
+         position = html.find(HREF, position + HREF.size())) {
+        std::string link = readQuotedValue(html, position + HREF.size());
+        if (link.empty() || link[0] == '#' || link.rfind("javascript:", 0) == 0 || link.rfind("mailto:", 0) == 0 ||
+            link.rfind("http://", 0) == 0 || link.rfind("https://", 0) == 0) {
+            continue;
+        }
+        links.push_back(std::move(link));
+    }
+    return links;
+}
+} // namespace
+
+std::vector<CorpusPage> loadCorpus(const std::filesystem::path& directory,
+                                   Core::Ports::IHtmlParser& htmlParser,
+                                   Core::Ports::ITextProcessor& textProcessor) {
+    std::vector<std::filesystem::path> files;
+    if (std::filesystem::is_directory(directory)) {
+        for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+            if (entry.is_regular_file() && entry.path().extension() == ".html") {
+                files.push_back(entry.path());
+            }
+        }
+    }
+    if (files.empty()) {
+        throw std::runtime_error("В каталоге корпуса нет страниц: " + directory.string());
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<CorpusPage> pages;
+    pages.reserve(files.size());
+    for (const auto& file : files) {
+        CorpusPage page;
+        page.name = file.stem().string();
+        page.html = readFile(file);
+        page.url = findCanonicalUrl(page.html);
+        if (page.url.empty()) {
+            throw std::runtime_error("У страницы корпуса нет <link rel=\"canonical\">: " + file.string());
+        }
+
+        page.text = htmlParser.extractText(page.html);
+        page.indexedText = textProcessor.toLowercase(textProcessor.normalize(page.text));
+        page.links = htmlParser.extractLinks(page.html, page.url);
+        page.relativeLinks = findRelativeLinks(page.html);
+        pages.push_back(std::move(page));
+    }
+    return pages;
+}
+} // namespace Benchmarks
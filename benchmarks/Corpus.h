@@ -0,0 +1,34 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "../Core/Ports/IHtmlParser.h"
+#include "../Core/Ports/ITextProcessor.h"
+
+namespace Benchmarks {
+/**
+ * @brief Страница корпуса и её промежуточные представления
+ *
+ * Представления строятся при загрузке так же, как при индексации страницы
+ * (IndexPageUseCase), чтобы каждый этап измерялся на своих настоящих входных данных.
+ */
+struct CorpusPage {
+    std::string name;                        // Имя файла без расширения: ru_article, en_forum
+    std::string url;                         // Из <link rel="canonical">
+    std::string html;
+    std::string text;                        // extractText
+    std::string indexedText;                 // normalize, затем toLowercase - вход analyzeWordFrequency
+    std::vector<std::string> links;          // extractLinks
+    std::vector<std::string> relativeLinks;  // Значения href, которые краулер разрешает через resolveUrl
+};
+
+/**
+ * @brief Загружает страницы *.html каталога в порядке имён файлов
+ * @throws std::runtime_error если каталог не содержит страниц или у страницы нет canonical URL
+ */
+std::vector<CorpusPage> loadCorpus(const std::filesystem::path& directory,
+                                   Core::Ports::IHtmlParser& htmlParser,
+                                   Core::Ports::ITextProcessor& textProcessor);
+} // namespace Benchmarks
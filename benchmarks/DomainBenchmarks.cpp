@@ -0,0 +1,161 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+
+#include "Benchmarks.h"
+#include "../Core/Domain/Model/PostingList.h"
+#include "../Core/Domain/Model/SearchResult.h"
+#include "../Core/Domain/Service/PostingIntersectionService.h"
+#include "../Core/Domain/Service/RankingService.h"
+#include "../Core/Domain/ValueObject/SearchQuery.h"
+#include "../Core/Domain/ValueObject/Url.h"
+
+namespace Benchmarks {
+namespace {
+using Core::Domain::Model::PostingList;
+using Core::Domain::Model::SearchResult;
+using Core::Domain::Service::PostingIntersectionService;
+
+// Фиксированное зерно: входы одинаковы во всех прогонах, результаты сравнимы
+constexpr unsigned RANDOM_SEED = 20240314;
+
+// Документов в коллекции для синтетических списков постингов
+constexpr PostingList::DocumentIdType COLLECTION_SIZE = 2000000;
+
+// Запросы как из строки поиска: русские, английские, смешанные, с лишними пробелами
+const std::vector<std::string> SEARCH_QUERIES = {
+    "поисковая система",
+    "инвертированный индекс списки постингов",
+    "Ёлочные  Игрушки",
+    "crawler",
+    "how inverted indexes work",
+    "conditional requests ETag",
+    "метро новая линия 2024",
+    "  boost beast  ",
+};
+
+/**
+ * @brief Список постингов: size случайных документов из коллекции, частоты 1..20
+ */
+PostingList makePostingList(size_t size, std::mt19937& random) {
+    std::uniform_int_distribution<PostingList::DocumentIdType> documentDistribution(1, COLLECTION_SIZE);
+    std::uniform_int_distribution<PostingList::FrequencyType> frequencyDistribution(1, 20);
+
+    std::vector<PostingList::DocumentIdType> documentIds;
+    documentIds.reserve(size);
+    while (documentIds.size() < size) {
+        documentIds.push_back(documentDistribution(random));
+        if (documentIds.size() == size) {
+            std::sort(documentIds.begin(), documentIds.end());
+            documentIds.erase(std::unique(documentIds.begin(), documentIds.end()), documentIds.end());
+        }
+    }
+
+    std::vector<PostingList::FrequencyType> frequencies(documentIds.size());
+    for (auto& frequency : frequencies) {
+        frequency = frequencyDistribution(random);
+    }
+    return PostingList(std::move(documentIds), std::move(frequencies));
+}
+
+/**
+ * @brief Пары списков: редкое слово с частым и два частых
+ */
+struct IntersectionInput {
+    const char* name;
+    std::vector<PostingList> lists;
+};
+
+std::vector<IntersectionInput> makeIntersectionInputs() {
+    std::mt19937 random(RANDOM_SEED);
+    std::vector<IntersectionInput> inputs;
+    inputs.push_back({"rare_common", {makePostingList(1000, random), makePostingList(1000000, random)}});
+    inputs.push_back({"common_common", {makePostingList(1000000, random), makePostingList(1000000, random)}});
+    return inputs;
+}
+
+std::vector<SearchResult> makeSearchResults(size_t count) {
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_int_distribution<SearchResult::RelevanceType> relevanceDistribution(1, 1000);
+
+    std::vector<SearchResult> results;
+    results.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        const auto documentId = static_cast<SearchResult::DocumentIdType>(i + 1);
+        results.emplace_back(documentId, "https://example.org/doc/" + std::to_string(documentId),
+                             relevanceDistribution(random));
+    }
+    return results;
+}
+} // namespace
+
+void registerDomainBenchmarks(const std::vector<CorpusPage>& corpus) {
+    // Все ссылки корпуса: то, что краулер передаёт в Url::create
+    static std::vector<std::string> links;
+    for (const auto& page : corpus) {
+        links.insert(links.end(), page.links.begin(), page.links.end());
+    }
+
+    benchmark::RegisterBenchmark("Url/create/corpus_links", [](benchmark::State& state) {
+        for (auto _ : state) {
+            for (const auto& link : links) {
+                benchmark::DoNotOptimize(Core::Domain::ValueObject::Url::create(link));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(links.size()));
+    });
+
+    benchmark::RegisterBenchmark("SearchQuery/create", [](benchmark::State& state) {
+        for (auto _ : state) {
+            for (const auto& query : SEARCH_QUERIES) {
+                benchmark::DoNotOptimize(Core::Domain::ValueObject::SearchQuery::create(query));
+            }
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SEARCH_QUERIES.size()));
+    });
+
+    // rankResults принимает результаты по значению; копирование входа в замер не входит
+    benchmark::RegisterBenchmark("RankingService/rankResults", [](benchmark::State& state) {
+        const auto results = makeSearchResults(static_cast<size_t>(state.range(0)));
+        for (auto _ : state) {
+            state.PauseTiming();
+            auto input = results;
+            state.ResumeTiming();
+            benchmark::DoNotOptimize(Core::Domain::Service::RankingService::rankResults(std::move(input)));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    })->RangeMultiplier(10)->Range(100, 100000);
+
+    static const std::vector<IntersectionInput> intersectionInputs = makeIntersectionInputs();
+    using Kernel = PostingIntersectionService::Kernel;
+    for (const Kernel kernel : {Kernel::SCALAR, Kernel::SSE42, Kernel::AVX2}) {
+        if (!PostingIntersectionService::isSupported(kernel)) {
+            continue;
+        }
+        const std::string kernelName = PostingIntersectionService::getKernelName(kernel);
+
+        for (const auto& input : intersectionInputs) {
+            benchmark::RegisterBenchmark(
+                ("PostingIntersectionService/intersect/" + kernelName + "/" + input.name).c_str(),
+                [&input, kernel](benchmark::State& state) {
+                    for (auto _ : state) {
+                        benchmark::DoNotOptimize(PostingIntersectionService::intersect(input.lists, kernel));
+                    }
+                })
+                ->Unit(benchmark::kMicrosecond);
+
+            benchmark::RegisterBenchmark(
+                ("PostingIntersectionService/intersectTop/" + kernelName + "/" + input.name).c_str(),
+                [&input, kernel](benchmark::State& state) {
+                    for (auto _ : state) {
+                        benchmark::DoNotOptimize(PostingIntersectionService::intersectTop(
+                            input.lists, Core::Domain::Service::RankingService::DEFAULT_MAX_RESULTS, kernel));
+                    }
+                })
+                ->Unit(benchmark::kMicrosecond);
+        }
+    }
+}
+} // namespace Benchmarks
@@ -0,0 +1,44 @@
+#include <benchmark/benchmark.h>
+
+#include "Benchmarks.h"
+#include "../Infrastructure/Parsers/HtmlParser.h"
+
+namespace Benchmarks {
+void registerHtmlParserBenchmarks(const std::vector<CorpusPage>& corpus,
+                                  Infrastructure::Parsers::HtmlParser& parser) {
+    for (const auto& page : corpus) {
+        benchmark::RegisterBenchmark(("HtmlParser/extractText/" + page.name).c_str(),
+                                     [&page, &parser](benchmark::State& state) {
+                                         for (auto _ : state) {
+                                             benchmark::DoNotOptimize(parser.extractText(page.html));
+                                         }
+                                         state.SetBytesProcessed(state.iterations() *
+                                                                 static_cast<int64_t>(page.html.size()));
+                                     });
+
+        benchmark::RegisterBenchmark(("HtmlParser/extractLinks/" + page.name).c_str(),
+                                     [&page, &parser](benchmark::State& state) {
+                                         for (auto _ : state) {
+                                             benchmark::DoNotOptimize(parser.extractLinks(page.html, page.url));
+                                         }
+                                         state.SetBytesProcessed(state.iterations() *
+                                                                 static_cast<int64_t>(page.html.size()));
+                                     });
+
+        if (page.relativeLinks.empty()) {
+            continue;
+        }
+        // Все относительные ссылки страницы за итерацию
+        benchmark::RegisterBenchmark(("HtmlParser/resolveUrl/" + page.name).c_str(),
+                                     [&page, &parser](benchmark::State& state) {
+                                         for (auto _ : state) {
+                                             for (const auto& link : page.relativeLinks) {
+                                                 benchmark::DoNotOptimize(parser.resolveUrl(link, page.url));
+                                             }
+                                         }
+                                         state.SetItemsProcessed(state.iterations() *
+                                                                 static_cast<int64_t>(page.relativeLinks.size()));
+                                     });
+    }
+}
+} // namespace Benchmarks
@@ -0,0 +1,132 @@
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "Benchmarks.h"
+#include "../Infrastructure/Http/BoostBeastHttpClient.h"
+#include "../Infrastructure/Http/BoostBeastHttpServer.h"
+
+namespace Benchmarks {
+namespace {
+// Порт заглушки на localhost
+constexpr int STUB_SERVER_PORT = 18181;
+
+// Время ожидания запуска заглушки
+constexpr int STUB_START_ATTEMPTS = 100;
+constexpr std::chrono::milliseconds STUB_START_POLL_INTERVAL{20};
+
+const std::string PAGE_ETAG = "\"v1\"";
+const std::string PAGE_LAST_MODIFIED = "Mon, 04 Mar 2024 10:00:00 GMT";
+
+/**
+ * @brief Сервер-заглушка на localhost с ответами, которые видит краулер при повторном обходе
+ *
+ * /page - страница 16 КБ с ETag и Last-Modified: на совпадающий If-None-Match отвечает 304;
+ * /moved - 301 на /page.
+ * Запускается при первом обращении и работает до завершения программы.
+ */
+class StubServer {
+  public:
+    StubServer() : server_(std::make_shared<Infrastructure::Http::BoostBeastHttpServer>()) {
+        thread_ = std::thread([this] {
+            const std::string page = "<html><body>" + std::string(16 * 1024, 'x') + "</body></html>";
+            server_->start(STUB_SERVER_PORT, [page](const Core::Ports::HttpRequestView& request) {
+                if (request.target == "/page") {
+                    if (request.getHeader("If-None-Match") == PAGE_ETAG) {
+                        Core::Ports::HttpResponse response;
+                        response.statusCode = 304;
+                        response.setHeader("ETag", PAGE_ETAG);
+                        return response;
+                    }
+                    auto response = Core::Ports::HttpResponse::html(page);
+                    response.setHeader("ETag", PAGE_ETAG);
+                    response.setHeader("Last-Modified", PAGE_LAST_MODIFIED);
+                    return response;
+                }
+                if (request.target == "/moved") {
+                    auto response = Core::Ports::HttpResponse::text("", 301);
+                    response.setHeader("Location", "/page");
+                    return response;
+                }
+                return Core::Ports::HttpResponse::text("Not found\n", 404);
+            });
+        });
+
+        // start() блокирует поток сервера: ждём, пока порт начнёт принимать соединения
+        Infrastructure::Http::BoostBeastHttpClient client;
+        for (int attempt = 0; attempt < STUB_START_ATTEMPTS && !client.isAccessible(url("/page")); ++attempt) {
+            std::this_thread::sleep_for(STUB_START_POLL_INTERVAL);
+        }
+    }
+
+    ~StubServer() {
+        server_->stop();
+        thread_.join();
+    }
+
+    StubServer(const StubServer&) = delete;
+    StubServer& operator=(const StubServer&) = delete;
+
+    static std::string url(const std::string& path) {
+        return "http://127.0.0.1:" + std::to_string(STUB_SERVER_PORT) + path;
+    }
+
+  private:
+    std::shared_ptr<Infrastructure::Http::BoostBeastHttpServer> server_;
+    std::thread thread_;
+};
+
+StubServer& getStubServer() {
+    static StubServer server;
+    return server;
+}
+
+/**
+ * @brief Условный запрос к заглушке с проверкой статуса ответа
+ *
+ * Неожиданный статус останавливает бенчмарк с ошибкой: вместе со временем
+ * прогон проверяет ветви 200 / 304 / редиректа клиента.
+ */
+void fetchExpecting(benchmark::State& state,
+                    const std::string& path,
+                    const Core::DTO::CacheValidatorsDTO& validators,
+                    int expectedStatus) {
+    getStubServer();
+    Infrastructure::Http::BoostBeastHttpClient client;
+    const std::string url = StubServer::url(path);
+
+    int64_t bytes = 0;
+    for (auto _ : state) {
+        auto response = client.fetch(url, validators);
+        if (response.statusCode != expectedStatus) {
+            state.SkipWithError(("Статус " + std::to_string(response.statusCode) + " вместо " +
+                                 std::to_string(expectedStatus))
+                                    .c_str());
+            break;
+        }
+        bytes += static_cast<int64_t>(response.body.size());
+    }
+    state.SetBytesProcessed(bytes);
+}
+} // namespace
+
+void registerHttpClientBenchmarks() {
+    // Первый обход: запрос без валидаторов, страница приходит целиком
+    benchmark::RegisterBenchmark("BoostBeastHttpClient/fetch/200", [](benchmark::State& state) {
+        fetchExpecting(state, "/page", {}, 200);
+    })->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+    // Повторный обход неизменившейся страницы: 304 без тела
+    benchmark::RegisterBenchmark("BoostBeastHttpClient/fetch/304", [](benchmark::State& state) {
+        fetchExpecting(state, "/page", {PAGE_ETAG, PAGE_LAST_MODIFIED}, 304);
+    })->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+    // Валидаторы исходного URL не отправляются цели редиректа: ложного 304 быть не должно
+    benchmark::RegisterBenchmark("BoostBeastHttpClient/fetch/redirect", [](benchmark::State& state) {
+        fetchExpecting(state, "/moved", {PAGE_ETAG, PAGE_LAST_MODIFIED}, 200);
+    })->Unit(benchmark::kMicrosecond)->UseRealTime();
+}
+} // namespace Benchmarks
@@ -0,0 +1,227 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/connect.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include "Benchmarks.h"
+#include "../Infrastructure/Http/BoostBeastHttpServer.h"
+
+namespace Benchmarks {
+namespace {
+namespace beast = boost::beast;
+namespace http = beast::http;
+namespace net = boost::asio;
+using tcp = net::ip::tcp;
+
+// Порт нагружаемого сервера на localhost (заглушка клиента занимает 18181)
+constexpr int LOAD_SERVER_PORT = 18182;
+
+// Время ожидания запуска сервера
+constexpr int SERVER_START_ATTEMPTS = 100;
+constexpr std::chrono::milliseconds SERVER_START_POLL_INTERVAL{20};
+
+// Одновременных keep-alive соединений и запросов на одну итерацию замера
+constexpr size_t LOAD_CONNECTIONS = 64;
+constexpr int64_t REQUESTS_PER_ITERATION = 20000;
+
+const std::string RESPONSE_BODY = R"({"status": "ok"})";
+
+/**
+ * @brief Сервер с заданными потоками и режимом acceptor, работающий в своём потоке
+ */
+class LoadServer {
+  public:
+    explicit LoadServer(const Infrastructure::Http::HttpServerSettings& settings)
+        : server_(std::make_shared<Infrastructure::Http::BoostBeastHttpServer>(settings)) {
+        thread_ = std::thread([this] {
+            server_->start(LOAD_SERVER_PORT, [](const Core::Ports::HttpRequestView&) {
+                return Core::Ports::HttpResponse::json(RESPONSE_BODY);
+            });
+        });
+
+        // start() блокирует поток сервера: ждём, пока порт начнёт принимать соединения
+        for (int attempt = 0; attempt < SERVER_START_ATTEMPTS && !ready_; ++attempt) {
+            net::io_context ioc;
+            tcp::socket socket(ioc);
+            beast::error_code errc;
+            socket.connect(endpoint(), errc);
+            ready_ = !errc;
+            if (!ready_) {
+                std::this_thread::sleep_for(SERVER_START_POLL_INTERVAL);
+            }
+        }
+    }
+
+    ~LoadServer() {
+        server_->stop();
+        thread_.join();
+    }
+
+    LoadServer(const LoadServer&) = delete;
+    LoadServer& operator=(const LoadServer&) = delete;
+
+    bool isReady() const {
+        return ready_;
+    }
+
+    static tcp::endpoint endpoint() {
+        return {net::ip::make_address("127.0.0.1"), static_cast<unsigned short>(LOAD_SERVER_PORT)};
+    }
+
+  private:
+    std::shared_ptr<Infrastructure::Http::BoostBeastHttpServer> server_;
+    std::thread thread_;
+    bool ready_ = false;
+};
+
+/**
+ * @brief Общий на итерацию запас запросов: соединения разбирают его, пока он не кончится
+ */
+struct LoadBudget {
+    std::atomic<int64_t> remaining{0};
+    std::atomic<int64_t> failures{0};
+};
+
+/**
+ * @brief Клиентское keep-alive соединение: запрос, ответ, следующий запрос (закрытая нагрузка)
+ */
+class LoadConnection : public std::enable_shared_from_this<LoadConnection> {
+  public:
+    LoadConnection(net::io_context& ioc, LoadBudget& budget) : socket_(ioc), budget_(budget) {
+        request_.method(http::verb::get);
+        request_.target("/api/search?q=test");
+        request_.version(11);
+        request_.set(http::field::host, "127.0.0.1");
+        request_.keep_alive(true);
+    }
+
+    void start() {
+        socket_.async_connect(LoadServer::endpoint(), [self = shared_from_this()](beast::error_code errc) {
+            if (errc) {
+                self->fail();
+                return;
+            }
+            self->sendNext();
+        });
+    }
+
+  private:
+    tcp::socket socket_;
+    LoadBudget& budget_;
+    beast::flat_buffer buffer_;
+    http::request<http::empty_body> request_;
+    http::response<http::string_body> response_;
+
+    void sendNext() {
+        if (budget_.remaining.fetch_sub(1, std::memory_order_relaxed) <= 0) {
+            beast::error_code errc;
+            socket_.shutdown(tcp::socket::shutdown_both, errc);
+            return;
+        }
+
+        http::async_write(socket_, request_, [self = shared_from_this()](beast::error_code errc, size_t) {
+            if (errc) {
+                self->fail();
+                return;
+            }
+            self->readResponse();
+        });
+    }
+
+    void readResponse() {
+        response_ = {};
+        http::async_read(socket_, buffer_, response_, [self = shared_from_this()](beast::error_code errc, size_t) {
+            if (errc || self->response_.result() != http::status::ok) {
+                self->fail();
+                return;
+            }
+            self->sendNext();
+        });
+    }
+
+    void fail() {
+        // Запросы упавшего соединения дорабатывают остальные
+        budget_.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+/**
+ * @brief Отправляет REQUESTS_PER_ITERATION запросов через LOAD_CONNECTIONS соединений
+ * @return Количество соединений, завершившихся ошибкой
+ */
+int64_t runLoad(unsigned int clientThreads) {
+    net::io_context ioc;
+    LoadBudget budget;
+    budget.remaining = REQUESTS_PER_ITERATION;
+
+    for (size_t i = 0; i < LOAD_CONNECTIONS; ++i) {
+        std::make_shared<LoadConnection>(ioc, budget)->start();
+    }
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < clientThreads; ++i) {
+        threads.emplace_back([&ioc] { ioc.run(); });
+    }
+    ioc.run();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    return budget.failures.load(std::memory_order_relaxed);
+}
+} // namespace
+
+void registerHttpServerBenchmarks() {
+    // Пропускная способность сервера на маленьких ответах от 1 до N потоков, с общим acceptor
+    // и с acceptor на каждый поток (SO_REUSEPORT). Нагрузку даёт клиент в этом же процессе на
+    // всех ядрах, поэтому рост req/s показателен, пока сервер и клиент не делят одни ядра.
+    // Результат - items_per_second (запросов в секунду)
+    const unsigned int hardwareThreads = std::max(std::thread::hardware_concurrency(), 1U);
+
+    auto* serve = benchmark::RegisterBenchmark(
+        "BoostBeastHttpServer/serve/keep_alive", [hardwareThreads](benchmark::State& state) {
+            Infrastructure::Http::HttpServerSettings settings;
+            settings.threadCount = static_cast<unsigned int>(state.range(0));
+            settings.reusePort = state.range(1) != 0;
+            settings.session.maxRequestsPerConnection = static_cast<unsigned int>(REQUESTS_PER_ITERATION);
+
+            LoadServer server(settings);
+            if (!server.isReady()) {
+                state.SkipWithError("Сервер не начал принимать соединения");
+                return;
+            }
+
+            int64_t failures = 0;
+            for (auto _ : state) {
+                failures += runLoad(hardwareThreads);
+            }
+            state.SetItemsProcessed(state.iterations() * REQUESTS_PER_ITERATION);
+
+            if (failures > 0) {
+                state.SkipWithError("Часть соединений завершилась ошибкой");
+            }
+        });
+
+    std::vector<int64_t> threadCounts;
+    for (unsigned int threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    serve->ArgsProduct({threadCounts, {0, 1}})
+        ->ArgNames({"threads", "reuse_port"})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+}
+} // namespace Benchmarks
@@ -0,0 +1,297 @@
+#include <benchmark/benchmark.h>
+
+#include <charconv>
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../Core/Application/AdmissionController.h"
+#include "../Core/Application/ClientRateLimiter.h"
+#include "../Core/Application/SingleFlight.h"
+#include "../Core/Domain/Model/PostingList.h"
+#include "../Core/Ports/ITracer.h"
+#include "../Infrastructure/Database/PostingListCodec.h"
+#include "../Infrastructure/Metrics/MetricsRegistry.h"
+
+namespace Benchmarks {
+namespace {
+using Infrastructure::Database::PostingListCodec;
+
+constexpr unsigned RANDOM_SEED = 20240314;
+
+// Потоков в многопоточных бенчмарках: от одного до числа, заметно превышающего ядра
+constexpr int MAX_THREADS = 16;
+
+/**
+ * @brief Постинги частого слова: небольшие разности ID, частоты 1..20
+ */
+std::vector<PostingListCodec::Posting> makePostings(size_t count) {
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_int_distribution<PostingListCodec::DocumentIdType> gapDistribution(1, 64);
+    std::uniform_int_distribution<PostingListCodec::FrequencyType> frequencyDistribution(1, 20);
+
+    std::vector<PostingListCodec::Posting> postings(count);
+    PostingListCodec::DocumentIdType documentId = 0;
+    for (auto& posting : postings) {
+        documentId += gapDistribution(random);
+        posting = {documentId, frequencyDistribution(random)};
+    }
+    return postings;
+}
+
+/**
+ * @brief Строка результата SELECT document_id, frequency в текстовом формате, как её отдаёт libpqxx
+ */
+struct PostingRow {
+    std::string documentId;
+    std::string frequency;
+};
+
+std::vector<PostingRow> makePostingRows(const std::vector<PostingListCodec::Posting>& postings) {
+    std::vector<PostingRow> rows;
+    rows.reserve(postings.size());
+    for (const auto& posting : postings) {
+        rows.push_back({std::to_string(posting.documentId), std::to_string(posting.frequency)});
+    }
+    return rows;
+}
+
+/**
+ * @brief Разбор поля строки результата (аналог row[i].as<T>())
+ */
+template <typename Value>
+Value parseField(const std::string& field) {
+    Value value{};
+    std::from_chars(field.data(), field.data() + field.size(), value);
+    return value;
+}
+
+/**
+ * @brief Трассировщик, ничего не записывающий: цена самого отрезка без записи в файл
+ */
+class NullTracer : public Core::Ports::ITracer {
+  public:
+    void recordSpan(const char* name,
+                    const char* category,
+                    std::string_view detail,
+                    Clock::time_point start,
+                    Clock::time_point end) override {
+        benchmark::DoNotOptimize(name);
+        benchmark::DoNotOptimize(category);
+        benchmark::DoNotOptimize(detail.size());
+        benchmark::DoNotOptimize(end - start);
+    }
+};
+
+/**
+ * @brief Занимает поток на заданное время, не отдавая процессор (имитация поиска)
+ */
+void spin(std::chrono::microseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+Infrastructure::Metrics::MetricsRegistry& getMetricsRegistry() {
+    static Infrastructure::Metrics::MetricsRegistry registry;
+    return registry;
+}
+} // namespace
+
+void registerInfrastructureBenchmarks() {
+    static const auto postings = makePostings(100000);
+    static const auto encoded = PostingListCodec::encode(postings);
+
+    benchmark::RegisterBenchmark("PostingListCodec/encode", [](benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(PostingListCodec::encode(postings));
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(postings.size()));
+    })->Unit(benchmark::kMicrosecond);
+
+    benchmark::RegisterBenchmark("PostingListCodec/decode", [](benchmark::State& state) {
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(PostingListCodec::decode(encoded.data(), encoded.size()));
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(postings.size()));
+        state.counters["bytes_per_posting"] =
+            static_cast<double>(encoded.size()) / static_cast<double>(postings.size());
+    })->Unit(benchmark::kMicrosecond);
+
+    // Список постингов для поиска: из blob упакованного хранения и из строк word_frequencies.
+    // Сетевой обмен и разбор протокола не входят ни в один замер
+    benchmark::RegisterBenchmark("PostingList/materialize/packed", [](benchmark::State& state) {
+        using Core::Domain::Model::PostingList;
+        for (auto _ : state) {
+            std::vector<PostingList::DocumentIdType> documentIds;
+            std::vector<PostingList::FrequencyType> frequencies;
+            PostingListCodec::Cursor cursor(encoded.data(), encoded.size());
+            PostingListCodec::Posting posting;
+            while (cursor.next(posting)) {
+                documentIds.push_back(posting.documentId);
+                frequencies.push_back(posting.frequency);
+            }
+            benchmark::DoNotOptimize(PostingList(std::move(documentIds), std::move(frequencies)));
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(postings.size()));
+    })->Unit(benchmark::kMicrosecond);
+
+    benchmark::RegisterBenchmark("PostingList/materialize/rows", [](benchmark::State& state) {
+        using Core::Domain::Model::PostingList;
+        static const auto rows = makePostingRows(postings);
+        for (auto _ : state) {
+            std::vector<PostingList::DocumentIdType> documentIds;
+            std::vector<PostingList::FrequencyType> frequencies;
+            for (const auto& row : rows) {
+                documentIds.push_back(parseField<PostingList::DocumentIdType>(row.documentId));
+                frequencies.push_back(parseField<PostingList::FrequencyType>(row.frequency));
+            }
+            benchmark::DoNotOptimize(PostingList(std::move(documentIds), std::move(frequencies)));
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(rows.size()));
+
+        // Байты значений полей без служебных данных протокола
+        size_t fieldBytes = 0;
+        for (const auto& row : rows) {
+            fieldBytes += row.documentId.size() + row.frequency.size();
+        }
+        state.counters["bytes_per_posting"] = static_cast<double>(fieldBytes) / static_cast<double>(rows.size());
+    })->Unit(benchmark::kMicrosecond);
+
+    // Метрики пишутся из всех потоков сервера: важна цена под конкуренцией
+    benchmark::RegisterBenchmark("MetricsRegistry/counter.add", [](benchmark::State& state) {
+        auto& counter = getMetricsRegistry().counter("benchmark_counter_total", "Benchmark counter");
+        for (auto _ : state) {
+            counter.add();
+        }
+    })->ThreadRange(1, MAX_THREADS);
+
+    benchmark::RegisterBenchmark("MetricsRegistry/histogram.record", [](benchmark::State& state) {
+        auto& histogram = getMetricsRegistry().histogram("benchmark_duration_seconds", "Benchmark histogram");
+        std::chrono::nanoseconds duration{1000};
+        for (auto _ : state) {
+            histogram.record(duration);
+            duration = std::chrono::nanoseconds((duration.count() * 7 + 13) % 50000000);
+        }
+    })->ThreadRange(1, MAX_THREADS);
+
+    // Отрезок трассировки: выключенная трассировка и запись в трассировщик без вывода
+    benchmark::RegisterBenchmark("TraceSpan/disabled", [](benchmark::State& state) {
+        Core::Ports::Tracing::setTracer(nullptr);
+        for (auto _ : state) {
+            Core::Ports::TraceSpan span("benchmark", "benchmark", "https://example.org/page");
+        }
+    });
+
+    benchmark::RegisterBenchmark("TraceSpan/enabled", [](benchmark::State& state) {
+        NullTracer tracer;
+        Core::Ports::Tracing::setTracer(&tracer);
+        for (auto _ : state) {
+            Core::Ports::TraceSpan span("benchmark", "benchmark", "https://example.org/page");
+        }
+        Core::Ports::Tracing::setTracer(nullptr);
+    });
+
+    // Нагрузочный прогон контроля допуска: потоки непрерывно выполняют "поиск" по 200 мкс
+    // при 4 допущенных одновременно; сверх этого запросы ждут или отклоняются
+    benchmark::RegisterBenchmark("AdmissionController/acquire", [](benchmark::State& state) {
+        // Создаётся и уничтожается первым потоком; остальные ждут его на границах цикла замера
+        static std::unique_ptr<Core::Application::AdmissionController> controller;
+        if (state.thread_index() == 0) {
+            Core::Application::AdmissionSettings settings;
+            settings.maxConcurrent = 4;
+            settings.maxQueued = 4;
+            controller = std::make_unique<Core::Application::AdmissionController>(settings);
+        }
+
+        int64_t rejected = 0;
+        for (auto _ : state) {
+            auto ticket = controller->acquire();
+            if (ticket) {
+                spin(std::chrono::microseconds(200));
+            } else {
+                ++rejected;
+            }
+        }
+        // Доля отклонённых запросов
+        state.counters["rejected"] =
+            benchmark::Counter(static_cast<double>(rejected), benchmark::Counter::kAvgIterations);
+
+        if (state.thread_index() == 0) {
+            controller.reset();
+        }
+    })
+        ->ThreadRange(1, MAX_THREADS)
+        ->UseRealTime()
+        ->Unit(benchmark::kMicrosecond);
+
+    // Одинаковые одновременные поиски: потоки непрерывно ищут один запрос по 200 мкс,
+    // и к бэкенду доходит только часть вызовов. С разными ключами объединять нечего -
+    // это цена самого SingleFlight без выигрыша
+    const auto registerSingleFlight = [](const char* name, bool sameKey) {
+        benchmark::RegisterBenchmark(name, [sameKey](benchmark::State& state) {
+            // Создаётся и уничтожается первым потоком; остальные ждут его на границах цикла замера
+            static std::unique_ptr<Core::Application::SingleFlight<int>> singleFlight;
+            if (state.thread_index() == 0) {
+                singleFlight = std::make_unique<Core::Application::SingleFlight<int>>(std::chrono::seconds(1));
+            }
+
+            const std::string key = sameKey ? "query" : "query " + std::to_string(state.thread_index());
+            const Core::Ports::RequestDeadline deadline;
+            int64_t executed = 0;
+            for (auto _ : state) {
+                benchmark::DoNotOptimize(singleFlight->run(key, deadline, [&executed](const auto&) {
+                    ++executed;
+                    spin(std::chrono::microseconds(200));
+                    return 1;
+                }));
+            }
+            // Доля вызовов, дошедших до бэкенда
+            state.counters["executed"] =
+                benchmark::Counter(static_cast<double>(executed), benchmark::Counter::kAvgIterations);
+
+            if (state.thread_index() == 0) {
+                singleFlight.reset();
+            }
+        })
+            ->ThreadRange(1, MAX_THREADS)
+            ->UseRealTime()
+            ->Unit(benchmark::kMicrosecond);
+    };
+    registerSingleFlight("SingleFlight/run/same_key", true);
+    registerSingleFlight("SingleFlight/run/distinct_keys", false);
+
+    benchmark::RegisterBenchmark("ClientRateLimiter/tryAcquire", [](benchmark::State& state) {
+        static Core::Application::ClientRateLimiter limiter(100.0, 20.0);
+
+        // У каждого потока свои клиенты: 1000 адресов вида 10.<поток>.x.y
+        std::vector<std::string> clients;
+        for (int i = 0; i < 1000; ++i) {
+            clients.push_back("10." + std::to_string(state.thread_index()) + "." + std::to_string(i / 256) + "." +
+                              std::to_string(i % 256));
+        }
+
+        size_t next = 0;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(limiter.tryAcquire(clients[next]));
+            next = next + 1 == clients.size() ? 0 : next + 1;
+        }
+    })->ThreadRange(1, MAX_THREADS);
+
+    // Каждый запрос с нового адреса: таблица клиентов заполнена, и каждый новый вытесняет старый
+    benchmark::RegisterBenchmark("ClientRateLimiter/tryAcquire/spray", [](benchmark::State& state) {
+        Core::Application::ClientRateLimiter limiter(100.0, 20.0, 10000);
+
+        uint32_t address = 0;
+        std::string client;
+        for (auto _ : state) {
+            client = std::to_string(address >> 16) + "." + std::to_string(address & 0xFFFF);
+            benchmark::DoNotOptimize(limiter.tryAcquire(client));
+            ++address;
+        }
+    });
+}
+} // namespace Benchmarks
@@ -0,0 +1,164 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmarks.h"
+#include "../Core/Domain/Model/RevisitSchedule.h"
+#include "../Core/Domain/Service/RevisitSchedulingService.h"
+
+namespace Benchmarks {
+namespace {
+using Core::Domain::Model::RevisitSchedule;
+using Core::Domain::Service::RevisitSchedulingService;
+
+constexpr unsigned RANDOM_SEED = 20240314;
+
+constexpr int64_t HOUR_SEC = 60 * 60;
+constexpr int64_t DAY_SEC = 24 * HOUR_SEC;
+
+// Коллекция и длительность моделирования
+constexpr size_t PAGE_COUNT = 2000;
+constexpr int64_t SIMULATION_SEC = 120 * DAY_SEC;
+
+// Доля статичных страниц; у остальных интенсивность изменений - лог-равномерно
+// от раза в час до раза в 90 дней
+constexpr double STATIC_PAGE_SHARE = 0.2;
+constexpr double MAX_CHANGE_RATE = 1.0 / static_cast<double>(HOUR_SEC);
+constexpr double MIN_CHANGE_RATE = 1.0 / static_cast<double>(90 * DAY_SEC);
+
+/**
+ * @brief Итог моделирования одной политики посещений
+ */
+struct SimulationResult {
+    int64_t fetches = 0;
+    double freshSeconds = 0.0;  // Суммарное время, когда копия в индексе совпадала со страницей
+};
+
+/**
+ * @brief Интенсивности изменений страниц (изменений в секунду, 0 - страница не меняется)
+ */
+std::vector<double> makeChangeRates() {
+    std::mt19937 random(RANDOM_SEED);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+    std::vector<double> rates(PAGE_COUNT);
+    const double logMin = std::log(MIN_CHANGE_RATE);
+    const double logMax = std::log(MAX_CHANGE_RATE);
+    for (auto& rate : rates) {
+        rate = unit(random) < STATIC_PAGE_SHARE ? 0.0 : std::exp(logMin + unit(random) * (logMax - logMin));
+    }
+    return rates;
+}
+
+/**
+ * @brief Моделирует посещения одной страницы на [0, SIMULATION_SEC]
+ *
+ * Изменения страницы - пуассоновский процесс: после каждого посещения время до
+ * следующего изменения разыгрывается заново (процесс без памяти). Копия свежая
+ * от посещения до первого изменения после него.
+ * @param nextInterval Интервал до следующего посещения по признаку изменения страницы
+ */
+template <typename NextInterval>
+void simulatePage(double changeRate, std::mt19937& random, NextInterval nextInterval, SimulationResult& result) {
+    std::exponential_distribution<double> timeToChange(changeRate > 0.0 ? changeRate : 1.0);
+    const auto drawChangeAt = [&](double visitedAt) {
+        return changeRate > 0.0 ? visitedAt + timeToChange(random) : std::numeric_limits<double>::infinity();
+    };
+
+    // Первичный краулинг: все страницы скачаны в момент 0
+    double visitedAt = 0.0;
+    double changeAt = drawChangeAt(visitedAt);
+    double nextVisitAt = static_cast<double>(nextInterval(0, true));
+    ++result.fetches;
+
+    while (true) {
+        const double until = std::min(nextVisitAt, static_cast<double>(SIMULATION_SEC));
+        result.freshSeconds += std::min(changeAt, until) - visitedAt;
+        if (nextVisitAt >= static_cast<double>(SIMULATION_SEC)) {
+            break;
+        }
+
+        const bool changed = changeAt <= nextVisitAt;
+        visitedAt = nextVisitAt;
+        changeAt = drawChangeAt(visitedAt);
+        nextVisitAt = visitedAt + static_cast<double>(nextInterval(static_cast<int64_t>(visitedAt), changed));
+        ++result.fetches;
+    }
+}
+
+/**
+ * @brief Адаптивная политика: интервалы из RevisitSchedulingService по наблюдённым изменениям
+ */
+SimulationResult simulateAdaptive(const std::vector<double>& changeRates, double visitPriceSec) {
+    std::mt19937 random(RANDOM_SEED);
+    SimulationResult result;
+    for (const double changeRate : changeRates) {
+        RevisitSchedule schedule("https://example.org/page");
+        simulatePage(
+            changeRate, random,
+            [&schedule, visitPriceSec](int64_t visitedAt, bool changed) {
+                RevisitSchedulingService::recordVisit(schedule, visitedAt, changed, visitPriceSec);
+                return schedule.getNextVisitAt() - visitedAt;
+            },
+            result);
+    }
+    return result;
+}
+
+/**
+ * @brief Равномерная политика: все страницы посещаются с одним интервалом
+ */
+SimulationResult simulateUniform(const std::vector<double>& changeRates, int64_t interval) {
+    std::mt19937 random(RANDOM_SEED);
+    SimulationResult result;
+    for (const double changeRate : changeRates) {
+        simulatePage(changeRate, random, [interval](int64_t, bool) { return interval; }, result);
+    }
+    return result;
+}
+} // namespace
+
+void registerRevisitBenchmarks() {
+    // Свежесть индекса при одинаковом числе скачиваний: адаптивное расписание против
+    // равномерного обхода, интервал которого подобран под тот же бюджет скачиваний.
+    // Аргумент - цена посещения (секунды), она задаёт бюджет. Время замера - цена
+    // моделирования; результат - в счётчиках: freshness_* - средняя по времени доля
+    // свежих копий, fetches_per_page_day - бюджет. Если адаптивное расписание не
+    // свежее равномерного, бенчмарк завершается ошибкой
+    static constexpr const char* NAME = "RevisitSchedulingService/simulate/adaptive_vs_uniform";
+    benchmark::RegisterBenchmark(NAME, [](benchmark::State& state) {
+        static const std::vector<double> changeRates = makeChangeRates();
+        const auto visitPriceSec = static_cast<double>(state.range(0));
+
+        SimulationResult adaptive;
+        SimulationResult uniform;
+        for (auto _ : state) {
+            adaptive = simulateAdaptive(changeRates, visitPriceSec);
+            const int64_t uniformInterval =
+                static_cast<int64_t>(PAGE_COUNT) * SIMULATION_SEC / std::max<int64_t>(1, adaptive.fetches);
+            uniform = simulateUniform(changeRates, uniformInterval);
+        }
+
+        const double pageSeconds = static_cast<double>(PAGE_COUNT) * static_cast<double>(SIMULATION_SEC);
+        const double pageDays = pageSeconds / static_cast<double>(DAY_SEC);
+        state.counters["freshness_adaptive"] = adaptive.freshSeconds / pageSeconds;
+        state.counters["freshness_uniform"] = uniform.freshSeconds / pageSeconds;
+        state.counters["fetches_per_page_day"] = static_cast<double>(adaptive.fetches) / pageDays;
+        state.counters["uniform_fetches_per_page_day"] = static_cast<double>(uniform.fetches) / pageDays;
+
+        if (adaptive.freshSeconds <= uniform.freshSeconds) {
+            state.SkipWithError("Адаптивное расписание не свежее равномерного при том же бюджете");
+        }
+    })
+        ->Arg(HOUR_SEC)
+        ->Arg(RevisitSchedulingService::DEFAULT_VISIT_PRICE_SEC)
+        ->Arg(DAY_SEC)
+        ->Unit(benchmark::kMillisecond)
+        ->Iterations(1);
+}
+} // namespace Benchmarks
@@ -0,0 +1,39 @@
+#include <benchmark/benchmark.h>
+
+#include "Benchmarks.h"
+#include "../Core/Domain/Service/IndexingService.h"
+#include "../Infrastructure/Text/BoostLocaleTextProcessor.h"
+
+namespace Benchmarks {
+void registerTextBenchmarks(const std::vector<CorpusPage>& corpus,
+                            Infrastructure::Text::BoostLocaleTextProcessor& textProcessor) {
+    for (const auto& page : corpus) {
+        benchmark::RegisterBenchmark(("BoostLocaleTextProcessor/normalize/" + page.name).c_str(),
+                                     [&page, &textProcessor](benchmark::State& state) {
+                                         for (auto _ : state) {
+                                             benchmark::DoNotOptimize(textProcessor.normalize(page.text));
+                                         }
+                                         state.SetBytesProcessed(state.iterations() *
+                                                                 static_cast<int64_t>(page.text.size()));
+                                     });
+
+        benchmark::RegisterBenchmark(("BoostLocaleTextProcessor/toLowercase/" + page.name).c_str(),
+                                     [&page, &textProcessor](benchmark::State& state) {
+                                         for (auto _ : state) {
+                                             benchmark::DoNotOptimize(textProcessor.toLowercase(page.text));
+                                         }
+                                         state.SetBytesProcessed(state.iterations() *
+                                                                 static_cast<int64_t>(page.text.size()));
+                                     });
+
+        benchmark::RegisterBenchmark(
+            ("IndexingService/analyzeWordFrequency/" + page.name).c_str(), [&page](benchmark::State& state) {
+                for (auto _ : state) {
+                    benchmark::DoNotOptimize(
+                        Core::Domain::Service::IndexingService::analyzeWordFrequency(page.indexedText));
+                }
+                state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(page.indexedText.size()));
+            });
+    }
+}
+} // namespace Benchmarks
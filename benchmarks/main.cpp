@@ -0,0 +1,69 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+#include "Benchmarks.h"
+#include "../Infrastructure/Parsers/HtmlParser.h"
+#include "../Infrastructure/Text/BoostLocaleTextProcessor.h"
+
+#ifndef SEARCH_BENCHMARK_CORPUS_DIR
+#define SEARCH_BENCHMARK_CORPUS_DIR "corpus"
+#endif
+
+/**
+ * Бенчмарки горячих путей Core и Infrastructure.
+ *
+ * Кроме флагов Google Benchmark (--benchmark_filter, --benchmark_out=results.json
+ * --benchmark_out_format=json, --benchmark_repetitions) принимает --corpus=<каталог>
+ * с HTML-страницами вместо каталога корпуса из исходников.
+ */
+int main(int argc, char* argv[]) {
+    // Устанавливаем UTF-8 для консоли
+    SetConsoleOutputCP(CP_UTF8);
+    SetConsoleCP(CP_UTF8);
+
+    benchmark::Initialize(&argc, argv);
+
+    static constexpr const char* CORPUS_FLAG = "--corpus=";
+    std::string corpusDirectory = SEARCH_BENCHMARK_CORPUS_DIR;
+    std::vector<char*> remainingArgs;
+    for (int i = 0; i < argc; ++i) {
+        if (i > 0 && std::strncmp(argv[i], CORPUS_FLAG, std::strlen(CORPUS_FLAG)) == 0) {
+            corpusDirectory = argv[i] + std::strlen(CORPUS_FLAG);
+        } else {
+            remainingArgs.push_back(argv[i]);
+        }
+    }
+    int remainingCount = static_cast<int>(remainingArgs.size());
+    if (benchmark::ReportUnrecognizedArguments(remainingCount, remainingArgs.data())) {
+        return 1;
+    }
+
+    try {
+        Infrastructure::Parsers::HtmlParser htmlParser;
+        Infrastructure::Text::BoostLocaleTextProcessor textProcessor("ru_RU.UTF-8");
+        const auto corpus = Benchmarks::loadCorpus(corpusDirectory, htmlParser, textProcessor);
+
+        Benchmarks::registerHtmlParserBenchmarks(corpus, htmlParser);
+        Benchmarks::registerTextBenchmarks(corpus, textProcessor);
+        Benchmarks::registerDomainBenchmarks(corpus);
+        Benchmarks::registerInfrastructureBenchmarks();
+        Benchmarks::registerAdmissionLoadBenchmarks();
+        Benchmarks::registerHttpClientBenchmarks();
+        Benchmarks::registerHttpServerBenchmarks();
+        Benchmarks::registerRevisitBenchmarks();
+
+        benchmark::RunSpecifiedBenchmarks();
+        benchmark::Shutdown();
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "ОШИБКА: " << e.what() << std::endl;
+        return 1;
+    }
+}